@@ -8,6 +8,7 @@
 #define MB_CONTROLLER_H 
 
 #include <iostream>
+#include <vector>
 
 #include "json/json.h"
 
@@ -65,6 +66,12 @@ namespace NsMessageBroker
        */
       void sendJsonMessage(Json::Value& message);
 
+      /**
+       * \brief send Json messages in one write.
+       * \param messages JSON messages in order of sending.
+       */
+      void sendJsonMessages(std::vector<Json::Value>& messages);
+
       /**
       * \brief generates new message id from diapason mControllersIdStart - (mControllersIdStart+999).
       * \return next id for message
@@ -128,6 +128,25 @@ namespace NsMessageBroker
       DBG_MSG(("Length:%d, Sent: %d bytes\n", mes.length(), bytesSent));
    }
 
+   void CMessageBrokerController::sendJsonMessages(std::vector<Json::Value>& messages)
+   {
+      DBG_MSG(("CMessageBrokerController::sendJsonMessages()\n"));
+      sync_primitives::AutoLock auto_lock(queue_lock_);
+      std::string mes;
+      for (std::vector<Json::Value>::iterator it = messages.begin(); it != messages.end(); ++it)
+      {
+         Json::Value& message = *it;
+         mes += m_writer.write(message);
+         if (!isNotification(message) && !isResponse(message))
+         {// not notification, not a response, store id and method name to recognize an answer
+            mWaitResponseQueue.insert(std::map<std::string, std::string>::value_type(message["id"].asString(), message["method"].asString()));
+         }
+      }
+      int bytesSent = Send(mes);
+      bytesSent = bytesSent; // to prevent compiler warnings in case DBG_MSG off
+      DBG_MSG(("Messages:%d, Length:%d, Sent: %d bytes\n", messages.size(), mes.length(), bytesSent));
+   }
+
    std::string CMessageBrokerController::findMethodById(std::string id)
    {
       DBG_MSG(("CMessageBrokerController::findMethodById()\n"));
@@ -41,6 +41,7 @@
 #include "utils/date_time.h"
 #include "application_manager/application_data_impl.h"
 #include "application_manager/usage_statistics.h"
+#include "application_manager/policies/compiled_permissions.h"
 #include "connection_handler/device.h"
 #include "utils/timer_thread.h"
 #include "utils/lock.h"
@@ -161,6 +162,10 @@ class ApplicationImpl : public virtual InitialApplicationDataImpl,
 
   UsageStatistics& usage_report();
 
+  policy::CompiledPermissionsPtr compiled_permissions() const;
+  void set_compiled_permissions(
+      const policy::CompiledPermissionsPtr& permissions);
+
   bool IsCommandLimitsExceeded(mobile_apis::FunctionID::eType cmd_id,
                                TLimitSource source);
   virtual void SubscribeToSoftButtons(int32_t cmd_id,
@@ -229,6 +234,8 @@ class ApplicationImpl : public virtual InitialApplicationDataImpl,
   std::set<mobile_apis::ButtonName::eType> subscribed_buttons_;
   std::set<uint32_t>                       subscribed_vehicle_info_;
   UsageStatistics                          usage_report_;
+  policy::CompiledPermissionsPtr           compiled_permissions_;
+  mutable sync_primitives::Lock            compiled_permissions_lock_;
   ProtocolVersion                          protocol_version_;
   bool                                     is_voice_communication_application_;
 
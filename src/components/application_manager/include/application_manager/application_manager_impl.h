@@ -39,10 +39,13 @@
 #include <set>
 #include "application_manager/hmi_command_factory.h"
 #include "application_manager/application_manager.h"
+#include "application_manager/file_streamer.h"
 #include "application_manager/hmi_capabilities.h"
 #include "application_manager/message.h"
 #include "application_manager/request_controller.h"
+#include "application_manager/request_traces.h"
 #include "application_manager/resume_ctrl.h"
+#include "application_manager/storage_ledger.h"
 #include "application_manager/vehicle_info_data.h"
 #include "protocol_handler/protocol_observer.h"
 #include "hmi_message_handler/hmi_message_observer.h"
@@ -69,10 +72,13 @@
 #include "utils/shared_ptr.h"
 #include "utils/message_queue.h"
 #include "utils/prioritized_queue.h"
+#include "utils/fair_prioritized_queue.h"
+#include "utils/id_hash_map.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/message_loop_thread.h"
 #include "utils/lock.h"
 #include "utils/singleton.h"
+#include "utils/snapshot_holder.h"
 
 namespace policy {
 class PolicyManager;
@@ -122,6 +128,13 @@ struct MessageFromMobile: public utils::SharedPtr<Message> {
   size_t PriorityOrder() const {
     return (*this)->Priority().OrderingValue();
   }
+  // FairPrioritizedQueue shares priority levels between applications
+  uint32_t FairQueueKey() const {
+    return (*this)->connection_key();
+  }
+  size_t FairQueueCost() const {
+    return (*this)->data_size();
+  }
 };
 
 struct MessageToMobile: public utils::SharedPtr<Message> {
@@ -159,7 +172,7 @@ struct MessageToHmi: public utils::SharedPtr<Message> {
 };
 
 // Short type names for prioritized message queues
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromMobile> > FromMobileQueue;
+typedef threads::MessageLoopThread<utils::FairPrioritizedQueue<MessageFromMobile> > FromMobileQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToMobile> > ToMobileQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromHmi> > FromHmiQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToHmi> > ToHmiQueue;
@@ -247,6 +260,44 @@ class ApplicationManagerImpl : public ApplicationManager,
     std::vector<utils::SharedPtr<Application>> IviInfoUpdated(
       VehicleDataType vehicle_info, int value);
 
+    /**
+     * @brief Subscribes application to button and registers it
+     * as the button subscriber.
+     * @param app Application to subscribe
+     * @param button Button to subscribe to
+     * @return true if application was not subscribed to button before
+     */
+    bool SubscribeAppToButton(ApplicationSharedPtr app,
+                              mobile_apis::ButtonName::eType button);
+
+    /**
+     * @brief Unsubscribes application from button and removes it
+     * from the button subscribers.
+     * @param app Application to unsubscribe
+     * @param button Button to unsubscribe from
+     * @return true if application was subscribed to button
+     */
+    bool UnsubscribeAppFromButton(ApplicationSharedPtr app,
+                                  mobile_apis::ButtonName::eType button);
+
+    /**
+     * @brief Subscribes application to vehicle data and registers it
+     * as the vehicle data subscriber.
+     * @param app Application to subscribe
+     * @param vehicle_info Type of vehicle data to subscribe to
+     * @return true if application was not subscribed to vehicle data before
+     */
+    bool SubscribeAppToIVI(ApplicationSharedPtr app, uint32_t vehicle_info);
+
+    /**
+     * @brief Unsubscribes application from vehicle data and removes it
+     * from the vehicle data subscribers.
+     * @param app Application to unsubscribe
+     * @param vehicle_info Type of vehicle data to unsubscribe from
+     * @return true if application was subscribed to vehicle data
+     */
+    bool UnsubscribeAppFromIVI(ApplicationSharedPtr app, uint32_t vehicle_info);
+
     /////////////////////////////////////////////////////
 
     HMICapabilities& hmi_capabilities();
@@ -258,6 +309,11 @@ class ApplicationManagerImpl : public ApplicationManager,
      * @param observer - pointer to observer
      */
     void SetTimeMetricObserver(AMMetricObserver* observer);
+
+    /**
+     * @brief Traces of mobile requests which are being processed
+     */
+    RequestTraces& request_traces();
 #endif  // TIME_TESTER
 
     ApplicationSharedPtr RegisterApplication(
@@ -433,6 +489,19 @@ class ApplicationManagerImpl : public ApplicationManager,
     void SendMessageToMobile(
       const utils::SharedPtr<smart_objects::SmartObject> message,
       bool final_message = false);
+
+    /**
+     * @brief Puts notification to the queue to be sent to several
+     * applications. JSON payload is serialized once per protocol version
+     * family, only connection key and protocol version are set per
+     * recipient. Policy permissions are checked for every application,
+     * applications not allowed to receive the notification are skipped.
+     * @param message Notification to send, connection key is ignored
+     * @param applications Recipients of notification
+     */
+    void MulticastMessageToMobile(
+      const smart_objects::SmartObject& message,
+      const std::vector<ApplicationSharedPtr>& applications);
     bool ManageMobileCommand(
       const utils::SharedPtr<smart_objects::SmartObject> message);
     void SendMessageToHMI(
@@ -453,8 +522,28 @@ class ApplicationManagerImpl : public ApplicationManager,
     virtual void OnMobileMessageSent(
         const ::protocol_handler::RawMessagePtr message);
 
+    /*
+     * @brief Number of messages of all applications waiting in queue of
+     * messages from mobile
+     */
+    size_t GetMessagesFromMobileCount() const;
+
+    /*
+     * @brief Number of messages of application with |connection_key|
+     * waiting in queue of messages from mobile
+     */
+    size_t GetMessagesFromMobileCount(uint32_t connection_key) const;
+
+    /*
+     * @brief Counters of lane of requests of application with
+     * |connection_key| in request controller
+     */
+    request_controller::RequestController::LaneStatistics
+    GetRequestLaneStatistics(uint32_t connection_key) const;
+
     void OnMessageReceived(hmi_message_handler::MessageSharedPointer message);
     void OnErrorSending(hmi_message_handler::MessageSharedPointer message);
+    void OnMessageSuperseded(hmi_message_handler::MessageSharedPointer message);
 
     void OnDeviceListUpdated(const connection_handler::DeviceMap& device_list);
     //TODO (EZamakhov): fix all indentations in this file
@@ -593,6 +682,40 @@ class ApplicationManagerImpl : public ApplicationManager,
         const std::string& file_name,
         const int64_t offset);
 
+    /**
+     * @brief Returns incoming message holding binary data of PutFile
+     * request. The data is not copied to smart object of request and is
+     * forgotten by application manager once taken.
+     *
+     * @return message or empty pointer if request has no binary data
+     */
+    utils::SharedPtr<Message> TakeFileChunk(uint32_t connection_key,
+                                            uint32_t correlation_id);
+
+    /*
+     * @brief Writes chunk of file downloaded by application. File stays
+     * open for next chunks until it is completed
+     *
+     * @param app_id Application downloading the file
+     * @param chunk binary data
+     * @param chunk_size size of binary data
+     * @param file_path path for saving data
+     * @param file_name File name
+     * @param offset of chunk. If offset is 0 - create new file
+     *        ( overrite existing )
+     * @param file_size Size of whole file, 0 if chunk is whole file
+     *
+     * @return SUCCESS if chunk was saved, other code otherwise
+     */
+    mobile_apis::Result::eType SaveFileChunk(
+        uint32_t app_id,
+        const uint8_t* chunk,
+        const size_t chunk_size,
+        const std::string& file_path,
+        const std::string& file_name,
+        const int64_t offset,
+        const int64_t file_size);
+
     /**
      * @brief Get available app space
      * @param name of the app folder(make + mobile app id)
@@ -600,6 +723,15 @@ class ApplicationManagerImpl : public ApplicationManager,
      */
     uint32_t GetAvailableSpaceForApp(const std::string& folder_name);
 
+    /**
+     * @brief Updates space used by app after file was saved or deleted
+     * @param name of the app folder(make + mobile app id)
+     * @param previous_size Size of file before change, 0 for new file
+     * @param size Size of file after change, 0 for deleted file
+     */
+    void UpdateUsedSpaceForApp(const std::string& folder_name,
+                               int64_t previous_size, int64_t size);
+
     /*
      * @brief returns true if HMI is cooperating
      */
@@ -668,6 +800,21 @@ class ApplicationManagerImpl : public ApplicationManager,
         const RPCParams& rpc_params,
         CommandParametersPermissions* params_permissions = NULL);
 
+    /**
+     * @brief Checks, if given RPC is allowed at current HMI level of
+     * application by its compiled policy permissions. RPCs which were not
+     * compiled are checked in policy table.
+     * @param app Application
+     * @param function_id FunctionID of RPC
+     * @param params_permissions Permissions for RPC parameters (e.g.
+     * SubscribeVehicleData) defined in policy table
+     * @return SUCCESS, if allowed, otherwise result code of check
+     */
+    mobile_apis::Result::eType CheckPolicyPermissions(
+        ApplicationSharedPtr app,
+        mobile_apis::FunctionID::eType function_id,
+        CommandParametersPermissions* params_permissions = NULL);
+
     // typedef for Applications list
     typedef const std::set<ApplicationSharedPtr> TAppList;
 
@@ -677,6 +824,31 @@ class ApplicationManagerImpl : public ApplicationManager,
     // typedef for Applications list const iterator
     typedef std::set<ApplicationSharedPtr>::const_iterator TAppListConstIt;
 
+  private:
+    typedef std::vector<ApplicationSharedPtr> ApplicationsVector;
+    typedef utils::IdHashMap<ApplicationSharedPtr> AppIdIndex;
+    typedef utils::IdHashMap<ApplicationsVector> HmiAppIdIndex;
+    /**
+     * @brief Keyed by hash of policy app id, applications with different
+     * ids having the same hash share the key.
+     */
+    typedef utils::IdHashMap<ApplicationsVector> PolicyAppIdIndex;
+
+    /**
+     * @brief Registered applications with indexes by app id, hmi app id
+     * and policy app id. Snapshot is never changed after it is published:
+     * writers copy current one, modify the copy and publish it instead.
+     */
+    struct ApplicationsSnapshot {
+      std::set<ApplicationSharedPtr> applications;
+      AppIdIndex by_app_id;
+      HmiAppIdIndex by_hmi_app_id;
+      PolicyAppIdIndex by_policy_app_id;
+    };
+    typedef utils::SnapshotHolder<ApplicationsSnapshot>::Snapshot
+    ApplicationsSnapshotPtr;
+
+  public:
     /**
      * Class for thread-safe access to applications list
      */
@@ -685,30 +857,31 @@ class ApplicationManagerImpl : public ApplicationManager,
 
       /**
        * @brief ApplicationListAccessor class constructor
+       * Takes current snapshot of applications list, no lock is held
+       * during accessor lifetime.
        */
-      ApplicationListAccessor() {
-        ApplicationManagerImpl::instance()->applications_list_lock_.Acquire();
+      ApplicationListAccessor()
+        : snapshot_(ApplicationManagerImpl::instance()->applications_.Get()) {
       }
 
       /**
        * @brief ApplicationListAccessor class destructor
        */
       ~ApplicationListAccessor() {
-        ApplicationManagerImpl::instance()->applications_list_lock_.Release();
       }
 
-      // TODO(VS): Now we have return application list by value, because we have
-      // situations, when our process is killed without Stop method called.
-      // This problem must be discussed and fixed.
       /**
        * @brief thread-safe getter for applications
-       * @return applications list
+       * @return applications registered when accessor was created,
+       * valid during accessor lifetime
        */
-      TAppList applications() {
-        return ApplicationManagerImpl::instance()->application_list_;
+      TAppList& applications() const {
+        return snapshot_->applications;
       }
 
      private:
+      const ApplicationsSnapshotPtr snapshot_;
+
       DISALLOW_COPY_AND_ASSIGN(ApplicationListAccessor);
     };
 
@@ -722,6 +895,42 @@ class ApplicationManagerImpl : public ApplicationManager,
 
     bool ConvertMessageToSO(const Message& message,
                             smart_objects::SmartObject& output);
+
+    /**
+     * @brief Fills params of mobile message from its protocol header
+     * without decoding msg_params, which are decoded by DecodeMsgParams
+     * only when message passes dispatch checks.
+     *
+     * @param message Mobile message of protocol version 2 or higher
+     * @param output Smart object to fill params of
+     *
+     * @return false if message was rejected with INVALID_DATA
+     */
+    bool ConvertMessageHeaderToSO(const Message& message,
+                                  smart_objects::SmartObject& output);
+
+    /**
+     * @brief Decodes and validates msg_params of mobile message which
+     * params were filled by ConvertMessageHeaderToSO.
+     *
+     * @param message Mobile message
+     * @param output Smart object to add msg_params to
+     *
+     * @return false if message was rejected with INVALID_DATA
+     */
+    bool DecodeMsgParams(const Message& message,
+                         smart_objects::SmartObject& output);
+
+    /**
+     * @brief Manages mobile command which msg_params are not decoded yet.
+     *
+     * @param message Smart object with params of message
+     * @param msg_params_source Message to decode msg_params from after
+     * routing and flood checks or NULL if they are decoded already
+     */
+    bool ManageMobileCommand(
+      const utils::SharedPtr<smart_objects::SmartObject> message,
+      const Message* msg_params_source);
     bool ConvertSOtoMessage(const smart_objects::SmartObject& message,
                             Message& output);
     utils::SharedPtr<Message> ConvertRawMsgToMessage(
@@ -747,6 +956,35 @@ class ApplicationManagerImpl : public ApplicationManager,
     // CALLED ON messages_to_hmi_ thread!
     virtual void Handle(const impl::MessageToHmi message) OVERRIDE;
 
+    typedef utils::IdHashMap<std::set<ApplicationSharedPtr> >
+    SubscribersIndex;
+
+    /**
+     * @brief Adds application to applications list and its indexes and
+     * publishes new snapshot.
+     * Must be called with applications_list_lock_ acquired.
+     */
+    void AddApplication(ApplicationSharedPtr application);
+
+    /**
+     * @brief Removes application from applications list and its indexes
+     * and publishes new snapshot.
+     * Must be called with applications_list_lock_ acquired.
+     */
+    void RemoveApplication(ApplicationSharedPtr application);
+
+    /**
+     * @brief Checks if application is in applications list.
+     * Must be called with applications_list_lock_ acquired.
+     */
+    bool IsApplicationListed(ApplicationSharedPtr application) const;
+
+    /**
+     * @brief Removes application from subscribers of key.
+     */
+    static void RemoveSubscriber(SubscribersIndex& index, uint32_t key,
+                                 ApplicationSharedPtr application);
+
     void SendUpdateAppList(const std::list<uint32_t>& applications_ids);
     void OnApplicationListUpdateTimer();
 
@@ -761,11 +999,18 @@ class ApplicationManagerImpl : public ApplicationManager,
     // members
 
     /**
-     * @brief List of applications
+     * @brief Registered applications, read without applications_list_lock_
+     */
+    utils::SnapshotHolder<ApplicationsSnapshot> applications_;
+
+    /**
+     * @brief Registered applications by buttons and vehicle data types
+     * they are subscribed to. Guarded by applications_list_lock_.
      */
-    std::set<ApplicationSharedPtr> application_list_;
+    SubscribersIndex button_subscribers_;
+    SubscribersIndex ivi_subscribers_;
 
-    // Lock for applications list
+    // Lock serializing changes of applications list and subscribers
     mutable sync_primitives::Lock applications_list_lock_;
 
     /**
@@ -813,12 +1058,16 @@ class ApplicationManagerImpl : public ApplicationManager,
     connection_handler::ConnectionHandler*  connection_handler_;
     protocol_handler::ProtocolHandler*      protocol_handler_;
     request_controller::RequestController   request_ctrl_;
+    FileStreamer                            file_streamer_;
+    StorageLedger                           storage_ledger_;
 
     hmi_apis::HMI_API*                      hmi_so_factory_;
     mobile_apis::MOBILE_API*                mobile_so_factory_;
 
     static uint32_t corelation_id_;
     static const uint32_t max_corelation_id_;
+    // Seconds after which space used by app folder is walked again
+    static const time_t storage_reconcile_period_;
 
 
     // Construct message threads when everything is already created
@@ -846,6 +1095,7 @@ class ApplicationManagerImpl : public ApplicationManager,
 
 #ifdef TIME_TESTER
     AMMetricObserver* metric_observer_;
+    RequestTraces request_traces_;
 #endif  // TIME_TESTER
 
     class ApplicationListUpdateTimer : public timer::TimerThread<ApplicationManagerImpl> {
@@ -33,7 +33,10 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_COMMAND_NOTIFICATION_IMPL_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_COMMAND_NOTIFICATION_IMPL_H_
 
+#include <vector>
+
 #include "application_manager/commands/command_impl.h"
+#include "application_manager/application.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
@@ -53,6 +56,14 @@ class CommandNotificationImpl : public CommandImpl {
   virtual bool CleanUp();
   virtual void Run();
   void SendNotification();
+
+  /**
+   * @brief Sends notification to several applications at once, message is
+   * serialized once and connection key of message is ignored
+   *
+   * @param applications Recipients of notification
+   */
+  void SendNotification(const std::vector<ApplicationSharedPtr>& applications);
  private:
   DISALLOW_COPY_AND_ASSIGN(CommandNotificationImpl);
 };
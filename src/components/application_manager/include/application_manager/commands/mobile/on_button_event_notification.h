@@ -71,9 +71,9 @@ class OnButtonEventNotification : public CommandNotificationImpl {
   /*
    * @brief Sends button event notification to mobile device
    *
-   * @param app Application to receive notification
+   * @param applications Applications to receive notification
    */
-  void SendButtonEvent(ApplicationConstSharedPtr app);
+  void SendButtonEvent(const std::vector<ApplicationSharedPtr>& applications);
 
   DISALLOW_COPY_AND_ASSIGN(OnButtonEventNotification);
 };
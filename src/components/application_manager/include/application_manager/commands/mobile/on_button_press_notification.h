@@ -71,9 +71,9 @@ class OnButtonPressNotification : public CommandNotificationImpl {
   /*
    * @brief Sends button press notification to mobile device
    *
-   * @param app Application to receive notification
+   * @param applications Applications to receive notification
    */
-  void SendButtonPress(ApplicationConstSharedPtr app);
+  void SendButtonPress(const std::vector<ApplicationSharedPtr>& applications);
 
   DISALLOW_COPY_AND_ASSIGN(OnButtonPressNotification);
 };
@@ -38,6 +38,7 @@
 
 #include "utils/shared_ptr.h"
 #include "protocol/message_priority.h"
+#include "protocol/raw_message.h"
 #include "protocol/rpc_type.h"
 #include "smart_objects/smart_object.h"
 
@@ -83,9 +84,16 @@ class Message {
   MessageType type() const;
   ProtocolVersion protocol_version() const;
 
+  // JSON and binary data received as parts of raw message are copied
+  // to string and vector only when these accessors are called
   const std::string& json_message() const;
   const BinaryData* binary_data() const;
   bool has_binary_data() const;
+  // JSON and binary data without copying
+  const char* json_begin() const;
+  size_t json_size() const;
+  const uint8_t* binary_data_begin() const;
+  size_t binary_data_size() const;
   size_t data_size() const;
   size_t payload_size() const;
   const smart_objects::SmartObject& smart_object() const;
@@ -97,6 +105,13 @@ class Message {
   void set_message_type(MessageType type);
   void set_binary_data(BinaryData* data);
   void set_json_message(const std::string& json_message);
+  /**
+   * @brief Sets JSON and binary data to parts of raw message received
+   * from mobile, message keeps raw message instead of copying them
+   */
+  void set_payload(const protocol_handler::RawMessagePtr& raw_message,
+                   const uint8_t* json, size_t json_size,
+                   const uint8_t* binary_data, size_t binary_data_size);
   void set_protocol_version(ProtocolVersion version);
   void set_smart_object(const smart_objects::SmartObject& object);
   void set_data_size(size_t data_size);
@@ -104,6 +119,14 @@ class Message {
 
   protocol_handler::MessagePriority Priority() const { return priority_; }
 
+  /**
+   * @brief Trace of message processing, empty if message is not traced
+   */
+  const protocol_handler::MessageTracePtr& trace() const { return trace_; }
+  void set_trace(const protocol_handler::MessageTracePtr& trace) {
+    trace_ = trace;
+  }
+
  private:
   int32_t function_id_;  // @remark protocol V2.
   int32_t correlation_id_;  // @remark protocol V2.
@@ -114,14 +137,22 @@ class Message {
   protocol_handler::MessagePriority priority_;
 
   int32_t connection_key_;
-  std::string json_message_;
+  mutable std::string json_message_;
   smart_objects::SmartObject smart_object_;
 
   // TODO(akandul): replace with shared_ptr
-  BinaryData* binary_data_;
+  mutable BinaryData* binary_data_;
+
+  // Raw message which JSON and binary data point to
+  protocol_handler::RawMessagePtr raw_message_;
+  const uint8_t* raw_json_;
+  size_t raw_json_size_;
+  const uint8_t* raw_binary_data_;
+  size_t raw_binary_data_size_;
   size_t data_size_;
   size_t payload_size_;
   ProtocolVersion version_;
+  protocol_handler::MessageTracePtr trace_;
 };
 }  // namespace application_manager
 
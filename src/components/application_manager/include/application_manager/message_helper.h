@@ -43,6 +43,7 @@
 #include "application_manager/application.h"
 #include "application_manager/vehicle_info_data.h"
 #include "policy/policy_types.h"
+#include "protocol/message_priority.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
@@ -149,6 +150,15 @@ class MessageHelper {
     static std::string StringifiedFunctionID(
       mobile_apis::FunctionID::eType function_id);
 
+    /*
+    * @brief Calculates priority of message to mobile: responses and
+    * HMI status changes go before notifications, messages with binary
+    * data go last
+    * @param message Message to mobile with params filled
+    */
+    static protocol_handler::MessagePriority PriorityOfMessageToMobile(
+      const smart_objects::SmartObject& message);
+
     static smart_objects::SmartObject* CreateBlockedByPoliciesResponse(
       mobile_apis::FunctionID::eType function_id,
       mobile_apis::Result::eType result, uint32_t correlation_id,
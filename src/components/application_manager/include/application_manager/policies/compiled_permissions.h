@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_POLICIES_COMPILED_PERMISSIONS_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_POLICIES_COMPILED_PERMISSIONS_H_
+
+#include <stdint.h>
+#include <bitset>
+#include <map>
+#include <vector>
+
+#include "interfaces/MOBILE_API.h"
+#include "policy/policy_types.h"
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "utils/shared_ptr.h"
+
+namespace policy {
+
+/**
+ * @brief Policy permissions of one application compiled into a table
+ * indexed by function id and HMI level, so checking RPC sent to or from
+ * application is a couple of array reads, without locking policy and
+ * without allocations.
+ *
+ * Table is filled once from policy table and is not changed after it is
+ * published. Parameters are interned as vehicle data types and kept as
+ * bitsets.
+ */
+class CompiledPermissions {
+ public:
+  /**
+   * @brief Capacity of table for requests, which are numbered from zero,
+   * and for notifications, which are numbered from OnHMIStatusID
+   */
+  static const int32_t kRequestsCount = 64;
+  static const int32_t kNotificationsCount = 64;
+  static const int32_t kHmiLevelsCount = mobile_apis::HMILevel::HMI_NONE + 1;
+  static const size_t kParametersCount = 32;
+
+  /**
+   * @brief Set of parameters indexed by mobile_apis::VehicleDataType
+   */
+  typedef std::bitset<kParametersCount> Parameters;
+
+  struct RpcPermissions {
+    RpcPermissions()
+      : hmi_level_permitted(kRpcDisallowed) {
+    }
+    PermitResult hmi_level_permitted;
+    Parameters allowed_params;
+    Parameters disallowed_params;
+    Parameters undefined_params;
+  };
+
+  /**
+   * @brief Creates empty table
+   * @param generation Generation of policy which table is compiled from
+   */
+  explicit CompiledPermissions(uint32_t generation);
+
+  uint32_t generation() const {
+    return generation_;
+  }
+
+  /**
+   * @brief Checks whether function id fits into table
+   */
+  static bool Contains(mobile_apis::FunctionID::eType function_id);
+
+  /**
+   * @brief Stores permissions of RPC in HMI level
+   * @return false if function id or HMI level doesn't fit into table
+   */
+  bool Set(mobile_apis::FunctionID::eType function_id,
+           mobile_apis::HMILevel::eType hmi_level,
+           const RpcPermissions& permissions);
+
+  /**
+   * @brief Returns permissions of RPC in HMI level,
+   * NULL if they were not stored
+   */
+  const RpcPermissions* Find(mobile_apis::FunctionID::eType function_id,
+                             mobile_apis::HMILevel::eType hmi_level) const {
+    const int32_t index = Index(function_id, hmi_level);
+    return index < 0 || !stored_.test(index) ? NULL : &permissions_[index];
+  }
+
+ private:
+  static const size_t kEntriesCount =
+      (kRequestsCount + kNotificationsCount) * kHmiLevelsCount;
+
+  static int32_t Index(mobile_apis::FunctionID::eType function_id,
+                       mobile_apis::HMILevel::eType hmi_level) {
+    if (hmi_level < 0 || hmi_level >= kHmiLevelsCount) {
+      return -1;
+    }
+    int32_t function_index = function_id;
+    if (function_id >= mobile_apis::FunctionID::OnHMIStatusID) {
+      function_index = function_id - mobile_apis::FunctionID::OnHMIStatusID;
+      if (function_index >= kNotificationsCount) {
+        return -1;
+      }
+      function_index += kRequestsCount;
+    } else if (function_index < 0 || function_index >= kRequestsCount) {
+      return -1;
+    }
+    return function_index * kHmiLevelsCount + hmi_level;
+  }
+
+  const uint32_t generation_;
+  std::vector<RpcPermissions> permissions_;
+  std::bitset<kEntriesCount> stored_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompiledPermissions);
+};
+
+typedef utils::SharedPtr<const CompiledPermissions> CompiledPermissionsPtr;
+
+/**
+ * @brief Tracks changes of policy which compiled permissions become out of
+ * date after. Change of whole policy table outdates permissions of all
+ * applications, change of permissions of one application outdates only
+ * its own table.
+ *
+ * Every change takes next generation, table is stamped with generation
+ * current when its compilation starts, so table compiled concurrently with
+ * change is never taken as actual.
+ */
+class PermissionsGenerations {
+ public:
+  PermissionsGenerations();
+
+  /**
+   * @brief Returns generation to stamp permissions compiled now with
+   */
+  uint32_t Current();
+
+  /**
+   * @brief Outdates permissions of all applications, called after policy
+   * table is loaded, reset or updated
+   */
+  void OnPolicyChanged();
+
+  /**
+   * @brief Outdates permissions of one application
+   * @param app_id Id of application which permissions were changed
+   */
+  void OnAppChanged(uint32_t app_id);
+
+  /**
+   * @brief Checks whether permissions of application were compiled after
+   * last change affecting them
+   */
+  bool IsActual(uint32_t app_id, const CompiledPermissions& permissions);
+
+ private:
+  sync_primitives::Lock lock_;
+  uint32_t generation_;
+  uint32_t policy_generation_;
+  /**
+   * @brief Generations of changes of single applications by application id.
+   * Changes older than change of policy table don't matter, so map is
+   * cleared on each one.
+   */
+  std::map<uint32_t, uint32_t> app_generations_;
+
+  DISALLOW_COPY_AND_ASSIGN(PermissionsGenerations);
+};
+
+}  // namespace policy
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_POLICIES_COMPILED_PERMISSIONS_H_
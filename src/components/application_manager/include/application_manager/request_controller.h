@@ -36,6 +36,7 @@
 #include <climits>
 #include <vector>
 #include <list>
+#include <map>
 
 #include "utils/lock.h"
 #include "utils/shared_ptr.h"
@@ -85,6 +86,27 @@ class RequestController {
       STOPPED,
     };
 
+    /**
+    * @brief Counters of requests lane of application
+    */
+    struct LaneStatistics {
+      LaneStatistics()
+        : depth(0),
+          max_depth(0),
+          executed(0),
+          total_wait_time(0),
+          max_wait_time(0) {}
+
+      // Requests waiting in lane now
+      size_t depth;
+      size_t max_depth;
+      // Requests taken from lane by workers
+      uint32_t executed;
+      // Milliseconds requests waited in lane before worker took them
+      int64_t total_wait_time;
+      int64_t max_wait_time;
+    };
+
     // Methods
 
     /**
@@ -100,7 +122,9 @@ class RequestController {
     virtual ~RequestController();
 
     /**
-    * @brief Initialize thread pool
+    * @brief Initialize thread pool. Pool starts with one worker and
+    * grows up to thread pool size from profile when requests of several
+    * applications wait for execution.
     *
     */
     void  InitializeThreadpool();
@@ -112,7 +136,9 @@ class RequestController {
     void DestroyThreadpool();
 
     /**
-    * @brief Check if max request amount wasn't exceed and adds request to queue.
+    * @brief Adds request to queue of its application. Limits of
+    * application must be checked by checkRequestLimits before, amount of
+    * queued requests is checked here under the same lock as the insert.
     *
     * @param request     Active mobile request
     * @param hmi_level   Current application hmi_level
@@ -123,6 +149,30 @@ class RequestController {
     TResult addMobileRequest(const MobileRequestPtr& request,
                              const mobile_apis::HMILevel::eType& hmi_level);
 
+    /**
+    * @brief Check if max request amount wasn't exceed for application.
+    * Needs only connection key, so message may be rejected before
+    * its msg_params are decoded. Total amount of queued requests is
+    * checked by addMobileRequest.
+    *
+    * @param connection_key Connection key of application sending request
+    *
+    * @return SUCCESS if request can be added or reason of rejection
+    *
+    */
+    TResult checkRequestLimits(const uint32_t& connection_key);
+
+    /**
+    * @brief Counters of requests lane of application, they are kept
+    * until requests of application are terminated
+    *
+    * @param connection_key Connection key of application
+    *
+    * @return Lane counters, zero ones if application sent no requests
+    *
+    */
+    LaneStatistics GetLaneStatistics(const uint32_t& connection_key) const;
+
 
     /**
     * @brief Store HMI request until response or timeout won't remove it
@@ -143,10 +193,12 @@ class RequestController {
     /**
     * @brief Removes request from queue
     *
+    * @param connection_key Connection key of application sent request
     * @param mobile_corellation_id Active mobile request correlation ID
     *
     */
-    void terminateMobileRequest(const uint32_t& mobile_correlation_id);
+    void terminateMobileRequest(const uint32_t& connection_key,
+                                const uint32_t& mobile_correlation_id);
 
 
     /**
@@ -222,8 +274,45 @@ class RequestController {
 
   private:
 
+    /**
+    * @brief Starts one more worker if requests wait for execution,
+    * all workers are busy and pool size limit allows it.
+    * Must be called with mobile_request_list_lock_ acquired.
+    */
+    void GrowThreadpoolIfNeeded();
+
     // Data types
 
+    /**
+    * @brief Mobile request waiting for execution
+    */
+    struct QueuedRequest {
+      QueuedRequest(const MobileRequestPtr& request,
+                    const TimevalStruct& enqueue_time)
+        : request(request),
+          enqueue_time(enqueue_time) {}
+
+      MobileRequestPtr request;
+      TimevalStruct enqueue_time;
+    };
+
+    /**
+    * @brief Serial lane of application: its requests are executed one
+    * by one in order they came, lanes of different applications are
+    * executed in parallel by workers of pool.
+    */
+    struct Lane {
+      Lane()
+        : busy(false) {}
+
+      std::list<QueuedRequest> requests;
+      // Request of lane is executed by some worker
+      bool busy;
+    };
+
+    typedef std::map<uint32_t, Lane> Lanes;
+    typedef std::map<uint32_t, LaneStatistics> LanesStatistics;
+
     class Worker : public ThreadDelegate {
       public:
         Worker(RequestController* requestController);
@@ -237,13 +326,45 @@ class RequestController {
         volatile bool                                    stop_flag_;
     };
 
+    /**
+    * @brief Moves thread of worker idle for idle_worker_timeout_ from
+    * pool to retired workers, last worker of pool is never retired.
+    * Must be called under mobile_request_list_lock_.
+    *
+    * @return true if worker should exit
+    */
+    bool RetireWorker(const Worker* worker);
+
+    /**
+    * @brief Joins and deletes threads of retired workers.
+    * Must be called under mobile_request_list_lock_.
+    */
+    void DeleteRetiredWorkers();
+
     std::vector<Thread*> pool_;
+    // Threads of workers exited being idle, not joined yet
+    std::vector<Thread*> retired_workers_;
     volatile TPoolState pool_state_;
+    // Maximal amount of workers
     uint32_t pool_size_;
+    // Workers waiting for requests
+    uint32_t idle_workers_;
     sync_primitives::ConditionalVariable cond_var_;
 
-    std::list<MobileRequestPtr> mobile_request_list_;
-    sync_primitives::Lock mobile_request_list_lock_;
+    /**
+    * @brief Lanes of applications having requests queued or executed,
+    * keyed by connection key
+    */
+    Lanes mobile_request_lanes_;
+    /**
+    * @brief Connection keys of lanes having queued requests and not
+    * executed by any worker, in order workers should take them
+    */
+    std::list<uint32_t> ready_lanes_;
+    LanesStatistics lanes_statistics_;
+    // Amount of queued requests of all lanes
+    size_t mobile_request_count_;
+    mutable sync_primitives::Lock mobile_request_list_lock_;
 
     RequestInfoSet pending_request_set_;
     sync_primitives::Lock pending_request_set_lock_;
@@ -255,6 +376,8 @@ class RequestController {
 
     timer::TimerThread<RequestController>  timer_;
     static const uint32_t dafault_sleep_time_ = UINT_MAX;
+    // Milliseconds worker waits for request before it is retired
+    static const int32_t idle_worker_timeout_ = 60000;
 
     DISALLOW_COPY_AND_ASSIGN(RequestController);
 };
@@ -37,6 +37,9 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_INFO_H_
 
 #include <stdint.h>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "application_manager/commands/command_request_impl.h"
 #include "commands/hmi/request_to_hmi.h"
@@ -55,15 +58,27 @@ namespace request_controller {
   typedef utils::SharedPtr<commands::CommandRequestImpl> MobileRequestPtr;
 
   struct RequestInfo {
-    RequestInfo(const uint64_t timeout_sec)
-      : timeout_sec_(timeout_sec) {
+    enum RequestType {
+      MobileRequest,
+      HMIRequest
+    };
+
+    RequestInfo(const uint64_t timeout_sec, RequestType request_type)
+      : timeout_sec_(timeout_sec),
+        app_id_(0),
+        hmi_level_(mobile_apis::HMILevel::INVALID_ENUM),
+        request_type_(request_type) {
         start_time_ = date_time::DateTime::getCurrentTime();
         updateEndTime();
       }
 
-    RequestInfo(const TimevalStruct& start_time,const  uint64_t timeout_sec)
+    RequestInfo(const TimevalStruct& start_time,const  uint64_t timeout_sec,
+                RequestType request_type)
       : start_time_(start_time),
-        timeout_sec_(timeout_sec) {
+        timeout_sec_(timeout_sec),
+        app_id_(0),
+        hmi_level_(mobile_apis::HMILevel::INVALID_ENUM),
+        request_type_(request_type) {
         updateEndTime();
     }
 
@@ -114,27 +129,143 @@ namespace request_controller {
       return hmi_level_;
     }
 
+    RequestType request_type() const {
+      return request_type_;
+    }
+
   protected:
     TimevalStruct                 start_time_;
     uint64_t                      timeout_sec_;
     TimevalStruct                 end_time_;
     uint32_t                      app_id_;
     mobile_apis::HMILevel::eType  hmi_level_;
+    RequestType                   request_type_;
   };
 
   typedef utils::SharedPtr<RequestInfo> RequestInfoPtr;
 
+  /**
+   * @brief Orders requests by end time. Requests with equal end time are
+   * ordered by address, so they are all kept in one set.
+   */
   struct RequestInfoComparator {
       bool operator() (const RequestInfoPtr lhs,
                        const RequestInfoPtr rhs) const {
         date_time::TimeCompare compare_result =
             date_time::DateTime::compareTime(lhs->end_time(), rhs->end_time());
 
-        return compare_result == date_time::LESS;
+        if (compare_result != date_time::EQUAL) {
+          return compare_result == date_time::LESS;
+        }
+        return lhs.get() < rhs.get();
       }
   };
 
-  typedef std::set<RequestInfoPtr,RequestInfoComparator> RequestInfoSet;
+  /**
+   * @brief Pending requests indexed by request type, connection key and
+   * correlation id for lookup and by end time for timeout tracking.
+   * Adding, finding, removing request and updating its timeout take
+   * O(log n), request which expires first is found in O(1).
+   * Requests with zero timeout are tracked, but never expire.
+   */
+  class RequestInfoSet {
+    public:
+      /**
+       * @brief Adds request
+       * @return false if request with the same id is already pending
+       */
+      bool Add(RequestInfoPtr request_info);
+
+      /**
+       * @brief Finds pending request
+       * @param request_type Type of request
+       * @param app_id Connection key of mobile request, 0 for HMI request
+       * @param correlation_id Correlation id of request
+       * @return request or invalid pointer if there is no such request
+       */
+      RequestInfoPtr Find(RequestInfo::RequestType request_type,
+                          uint32_t app_id, uint32_t correlation_id) const;
+
+      /**
+       * @brief Returns request with not null timeout which expires first
+       * or invalid pointer if there is no such request
+       */
+      RequestInfoPtr FrontWithNotNullTimeout() const;
+
+      /**
+       * @brief Removes request
+       * @return false if request is not pending
+       */
+      bool RemoveRequest(const RequestInfoPtr& request_info);
+
+      /**
+       * @brief Removes all mobile requests of application
+       * @return removed requests
+       */
+      std::vector<RequestInfoPtr> RemoveByConnectionKey(uint32_t app_id);
+
+      /**
+       * @brief Removes all requests of given type
+       * @return removed requests
+       */
+      std::vector<RequestInfoPtr> RemoveByType(
+        RequestInfo::RequestType request_type);
+
+      /**
+       * @brief Sets new timeout of pending request and moves it to the new
+       * place in timeout order
+       */
+      void UpdateTimeOut(const RequestInfoPtr& request_info,
+                         uint64_t timeout_sec);
+
+      /**
+       * @brief Counts pending mobile requests of application matching
+       * predicate, other applications requests are not visited
+       */
+      template<typename Predicate>
+      uint32_t CountAppRequests(uint32_t app_id, Predicate predicate) const {
+        uint32_t count = 0;
+        RequestsById::const_iterator it = requests_by_id_.lower_bound(
+            RequestId(RequestInfo::MobileRequest, app_id, 0));
+        for (; requests_by_id_.end() != it &&
+             RequestInfo::MobileRequest == it->first.request_type &&
+             app_id == it->first.app_id; ++it) {
+          if (predicate(it->second)) {
+            ++count;
+          }
+        }
+        return count;
+      }
+
+      size_t Size() const;
+
+      void Clear();
+
+    private:
+      struct RequestId {
+        RequestId(RequestInfo::RequestType type, uint32_t app,
+                  uint32_t correlation)
+          : request_type(type),
+            app_id(app),
+            correlation_id(correlation) {}
+
+        bool operator<(const RequestId& other) const;
+
+        RequestInfo::RequestType request_type;
+        uint32_t app_id;
+        uint32_t correlation_id;
+      };
+
+      typedef std::map<RequestId, RequestInfoPtr> RequestsById;
+      typedef std::set<RequestInfoPtr, RequestInfoComparator>
+      RequestsByEndTime;
+
+      static RequestId IdOf(const RequestInfoPtr& request_info);
+      void Erase(RequestsById::iterator it);
+
+      RequestsById requests_by_id_;
+      RequestsByEndTime requests_by_end_time_;
+  };
 
   struct HMIRequestInfo: public RequestInfo {
     HMIRequestInfo(RequestPtr request, const uint64_t timeout_sec);
@@ -542,6 +542,17 @@ UsageStatistics& ApplicationImpl::usage_report() {
   return usage_report_;
 }
 
+policy::CompiledPermissionsPtr ApplicationImpl::compiled_permissions() const {
+  sync_primitives::AutoLock lock(compiled_permissions_lock_);
+  return compiled_permissions_;
+}
+
+void ApplicationImpl::set_compiled_permissions(
+    const policy::CompiledPermissionsPtr& permissions) {
+  sync_primitives::AutoLock lock(compiled_permissions_lock_);
+  compiled_permissions_ = permissions;
+}
+
 bool ApplicationImpl::IsCommandLimitsExceeded(
     mobile_apis::FunctionID::eType cmd_id,
     TLimitSource source) {
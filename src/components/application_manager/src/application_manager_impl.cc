@@ -32,6 +32,7 @@
 
 #include <stdlib.h>  // for rand()
 
+#include <algorithm>
 #include <climits>
 #include <string>
 #include <fstream>
@@ -61,10 +62,60 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "ApplicationManager")
 
 uint32_t ApplicationManagerImpl::corelation_id_ = 0;
 const uint32_t ApplicationManagerImpl::max_corelation_id_ = UINT_MAX;
+const time_t ApplicationManagerImpl::storage_reconcile_period_ = 60;
 
 namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
 namespace jhs = NsSmartDeviceLink::NsJSONHandler::strings;
 
+namespace {
+mobile_apis::Result::eType PolicyRejectionResult(policy::PermitResult result) {
+  switch (result) {
+    case policy::kRpcDisallowed:
+      return mobile_apis::Result::DISALLOWED;
+    case policy::kRpcUserDisallowed:
+      return mobile_apis::Result::USER_DISALLOWED;
+    default:
+      return mobile_apis::Result::INVALID_ENUM;
+  }
+}
+
+// Key of application in index by policy app id, FNV-1a hash of the id
+uint32_t PolicyAppIdKey(const std::string& policy_app_id) {
+  uint32_t hash = 2166136261u;
+  for (std::string::const_iterator it = policy_app_id.begin();
+       policy_app_id.end() != it; ++it) {
+    hash ^= static_cast<uint8_t>(*it);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Removes |application| from applications sharing the same key
+void EraseApplication(ApplicationSharedPtr application,
+                      std::vector<ApplicationSharedPtr>* applications) {
+  std::vector<ApplicationSharedPtr>::iterator it =
+    std::find(applications->begin(), applications->end(), application);
+  if (applications->end() != it) {
+    applications->erase(it);
+  }
+}
+
+void AppendParametersNames(
+    const policy::CompiledPermissions::Parameters& parameters,
+    std::vector<std::string>* names) {
+  if (parameters.none()) {
+    return;
+  }
+  const VehicleData& vehicle_data = MessageHelper::vehicle_data();
+  VehicleData::const_iterator it = vehicle_data.begin();
+  for (; vehicle_data.end() != it; ++it) {
+    if (parameters.test(it->second)) {
+      names->push_back(it->first);
+    }
+  }
+}
+}  // namespace
+
 ApplicationManagerImpl::ApplicationManagerImpl()
   : applications_list_lock_(true),
     audio_pass_thru_active_(false),
@@ -77,6 +128,7 @@ ApplicationManagerImpl::ApplicationManagerImpl()
     connection_handler_(NULL),
     protocol_handler_(NULL),
     request_ctrl_(),
+    storage_ledger_(storage_reconcile_period_),
     hmi_so_factory_(NULL),
     mobile_so_factory_(NULL),
     messages_from_mobile_("AM FromMobile", this),
@@ -120,6 +172,15 @@ ApplicationManagerImpl::~ApplicationManagerImpl() {
 
 bool ApplicationManagerImpl::Stop() {
   LOG4CXX_INFO(logger_, "Stop ApplicationManager.");
+#ifdef ENABLE_LOG
+  const utils::FreeListPool::Statistics command_pool =
+      commands::CommandImpl::pool_statistics();
+  LOG4CXX_INFO(logger_, "Commands created: " << command_pool.allocations
+               << " reused memory: " << command_pool.reused
+               << " heap allocations: " << command_pool.heap_allocations
+               << " alive: " << command_pool.live
+               << " pooled: " << command_pool.pooled);
+#endif  // ENABLE_LOG
   application_list_update_timer_->stop();
   try {
     UnregisterAllApplications();
@@ -137,41 +198,35 @@ bool ApplicationManagerImpl::Stop() {
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::application(uint32_t app_id) const {
-  sync_primitives::AutoLock lock(applications_list_lock_);
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
 
-  std::set<ApplicationSharedPtr>::const_iterator it =
-    application_list_.begin();
-  for (; it != application_list_.end(); ++it) {
-    if ((*it)->app_id() == app_id) {
-      return (*it);
-    }
-  }
-  return ApplicationSharedPtr();
+  const ApplicationSharedPtr* app = snapshot->by_app_id.find(app_id);
+  return app ? *app : ApplicationSharedPtr();
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::application_by_hmi_app(
   uint32_t hmi_app_id) const {
-  sync_primitives::AutoLock lock(applications_list_lock_);
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
 
-  std::set<ApplicationSharedPtr>::const_iterator it =
-    application_list_.begin();
-  for (; it != application_list_.end(); ++it) {
-    if ((*it)->hmi_app_id() == hmi_app_id) {
-      return (*it);
-    }
+  const ApplicationsVector* apps = snapshot->by_hmi_app_id.find(hmi_app_id);
+  if (!apps || apps->empty()) {
+    return ApplicationSharedPtr();
   }
-  return ApplicationSharedPtr();
+  return apps->front();
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::application_by_policy_id(
   const std::string& policy_app_id) const {
-  sync_primitives::AutoLock lock(applications_list_lock_);
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
 
-  std::vector<ApplicationSharedPtr> result;
-  for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
-       application_list_.end() != it;
-       ++it) {
-    if (policy_app_id.compare((*it)->mobile_app_id()->asString()) == 0) {
+  const ApplicationsVector* apps =
+    snapshot->by_policy_app_id.find(PolicyAppIdKey(policy_app_id));
+  if (!apps) {
+    return ApplicationSharedPtr();
+  }
+  for (ApplicationsVector::const_iterator it = apps->begin();
+       apps->end() != it; ++it) {
+    if ((*it)->mobile_app_id()->asString() == policy_app_id) {
       return *it;
     }
   }
@@ -180,8 +235,9 @@ ApplicationSharedPtr ApplicationManagerImpl::application_by_policy_id(
 
 ApplicationSharedPtr ApplicationManagerImpl::active_application() const {
   // TODO(DK) : check driver distraction
-  for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
-       application_list_.end() != it;
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
+  for (TAppListConstIt it = snapshot->applications.begin();
+       snapshot->applications.end() != it;
        ++it) {
     if ((*it)->IsFullscreen()) {
       return *it;
@@ -193,10 +249,10 @@ ApplicationSharedPtr ApplicationManagerImpl::active_application() const {
 
 ApplicationSharedPtr
 ApplicationManagerImpl::get_limited_media_application() const {
-  sync_primitives::AutoLock lock(applications_list_lock_);
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
 
-  for (TAppListIt it = application_list_.begin();
-       application_list_.end() != it; ++it) {
+  for (TAppListConstIt it = snapshot->applications.begin();
+       snapshot->applications.end() != it; ++it) {
     if ((*it)->is_media_application() &&
         (mobile_api::HMILevel::HMI_LIMITED == (*it)->hmi_level())) {
       return *it;
@@ -208,10 +264,10 @@ ApplicationManagerImpl::get_limited_media_application() const {
 
 ApplicationSharedPtr
 ApplicationManagerImpl::get_limited_navi_application() const {
-  sync_primitives::AutoLock lock(applications_list_lock_);
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
 
-  for (TAppListIt it = application_list_.begin();
-       application_list_.end() != it; ++it) {
+  for (TAppListConstIt it = snapshot->applications.begin();
+       snapshot->applications.end() != it; ++it) {
     if ((*it)->allowed_support_navigation() &&
         (mobile_api::HMILevel::HMI_LIMITED == (*it)->hmi_level())) {
       return *it;
@@ -223,10 +279,10 @@ ApplicationManagerImpl::get_limited_navi_application() const {
 
 ApplicationSharedPtr
 ApplicationManagerImpl::get_limited_voice_application() const {
-  sync_primitives::AutoLock lock(applications_list_lock_);
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
 
-  for (TAppListIt it = application_list_.begin();
-       application_list_.end() != it; ++it) {
+  for (TAppListConstIt it = snapshot->applications.begin();
+       snapshot->applications.end() != it; ++it) {
     if ((*it)->is_voice_communication_supported() &&
         (mobile_api::HMILevel::HMI_LIMITED == (*it)->hmi_level())) {
       return *it;
@@ -290,15 +346,15 @@ bool ApplicationManagerImpl::DoesAudioAppWithSameHMITypeExistInFullOrLimited(
 
 std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_by_button(
   uint32_t button) {
-  std::vector<ApplicationSharedPtr> result;
-  for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
-       application_list_.end() != it; ++it) {
-    if ((*it)->IsSubscribedToButton(
-          static_cast<mobile_apis::ButtonName::eType>(button))) {
-      result.push_back(*it);
-    }
+  sync_primitives::AutoLock lock(applications_list_lock_);
+
+  const std::set<ApplicationSharedPtr>* subscribers =
+    button_subscribers_.find(button);
+  if (!subscribers) {
+    return std::vector<ApplicationSharedPtr>();
   }
-  return result;
+  return std::vector<ApplicationSharedPtr>(subscribers->begin(),
+                                           subscribers->end());
 }
 
 std::vector<utils::SharedPtr<Application>> ApplicationManagerImpl::IviInfoUpdated(
@@ -313,20 +369,64 @@ VehicleDataType vehicle_info, int value) {
       break;
   }
 
-  std::vector<utils::SharedPtr<application_manager::Application>> result;
-  for (std::set<utils::SharedPtr<application_manager::Application>>::iterator it = application_list_.begin();
-       application_list_.end() != it; ++it) {
-    if ((*it)->IsSubscribedToIVI(static_cast<uint32_t>(vehicle_info))) {
-      result.push_back(*it);
-    }
+  sync_primitives::AutoLock lock(applications_list_lock_);
+
+  const std::set<ApplicationSharedPtr>* subscribers =
+    ivi_subscribers_.find(static_cast<uint32_t>(vehicle_info));
+  if (!subscribers) {
+    return std::vector<ApplicationSharedPtr>();
   }
-  return result;
+  return std::vector<ApplicationSharedPtr>(subscribers->begin(),
+                                           subscribers->end());
+}
+
+bool ApplicationManagerImpl::SubscribeAppToButton(
+  ApplicationSharedPtr app, mobile_apis::ButtonName::eType button) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+
+  if (!app->SubscribeToButton(button)) {
+    return false;
+  }
+  if (IsApplicationListed(app)) {
+    button_subscribers_[button].insert(app);
+  }
+  return true;
+}
+
+bool ApplicationManagerImpl::UnsubscribeAppFromButton(
+  ApplicationSharedPtr app, mobile_apis::ButtonName::eType button) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+
+  RemoveSubscriber(button_subscribers_, button, app);
+  return app->UnsubscribeFromButton(button);
+}
+
+bool ApplicationManagerImpl::SubscribeAppToIVI(ApplicationSharedPtr app,
+                                               uint32_t vehicle_info) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+
+  if (!app->SubscribeToIVI(vehicle_info)) {
+    return false;
+  }
+  if (IsApplicationListed(app)) {
+    ivi_subscribers_[vehicle_info].insert(app);
+  }
+  return true;
+}
+
+bool ApplicationManagerImpl::UnsubscribeAppFromIVI(ApplicationSharedPtr app,
+                                                   uint32_t vehicle_info) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+
+  RemoveSubscriber(ivi_subscribers_, vehicle_info, app);
+  return app->UnsubscribeFromIVI(vehicle_info);
 }
 
 std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_with_navi() {
   std::vector<ApplicationSharedPtr> result;
-  for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
-       application_list_.end() != it;
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
+  for (TAppListConstIt it = snapshot->applications.begin();
+       snapshot->applications.end() != it;
        ++it) {
     if ((*it)->allowed_support_navigation()) {
       result.push_back(*it);
@@ -475,9 +575,18 @@ ApplicationSharedPtr ApplicationManagerImpl::RegisterApplication(
     }
   }
 
+  // Resumed application restores its HMI application id. It is indexed,
+  // so it is assigned before application becomes visible in the list.
+  if (resume_ctrl_.IsApplicationSaved(mobile_app_id)) {
+    application->set_hmi_application_id(
+      resume_ctrl_.GetHMIApplicationID(mobile_app_id));
+  } else {
+    application->set_hmi_application_id(GenerateNewHMIAppID());
+  }
+
   sync_primitives::AutoLock lock(applications_list_lock_);
 
-  application_list_.insert(application);
+  AddApplication(application);
 
   return application;
 }
@@ -782,6 +891,21 @@ void ApplicationManagerImpl::OnMobileMessageSent(
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::OnMobileMessageSent");
 }
 
+size_t ApplicationManagerImpl::GetMessagesFromMobileCount() const {
+  return messages_from_mobile_.GetMessagesCount();
+}
+
+size_t ApplicationManagerImpl::GetMessagesFromMobileCount(
+  uint32_t connection_key) const {
+  return messages_from_mobile_.GetMessagesCount(connection_key);
+}
+
+request_controller::RequestController::LaneStatistics
+ApplicationManagerImpl::GetRequestLaneStatistics(
+  uint32_t connection_key) const {
+  return request_ctrl_.GetLaneStatistics(connection_key);
+}
+
 void ApplicationManagerImpl::OnMessageReceived(
   hmi_message_handler::MessageSharedPointer message) {
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::OnMessageReceived");
@@ -800,6 +924,14 @@ void ApplicationManagerImpl::OnErrorSending(
   return;
 }
 
+void ApplicationManagerImpl::OnMessageSuperseded(
+  hmi_message_handler::MessageSharedPointer message) {
+  // HMI won't respond to request it never got
+  if (kRequest == message->type()) {
+    request_ctrl_.terminateHMIRequest(message->correlation_id());
+  }
+}
+
 void ApplicationManagerImpl::OnDeviceListUpdated(
     const connection_handler::DeviceMap& device_list) {
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::OnDeviceListUpdated");
@@ -1153,38 +1285,39 @@ void ApplicationManagerImpl::SendMessageToMobile(
     logger_,
     "Attached schema to message, result if valid: " << message->isValid());
 
-  // Messages to mobile are not yet prioritized so use default priority value
+  // Final message closes connection so it must not overtake messages
+  // queued before it and gets the lowest priority
   utils::SharedPtr<Message> message_to_send(new Message(
-        protocol_handler::MessagePriority::kDefault));
+        final_message ? protocol_handler::MessagePriority::kDefault
+                      : MessageHelper::PriorityOfMessageToMobile(*message)));
   if (!ConvertSOtoMessage((*message), (*message_to_send))) {
     LOG4CXX_WARN(logger_, "Can't send msg to Mobile: failed to create string");
     return;
   }
+#ifdef TIME_TESTER
+  if (kResponse == message_to_send->type()) {
+    const protocol_handler::MessageTracePtr trace = request_traces_.Finish(
+        message_to_send->connection_key(), message_to_send->correlation_id());
+    if (trace) {
+      trace->Mark(protocol_handler::MessageTrace::kResponseSerialized);
+      message_to_send->set_trace(trace);
+    }
+  }
+#endif  // TIME_TESTER
 
   smart_objects::SmartObject& msg_to_mobile = *message;
   // If correlation_id is not present, it is from-HMI message which should be
   // checked against policy permissions
   if (msg_to_mobile[strings::params].keyExists(strings::correlation_id)) {
     request_ctrl_.terminateMobileRequest(
+      msg_to_mobile[strings::params][strings::connection_key].asUInt(),
       msg_to_mobile[strings::params][strings::correlation_id].asInt());
   } else if (app) {
     mobile_apis::FunctionID::eType function_id =
         static_cast<mobile_apis::FunctionID::eType>(
         (*message)[strings::params][strings::function_id].asUInt());
-    RPCParams params;
-
-    const smart_objects::SmartObject& s_map = (*message)[strings::msg_params];
-    if (smart_objects::SmartType_Map == s_map.getType()) {
-      smart_objects::SmartMap::iterator iter = s_map.map_begin();
-      smart_objects::SmartMap::iterator iter_end = s_map.map_end();
-
-      for (; iter != iter_end; ++iter) {
-        params.push_back(iter->first);
-      }
-    }
     const mobile_apis::Result::eType check_result =
-        CheckPolicyPermissions( app->mobile_app_id()->asString(),
-                                app->hmi_level(), function_id, params);
+        CheckPolicyPermissions(app, function_id);
     if (mobile_apis::Result::SUCCESS != check_result) {
       const std::string string_functionID =
           MessageHelper::StringifiedFunctionID(function_id);
@@ -1202,8 +1335,98 @@ void ApplicationManagerImpl::SendMessageToMobile(
                                   final_message));
 }
 
+void ApplicationManagerImpl::MulticastMessageToMobile(
+  const smart_objects::SmartObject& message,
+  const std::vector<ApplicationSharedPtr>& applications) {
+  LOG4CXX_INFO(logger_, "ApplicationManagerImpl::MulticastMessageToMobile");
+
+  if (!protocol_handler_) {
+    LOG4CXX_WARN(logger_, "No Protocol Handler set");
+    return;
+  }
+
+  std::vector<ApplicationSharedPtr>::const_iterator it = applications.begin();
+  if (message[strings::params].keyExists(strings::binary_data)) {
+    // Binary data is owned by outgoing message, so it can't be shared
+    for (; applications.end() != it; ++it) {
+      if (!(*it)) {
+        continue;
+      }
+      utils::SharedPtr<smart_objects::SmartObject> copy(
+        new smart_objects::SmartObject(message));
+      (*copy)[strings::params][strings::connection_key] = (*it)->app_id();
+      SendMessageToMobile(copy);
+    }
+    return;
+  }
+
+  smart_objects::SmartObject payload(message);
+  mobile_so_factory().attachSchema(payload);
+  const protocol_handler::MessagePriority priority =
+    MessageHelper::PriorityOfMessageToMobile(payload);
+
+  const mobile_apis::FunctionID::eType function_id =
+    static_cast<mobile_apis::FunctionID::eType>(
+      payload[strings::params][strings::function_id].asUInt());
+
+  // V1 and V2+ use different formatters, V2 and V3 share the same JSON
+  utils::SharedPtr<Message> serialized_v1;
+  utils::SharedPtr<Message> serialized_v2;
+  for (; applications.end() != it; ++it) {
+    const ApplicationSharedPtr app = *it;
+    if (!app) {
+      continue;
+    }
+
+    const mobile_apis::Result::eType check_result =
+        CheckPolicyPermissions(app, function_id);
+    if (mobile_apis::Result::SUCCESS != check_result) {
+      LOG4CXX_WARN(logger_, "Function \""
+                   << MessageHelper::StringifiedFunctionID(function_id)
+                   << "\" (#" << function_id << ") not allowed by policy for "
+                   << "application " << app->app_id());
+      continue;
+    }
+
+    const ProtocolVersion version = app->protocol_version();
+    utils::SharedPtr<Message>& serialized =
+      ProtocolVersion::kV1 == version ? serialized_v1 : serialized_v2;
+    if (!serialized) {
+      payload[strings::params][strings::protocol_version] = version;
+      payload[strings::params][strings::connection_key] = app->app_id();
+      serialized = utils::SharedPtr<Message>(new Message(priority));
+      if (!ConvertSOtoMessage(payload, *serialized)) {
+        LOG4CXX_WARN(logger_,
+                     "Can't send msg to Mobile: failed to create string");
+        return;
+      }
+    }
+
+    utils::SharedPtr<Message> message_to_send(new Message(priority));
+    message_to_send->set_function_id(serialized->function_id());
+    message_to_send->set_correlation_id(serialized->correlation_id());
+    message_to_send->set_message_type(serialized->type());
+    message_to_send->set_json_message(serialized->json_message());
+    message_to_send->set_protocol_version(version);
+    message_to_send->set_connection_key(app->app_id());
+
+    if (function_id == mobile_apis::FunctionID::OnSystemRequestID) {
+      policy::PolicyHandler::instance()->OnUpdateRequestSentToMobile();
+    }
+
+    messages_to_mobile_.PostMessage(impl::MessageToMobile(message_to_send,
+                                    false));
+  }
+}
+
 bool ApplicationManagerImpl::ManageMobileCommand(
   const utils::SharedPtr<smart_objects::SmartObject> message) {
+  return ManageMobileCommand(message, NULL);
+}
+
+bool ApplicationManagerImpl::ManageMobileCommand(
+  const utils::SharedPtr<smart_objects::SmartObject> message,
+  const Message* msg_params_source) {
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::ManageMobileCommand");
 
   if (!message) {
@@ -1257,6 +1480,7 @@ bool ApplicationManagerImpl::ManageMobileCommand(
           static_cast<int32_t>(mobile_apis::Result::APPLICATION_NOT_REGISTERED));
 
       SendMessageToMobile(response);
+      file_streamer_.TakeChunk(connection_key, correlation_id);
       return false;
     }
 
@@ -1264,6 +1488,13 @@ bool ApplicationManagerImpl::ManageMobileCommand(
     mobile_so_factory().attachSchema(*message);
   }
 
+  if (msg_params_source &&
+      message_type != mobile_apis::messageType::request &&
+      !DecodeMsgParams(*msg_params_source, *message)) {
+    delete command;
+    return false;
+  }
+
   if (message_type ==
       mobile_apis::messageType::response) {
     if (command->Init()) {
@@ -1301,8 +1532,26 @@ bool ApplicationManagerImpl::ManageMobileCommand(
 
     // commands will be launched from request_ctrl
 
+    // Flooding application is rejected before msg_params are decoded
     request_controller::RequestController::TResult result =
-      request_ctrl_.addMobileRequest(command_request, app_hmi_level);
+      request_ctrl_.checkRequestLimits(connection_key);
+    if (request_controller::RequestController::SUCCESS == result &&
+        msg_params_source &&
+        !DecodeMsgParams(*msg_params_source, *message)) {
+      file_streamer_.TakeChunk(connection_key, correlation_id);
+      delete command;
+      return false;
+    }
+
+    if (request_controller::RequestController::SUCCESS == result) {
+      result = request_ctrl_.addMobileRequest(command_request, app_hmi_level);
+    } else {
+      delete command;
+    }
+    if (request_controller::RequestController::SUCCESS != result) {
+      // Binary data of rejected PutFile won't be taken by request
+      file_streamer_.TakeChunk(connection_key, correlation_id);
+    }
 
     if (result == request_controller::RequestController::SUCCESS) {
       LOG4CXX_INFO(logger_, "Perform request");
@@ -1388,7 +1637,8 @@ void ApplicationManagerImpl::SendMessageToHMI(
     "Attached schema to message, result if valid: " << message->isValid());
 
 
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(MQUEUE_HMIADAPTER)
+  // Adapter formats message itself according to negotiated format
   message_to_send->set_smart_object(*message);
 #else
   if (!ConvertSOtoMessage(*message, *message_to_send)) {
@@ -1396,7 +1646,7 @@ void ApplicationManagerImpl::SendMessageToHMI(
                  "Cannot send message to HMI: failed to create string");
     return;
   }
-#endif  // HMI_DBUS_API
+#endif  // HMI_DBUS_API || MQUEUE_HMIADAPTER
 
   messages_to_hmi_.PostMessage(impl::MessageToHmi(message_to_send));
 }
@@ -1426,6 +1676,12 @@ bool ApplicationManagerImpl::ManageHMICommand(
     LOG4CXX_DEBUG(logger_, "ManageHMICommand");
     request_ctrl_.addHMIRequest(command);
   }
+#ifdef TIME_TESTER
+  if (kResponse == message_type) {
+    request_traces_.OnHmiResponse(
+        (*message)[strings::params][strings::correlation_id].asUInt());
+  }
+#endif  // TIME_TESTER
 
   if (command->Init()) {
     command->Run();
@@ -1470,6 +1726,7 @@ bool ApplicationManagerImpl::Init() {
                   "Storage directory doesn't have read/write permissions");
     return false;
   }
+  storage_ledger_.Seed(app_storage_folder);
 
   const std::string system_files_path =
       profile::Profile::instance()->system_files_path();
@@ -1502,58 +1759,29 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
   switch (message.protocol_version()) {
     case ProtocolVersion::kV3:
     case ProtocolVersion::kV2: {
-        const bool conversion_result =
-            formatters::CFormatterJsonSDLRPCv2::fromString(
-            message.json_message(), output, message.function_id(),
-            message.type(), message.correlation_id());
-        if (!conversion_result
-            || !mobile_so_factory().attachSchema(output)
-            || ((output.validate() != smart_objects::Errors::OK)) ) {
-          LOG4CXX_WARN(logger_, "Failed to parse string to smart object :"
-                       << message.json_message());
-          utils::SharedPtr<smart_objects::SmartObject> response(
-                MessageHelper::CreateNegativeResponse(
-                  message.connection_key(), message.function_id(),
-                  message.correlation_id(), mobile_apis::Result::INVALID_DATA));
-          ManageMobileCommand(response);
-          return false;
-        }
-      LOG4CXX_INFO(
-        logger_,
-        "Convertion result for sdl object is true" << " function_id "
-        << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
-      output[strings::params][strings::connection_key] =
-        message.connection_key();
-      output[strings::params][strings::protocol_version] =
-        message.protocol_version();
-      if (message.binary_data()) {
-        if (message.payload_size() < message.data_size()) {
-          LOG4CXX_ERROR(logger_, "Incomplete binary" <<
-                                " binary size should be  " << message.data_size() <<
-                                " payload data size is " << message.payload_size());
-          utils::SharedPtr<smart_objects::SmartObject> response(
-                            MessageHelper::CreateNegativeResponse(
-                            message.connection_key(), message.function_id(),
-                            message.correlation_id(), mobile_apis::Result::INVALID_DATA));
-          ManageMobileCommand(response);
-          return false;
-        }
-        output[strings::params][strings::binary_data] =
-          *(message.binary_data());
+      if (!ConvertMessageHeaderToSO(message, output) ||
+          !DecodeMsgParams(message, output)) {
+        return false;
       }
       break;
     }
     case ProtocolVersion::kHMI: {
+      if (message.json_message().empty() &&
+          smart_objects::SmartType_Map == message.smart_object().getType()) {
+        // Message was received in binary format and decoded by adapter
+        output = message.smart_object();
+      } else {
 #ifdef ENABLE_LOG
-      int32_t result =
+        int32_t result =
 #endif
-      formatters::FormatterJsonRpc::FromString <
-                       hmi_apis::FunctionID::eType, hmi_apis::messageType::eType > (
-                         message.json_message(), output);
-      LOG4CXX_INFO(
-        logger_,
-        "Convertion result: " << result << " function id "
-        << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
+        formatters::FormatterJsonRpc::FromString <
+                         hmi_apis::FunctionID::eType, hmi_apis::messageType::eType > (
+                           message.json_message(), output);
+        LOG4CXX_INFO(
+          logger_,
+          "Convertion result: " << result << " function id "
+          << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
+      }
       if (!hmi_so_factory().attachSchema(output)) {
         LOG4CXX_WARN(logger_, "Failed to attach schema to object.");
         return false;
@@ -1618,6 +1846,73 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
   return true;
 }
 
+bool ApplicationManagerImpl::ConvertMessageHeaderToSO(
+  const Message& message, smart_objects::SmartObject& output) {
+  smart_objects::SmartObject& params = output[strings::params];
+  params[strings::message_type] = message.type();
+  params[strings::function_id] = message.function_id();
+  params[strings::correlation_id] = message.correlation_id();
+  params[strings::protocol_type] =
+    commands::CommandImpl::mobile_protocol_type_;
+  params[strings::connection_key] = message.connection_key();
+  params[strings::protocol_version] = message.protocol_version();
+
+  if (message.has_binary_data()) {
+    if (message.payload_size() < message.data_size()) {
+      LOG4CXX_ERROR(logger_, "Incomplete binary" <<
+                    " binary size should be  " << message.data_size() <<
+                    " payload data size is " << message.payload_size());
+      utils::SharedPtr<smart_objects::SmartObject> response(
+        MessageHelper::CreateNegativeResponse(
+          message.connection_key(), message.function_id(),
+          message.correlation_id(), mobile_apis::Result::INVALID_DATA));
+      ManageMobileCommand(response);
+      return false;
+    }
+    // Binary data of PutFile is written to file right from the message,
+    // see ProcessMessageFromMobile
+    if (mobile_apis::FunctionID::PutFileID != message.function_id()) {
+      params[strings::binary_data] = smart_objects::SmartBinary(
+        message.binary_data_begin(),
+        message.binary_data_begin() + message.binary_data_size());
+    }
+  }
+  return true;
+}
+
+bool ApplicationManagerImpl::DecodeMsgParams(
+  const Message& message, smart_objects::SmartObject& output) {
+  LOG4CXX_DEBUG(logger_, "Decoding msg_params of " << message.json_size()
+                << " bytes");
+  // Formatter sets same params as header did, except protocol version.
+  // JSON is parsed right from the buffer it was received in
+  const bool conversion_result =
+    formatters::CFormatterJsonSDLRPCv2::fromString(
+      message.json_begin(), message.json_begin() + message.json_size(),
+      output, message.function_id(), message.type(),
+      message.correlation_id());
+  output[strings::params][strings::protocol_version] =
+    message.protocol_version();
+
+  if (!conversion_result
+      || !mobile_so_factory().attachSchema(output)
+      || ((output.validate() != smart_objects::Errors::OK))) {
+    LOG4CXX_WARN(logger_, "Failed to parse string to smart object :"
+                 << std::string(message.json_begin(), message.json_size()));
+    utils::SharedPtr<smart_objects::SmartObject> response(
+      MessageHelper::CreateNegativeResponse(
+        message.connection_key(), message.function_id(),
+        message.correlation_id(), mobile_apis::Result::INVALID_DATA));
+    ManageMobileCommand(response);
+    return false;
+  }
+  LOG4CXX_INFO(
+    logger_,
+    "Convertion result for sdl object is true" << " function_id "
+    << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
+  return true;
+}
+
 bool ApplicationManagerImpl::ConvertSOtoMessage(
   const smart_objects::SmartObject& message, Message& output) {
   LOG4CXX_INFO(logger_, "Message to convert");
@@ -1743,6 +2038,7 @@ utils::SharedPtr<Message> ApplicationManagerImpl::ConvertRawMsgToMessage(
 
   if (convertion_result) {
     outgoing_message = convertion_result;
+    outgoing_message->set_trace(message->trace());
   } else {
     LOG4CXX_ERROR(logger_, "Received invalid message");
   }
@@ -1764,15 +2060,38 @@ void ApplicationManagerImpl::ProcessMessageFromMobile(
     return;
   }
 
-  if (!ConvertMessageToSO(*message, *so_from_mobile)) {
+  // Header of protocol version 2 and higher contains everything needed for
+  // dispatch, so msg_params are decoded only for accepted messages
+  const bool decode_header_only =
+    ProtocolVersion::kV2 == message->protocol_version() ||
+    ProtocolVersion::kV3 == message->protocol_version();
+  if (decode_header_only) {
+    if (!ConvertMessageHeaderToSO(*message, *so_from_mobile)) {
+      LOG4CXX_ERROR(logger_, "Cannot create smart object from message");
+      return;
+    }
+  } else if (!ConvertMessageToSO(*message, *so_from_mobile)) {
     LOG4CXX_ERROR(logger_, "Cannot create smart object from message");
     return;
   }
+  if (message->has_binary_data() &&
+      mobile_apis::FunctionID::PutFileID == message->function_id()) {
+    file_streamer_.HoldChunk(message->connection_key(),
+                             message->correlation_id(), message);
+  }
 #ifdef TIME_TESTER
   metric->message = so_from_mobile;
+  if (message->trace() &&
+      kRequest == message->type()) {
+    message->trace()->Mark(protocol_handler::MessageTrace::kParsed);
+    message->trace()->set_function_id(message->function_id());
+    request_traces_.Start(message->connection_key(),
+                          message->correlation_id(), message->trace());
+  }
 #endif  // TIME_TESTER
 
-  if (!ManageMobileCommand(so_from_mobile)) {
+  if (!ManageMobileCommand(so_from_mobile,
+                           decode_header_only ? message.get() : NULL)) {
     LOG4CXX_ERROR(logger_, "Received command didn't run successfully");
   }
 #ifdef TIME_TESTER
@@ -1839,6 +2158,10 @@ HMICapabilities& ApplicationManagerImpl::hmi_capabilities() {
 void ApplicationManagerImpl::SetTimeMetricObserver(AMMetricObserver* observer) {
   metric_observer_ = observer;
 }
+
+RequestTraces& ApplicationManagerImpl::request_traces() {
+  return request_traces_;
+}
 #endif  // TIME_TESTER
 
 void ApplicationManagerImpl::addNotification(const CommandSharedPtr ptr) {
@@ -1937,7 +2260,8 @@ void ApplicationManagerImpl::SendOnSDLClose() {
     "Attached schema to message, result if valid: " << msg->isValid());
 
 
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(MQUEUE_HMIADAPTER)
+  // Adapter formats message itself according to negotiated format
   message_to_send->set_smart_object(*msg);
 #else
   if (!ConvertSOtoMessage(*msg, *message_to_send)) {
@@ -1945,7 +2269,7 @@ void ApplicationManagerImpl::SendOnSDLClose() {
                  "Cannot send message to HMI: failed to create string");
     return;
   }
-#endif  // HMI_DBUS_API
+#endif  // HMI_DBUS_API || MQUEUE_HMIADAPTER
 
   if (!hmi_handler_) {
     LOG4CXX_WARN(logger_, "No HMI Handler set");
@@ -1970,9 +2294,9 @@ void ApplicationManagerImpl::UnregisterAllApplications(bool generated_by_hmi) {
 
   sync_primitives::AutoLock lock(applications_list_lock_);
 
-  std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
-  while (it != application_list_.end()) {
-    ApplicationSharedPtr app_to_remove = *it;
+  ApplicationsSnapshotPtr snapshot = applications_.Get();
+  while (!snapshot->applications.empty()) {
+    ApplicationSharedPtr app_to_remove = *snapshot->applications.begin();
     MessageHelper::SendOnAppInterfaceUnregisteredNotificationToMobile(
         app_to_remove->app_id(), unregister_reason_);
     UnregisterApplication(app_to_remove->app_id(),
@@ -1980,7 +2304,7 @@ void ApplicationManagerImpl::UnregisterAllApplications(bool generated_by_hmi) {
                           is_unexpected_disconnect);
 
     connection_handler_->CloseSession(app_to_remove->app_id());
-    it = application_list_.begin();
+    snapshot = applications_.Get();
   }
 
   if (is_ignition_off) {
@@ -2015,19 +2339,14 @@ void ApplicationManagerImpl::UnregisterApplication(
     }
   }
 
-  ApplicationSharedPtr app_to_remove;
-  std::set<ApplicationSharedPtr>::const_iterator it = application_list_.begin();
-  for (; it != application_list_.end(); ++it) {
-    if ((*it)->app_id() == app_id) {
-      app_to_remove = *it;
-      break;
-    }
-  }
-  if (!app_to_remove) {
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
+  const ApplicationSharedPtr* found = snapshot->by_app_id.find(app_id);
+  if (!found) {
     LOG4CXX_ERROR(logger_, "Cant find application with app_id = " << app_id);
     return;
   }
-  application_list_.erase(app_to_remove);
+  ApplicationSharedPtr app_to_remove = *found;
+  RemoveApplication(app_to_remove);
 
   if (is_resuming) {
     resume_ctrl_.SaveApplication(app_to_remove);
@@ -2043,17 +2362,109 @@ void ApplicationManagerImpl::UnregisterApplication(
                                                  is_unexpected_disconnect);
 
   request_ctrl_.terminateAppRequests(app_id);
+  file_streamer_.Close(app_id);
+#ifdef TIME_TESTER
+  request_traces_.Forget(app_id);
+#endif  // TIME_TESTER
+  // Files of app are cleaned up with it, so its folder is walked again
+  // when app is registered next time
+  storage_ledger_.Forget(profile::Profile::instance()->app_storage_folder() +
+                         "/" + app_to_remove->folder_name());
   return;
 }
 
 
+void ApplicationManagerImpl::AddApplication(ApplicationSharedPtr application) {
+  utils::SharedPtr<ApplicationsSnapshot> snapshot = applications_.Copy();
+  snapshot->applications.insert(application);
+  snapshot->by_app_id[application->app_id()] = application;
+  snapshot->by_hmi_app_id[application->hmi_app_id()].push_back(application);
+  snapshot->by_policy_app_id[
+    PolicyAppIdKey(application->mobile_app_id()->asString())].push_back(
+      application);
+  applications_.Publish(snapshot);
+
+  // Application may be subscribed before registration, e.g. to custom button
+  const std::set<mobile_apis::ButtonName::eType>& buttons =
+    application->SubscribedButtons();
+  for (std::set<mobile_apis::ButtonName::eType>::const_iterator it =
+         buttons.begin(); it != buttons.end(); ++it) {
+    button_subscribers_[*it].insert(application);
+  }
+  const std::set<uint32_t>& ivi = application->SubscribesIVI();
+  for (std::set<uint32_t>::const_iterator it = ivi.begin(); it != ivi.end();
+       ++it) {
+    ivi_subscribers_[*it].insert(application);
+  }
+}
+
+void ApplicationManagerImpl::RemoveApplication(
+  ApplicationSharedPtr application) {
+  utils::SharedPtr<ApplicationsSnapshot> snapshot = applications_.Copy();
+  snapshot->applications.erase(application);
+  snapshot->by_app_id.erase(application->app_id());
+
+  const uint32_t hmi_app_id = application->hmi_app_id();
+  ApplicationsVector* hmi_apps = snapshot->by_hmi_app_id.find(hmi_app_id);
+  if (hmi_apps) {
+    EraseApplication(application, hmi_apps);
+    if (hmi_apps->empty()) {
+      snapshot->by_hmi_app_id.erase(hmi_app_id);
+    }
+  }
+
+  const uint32_t policy_key =
+    PolicyAppIdKey(application->mobile_app_id()->asString());
+  ApplicationsVector* policy_apps =
+    snapshot->by_policy_app_id.find(policy_key);
+  if (policy_apps) {
+    EraseApplication(application, policy_apps);
+    if (policy_apps->empty()) {
+      snapshot->by_policy_app_id.erase(policy_key);
+    }
+  }
+  applications_.Publish(snapshot);
+
+  const std::set<mobile_apis::ButtonName::eType>& buttons =
+    application->SubscribedButtons();
+  for (std::set<mobile_apis::ButtonName::eType>::const_iterator it =
+         buttons.begin(); it != buttons.end(); ++it) {
+    RemoveSubscriber(button_subscribers_, *it, application);
+  }
+  const std::set<uint32_t>& ivi = application->SubscribesIVI();
+  for (std::set<uint32_t>::const_iterator it = ivi.begin(); it != ivi.end();
+       ++it) {
+    RemoveSubscriber(ivi_subscribers_, *it, application);
+  }
+}
+
+bool ApplicationManagerImpl::IsApplicationListed(
+  ApplicationSharedPtr application) const {
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
+  const ApplicationSharedPtr* listed =
+    snapshot->by_app_id.find(application->app_id());
+  return listed && *listed == application;
+}
+
+void ApplicationManagerImpl::RemoveSubscriber(
+  SubscribersIndex& index, uint32_t key, ApplicationSharedPtr application) {
+  std::set<ApplicationSharedPtr>* subscribers = index.find(key);
+  if (!subscribers) {
+    return;
+  }
+  subscribers->erase(application);
+  if (subscribers->empty()) {
+    index.erase(key);
+  }
+}
+
 void ApplicationManagerImpl::UnregisterRevokedApplication(
     const uint32_t& app_id, mobile_apis::Result::eType reason) {
   UnregisterApplication(app_id, reason);
 
   connection_handler_->CloseSession(app_id);
 
-  if (application_list_.empty()) {
+  if (applications_.Get()->applications.empty()) {
     connection_handler_->CloseRevokedConnection(app_id);
   }
 }
@@ -2065,6 +2476,10 @@ void ApplicationManagerImpl::Handle(const impl::MessageFromMobile message) {
     LOG4CXX_ERROR(logger_, "Null-pointer message received.");
     return;
   }
+  LOG4CXX_DEBUG(logger_, "Messages of connection " << message->connection_key()
+                << " left in queue: "
+                << GetMessagesFromMobileCount(message->connection_key())
+                << " of " << GetMessagesFromMobileCount());
   ProcessMessageFromMobile(message);
 }
 
@@ -2082,6 +2497,8 @@ void ApplicationManagerImpl::Handle(const impl::MessageToMobile message) {
     LOG4CXX_ERROR(logger_, "Failed to create raw message.");
     return;
   }
+  rawMessage->set_trace(message->trace());
+  rawMessage->set_priority(message->Priority());
 
   if (!protocol_handler_) {
     LOG4CXX_WARN(logger_,
@@ -2187,26 +2604,64 @@ mobile_apis::Result::eType ApplicationManagerImpl::CheckPolicyPermissions(
     application_by_policy_id(policy_app_id)->
         usage_report().RecordPolicyRejectedRpcCall();
 
-    switch (result.hmi_level_permitted) {
-      case policy::kRpcDisallowed:
-        return mobile_apis::Result::DISALLOWED;
-      case policy::kRpcUserDisallowed:
-        return mobile_apis::Result::USER_DISALLOWED;
-      default:
-        return mobile_apis::Result::INVALID_ENUM;
-    }
+    return PolicyRejectionResult(result.hmi_level_permitted);
   }
   LOG4CXX_INFO(logger_, "Request is allowed by policies. "+log_msg);
   return mobile_api::Result::SUCCESS;
 }
 
+mobile_apis::Result::eType ApplicationManagerImpl::CheckPolicyPermissions(
+    ApplicationSharedPtr app,
+    mobile_apis::FunctionID::eType function_id,
+    CommandParametersPermissions* params_permissions) {
+  if (!policy::PolicyHandler::instance()->PolicyEnabled()) {
+    return mobile_apis::Result::SUCCESS;
+  }
+
+  const mobile_apis::HMILevel::eType hmi_level = app->hmi_level();
+  const policy::CompiledPermissionsPtr permissions =
+      policy::PolicyHandler::instance()->GetCompiledPermissions(*app);
+  const policy::CompiledPermissions::RpcPermissions* rpc_permissions =
+      permissions ? permissions->Find(function_id, hmi_level) : NULL;
+  if (!rpc_permissions) {
+    return CheckPolicyPermissions(app->mobile_app_id()->asString(), hmi_level,
+                                  function_id, RPCParams(),
+                                  params_permissions);
+  }
+
+  if (NULL != params_permissions) {
+    AppendParametersNames(rpc_permissions->allowed_params,
+                          &params_permissions->allowed_params);
+    AppendParametersNames(rpc_permissions->disallowed_params,
+                          &params_permissions->disallowed_params);
+    AppendParametersNames(rpc_permissions->undefined_params,
+                          &params_permissions->undefined_params);
+  }
+
+  const policy::PermitResult permit_result =
+      rpc_permissions->hmi_level_permitted;
+  if (policy::kRpcAllowed == permit_result) {
+    return mobile_apis::Result::SUCCESS;
+  }
+
+  if (hmi_level == mobile_apis::HMILevel::HMI_NONE
+      && function_id != mobile_apis::FunctionID::UnregisterAppInterfaceID) {
+    app->usage_report().RecordRpcSentInHMINone();
+  }
+  LOG4CXX_WARN(logger_, "Request is blocked by policies. Application: "
+               << app->app_id() << ", RPC: " << function_id
+               << ", HMI status: " << hmi_level);
+  app->usage_report().RecordPolicyRejectedRpcCall();
+  return PolicyRejectionResult(permit_result);
+}
+
 void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
   mobile_apis::AudioStreamingState::eType state =
     hmi_capabilities_.attenuated_supported()
     ? mobile_apis::AudioStreamingState::ATTENUATED
     : mobile_apis::AudioStreamingState::NOT_AUDIBLE;
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationManagerImpl::TAppList local_app_list = accessor.applications();
+  ApplicationManagerImpl::TAppList& local_app_list = accessor.applications();
 
   ApplicationManagerImpl::TAppListConstIt it = local_app_list.begin();
   ApplicationManagerImpl::TAppListConstIt itEnd = local_app_list.end();
@@ -2230,7 +2685,7 @@ void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
 void ApplicationManagerImpl::Unmute(VRTTSSessionChanging changing_state) {
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationManagerImpl::TAppList local_app_list = application_list_;
+  ApplicationManagerImpl::TAppList& local_app_list = accessor.applications();
   ApplicationManagerImpl::TAppListConstIt it = local_app_list.begin();
   ApplicationManagerImpl::TAppListConstIt itEnd = local_app_list.end();
 
@@ -2297,6 +2752,27 @@ mobile_apis::Result::eType ApplicationManagerImpl::SaveBinary(
   return mobile_apis::Result::SUCCESS;
 }
 
+utils::SharedPtr<Message> ApplicationManagerImpl::TakeFileChunk(
+  uint32_t connection_key, uint32_t correlation_id) {
+  return file_streamer_.TakeChunk(connection_key, correlation_id);
+}
+
+mobile_apis::Result::eType ApplicationManagerImpl::SaveFileChunk(
+  uint32_t app_id, const uint8_t* chunk, const size_t chunk_size,
+  const std::string& file_path, const std::string& file_name,
+  const int64_t offset, const int64_t file_size) {
+  LOG4CXX_INFO(logger_, "SaveFileChunk chunk_size = " << chunk_size
+               << " offset = " << offset << " file_size = " << file_size);
+
+  if (chunk_size > file_system::GetAvailableDiskSpace(file_path)) {
+    LOG4CXX_ERROR(logger_, "Out of free disc space.");
+    return mobile_apis::Result::OUT_OF_MEMORY;
+  }
+
+  return file_streamer_.Write(app_id, file_path + "/" + file_name, chunk,
+                              chunk_size, offset, file_size);
+}
+
 uint32_t ApplicationManagerImpl::GetAvailableSpaceForApp(
   const std::string& folder_name) {
   const uint32_t app_quota = profile::Profile::instance()->app_dir_quota();
@@ -2307,7 +2783,8 @@ uint32_t ApplicationManagerImpl::GetAvailableSpaceForApp(
   app_storage_path += folder_name;
 
   if (file_system::DirectoryExists(app_storage_path)) {
-    size_t size_of_directory = file_system::DirectorySize(app_storage_path);
+    const uint64_t size_of_directory =
+      storage_ledger_.UsedSpace(app_storage_path);
     if (app_quota < size_of_directory) {
       return 0;
     }
@@ -2326,6 +2803,13 @@ uint32_t ApplicationManagerImpl::GetAvailableSpaceForApp(
   }
 }
 
+void ApplicationManagerImpl::UpdateUsedSpaceForApp(
+  const std::string& folder_name, int64_t previous_size, int64_t size) {
+  storage_ledger_.Update(
+    profile::Profile::instance()->app_storage_folder() + "/" + folder_name,
+    previous_size, size);
+}
+
 bool ApplicationManagerImpl::IsHMICooperating() const {
   return hmi_cooperating_;
 }
@@ -2335,14 +2819,13 @@ void ApplicationManagerImpl::OnApplicationListUpdateTimer() {
 
   std::list <uint32_t> applications_ids;
 
-  applications_list_lock_.Acquire();
-  for (std::set<ApplicationSharedPtr>::const_iterator i = application_list_.begin();
-       i != application_list_.end(); ++i) {
+  const ApplicationsSnapshotPtr snapshot = applications_.Get();
+  for (TAppListConstIt i = snapshot->applications.begin();
+       i != snapshot->applications.end(); ++i) {
     ApplicationSharedPtr application = *i;
     uint32_t app_id = application->app_id();
     applications_ids.push_back(app_id);
   }
-  applications_list_lock_.Release();
 
   SendUpdateAppList(applications_ids);
 }
@@ -2411,7 +2894,7 @@ void ApplicationManagerImpl::CreatePhoneCallAppList() {
   LOG4CXX_TRACE_ENTER(logger_);
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationManagerImpl::TAppList local_app_list = accessor.applications();
+  ApplicationManagerImpl::TAppList& local_app_list = accessor.applications();
 
   ApplicationManagerImpl::TAppListIt it = local_app_list.begin();
   ApplicationManagerImpl::TAppListIt itEnd = local_app_list.end();
@@ -2438,9 +2921,6 @@ void ApplicationManagerImpl::CreatePhoneCallAppList() {
 void ApplicationManagerImpl::ResetPhoneCallAppList() {
   LOG4CXX_TRACE_ENTER(logger_);
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationManagerImpl::TAppList local_app_list = accessor.applications();
-
   std::map<uint32_t, AppState>::iterator it =
       on_phone_call_app_list_.begin();
   std::map<uint32_t, AppState>::iterator it_end =
@@ -38,6 +38,22 @@ namespace commands {
 
 CREATE_LOGGERPTR_LOCAL(CommandImpl::logger_, "Commands")
 
+namespace {
+
+// Command objects are a few hundred bytes at most
+const size_t kMaxPooledCommandSize = 1024;
+const size_t kMaxFreeCommandsPerSize = 64;
+
+utils::FreeListPool& command_pool() {
+  // Pool is never destroyed, commands may be freed by other static objects
+  // on exit
+  static utils::FreeListPool* pool =
+      new utils::FreeListPool(kMaxPooledCommandSize, kMaxFreeCommandsPerSize);
+  return *pool;
+}
+
+}  // namespace
+
 const int32_t CommandImpl::hmi_protocol_type_ = 1;
 const int32_t CommandImpl::mobile_protocol_type_ = 0;
 const int32_t CommandImpl::protocol_version_ = 3;
@@ -51,6 +67,18 @@ CommandImpl::~CommandImpl() {
   CleanUp();
 }
 
+void* CommandImpl::operator new(size_t size) {
+  return command_pool().Allocate(size);
+}
+
+void CommandImpl::operator delete(void* command, size_t size) {
+  command_pool().Deallocate(command, size);
+}
+
+utils::FreeListPool::Statistics CommandImpl::pool_statistics() {
+  return command_pool().statistics();
+}
+
 bool CommandImpl::CheckPermissions(){
   return true;
 }
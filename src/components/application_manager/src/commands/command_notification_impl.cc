@@ -69,6 +69,20 @@ void CommandNotificationImpl::SendNotification() {
   ApplicationManagerImpl::instance()->SendMessageToMobile(message_);
 }
 
+void CommandNotificationImpl::SendNotification(
+    const std::vector<ApplicationSharedPtr>& applications) {
+  (*message_)[strings::params][strings::protocol_type] = mobile_protocol_type_;
+  (*message_)[strings::params][strings::message_type] =
+      static_cast<int32_t>(application_manager::MessageType::kNotification);
+
+  LOG4CXX_INFO(logger_, "SendNotification to " << applications.size()
+               << " applications");
+  MessageHelper::PrintSmartObject(*message_);
+
+  ApplicationManagerImpl::instance()->MulticastMessageToMobile(*message_,
+                                                               applications);
+}
+
 }  // namespace commands
 
 }  // namespace application_manager
@@ -222,6 +222,11 @@ void CommandRequestImpl::SendHMIRequest(
     request[strings::msg_params] = *msg_params;
   }
 
+#ifdef TIME_TESTER
+  ApplicationManagerImpl::instance()->request_traces().OnHmiRequest(
+      hmi_correlation_id, connection_key(), correlation_id());
+#endif  // TIME_TESTER
+
   if (!ApplicationManagerImpl::instance()->ManageHMICommand(result)) {
     LOG4CXX_ERROR(logger_, "Unable to send request");
     SendResponse(false, mobile_apis::Result::OUT_OF_MEMORY);
@@ -371,32 +376,18 @@ bool CommandRequestImpl::CheckAllowedParameters() {
 
   typedef std::set<application_manager::ApplicationSharedPtr> ApplicationList;
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationList app_list = accessor.applications();
+  const ApplicationList& app_list = accessor.applications();
   ApplicationList::const_iterator it_app_list = app_list.begin();
   ApplicationList::const_iterator it_app_list_end = app_list.end();
   for (; it_app_list != it_app_list_end; ++it_app_list) {
     if (connection_key() == (*it_app_list).get()->app_id()) {
 
-      RPCParams params;
-
-      const smart_objects::SmartObject& s_map = (*message_)[strings::msg_params];
-      if (smart_objects::SmartType_Map == s_map.getType()) {
-        smart_objects::SmartMap::iterator iter = s_map.map_begin();
-        smart_objects::SmartMap::iterator iter_end = s_map.map_end();
-
-        for (; iter != iter_end; ++iter) {
-          params.push_back(iter->first);
-        }
-      }
-
       CommandParametersPermissions params_permissions;
       mobile_apis::Result::eType check_result =
           application_manager::ApplicationManagerImpl::instance()->
           CheckPolicyPermissions(
-            (*it_app_list).get()->mobile_app_id()->asString(),
-            (*it_app_list).get()->hmi_level(),
+            *it_app_list,
             static_cast<mobile_api::FunctionID::eType>(function_id()),
-            params,
             &params_permissions);
 
       // Check, if RPC is allowed by policy
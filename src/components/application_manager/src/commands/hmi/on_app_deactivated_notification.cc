@@ -91,7 +91,7 @@ void OnAppDeactivatedNotification::Run() {
       }
       // switch HMI level for all applications in FULL or LIMITED
       ApplicationManagerImpl::ApplicationListAccessor accessor;
-      ApplicationManagerImpl::TAppList applications =
+      const ApplicationManagerImpl::TAppList& applications =
           accessor.applications();
       ApplicationManagerImpl::TAppListIt it =
           applications.begin();
@@ -31,6 +31,7 @@
  */
 
 #include <set>
+#include <vector>
 #include "application_manager/commands/hmi/on_driver_distraction_notification.h"
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/application_impl.h"
@@ -70,24 +71,30 @@ void OnDriverDistractionNotification::Run() {
 
   (*on_driver_distraction)[strings::params][strings::function_id] =
       mobile_api::FunctionID::OnDriverDistractionID;
+  (*on_driver_distraction)[strings::params][strings::protocol_type] =
+      mobile_protocol_type_;
+  (*on_driver_distraction)[strings::params][strings::message_type] =
+      static_cast<int32_t>(application_manager::MessageType::kNotification);
 
   (*on_driver_distraction)[strings::msg_params][mobile_notification::state] =
       state;
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const std::set<ApplicationSharedPtr> applications = accessor.applications();
+  const std::set<ApplicationSharedPtr>& applications = accessor.applications();
 
+  std::vector<ApplicationSharedPtr> recipients;
   std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
   for (; applications.end() != it; ++it) {
     ApplicationSharedPtr app = *it;
     if (app.valid()) {
       if (mobile_apis::HMILevel::eType::HMI_NONE != app->hmi_level()) {
-          (*on_driver_distraction)[strings::params]
-                                  [strings::connection_key] = app->app_id();
-          SendNotificationToMobile(on_driver_distraction);
+        recipients.push_back(app);
       }
     }
   }
+
+  ApplicationManagerImpl::instance()->MulticastMessageToMobile(
+      *on_driver_distraction, recipients);
 }
 
 }  // namespace hmi
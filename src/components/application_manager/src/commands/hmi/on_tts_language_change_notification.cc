@@ -71,7 +71,7 @@ void OnTTSLanguageChangeNotification::Run() {
       static_cast<int32_t>(mobile_apis::FunctionID::OnLanguageChangeID);
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const std::set<ApplicationSharedPtr> applications = accessor.applications();
+  const std::set<ApplicationSharedPtr>& applications = accessor.applications();
 
   std::set<ApplicationSharedPtr>::iterator it = applications.begin();
   for (;applications.end() != it; ++it) {
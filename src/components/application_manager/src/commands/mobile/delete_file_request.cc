@@ -80,7 +80,11 @@ void DeleteFileRequest::Run() {
   full_file_path += sync_file_name;
 
   if (file_system::FileExists(full_file_path)) {
+    const int64_t file_size = file_system::FileSize(full_file_path);
     if (file_system::DeleteFile(full_file_path)) {
+      ApplicationManagerImpl::instance()->UpdateUsedSpaceForApp(
+          application->folder_name(), file_size, 0);
+
       const AppFile* file = application->GetFile(full_file_path);
       if (file) {
         SendFileRemovedNotification(file);
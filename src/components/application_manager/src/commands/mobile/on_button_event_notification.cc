@@ -91,13 +91,14 @@ void OnButtonEventNotification::Run() {
       return;
     }
 
-    SendButtonEvent(app);
+    SendButtonEvent(std::vector<ApplicationSharedPtr>(1, app));
     return;
   }
 
   const std::vector<ApplicationSharedPtr>& subscribedApps =
       ApplicationManagerImpl::instance()->applications_by_button(btn_id);
 
+  std::vector<ApplicationSharedPtr> recipients;
   std::vector<ApplicationSharedPtr>::const_iterator it = subscribedApps.begin();
   for (; subscribedApps.end() != it; ++it) {
     ApplicationSharedPtr subscribed_app = *it;
@@ -119,11 +120,16 @@ void OnButtonEventNotification::Run() {
       continue;
     }
 
-    SendButtonEvent(subscribed_app);
+    recipients.push_back(subscribed_app);
+  }
+
+  if (!recipients.empty()) {
+    SendButtonEvent(recipients);
   }
 }
 
-void OnButtonEventNotification::SendButtonEvent(ApplicationConstSharedPtr app) {
+void OnButtonEventNotification::SendButtonEvent(
+    const std::vector<ApplicationSharedPtr>& applications) {
   smart_objects::SmartObject* on_btn_event = new smart_objects::SmartObject();
 
   if (!on_btn_event) {
@@ -131,13 +137,6 @@ void OnButtonEventNotification::SendButtonEvent(ApplicationConstSharedPtr app) {
     return;
   }
 
-  if (!app) {
-    LOG4CXX_ERROR_EXT(logger_, "OnButtonEvent NULL pointer");
-    return;
-  }
-
-  (*on_btn_event)[strings::params][strings::connection_key] = app->app_id();
-
   (*on_btn_event)[strings::params][strings::function_id] =
       static_cast<int32_t>(mobile_apis::FunctionID::eType::OnButtonEventID);
 
@@ -153,7 +152,7 @@ void OnButtonEventNotification::SendButtonEvent(ApplicationConstSharedPtr app) {
   }
 
   message_.reset(on_btn_event);
-  SendNotification();
+  SendNotification(applications);
 }
 
 }  // namespace mobile
@@ -91,13 +91,14 @@ void OnButtonPressNotification::Run() {
       return;
     }
 
-    SendButtonPress(app);
+    SendButtonPress(std::vector<ApplicationSharedPtr>(1, app));
     return;
   }
 
   const std::vector<ApplicationSharedPtr>& subscribedApps =
       ApplicationManagerImpl::instance()->applications_by_button(btn_id);
 
+  std::vector<ApplicationSharedPtr> recipients;
   std::vector<ApplicationSharedPtr>::const_iterator it = subscribedApps.begin();
   for (; subscribedApps.end() != it; ++it) {
     ApplicationSharedPtr subscribed_app = *it;
@@ -119,11 +120,16 @@ void OnButtonPressNotification::Run() {
       continue;
     }
 
-    SendButtonPress(subscribed_app);
+    recipients.push_back(subscribed_app);
+  }
+
+  if (!recipients.empty()) {
+    SendButtonPress(recipients);
   }
 }
 
-void OnButtonPressNotification::SendButtonPress(ApplicationConstSharedPtr app) {
+void OnButtonPressNotification::SendButtonPress(
+    const std::vector<ApplicationSharedPtr>& applications) {
   smart_objects::SmartObject* on_btn_press = new smart_objects::SmartObject();
 
   if (!on_btn_press) {
@@ -131,13 +137,6 @@ void OnButtonPressNotification::SendButtonPress(ApplicationConstSharedPtr app) {
     return;
   }
 
-  if (!app) {
-    LOG4CXX_ERROR_EXT(logger_, "OnButtonPress NULL pointer");
-    return;
-  }
-
-  (*on_btn_press)[strings::params][strings::connection_key] = app->app_id();
-
   (*on_btn_press)[strings::params][strings::function_id] =
       static_cast<int32_t>(mobile_apis::FunctionID::eType::OnButtonPressID);
 
@@ -153,7 +152,7 @@ void OnButtonPressNotification::SendButtonPress(ApplicationConstSharedPtr app) {
   }
 
   message_.reset(on_btn_press);
-  SendNotification();
+  SendNotification(applications);
 }
 
 }  // namespace mobile
@@ -31,6 +31,10 @@
  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "application_manager/commands/mobile/on_vehicle_data_notification.h"
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/application_impl.h"
@@ -52,35 +56,56 @@ OnVehicleDataNotification::~OnVehicleDataNotification() {
 void OnVehicleDataNotification::Run() {
   LOG4CXX_INFO(logger_, "OnVehicleDataNotification::Run");
 
+  typedef std::vector<std::string> VehicleDataNames;
+  typedef std::map<ApplicationSharedPtr, VehicleDataNames> AppVehicleData;
+  AppVehicleData app_vehicle_data;
+
   const VehicleData& vehicle_data = MessageHelper::vehicle_data();
   VehicleData::const_iterator it = vehicle_data.begin();
 
   for (; vehicle_data.end() != it; ++it) {
     if (true == (*message_)[strings::msg_params].keyExists(it->first)) {
-      const std::vector<utils::SharedPtr<Application>>& applications =
+      const std::vector<ApplicationSharedPtr>& applications =
             ApplicationManagerImpl::instance()->IviInfoUpdated(it->second,
                 (*message_)[strings::msg_params][it->first].asInt());
 
-      std::vector<utils::SharedPtr<Application>>::const_iterator it = applications.begin();
-      for (; applications.end() != it; ++it) {
-        utils::SharedPtr<Application> app = *it;
-        if (!app) {
+      std::vector<ApplicationSharedPtr>::const_iterator app_it =
+          applications.begin();
+      for (; applications.end() != app_it; ++app_it) {
+        if (!(*app_it)) {
           LOG4CXX_ERROR_EXT(logger_, "NULL pointer");
           continue;
         }
+        app_vehicle_data[*app_it].push_back(it->first);
+      }
+    }
+  }
 
-        LOG4CXX_INFO(
-          logger_,
-          "Send OnVehicleData PRNDL notification to " << app->name()
-          << " application id " << app->app_id());
+  // Applications subscribed to the same items share one serialized message
+  typedef std::map<VehicleDataNames, std::vector<ApplicationSharedPtr> >
+      Recipients;
+  Recipients recipients;
+  AppVehicleData::const_iterator app_data = app_vehicle_data.begin();
+  for (; app_vehicle_data.end() != app_data; ++app_data) {
+    recipients[app_data->second].push_back(app_data->first);
+  }
 
-        (*message_)[strings::params][strings::connection_key] = app->app_id();
+  const smart_objects::SmartObject received_params =
+      (*message_)[strings::msg_params];
+  Recipients::const_iterator group = recipients.begin();
+  for (; recipients.end() != group; ++group) {
+    smart_objects::SmartObject& msg_params = (*message_)[strings::msg_params];
+    msg_params = smart_objects::SmartObject(smart_objects::SmartType_Map);
+    VehicleDataNames::const_iterator name = group->first.begin();
+    for (; group->first.end() != name; ++name) {
+      msg_params[*name] = received_params[*name];
+    }
 
-        SendNotification();
-      }
+    LOG4CXX_INFO(logger_, "Send OnVehicleData notification with "
+                 << group->first.size() << " items to "
+                 << group->second.size() << " applications");
 
-      return;
-    }
+    SendNotification(group->second);
   }
 }
 
@@ -48,10 +48,31 @@ PutFileRequest::PutFileRequest(const MessageSharedPtr& message)
   , sync_file_name_()
   , length_(0)
   , file_type_(mobile_apis::FileType::INVALID_ENUM)
-  , is_persistent_file_(false) {
+  , is_persistent_file_(false)
+  , chunk_taken_(false) {
 }
 
 PutFileRequest::~PutFileRequest() {
+  // Request rejected by limits or dropped before Run doesn't leave
+  // its binary data held
+  if (!chunk_taken_ && ApplicationManagerImpl::exists()) {
+    TakeChunk();
+  }
+}
+
+bool PutFileRequest::CheckPermissions() {
+  if (CommandRequestImpl::CheckPermissions()) {
+    return true;
+  }
+  // Request won't run, but stays pending until it is expired
+  TakeChunk();
+  return false;
+}
+
+utils::SharedPtr<Message> PutFileRequest::TakeChunk() {
+  chunk_taken_ = true;
+  return ApplicationManagerImpl::instance()->TakeFileChunk(connection_key(),
+                                                           correlation_id());
 }
 
 void PutFileRequest::Run() {
@@ -59,6 +80,9 @@ void PutFileRequest::Run() {
 
   ApplicationSharedPtr application =
       ApplicationManagerImpl::instance()->application(connection_key());
+  // Binary data is not copied to smart object, it is kept by incoming
+  // message until file chunk is written
+  const utils::SharedPtr<Message> chunk = TakeChunk();
   smart_objects::SmartObject response_params = smart_objects::SmartObject(
         smart_objects::SmartType_Map);
 
@@ -81,7 +105,7 @@ void PutFileRequest::Run() {
     return;
   }
 
-  if (!(*message_)[strings::params].keyExists(strings::binary_data)) {
+  if (!chunk || !chunk->has_binary_data()) {
     LOG4CXX_ERROR(logger_, "Binary data empty");
     SendResponse(false, mobile_apis::Result::INVALID_DATA,
                  "Binary data empty",
@@ -109,19 +133,21 @@ void PutFileRequest::Run() {
   file_type_ =
     static_cast<mobile_apis::FileType::eType>(
       (*message_)[strings::msg_params][strings::file_type].asInt());
-  const std::vector<uint8_t> binary_data =
-    (*message_)[strings::params][strings::binary_data].asBinary();
+  const uint8_t* binary_data = chunk->binary_data_begin();
+  const size_t binary_data_size = chunk->binary_data_size();
 
   // Policy table update in json format is currently to be received via PutFile
   // TODO(PV): after latest discussion has to be changed
   if (mobile_apis::FileType::JSON == file_type_) {
-    policy::PolicyHandler::instance()->ReceiveMessageFromSDK(sync_file_name_, binary_data);
+    policy::PolicyHandler::instance()->ReceiveMessageFromSDK(
+        sync_file_name_,
+        BinaryData(binary_data, binary_data + binary_data_size));
   }
 
   offset_ = 0;
   is_persistent_file_ = false;
   bool is_system_file = false;
-  length_ = binary_data.size();
+  length_ = binary_data_size;
   bool is_download_compleate = true;
   bool offset_exist =
       (*message_)[strings::msg_params].keyExists(strings::offset);
@@ -130,6 +156,13 @@ void PutFileRequest::Run() {
     offset_ = (*message_)[strings::msg_params][strings::offset].asInt64();
   }
 
+  // Length sent with first chunk is size of whole file
+  int64_t file_size = 0;
+  if (0 == offset_ &&
+      (*message_)[strings::msg_params].keyExists(strings::length)) {
+    file_size = (*message_)[strings::msg_params][strings::length].asInt64();
+  }
+
   if ((*message_)[strings::msg_params].
       keyExists(strings::persistent_file)) {
     is_persistent_file_ =
@@ -153,7 +186,7 @@ void PutFileRequest::Run() {
     uint32_t space_available = ApplicationManagerImpl::instance()->
         GetAvailableSpaceForApp(application->folder_name());
 
-    if (binary_data.size() > space_available) {
+    if (binary_data_size > space_available) {
 
       response_params[strings::space_available] =
           static_cast<uint32_t>(space_available);
@@ -172,11 +205,21 @@ void PutFileRequest::Run() {
     return;
   }
 
+  // Offset of chunk is checked to match size of existing file
+  const int64_t previous_size = 0 == offset_ ?
+      file_system::FileSize(file_path + "/" + sync_file_name_) : offset_;
+
   mobile_apis::Result::eType save_result =
-      ApplicationManagerImpl::instance()->SaveBinary(binary_data, file_path,
-                                                     sync_file_name_, offset_);
+      ApplicationManagerImpl::instance()->SaveFileChunk(
+        connection_key(), binary_data, binary_data_size, file_path,
+        sync_file_name_, offset_, file_size);
 
   if (!is_system_file) {
+    if (mobile_apis::Result::SUCCESS == save_result) {
+      ApplicationManagerImpl::instance()->UpdateUsedSpaceForApp(
+          application->folder_name(), previous_size,
+          offset_ + binary_data_size);
+    }
     response_params[strings::space_available] = static_cast<uint32_t>(
         ApplicationManagerImpl::instance()->GetAvailableSpaceForApp(
           application->folder_name()));
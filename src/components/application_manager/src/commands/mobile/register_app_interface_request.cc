@@ -215,18 +215,6 @@ void RegisterAppInterfaceRequest::Run() {
                       "  hasn't been registered!");
   } else {
 
-    // For resuming application need to restore hmi_app_id from resumeCtrl
-    const std::string mobile_app_id = msg_params[strings::app_id].asString();
-    ResumeCtrl& resumer = ApplicationManagerImpl::instance()->resume_controller();
-
-    // there is side affect with 2 mobile app with the same mobile app_id
-    if (resumer.IsApplicationSaved(mobile_app_id)) {
-      app->set_hmi_application_id(resumer.GetHMIApplicationID(mobile_app_id));
-    } else {
-      app->set_hmi_application_id(
-        ApplicationManagerImpl::instance()->GenerateNewHMIAppID());
-    }
-
     app->set_is_media_application(
       msg_params[strings::is_media_application].asBool());
 
@@ -507,7 +495,7 @@ RegisterAppInterfaceRequest::CheckCoincidence() {
     (*message_)[strings::msg_params];
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const std::set<ApplicationSharedPtr> applications = accessor.applications();
+  const std::set<ApplicationSharedPtr>& applications = accessor.applications();
 
   std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
   const std::string app_name = msg_params[strings::app_name].asString();
@@ -735,7 +723,7 @@ bool RegisterAppInterfaceRequest::IsApplicationWithSameAppIdRegistered() {
                                     [strings::app_id].asString();
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const std::set<ApplicationSharedPtr> applications = accessor.applications();
+  const std::set<ApplicationSharedPtr>& applications = accessor.applications();
 
   std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
   std::set<ApplicationSharedPtr>::const_iterator it_end = applications.end();
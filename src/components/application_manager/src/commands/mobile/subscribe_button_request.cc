@@ -76,7 +76,8 @@ void SubscribeButtonRequest::Run() {
     return;
   }
 
-  app->SubscribeToButton(static_cast<mobile_apis::ButtonName::eType>(btn_id));
+  ApplicationManagerImpl::instance()->SubscribeAppToButton(
+    app, static_cast<mobile_apis::ButtonName::eType>(btn_id));
   SendResponse(true, mobile_apis::Result::SUCCESS);
 
   app->UpdateHash();
@@ -120,7 +120,8 @@ void SubscribeVehicleDataRequest::Run() {
         msg_params[key_name] = is_key_enabled;
 
         VehicleDataType key_type = it->second;
-        if (app->SubscribeToIVI(static_cast<uint32_t>(key_type))) {
+        if (ApplicationManagerImpl::instance()->SubscribeAppToIVI(
+              app, static_cast<uint32_t>(key_type))) {
           ++subscribed_items;
         } else {
           response_params[key_name][strings::data_type] = key_type;
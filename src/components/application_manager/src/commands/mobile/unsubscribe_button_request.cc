@@ -70,7 +70,8 @@ void UnsubscribeButtonRequest::Run() {
     return;
   }
 
-  app->UnsubscribeFromButton(static_cast<mobile_apis::ButtonName::eType>(btn_id));
+  ApplicationManagerImpl::instance()->UnsubscribeAppFromButton(
+    app, static_cast<mobile_apis::ButtonName::eType>(btn_id));
   SendResponse(true, mobile_apis::Result::SUCCESS);
 }
 
@@ -124,7 +124,8 @@ void UnsubscribeVehicleDataRequest::Run() {
         msg_params[key_name] = is_key_enabled;
 
         VehicleDataType key_type = it->second;
-        if (app->UnsubscribeFromIVI(static_cast<uint32_t>(key_type))) {
+        if (ApplicationManagerImpl::instance()->UnsubscribeAppFromIVI(
+              app, static_cast<uint32_t>(key_type))) {
           ++unsubscribed_items;
         } else {
           response_params[key_name][strings::data_type] = key_type;
@@ -30,6 +30,8 @@
  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+
 #include "interfaces/HMI_API.h"
 #include "application_manager/event_engine/event_observer.h"
 #include "application_manager/event_engine/event_dispatcher.h"
@@ -38,85 +40,152 @@ namespace application_manager {
 namespace event_engine {
 using namespace sync_primitives;
 
-EventDispatcher::EventDispatcher()
-    : observers_() {
+namespace {
+
+struct IsRemoved {
+  template<typename Entry>
+  bool operator()(const Entry& entry) const {
+    return NULL == entry.observer;
+  }
+};
+
+}  // namespace
+
+EventDispatcher::EventDispatcher() {
 }
 
 EventDispatcher::~EventDispatcher() {
 }
 
-void EventDispatcher::raise_event(const Event& event) {
-  // create local list
-  ObserverList list;
-  {
-    AutoLock auto_lock(state_lock_);
-    // check if event is notification
-    if (hmi_apis::messageType::notification == event.smart_object_type()) {
-
-      //ObserversMap iterator
-      ObserversMap::iterator it = observers_[event.id()].begin();
-      for (; observers_[event.id()].end() != it; ++it) {
-        list = it->second;
-      }
-    }
+EventDispatcher::Shard& EventDispatcher::shard(const Event::EventID& event_id) {
+  return shards_[static_cast<uint32_t>(event_id) % kShardsCount];
+}
 
-    if (hmi_apis::messageType::response == event.smart_object_type()
-        || hmi_apis::messageType::error_response == event.smart_object_type()) {
-      list = observers_[event.id()][event.smart_object_correlation_id()];
-    }
+void EventDispatcher::raise_event(const Event& event) {
+  const bool is_notification =
+      hmi_apis::messageType::notification == event.smart_object_type();
+  const bool is_response =
+      hmi_apis::messageType::response == event.smart_object_type() ||
+      hmi_apis::messageType::error_response == event.smart_object_type();
+  if (!is_notification && !is_response) {
+    return;
   }
 
-  // Call observers
-  ObserverList::iterator observers =  list.begin();
-  for (; list.end() != observers; ++observers) {
-      (*observers)->on_event(event);
+  Shard& event_shard = shard(event.id());
+  AutoLock auto_lock(event_shard.lock);
+  EventObserverMap::iterator event_observers =
+      event_shard.observers.find(event.id());
+  if (event_shard.observers.end() == event_observers) {
+    return;
+  }
+  ++event_shard.dispatching;
+  // Observers subscribed during dispatch get next event
+  const uint64_t subscriptions = event_shard.subscriptions;
+  ObserversMap& observers = event_observers->second;
+  if (is_response) {
+    ObserversMap::iterator it =
+        observers.find(event.smart_object_correlation_id());
+    if (observers.end() != it) {
+      notify_observers(it->second, subscriptions, auto_lock, event);
+    }
+  } else {
+    // Map nodes are not erased while shard is dispatching
+    ObserversMap::iterator it = observers.begin();
+    for (; observers.end() != it; ++it) {
+      notify_observers(it->second, subscriptions, auto_lock, event);
+    }
   }
+  --event_shard.dispatching;
+  compact_shard(event_shard);
 }
 
 void EventDispatcher::add_observer(const Event::EventID& event_id,
                                    int32_t hmi_correlation_id,
                                    EventObserver* const observer) {
-  AutoLock auto_lock(state_lock_);
-  observers_[event_id][hmi_correlation_id].push_back(observer);
+  Shard& event_shard = shard(event_id);
+  AutoLock auto_lock(event_shard.lock);
+  event_shard.observers[event_id][hmi_correlation_id].push_back(
+      ObserverEntry(observer, event_shard.subscriptions++));
 }
 
 void EventDispatcher::remove_observer(const Event::EventID& event_id,
                                       EventObserver* const observer) {
-  AutoLock auto_lock(state_lock_);
-  ObserversMap::iterator it =  observers_[event_id].begin();
-  for (; observers_[event_id].end() != it; ++it) {
-
-    //ObserverList iterator
-    ObserverList::iterator observer_it =  it->second.begin();
-    while (it->second.end() != observer_it) {
-      if (observer->id() == (*observer_it)->id()) {
-        observer_it = it->second.erase(observer_it);
-      } else {
-        ++observer_it;
+  Shard& event_shard = shard(event_id);
+  AutoLock auto_lock(event_shard.lock);
+  EventObserverMap::iterator event_observers =
+      event_shard.observers.find(event_id);
+  if (event_shard.observers.end() != event_observers) {
+    remove_from_observers(event_shard, event_observers->second, observer);
+    compact_shard(event_shard);
+  }
+}
+
+void EventDispatcher::remove_observer(EventObserver* const observer) {
+  for (uint32_t i = 0; i < kShardsCount; ++i) {
+    AutoLock auto_lock(shards_[i].lock);
+    EventObserverMap::iterator it = shards_[i].observers.begin();
+    for (; shards_[i].observers.end() != it; ++it) {
+      remove_from_observers(shards_[i], it->second, observer);
+    }
+    compact_shard(shards_[i]);
+  }
+}
+
+void EventDispatcher::notify_observers(const ObserverEntries& entries,
+                                       uint64_t subscriptions,
+                                       AutoLock& auto_lock,
+                                       const Event& event) {
+  // Entries may be appended and reallocated while observer is called
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EventObserver* const observer = entries[i].observer;
+    if (!observer || subscriptions <= entries[i].subscription) {
+      continue;
+    }
+    AutoUnlock auto_unlock(auto_lock);
+    observer->on_event(event);
+  }
+}
+
+void EventDispatcher::remove_from_observers(
+    Shard& shard, ObserversMap& observers,
+    const EventObserver* const observer) {
+  ObserversMap::iterator it = observers.begin();
+  for (; observers.end() != it; ++it) {
+    ObserverEntries::iterator entry = it->second.begin();
+    for (; it->second.end() != entry; ++entry) {
+      if (entry->observer && observer->id() == entry->observer->id()) {
+        entry->observer = NULL;
+        shard.has_removed = true;
       }
     }
   }
 }
 
-void EventDispatcher::remove_observer(EventObserver* const observer) {
-  AutoLock auto_lock(state_lock_);
-  EventObserverMap::iterator event_map = observers_.begin();
-  for (; observers_.end() != event_map; ++event_map) {
-
-    ObserversMap::iterator it =  event_map->second.begin();
-    for (; event_map->second.end() != it; ++it) {
-
-      //ObserverList iterator
-      ObserverList::iterator observer_it =  it->second.begin();
-      while (it->second.end() != observer_it) {
-        if (observer->id() == (*observer_it)->id()) {
-          observer_it = it->second.erase(observer_it);
-        } else {
-          ++observer_it;
-        }
+void EventDispatcher::compact_shard(Shard& shard) {
+  if (0 != shard.dispatching || !shard.has_removed) {
+    return;
+  }
+  EventObserverMap::iterator event_observers = shard.observers.begin();
+  while (shard.observers.end() != event_observers) {
+    ObserversMap& observers = event_observers->second;
+    ObserversMap::iterator it = observers.begin();
+    while (observers.end() != it) {
+      it->second.erase(std::remove_if(it->second.begin(), it->second.end(),
+                                      IsRemoved()),
+                       it->second.end());
+      if (it->second.empty()) {
+        observers.erase(it++);
+      } else {
+        ++it;
       }
     }
+    if (observers.empty()) {
+      shard.observers.erase(event_observers++);
+    } else {
+      ++event_observers;
+    }
   }
+  shard.has_removed = false;
 }
 
 }
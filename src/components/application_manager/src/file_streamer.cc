@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/file_streamer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <limits>
+
+#include "utils/file_system.h"
+#include "utils/logger.h"
+
+namespace application_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "FileStreamer");
+
+FileStreamer::FileStreamer()
+  : sync_queue_("FileSync", &file_sync_) {
+}
+
+FileStreamer::~FileStreamer() {
+  sync_primitives::AutoLock auto_lock(open_files_lock_);
+  for (OpenFiles::const_iterator it = open_files_.begin();
+       open_files_.end() != it; ++it) {
+    if (it->second.fd >= 0) {
+      Release(it->second);
+    }
+  }
+  open_files_.clear();
+}
+
+void FileStreamer::HoldChunk(uint32_t connection_key, uint32_t correlation_id,
+                             const utils::SharedPtr<Message>& message) {
+  sync_primitives::AutoLock auto_lock(chunks_lock_);
+  chunks_[ChunkId(connection_key, correlation_id)] = message;
+}
+
+utils::SharedPtr<Message> FileStreamer::TakeChunk(uint32_t connection_key,
+                                                  uint32_t correlation_id) {
+  utils::SharedPtr<Message> message;
+  sync_primitives::AutoLock auto_lock(chunks_lock_);
+  Chunks::iterator it = chunks_.find(ChunkId(connection_key, correlation_id));
+  if (chunks_.end() != it) {
+    message = it->second;
+    chunks_.erase(it);
+  }
+  return message;
+}
+
+mobile_apis::Result::eType FileStreamer::Write(uint32_t app_id,
+                                               const std::string& full_file_path,
+                                               const uint8_t* data,
+                                               size_t size,
+                                               int64_t offset,
+                                               int64_t file_size) {
+  LOG4CXX_INFO(logger_, "Write " << size << " bytes at " << offset
+               << " to " << full_file_path);
+
+  // Application's requests are run one by one, so file is written without
+  // lock and others may be written meanwhile. Entry stays in the map marked
+  // as writing, so Close of application is noticed before it is put back.
+  OpenFile file;
+  {
+    sync_primitives::AutoLock auto_lock(open_files_lock_);
+    OpenFile& entry = open_files_[app_id];
+    file = entry;
+    entry.writing = true;
+  }
+
+  const mobile_apis::Result::eType result =
+      WriteChunk(full_file_path, data, size, offset, file_size, &file);
+
+  sync_primitives::AutoLock auto_lock(open_files_lock_);
+  OpenFiles::iterator it = open_files_.find(app_id);
+  if (it->second.closed || file.fd < 0) {
+    if (file.fd >= 0) {
+      Release(file);
+    }
+    open_files_.erase(it);
+  } else {
+    file.writing = false;
+    it->second = file;
+  }
+  return result;
+}
+
+mobile_apis::Result::eType FileStreamer::WriteChunk(
+    const std::string& full_file_path, const uint8_t* data, size_t size,
+    int64_t offset, int64_t file_size, OpenFile* file) {
+  if (file->fd >= 0 && (file->path != full_file_path || file->end != offset)) {
+    LOG4CXX_INFO(logger_, "Download of " << file->path << " is interrupted");
+    Release(*file);
+    file->fd = -1;
+  }
+
+  if (file->fd < 0) {
+    const mobile_apis::Result::eType result =
+        Open(full_file_path, offset, file_size, file);
+    if (mobile_apis::Result::SUCCESS != result) {
+      return result;
+    }
+  }
+
+  size_t written = 0;
+  while (written < size) {
+    const ssize_t result = pwrite(file->fd, data + written, size - written,
+                                  file->end + written);
+    if (result < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      LOG4CXX_ERROR(logger_, "Failed to write " << full_file_path
+                    << " error " << errno);
+      Release(*file);
+      file->fd = -1;
+      return mobile_apis::Result::GENERIC_ERROR;
+    }
+    written += result;
+  }
+  file->end += written;
+
+  if (file->end >= file->file_size) {
+    LOG4CXX_INFO(logger_, "File " << full_file_path << " is completed");
+    Release(*file);
+    file->fd = -1;
+  }
+  return mobile_apis::Result::SUCCESS;
+}
+
+void FileStreamer::Close(uint32_t app_id) {
+  {
+    sync_primitives::AutoLock auto_lock(open_files_lock_);
+    OpenFiles::iterator it = open_files_.find(app_id);
+    if (open_files_.end() != it) {
+      if (it->second.writing) {
+        // Writer releases the file when chunk is written
+        it->second.closed = true;
+      } else {
+        Release(it->second);
+        open_files_.erase(it);
+      }
+    }
+  }
+  sync_primitives::AutoLock auto_lock(chunks_lock_);
+  const uint32_t last_correlation_id = std::numeric_limits<uint32_t>::max();
+  chunks_.erase(chunks_.lower_bound(ChunkId(app_id, 0)),
+                chunks_.upper_bound(ChunkId(app_id, last_correlation_id)));
+}
+
+void FileStreamer::FileSync::Handle(const int fd) {
+  if (0 != fdatasync(fd)) {
+    LOG4CXX_WARN(logger_, "Failed to sync file, error " << errno);
+  }
+  close(fd);
+}
+
+mobile_apis::Result::eType FileStreamer::Open(
+    const std::string& full_file_path, int64_t offset, int64_t file_size,
+    OpenFile* file) {
+  int flags = O_WRONLY | O_CREAT;
+  if (0 == offset) {
+    // Offset 0 rewrites file
+    flags |= O_TRUNC;
+  } else if (file_system::FileSize(full_file_path) != offset) {
+    LOG4CXX_INFO(logger_, "Offset " << offset
+                 << " doesn't match size of existing file");
+    return mobile_apis::Result::INVALID_DATA;
+  }
+
+  const int fd = open(full_file_path.c_str(), flags,
+                      S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+  if (fd < 0) {
+    LOG4CXX_ERROR(logger_, "Failed to open " << full_file_path
+                  << " error " << errno);
+    return mobile_apis::Result::GENERIC_ERROR;
+  }
+
+#if defined(__linux__)
+  // Space is reserved without changing size of file, so offset of next
+  // chunk is still checked against size of downloaded part
+  if (file_size > offset &&
+      0 != fallocate(fd, FALLOC_FL_KEEP_SIZE, offset, file_size - offset)) {
+    LOG4CXX_WARN(logger_, "Failed to reserve space for " << full_file_path
+                 << " error " << errno);
+  }
+#endif  // __linux__
+
+  file->path = full_file_path;
+  file->fd = fd;
+  file->end = offset;
+  file->file_size = file_size;
+  return mobile_apis::Result::SUCCESS;
+}
+
+void FileStreamer::Release(const OpenFile& file) {
+  sync_queue_.PostMessage(file.fd);
+}
+
+}  // namespace application_manager
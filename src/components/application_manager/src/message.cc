@@ -62,13 +62,22 @@ Message::Message(protocol_handler::MessagePriority priority)
       priority_(priority),
       connection_key_(0),
       binary_data_(NULL),
+      raw_json_(NULL),
+      raw_json_size_(0),
+      raw_binary_data_(NULL),
+      raw_binary_data_size_(0),
       data_size_(0),
       payload_size_(0),
       version_(kUnknownProtocol) {
 }
 
 Message::Message(const Message& message)
-    : priority_(message.priority_) {
+    : priority_(message.priority_),
+      binary_data_(NULL),
+      raw_json_(NULL),
+      raw_json_size_(0),
+      raw_binary_data_(NULL),
+      raw_binary_data_size_(0) {
   *this = message;
 }
 
@@ -80,11 +89,17 @@ Message& Message::operator=(const Message& message) {
   set_data_size(message.data_size_);
   set_payload_size(message.payload_size_);
   if (message.binary_data_) {
-    set_binary_data(message.binary_data_);
+    set_binary_data(new BinaryData(*message.binary_data_));
   }
   set_json_message(message.json_message_);
+  raw_message_ = message.raw_message_;
+  raw_json_ = message.raw_json_;
+  raw_json_size_ = message.raw_json_size_;
+  raw_binary_data_ = message.raw_binary_data_;
+  raw_binary_data_size_ = message.raw_binary_data_size_;
   set_protocol_version(message.protocol_version());
   priority_ = message.priority_;
+  trace_ = message.trace_;
 
   return *this;
 }
@@ -94,15 +109,18 @@ bool Message::operator==(const Message& message) {
   bool correlation_id = correlation_id_ == message.correlation_id_;
   bool connection_key = connection_key_ == message.connection_key_;
   bool type = type_ == message.type_;
-  bool json_message = json_message_ == message.json_message_;
+  bool json_message = json_size() == message.json_size() &&
+      std::equal(json_begin(), json_begin() + json_size(),
+                 message.json_begin());
   bool version = version_ == message.version_;
   bool data_size = data_size_ == message.data_size_;
   bool payload_size = payload_size_ == message.payload_size_;
 
 
-  bool binary_data = std::equal(binary_data_->begin(), binary_data_->end(),
-                                message.binary_data_->begin(),
-                                BinaryDataPredicate);
+  bool binary_data = binary_data_size() == message.binary_data_size() &&
+      std::equal(binary_data_begin(),
+                 binary_data_begin() + binary_data_size(),
+                 message.binary_data_begin(), BinaryDataPredicate);
 
   return function_id && correlation_id && connection_key && type && binary_data
       && json_message && version && data_size && payload_size;
@@ -135,15 +153,46 @@ ProtocolVersion Message::protocol_version() const {
 }
 
 const std::string& Message::json_message() const {
+  if (raw_json_ && json_message_.empty()) {
+    json_message_.assign(json_begin(), json_size());
+  }
   return json_message_;
 }
 
 const BinaryData* Message::binary_data() const {
+  if (raw_binary_data_ && !binary_data_) {
+    binary_data_ = new BinaryData(raw_binary_data_,
+                                  raw_binary_data_ + raw_binary_data_size_);
+  }
   return binary_data_;
 }
 
 bool Message::has_binary_data() const {
-  return (binary_data_ != NULL);
+  return (binary_data_ != NULL || raw_binary_data_ != NULL);
+}
+
+const char* Message::json_begin() const {
+  return raw_json_ ? reinterpret_cast<const char*>(raw_json_)
+                   : json_message_.data();
+}
+
+size_t Message::json_size() const {
+  return raw_json_ ? raw_json_size_ : json_message_.size();
+}
+
+const uint8_t* Message::binary_data_begin() const {
+  if (raw_binary_data_) {
+    return raw_binary_data_;
+  }
+  return binary_data_ && !binary_data_->empty() ? &binary_data_->front()
+                                                : NULL;
+}
+
+size_t Message::binary_data_size() const {
+  if (raw_binary_data_) {
+    return raw_binary_data_size_;
+  }
+  return binary_data_ ? binary_data_->size() : 0;
 }
 
 size_t Message::data_size() const {
@@ -181,10 +230,30 @@ void Message::set_binary_data(BinaryData* data) {
   }
 
   binary_data_ = data;
+  raw_binary_data_ = NULL;
+  raw_binary_data_size_ = 0;
 }
 
 void Message::set_json_message(const std::string& json_message) {
   json_message_ = json_message;
+  raw_json_ = NULL;
+  raw_json_size_ = 0;
+}
+
+void Message::set_payload(const protocol_handler::RawMessagePtr& raw_message,
+                          const uint8_t* json, size_t json_size,
+                          const uint8_t* binary_data,
+                          size_t binary_data_size) {
+  raw_message_ = raw_message;
+  json_message_.clear();
+  raw_json_ = json_size ? json : NULL;
+  raw_json_size_ = json_size;
+  if (binary_data_) {
+    delete binary_data_;
+    binary_data_ = NULL;
+  }
+  raw_binary_data_ = binary_data_size ? binary_data : NULL;
+  raw_binary_data_size_ = binary_data_size;
 }
 
 void Message::set_protocol_version(ProtocolVersion version) {
@@ -459,6 +459,25 @@ std::string MessageHelper::StringifiedFunctionID(
   return std::string();
 }
 
+protocol_handler::MessagePriority MessageHelper::PriorityOfMessageToMobile(
+  const smart_objects::SmartObject& message) {
+  using protocol_handler::MessagePriority;
+  const smart_objects::SmartObject& params = message[strings::params];
+  MessagePriority::Urgency urgency = MessagePriority::kNormal;
+  if (params.keyExists(strings::binary_data) ||
+      mobile_apis::FunctionID::OnAudioPassThruID ==
+      params[strings::function_id].asInt()) {
+    urgency = MessagePriority::kBulkData;
+  } else if (kResponse == params[strings::message_type].asInt() ||
+             mobile_apis::FunctionID::OnHMIStatusID ==
+             params[strings::function_id].asInt()) {
+    // Both have the same urgency so that OnHMIStatus does not overtake
+    // response to RegisterAppInterface
+    urgency = MessagePriority::kUrgent;
+  }
+  return MessagePriority::FromServiceType(protocol_handler::kRpc, urgency);
+}
+
 #ifdef HMI_DBUS_API
 namespace {
 const std::map<std::string, uint16_t> create_get_vehicle_data_args() {
@@ -870,7 +889,7 @@ smart_objects::SmartObject* MessageHelper::CreateAppVrHelp(
   vr_help[strings::vr_help_title] = app->name();
 
   ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const std::set<ApplicationSharedPtr> apps = accessor.applications();
+  const std::set<ApplicationSharedPtr>& apps = accessor.applications();
 
   int32_t index = 0;
   std::set<ApplicationSharedPtr>::const_iterator it_app = apps.begin();
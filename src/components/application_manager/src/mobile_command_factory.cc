@@ -31,6 +31,8 @@
  */
 
 #include "application_manager/mobile_command_factory.h"
+#include <vector>
+#include "application_manager/message.h"
 #include "application_manager/commands/mobile/add_command_request.h"
 #include "application_manager/commands/mobile/add_command_response.h"
 #include "application_manager/commands/mobile/delete_command_request.h"
@@ -128,422 +130,290 @@
 
 namespace application_manager {
 
+namespace {
+
+typedef commands::Command* (*CommandCreator)(const MessageSharedPtr& message);
+
+template<typename CommandType>
+commands::Command* Create(const MessageSharedPtr& message) {
+  return new CommandType(message);
+}
+
+/**
+ * @brief Creators of commands indexed by function id. Function ids of
+ * RPCs start from zero and ids of notifications start from OnHMIStatusID,
+ * each range is kept in its own table.
+ */
+class CommandCreators {
+ public:
+  void Add(mobile_apis::FunctionID::eType function_id,
+           CommandCreator creator) {
+    Add(function_id, MessageType::kRequest, creator, creator);
+  }
+
+  /**
+   * @brief Messages of message_type are created by matching creator,
+   * messages of any other type by others creator
+   */
+  void Add(mobile_apis::FunctionID::eType function_id,
+           MessageType message_type,
+           CommandCreator matching_creator,
+           CommandCreator others_creator) {
+    std::vector<Entry>& entries =
+        IsNotification(function_id) ? notifications_ : rpcs_;
+    const size_t index = Index(function_id);
+    if (entries.size() <= index) {
+      entries.resize(index + 1);
+    }
+    entries[index].message_type = message_type;
+    entries[index].matching = matching_creator;
+    entries[index].others = others_creator;
+  }
+
+  /**
+   * @brief Returns creator or NULL if function id is unknown
+   */
+  CommandCreator Find(int32_t function_id, int32_t message_type) const {
+    if (function_id < 0) {
+      return NULL;
+    }
+    const std::vector<Entry>& entries =
+        IsNotification(function_id) ? notifications_ : rpcs_;
+    const size_t index = Index(function_id);
+    if (entries.size() <= index) {
+      return NULL;
+    }
+    const Entry& entry = entries[index];
+    return entry.message_type == message_type ? entry.matching : entry.others;
+  }
+
+ private:
+  struct Entry {
+    Entry()
+      : message_type(MessageType::kUnknownType),
+        matching(NULL),
+        others(NULL) {
+    }
+    MessageType message_type;
+    CommandCreator matching;
+    CommandCreator others;
+  };
+
+  static bool IsNotification(int32_t function_id) {
+    return mobile_apis::FunctionID::OnHMIStatusID <= function_id;
+  }
+
+  static size_t Index(int32_t function_id) {
+    return static_cast<size_t>(IsNotification(function_id) ?
+        function_id - mobile_apis::FunctionID::OnHMIStatusID : function_id);
+  }
+
+  std::vector<Entry> rpcs_;
+  std::vector<Entry> notifications_;
+};
+
+CommandCreators BuildCommandCreators() {
+  CommandCreators creators;
+  creators.Add(mobile_apis::FunctionID::RegisterAppInterfaceID,
+               MessageType::kRequest,
+               &Create<commands::RegisterAppInterfaceRequest>,
+               &Create<commands::RegisterAppInterfaceResponse>);
+  creators.Add(mobile_apis::FunctionID::UnregisterAppInterfaceID,
+               MessageType::kRequest,
+               &Create<commands::UnregisterAppInterfaceRequest>,
+               &Create<commands::UnregisterAppInterfaceResponse>);
+  creators.Add(mobile_apis::FunctionID::SetGlobalPropertiesID,
+               MessageType::kResponse,
+               &Create<commands::SetGlobalPropertiesResponse>,
+               &Create<commands::SetGlobalPropertiesRequest>);
+  creators.Add(mobile_apis::FunctionID::ResetGlobalPropertiesID,
+               MessageType::kResponse,
+               &Create<commands::ResetGlobalPropertiesResponse>,
+               &Create<commands::ResetGlobalPropertiesRequest>);
+  creators.Add(mobile_apis::FunctionID::AddCommandID,
+               MessageType::kResponse,
+               &Create<commands::AddCommandResponse>,
+               &Create<commands::AddCommandRequest>);
+  creators.Add(mobile_apis::FunctionID::DeleteCommandID,
+               MessageType::kResponse,
+               &Create<commands::DeleteCommandResponse>,
+               &Create<commands::DeleteCommandRequest>);
+  creators.Add(mobile_apis::FunctionID::AddSubMenuID,
+               MessageType::kResponse,
+               &Create<commands::AddSubMenuResponse>,
+               &Create<commands::AddSubMenuRequest>);
+  creators.Add(mobile_apis::FunctionID::DeleteSubMenuID,
+               MessageType::kResponse,
+               &Create<commands::DeleteSubMenuResponse>,
+               &Create<commands::DeleteSubMenuRequest>);
+  creators.Add(mobile_apis::FunctionID::DeleteInteractionChoiceSetID,
+               MessageType::kResponse,
+               &Create<commands::DeleteInteractionChoiceSetResponse>,
+               &Create<commands::DeleteInteractionChoiceSetRequest>);
+  creators.Add(mobile_apis::FunctionID::AlertID,
+               MessageType::kResponse,
+               &Create<commands::AlertResponse>,
+               &Create<commands::AlertRequest>);
+  creators.Add(mobile_apis::FunctionID::SpeakID,
+               MessageType::kResponse,
+               &Create<commands::SpeakResponse>,
+               &Create<commands::SpeakRequest>);
+  creators.Add(mobile_apis::FunctionID::SliderID,
+               MessageType::kResponse,
+               &Create<commands::SliderResponse>,
+               &Create<commands::SliderRequest>);
+  creators.Add(mobile_apis::FunctionID::PerformAudioPassThruID,
+               MessageType::kResponse,
+               &Create<commands::PerformAudioPassThruResponse>,
+               &Create<commands::PerformAudioPassThruRequest>);
+  creators.Add(mobile_apis::FunctionID::CreateInteractionChoiceSetID,
+               MessageType::kResponse,
+               &Create<commands::CreateInteractionChoiceSetResponse>,
+               &Create<commands::CreateInteractionChoiceSetRequest>);
+  creators.Add(mobile_apis::FunctionID::PerformInteractionID,
+               MessageType::kResponse,
+               &Create<commands::PerformInteractionResponse>,
+               &Create<commands::PerformInteractionRequest>);
+  creators.Add(mobile_apis::FunctionID::EndAudioPassThruID,
+               MessageType::kResponse,
+               &Create<commands::EndAudioPassThruResponse>,
+               &Create<commands::EndAudioPassThruRequest>);
+  creators.Add(mobile_apis::FunctionID::PutFileID,
+               MessageType::kResponse,
+               &Create<commands::PutFileResponse>,
+               &Create<commands::PutFileRequest>);
+  creators.Add(mobile_apis::FunctionID::DeleteFileID,
+               MessageType::kResponse,
+               &Create<commands::DeleteFileResponse>,
+               &Create<commands::DeleteFileRequest>);
+  creators.Add(mobile_apis::FunctionID::ListFilesID,
+               MessageType::kResponse,
+               &Create<commands::ListFilesResponse>,
+               &Create<commands::ListFilesRequest>);
+  creators.Add(mobile_apis::FunctionID::SubscribeButtonID,
+               MessageType::kResponse,
+               &Create<commands::SubscribeButtonResponse>,
+               &Create<commands::SubscribeButtonRequest>);
+  creators.Add(mobile_apis::FunctionID::UnsubscribeButtonID,
+               MessageType::kResponse,
+               &Create<commands::UnsubscribeButtonResponse>,
+               &Create<commands::UnsubscribeButtonRequest>);
+  creators.Add(mobile_apis::FunctionID::ShowConstantTBTID,
+               MessageType::kResponse,
+               &Create<commands::ShowConstantTBTResponse>,
+               &Create<commands::ShowConstantTBTRequest>);
+  creators.Add(mobile_apis::FunctionID::ShowID,
+               MessageType::kResponse,
+               &Create<commands::ShowResponse>,
+               &Create<commands::ShowRequest>);
+  creators.Add(mobile_apis::FunctionID::SubscribeVehicleDataID,
+               MessageType::kResponse,
+               &Create<commands::SubscribeVehicleDataResponse>,
+               &Create<commands::SubscribeVehicleDataRequest>);
+  creators.Add(mobile_apis::FunctionID::UnsubscribeVehicleDataID,
+               MessageType::kResponse,
+               &Create<commands::UnsubscribeVehicleDataResponse>,
+               &Create<commands::UnsubscribeVehicleDataRequest>);
+  creators.Add(mobile_apis::FunctionID::ReadDIDID,
+               MessageType::kResponse,
+               &Create<commands::ReadDIDResponse>,
+               &Create<commands::ReadDIDRequest>);
+  creators.Add(mobile_apis::FunctionID::GetVehicleDataID,
+               MessageType::kResponse,
+               &Create<commands::GetVehicleDataResponse>,
+               &Create<commands::GetVehicleDataRequest>);
+  creators.Add(mobile_apis::FunctionID::ScrollableMessageID,
+               MessageType::kResponse,
+               &Create<commands::ScrollableMessageResponse>,
+               &Create<commands::ScrollableMessageRequest>);
+  creators.Add(mobile_apis::FunctionID::AlertManeuverID,
+               MessageType::kResponse,
+               &Create<commands::AlertManeuverResponse>,
+               &Create<commands::AlertManeuverRequest>);
+  creators.Add(mobile_apis::FunctionID::SetAppIconID,
+               MessageType::kResponse,
+               &Create<commands::SetIconResponse>,
+               &Create<commands::SetIconRequest>);
+  creators.Add(mobile_apis::FunctionID::SetDisplayLayoutID,
+               MessageType::kResponse,
+               &Create<commands::SetDisplayLayoutResponse>,
+               &Create<commands::SetDisplayLayoutRequest>);
+  creators.Add(mobile_apis::FunctionID::UpdateTurnListID,
+               MessageType::kResponse,
+               &Create<commands::UpdateTurnListResponse>,
+               &Create<commands::UpdateTurnListRequest>);
+  creators.Add(mobile_apis::FunctionID::ChangeRegistrationID,
+               MessageType::kResponse,
+               &Create<commands::ChangeRegistrationResponse>,
+               &Create<commands::ChangeRegistrationRequest>);
+  creators.Add(mobile_apis::FunctionID::GetDTCsID,
+               MessageType::kResponse,
+               &Create<commands::GetDTCsResponse>,
+               &Create<commands::GetDTCsRequest>);
+  creators.Add(mobile_apis::FunctionID::DiagnosticMessageID,
+               MessageType::kResponse,
+               &Create<commands::DiagnosticMessageResponse>,
+               &Create<commands::DiagnosticMessageRequest>);
+  creators.Add(mobile_apis::FunctionID::SetMediaClockTimerID,
+               MessageType::kResponse,
+               &Create<commands::SetMediaClockTimerResponse>,
+               &Create<commands::SetMediaClockRequest>);
+  creators.Add(mobile_apis::FunctionID::SystemRequestID,
+               MessageType::kResponse,
+               &Create<commands::SystemResponse>,
+               &Create<commands::SystemRequest>);
+  creators.Add(mobile_apis::FunctionID::SendLocationID,
+               MessageType::kResponse,
+               &Create<commands::SendLocationResponse>,
+               &Create<commands::SendLocationRequest>);
+  creators.Add(mobile_apis::FunctionID::OnButtonEventID,
+               &Create<commands::mobile::OnButtonEventNotification>);
+  creators.Add(mobile_apis::FunctionID::OnButtonPressID,
+               &Create<commands::mobile::OnButtonPressNotification>);
+  creators.Add(mobile_apis::FunctionID::OnAudioPassThruID,
+               &Create<commands::OnAudioPassThruNotification>);
+  creators.Add(mobile_apis::FunctionID::OnVehicleDataID,
+               &Create<commands::OnVehicleDataNotification>);
+  creators.Add(mobile_apis::FunctionID::OnAppInterfaceUnregisteredID,
+               &Create<commands::OnAppInterfaceUnregisteredNotification>);
+  creators.Add(mobile_apis::FunctionID::OnCommandID,
+               &Create<commands::OnCommandNotification>);
+  creators.Add(mobile_apis::FunctionID::OnTBTClientStateID,
+               &Create<commands::OnTBTClientStateNotification>);
+  creators.Add(mobile_apis::FunctionID::OnDriverDistractionID,
+               &Create<commands::mobile::OnDriverDistractionNotification>);
+  creators.Add(mobile_apis::FunctionID::OnLanguageChangeID,
+               &Create<commands::OnLanguageChangeNotification>);
+  creators.Add(mobile_apis::FunctionID::OnPermissionsChangeID,
+               &Create<commands::OnPermissionsChangeNotification>);
+  creators.Add(mobile_apis::FunctionID::OnHMIStatusID,
+               &Create<commands::OnHMIStatusNotification>);
+  creators.Add(mobile_apis::FunctionID::OnKeyboardInputID,
+               &Create<commands::mobile::OnKeyBoardInputNotification>);
+  creators.Add(mobile_apis::FunctionID::OnTouchEventID,
+               &Create<commands::mobile::OnTouchEventNotification>);
+  creators.Add(mobile_apis::FunctionID::OnSystemRequestID,
+               &Create<commands::mobile::OnSystemRequestNotification>);
+  creators.Add(mobile_apis::FunctionID::OnHashChangeID,
+               &Create<commands::mobile::OnHashChangeNotification>);
+  return creators;
+}
+
+}  // namespace
+
 commands::Command *MobileCommandFactory::CreateCommand(
     const MessageSharedPtr& message) {
+  static const CommandCreators creators = BuildCommandCreators();
 
-  switch ((*message)[strings::params][strings::function_id].asInt()) {
-    case mobile_apis::FunctionID::RegisterAppInterfaceID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kRequest)) {
-        return new commands::RegisterAppInterfaceRequest(message);
-      } else {
-        return new commands::RegisterAppInterfaceResponse(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::UnregisterAppInterfaceID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kRequest)) {
-        return new commands::UnregisterAppInterfaceRequest(message);
-      } else {
-        return new commands::UnregisterAppInterfaceResponse(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SetGlobalPropertiesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SetGlobalPropertiesResponse(message);
-      } else {
-        return new commands::SetGlobalPropertiesRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ResetGlobalPropertiesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ResetGlobalPropertiesResponse(message);
-      } else {
-        return new commands::ResetGlobalPropertiesRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::AddCommandID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::AddCommandResponse(message);
-      } else {
-        return new commands::AddCommandRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::DeleteCommandID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::DeleteCommandResponse(message);
-      } else {
-        return new commands::DeleteCommandRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::AddSubMenuID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::AddSubMenuResponse(message);
-      } else {
-        return new commands::AddSubMenuRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::DeleteSubMenuID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::DeleteSubMenuResponse(message);
-      } else {
-        return new commands::DeleteSubMenuRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::DeleteInteractionChoiceSetID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return
-            new commands::DeleteInteractionChoiceSetResponse(message);
-      } else {
-        return new commands::DeleteInteractionChoiceSetRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::AlertID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::AlertResponse(message);
-      } else {
-        return new commands::AlertRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SpeakID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SpeakResponse(message);
-      } else {
-        return new commands::SpeakRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SliderID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SliderResponse(message);
-      } else {
-        return new commands::SliderRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::PerformAudioPassThruID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::PerformAudioPassThruResponse(message);
-      } else {
-        return new commands::PerformAudioPassThruRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::CreateInteractionChoiceSetID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return
-            new commands::CreateInteractionChoiceSetResponse(message);
-      } else {
-        return new commands::CreateInteractionChoiceSetRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::PerformInteractionID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::PerformInteractionResponse(message);
-      } else {
-        return new commands::PerformInteractionRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::EndAudioPassThruID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::EndAudioPassThruResponse(message);
-      } else {
-        return new commands::EndAudioPassThruRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::PutFileID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::PutFileResponse(message);
-      } else {
-        return new commands::PutFileRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::DeleteFileID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::DeleteFileResponse(message);
-      } else {
-        return new commands::DeleteFileRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ListFilesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ListFilesResponse(message);
-      } else {
-        return new commands::ListFilesRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SubscribeButtonID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SubscribeButtonResponse(message);
-      } else {
-        return new commands::SubscribeButtonRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::UnsubscribeButtonID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::UnsubscribeButtonResponse(message);
-      } else {
-        return new commands::UnsubscribeButtonRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ShowConstantTBTID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ShowConstantTBTResponse(message);
-      } else {
-        return new commands::ShowConstantTBTRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ShowID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ShowResponse(message);
-      } else {
-        return new commands::ShowRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SubscribeVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SubscribeVehicleDataResponse(message);
-      } else {
-        return new commands::SubscribeVehicleDataRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::UnsubscribeVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::UnsubscribeVehicleDataResponse(message);
-      } else {
-        return new commands::UnsubscribeVehicleDataRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ReadDIDID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ReadDIDResponse(message);
-      } else {
-        return new commands::ReadDIDRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::GetVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::GetVehicleDataResponse(message);
-      } else {
-        return new commands::GetVehicleDataRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ScrollableMessageID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ScrollableMessageResponse(message);
-      } else {
-        return new commands::ScrollableMessageRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::AlertManeuverID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::AlertManeuverResponse(message);
-      } else {
-        return new commands::AlertManeuverRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SetAppIconID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SetIconResponse(message);
-      } else {
-        return new commands::SetIconRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SetDisplayLayoutID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SetDisplayLayoutResponse(message);
-      } else {
-        return new commands::SetDisplayLayoutRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::UpdateTurnListID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::UpdateTurnListResponse(message);
-      } else {
-        return new commands::UpdateTurnListRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::ChangeRegistrationID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::ChangeRegistrationResponse(message);
-      } else {
-        return new commands::ChangeRegistrationRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::GetDTCsID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::GetDTCsResponse(message);
-      } else {
-        return new commands::GetDTCsRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::DiagnosticMessageID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::DiagnosticMessageResponse(message);
-      } else {
-        return new commands::DiagnosticMessageRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SetMediaClockTimerID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SetMediaClockTimerResponse(message);
-      } else {
-        return new commands::SetMediaClockRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SystemRequestID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SystemResponse(message);
-      } else {
-        return new commands::SystemRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::SendLocationID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
-        return new commands::SendLocationResponse(message);
-      } else {
-        return new commands::SendLocationRequest(message);
-      }
-      break;
-    }
-    case mobile_apis::FunctionID::OnButtonEventID: {
-      return new commands::mobile::OnButtonEventNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnButtonPressID: {
-      return new commands::mobile::OnButtonPressNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnAudioPassThruID: {
-      return new commands::OnAudioPassThruNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnVehicleDataID: {
-      return new commands::OnVehicleDataNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnAppInterfaceUnregisteredID: {
-      return
-          new commands::OnAppInterfaceUnregisteredNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnCommandID: {
-      return new commands::OnCommandNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnTBTClientStateID: {
-      return new commands::OnTBTClientStateNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnDriverDistractionID: {
-      return
-          new commands::mobile::OnDriverDistractionNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnLanguageChangeID: {
-      return new commands::OnLanguageChangeNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnPermissionsChangeID: {
-      return new commands::OnPermissionsChangeNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnHMIStatusID: {
-      return new commands::OnHMIStatusNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnKeyboardInputID: {
-      return new commands::mobile::OnKeyBoardInputNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnTouchEventID: {
-      return new commands::mobile::OnTouchEventNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnSystemRequestID: {
-      return new commands::mobile::OnSystemRequestNotification(message);
-      break;
-    }
-    case mobile_apis::FunctionID::OnHashChangeID: {
-      return new commands::mobile::OnHashChangeNotification(message);
-      break;
-    }
-    default: {
-      (*message)[strings::params][strings::function_id] =
-          static_cast<int32_t>(mobile_apis::FunctionID::GenericResponseID);
-      return new commands::GenericResponse(message);
-    }
+  const CommandCreator creator = creators.Find(
+      (*message)[strings::params][strings::function_id].asInt(),
+      (*message)[strings::params][strings::message_type].asInt());
+  if (!creator) {
+    (*message)[strings::params][strings::function_id] =
+        static_cast<int32_t>(mobile_apis::FunctionID::GenericResponseID);
+    return new commands::GenericResponse(message);
   }
+  return creator(message);
 }
 
 }  // namespace application_manager
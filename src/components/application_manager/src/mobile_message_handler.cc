@@ -108,7 +108,10 @@ MobileMessageHandler::HandleIncomingMessageProtocolV2(
           protocol_handler::MessagePriority::FromServiceType(
               message->service_type())));
 
-  outgoing_message->set_json_message(payload.json);
+  // JSON and binary data are not copied, message keeps raw message
+  outgoing_message->set_payload(message, payload.json,
+                                payload.header.json_size, payload.data,
+                                payload.data_size);
   outgoing_message->set_function_id(payload.header.rpc_function_id);
   outgoing_message->set_message_type(
       MessageTypeFromRpcType(payload.header.rpc_type));
@@ -119,11 +122,6 @@ MobileMessageHandler::HandleIncomingMessageProtocolV2(
         ->protocol_version()));
   outgoing_message->set_data_size(message->data_size());
   outgoing_message->set_payload_size(message->payload_size());
-
-  if (!payload.data.empty()) {
-    outgoing_message->set_binary_data(
-        new application_manager::BinaryData(payload.data));
-  }
   return outgoing_message.release();
 }
 
@@ -132,18 +130,24 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV1(
   const MobileMessage& message) {
   LOG4CXX_INFO(logger_,
                "MobileMessageHandler HandleOutgoingMessageProtocolV1()");
-  std::string messageString = message->json_message();
+  const std::string& messageString = message->json_message();
   if (messageString.length() == 0) {
     LOG4CXX_INFO(logger_,
                  "Drop ill-formed message from mobile");
     return NULL;
   }
 
-  uint8_t* rawMessage = new uint8_t[messageString.length() + 1];
-  memcpy(rawMessage, messageString.c_str(), messageString.length() + 1);
+  // Room is left for protocol header to be written in place
+  const size_t header_room = protocol_handler::PROTOCOL_HEADER_V2_SIZE;
+  uint8_t* rawMessage =
+      new uint8_t[header_room + messageString.length() + 1];
+  memcpy(rawMessage + header_room, messageString.c_str(),
+         messageString.length() + 1);
 
-  protocol_handler::RawMessage* result = new protocol_handler::RawMessage(
-    message->connection_key(), 1, rawMessage, messageString.length() + 1);
+  protocol_handler::RawMessage* result =
+    protocol_handler::RawMessage::CreateWithHeaderRoom(
+      message->connection_key(), 1, rawMessage, header_room,
+      messageString.length() + 1);
 
   return result;
 }
@@ -157,14 +161,15 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV2(
     LOG4CXX_ERROR(logger_, "json string is empty.");
   }
   uint32_t jsonSize = message->json_message().length();
-  uint32_t binarySize = 0;
-  if (message->has_binary_data()) {
-    binarySize = message->binary_data()->size();
-  }
+  uint32_t binarySize = message->binary_data_size();
 
+  // Protocol header and RPC binary header both are 12 bytes long.
+  // Room is left for protocol header to be written in place
+  const size_t header_room = protocol_handler::PROTOCOL_HEADER_V2_SIZE;
   const size_t dataForSendingSize =
       protocol_handler::PROTOCOL_HEADER_V2_SIZE + jsonSize + binarySize;
-  uint8_t* dataForSending = new uint8_t[dataForSendingSize];
+  uint8_t* buffer = new uint8_t[header_room + dataForSendingSize];
+  uint8_t* dataForSending = buffer + header_room;
   uint8_t offset = 0;
 
   uint8_t rpcTypeFlag = 0;
@@ -202,19 +207,15 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV2(
 
   memcpy(dataForSending + offset, message->json_message().c_str(), jsonSize);
 
-  if (message->has_binary_data()) {
-    const std::vector<uint8_t>& binaryData = *(message->binary_data());
-    uint8_t* currentPointer = dataForSending + offset + jsonSize;
-    for (uint32_t i = 0; i < binarySize; ++i) {
-      currentPointer[i] = binaryData[i];
-    }
+  if (binarySize) {
+    memcpy(dataForSending + offset + jsonSize, message->binary_data_begin(),
+           binarySize);
   }
 
   protocol_handler::RawMessage* msgToProtocolHandler =
-    new protocol_handler::RawMessage(message->connection_key(),
-                                     message->protocol_version(),
-                                     dataForSending,
-                                     dataForSendingSize);
+    protocol_handler::RawMessage::CreateWithHeaderRoom(
+      message->connection_key(), message->protocol_version(), buffer,
+      header_room, dataForSendingSize);
 
   return msgToProtocolHandler;
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/policies/compiled_permissions.h"
+
+namespace policy {
+
+CompiledPermissions::CompiledPermissions(uint32_t generation)
+  : generation_(generation),
+    permissions_(kEntriesCount) {
+}
+
+bool CompiledPermissions::Contains(mobile_apis::FunctionID::eType function_id) {
+  return Index(function_id, mobile_apis::HMILevel::HMI_FULL) >= 0;
+}
+
+bool CompiledPermissions::Set(mobile_apis::FunctionID::eType function_id,
+                              mobile_apis::HMILevel::eType hmi_level,
+                              const RpcPermissions& permissions) {
+  const int32_t index = Index(function_id, hmi_level);
+  if (index < 0) {
+    return false;
+  }
+  permissions_[index] = permissions;
+  stored_.set(index);
+  return true;
+}
+
+PermissionsGenerations::PermissionsGenerations()
+  : generation_(0),
+    policy_generation_(0) {
+}
+
+uint32_t PermissionsGenerations::Current() {
+  sync_primitives::AutoLock lock(lock_);
+  return generation_;
+}
+
+void PermissionsGenerations::OnPolicyChanged() {
+  sync_primitives::AutoLock lock(lock_);
+  policy_generation_ = ++generation_;
+  app_generations_.clear();
+}
+
+void PermissionsGenerations::OnAppChanged(uint32_t app_id) {
+  sync_primitives::AutoLock lock(lock_);
+  app_generations_[app_id] = ++generation_;
+}
+
+bool PermissionsGenerations::IsActual(uint32_t app_id,
+                                      const CompiledPermissions& permissions) {
+  sync_primitives::AutoLock lock(lock_);
+  if (permissions.generation() < policy_generation_) {
+    return false;
+  }
+  std::map<uint32_t, uint32_t>::const_iterator it =
+      app_generations_.find(app_id);
+  return app_generations_.end() == it ||
+         permissions.generation() >= it->second;
+}
+
+}  // namespace policy
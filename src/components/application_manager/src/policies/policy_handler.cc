@@ -51,6 +51,7 @@
 #include "policy/policy_types.h"
 #include "interfaces/MOBILE_API.h"
 #include "utils/file_system.h"
+#include "smart_objects/enum_schema_item.h"
 
 namespace policy {
 
@@ -72,6 +73,30 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "PolicyHandler")
 
 typedef std::set<application_manager::ApplicationSharedPtr> ApplicationList;
 
+namespace {
+/**
+ * @brief Interns names of parameters as vehicle data types
+ * @return false if some name is not a known vehicle data
+ */
+bool InternParameters(const std::vector<PTString>& names,
+                      CompiledPermissions::Parameters* parameters) {
+  const application_manager::VehicleData& vehicle_data =
+    application_manager::MessageHelper::vehicle_data();
+  std::vector<PTString>::const_iterator it = names.begin();
+  for (; names.end() != it; ++it) {
+    application_manager::VehicleData::const_iterator type =
+      vehicle_data.find(*it);
+    if (vehicle_data.end() == type || type->second < 0 ||
+        static_cast<size_t>(type->second) >=
+        CompiledPermissions::kParametersCount) {
+      return false;
+    }
+    parameters->set(type->second);
+  }
+  return true;
+}
+}  // namespace
+
 struct DeactivateApplication {
     explicit DeactivateApplication(
       const connection_handler::DeviceHandle& device_id)
@@ -270,7 +295,9 @@ bool PolicyHandler::InitPolicyTable() {
   std::string preloaded_file =
     profile::Profile::instance()->preloaded_pt_file();
   if (file_system::FileExists(preloaded_file)) {
-    return policy_manager_->InitPT(preloaded_file);
+    const bool result = policy_manager_->InitPT(preloaded_file);
+    OnPermissionsChanged();
+    return result;
   }
   LOG4CXX_WARN(logger_, "The file which contains preloaded PT is not exist");
   return false;
@@ -282,7 +309,9 @@ bool PolicyHandler::ResetPolicyTable() {
   std::string preloaded_file =
     profile::Profile::instance()->preloaded_pt_file();
   if (file_system::FileExists(preloaded_file)) {
-    return policy_manager_->ResetPT(preloaded_file);
+    const bool result = policy_manager_->ResetPT(preloaded_file);
+    OnPermissionsChanged();
+    return result;
   }
   LOG4CXX_WARN(logger_, "The file which contains preloaded PT is not exist");
   return false;
@@ -291,13 +320,15 @@ bool PolicyHandler::ResetPolicyTable() {
 bool PolicyHandler::ClearUserConsent() {
   LOG4CXX_INFO(logger_, "Removing user consent records in policy table.");
   POLICY_LIB_CHECK(false);
-  return policy_manager_->ResetUserConsent();
+  const bool result = policy_manager_->ResetUserConsent();
+  OnPermissionsChanged();
+  return result;
 }
 
 uint32_t PolicyHandler::GetAppIdForSending() {
   // Get app.list
   application_manager::ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const ApplicationList app_list = accessor.applications();
+  const ApplicationList& app_list = accessor.applications();
 
   if (app_list.empty()) {
     return 0;
@@ -423,7 +454,7 @@ void PolicyHandler::OnDeviceConsentChanged(const std::string& device_id,
   // notified about these changes
 
   application_manager::ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationList app_list = accessor.applications();
+  const ApplicationList& app_list = accessor.applications();
   ApplicationList::const_iterator it_app_list = app_list.begin();
   ApplicationList::const_iterator it_app_list_end = app_list.end();
   for (; it_app_list != it_app_list_end; ++it_app_list) {
@@ -442,6 +473,7 @@ void PolicyHandler::OnDeviceConsentChanged(const std::string& device_id,
 
       policy_manager_->ReactOnUserDevConsentForApp(policy_app_id,
                                                    is_allowed);
+      OnAppPermissionsChanged(**it_app_list);
 
       policy_manager_->SendNotificationOnPermissionsUpdated(policy_app_id);
     }
@@ -453,6 +485,7 @@ void PolicyHandler::AddApplication(const std::string& application_id) {
   registration_in_progress = true;
   POLICY_LIB_CHECK_VOID();
   policy_manager_->AddApplication(application_id);
+  OnPermissionsChanged(application_id);
 }
 
 void PolicyHandler::SetDeviceInfo(std::string& device_id,
@@ -483,6 +516,7 @@ void PolicyHandler::OnAppPermissionConsent(const uint32_t connection_key,
 
     if (!permissions.policy_app_id.empty()) {
       policy_manager_->SetUserConsentForApp(permissions);
+      OnPermissionsChanged(permissions.policy_app_id);
     }
 
     return;
@@ -525,6 +559,7 @@ void PolicyHandler::OnAppPermissionConsent(const uint32_t connection_key,
     permissions.policy_app_id = it->first;
     permissions.device_id = it->second;
     policy_manager_->SetUserConsentForApp(permissions);
+    OnAppPermissionsChanged(*app);
   }
 }
 
@@ -549,7 +584,7 @@ void PolicyHandler::OnGetListOfPermissions(const uint32_t connection_key,
   if (!connection_key) {
     LinkAppToDevice linker(app_to_device_link_);
     application_manager::ApplicationManagerImpl::ApplicationListAccessor accessor;
-    const ApplicationList app_list = accessor.applications();
+    const ApplicationList& app_list = accessor.applications();
     std::set<application_manager::ApplicationSharedPtr>::const_iterator it_app =
         app_list.begin();
     std::set<application_manager::ApplicationSharedPtr>::const_iterator
@@ -675,6 +710,7 @@ void PolicyHandler::OnVehicleDataUpdated(
 void PolicyHandler::OnAppRevoked(const std::string& policy_app_id) {
   LOG4CXX_TRACE(logger_, "OnAppRevoked with policy_app_id " << policy_app_id << " is revoked.");
   POLICY_LIB_CHECK_VOID();
+  OnPermissionsChanged(policy_app_id);
   application_manager::ApplicationSharedPtr app =
     application_manager::ApplicationManagerImpl::instance()
     ->application_by_policy_id(policy_app_id);
@@ -702,6 +738,7 @@ void PolicyHandler::OnPendingPermissionChange(
   LOG4CXX_INFO(logger_, "PolicyHandler::OnPendingPermissionChange for "
                << policy_app_id);
   POLICY_LIB_CHECK_VOID();
+  OnPermissionsChanged(policy_app_id);
   application_manager::ApplicationSharedPtr app =
       application_manager::ApplicationManagerImpl::instance()
       ->application_by_policy_id(policy_app_id);
@@ -816,6 +853,7 @@ bool PolicyHandler::ReceiveMessageFromSDK(const std::string& file,
     LOG4CXX_INFO(logger_, "PTU was successful.");
     exchange_handler_->Stop();
     policy_manager_->CleanupUnpairedDevices();
+    OnPermissionsChanged();
     int32_t correlation_id =
       application_manager::ApplicationManagerImpl::instance()
       ->GetNextHMICorrelationID();
@@ -894,7 +932,7 @@ void PolicyHandler::OnAllowSDLFunctionalityNotification(bool is_allowed,
   // Common devices consents change
   if (!device_specific) {
     application_manager::ApplicationManagerImpl::ApplicationListAccessor accessor;
-    const std::set<application_manager::ApplicationSharedPtr> app_list =
+    const std::set<application_manager::ApplicationSharedPtr>& app_list =
         accessor.applications();
 
     std::set<application_manager::ApplicationSharedPtr>::const_iterator
@@ -928,6 +966,7 @@ void PolicyHandler::OnAllowSDLFunctionalityNotification(bool is_allowed,
     }
     policy_manager_->SetUserConsentForDevice(device_params.device_mac_address,
         is_allowed);
+    OnDevicePermissionsChanged(device_id);
 
   }
 
@@ -1073,6 +1112,7 @@ void PolicyHandler::OnPTExchangeNeeded() {
 void PolicyHandler::OnPermissionsUpdated(const std::string& policy_app_id,
                                          const Permissions& permissions,
                                          const HMILevel& default_hmi) {
+  OnPermissionsChanged(policy_app_id);
   application_manager::ApplicationSharedPtr app =
     application_manager::ApplicationManagerImpl::instance()
     ->application_by_policy_id(policy_app_id);
@@ -1148,6 +1188,101 @@ void PolicyHandler::CheckPermissions(const PTString& app_id,
   policy_manager_->CheckPermissions(app_id, hmi_level, rpc, rpc_params, result);
 }
 
+CompiledPermissionsPtr PolicyHandler::GetCompiledPermissions(
+    application_manager::Application& app) {
+  POLICY_LIB_CHECK(CompiledPermissionsPtr());
+  const uint32_t generation = permissions_generations_.Current();
+  CompiledPermissionsPtr permissions = app.compiled_permissions();
+  if (permissions &&
+      permissions_generations_.IsActual(app.app_id(), *permissions)) {
+    return permissions;
+  }
+  permissions = CompilePermissions(app.mobile_app_id()->asString(),
+                                   generation);
+  app.set_compiled_permissions(permissions);
+  return permissions;
+}
+
+void PolicyHandler::OnPermissionsChanged() {
+  permissions_generations_.OnPolicyChanged();
+}
+
+void PolicyHandler::OnPermissionsChanged(const std::string& policy_app_id) {
+  application_manager::ApplicationManagerImpl::ApplicationListAccessor accessor;
+  const ApplicationList& app_list = accessor.applications();
+  ApplicationList::const_iterator it = app_list.begin();
+  for (; app_list.end() != it; ++it) {
+    if (policy_app_id == (*it)->mobile_app_id()->asString()) {
+      OnAppPermissionsChanged(**it);
+    }
+  }
+}
+
+void PolicyHandler::OnDevicePermissionsChanged(uint32_t device_handle) {
+  application_manager::ApplicationManagerImpl::ApplicationListAccessor accessor;
+  const ApplicationList& app_list = accessor.applications();
+  ApplicationList::const_iterator it = app_list.begin();
+  for (; app_list.end() != it; ++it) {
+    if (device_handle == (*it)->device()) {
+      OnAppPermissionsChanged(**it);
+    }
+  }
+}
+
+void PolicyHandler::OnAppPermissionsChanged(
+    const application_manager::Application& app) {
+  permissions_generations_.OnAppChanged(app.app_id());
+}
+
+CompiledPermissionsPtr PolicyHandler::CompilePermissions(
+    const std::string& policy_app_id, uint32_t generation) {
+  using namespace NsSmartDeviceLink::NsSmartObjects;
+  typedef EnumConversionHelper<mobile_apis::FunctionID::eType> FunctionIDs;
+  LOG4CXX_INFO(logger_, "Compiling permissions of application "
+               << policy_app_id);
+
+  utils::SharedPtr<CompiledPermissions> permissions(
+    new CompiledPermissions(generation));
+  const RPCParams rpc_params;
+  FunctionIDs::EnumToCStringMap::const_iterator it =
+    FunctionIDs::enum_to_cstring_map().begin();
+  for (; FunctionIDs::enum_to_cstring_map().end() != it; ++it) {
+    const mobile_apis::FunctionID::eType function_id = it->first;
+    // RPCs which don't fit into table are checked against policy directly
+    if (mobile_apis::FunctionID::RESERVED == function_id ||
+        !CompiledPermissions::Contains(function_id)) {
+      continue;
+    }
+    const std::string rpc =
+      application_manager::MessageHelper::StringifiedFunctionID(function_id);
+    for (int32_t level = 0; level < CompiledPermissions::kHmiLevelsCount;
+         ++level) {
+      const mobile_apis::HMILevel::eType hmi_level =
+        static_cast<mobile_apis::HMILevel::eType>(level);
+      CheckPermissionResult result;
+      policy_manager_->CheckPermissions(
+        policy_app_id,
+        application_manager::MessageHelper::StringifiedHMILevel(hmi_level),
+        rpc, rpc_params, result);
+
+      CompiledPermissions::RpcPermissions rpc_permissions;
+      rpc_permissions.hmi_level_permitted = result.hmi_level_permitted;
+      if (!InternParameters(result.list_of_allowed_params,
+                            &rpc_permissions.allowed_params) ||
+          !InternParameters(result.list_of_disallowed_params,
+                            &rpc_permissions.disallowed_params) ||
+          !InternParameters(result.list_of_undefined_params,
+                            &rpc_permissions.undefined_params)) {
+        LOG4CXX_WARN(logger_, "Parameters of " << rpc << " are not all "
+                     "vehicle data, they will be checked against policy.");
+        continue;
+      }
+      permissions->Set(function_id, hmi_level, rpc_permissions);
+    }
+  }
+  return permissions;
+}
+
 uint32_t PolicyHandler::GetNotificationsNumber(const std::string& priority) {
   POLICY_LIB_CHECK(0);
  return policy_manager_->GetNotificationsNumber(priority);
@@ -1281,6 +1416,11 @@ void PolicyHandler::RemoveDevice(const std::string& device_id) {
   POLICY_LIB_CHECK_VOID();
 
   policy_manager_->MarkUnpairedDevice(device_id);
+  connection_handler::DeviceHandle device_handle;
+  if (application_manager::ApplicationManagerImpl::instance()
+      ->connection_handler()->GetDeviceID(device_id, &device_handle)) {
+    OnDevicePermissionsChanged(device_handle);
+  }
 
 }
 
@@ -34,6 +34,7 @@
 #include "utils/logger.h"
 #include "config_profile/profile.h"
 #include "application_manager/request_controller.h"
+#include "application_manager/application_manager_impl.h"
 #include "application_manager/commands/command_request_impl.h"
 #include "application_manager/commands/hmi/request_to_hmi.h"
 
@@ -48,6 +49,8 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "RequestController");
 RequestController::RequestController()
   : pool_state_(UNDEFINED),
     pool_size_(profile::Profile::instance()->thread_pool_size()),
+    idle_workers_(0),
+    mobile_request_count_(0),
     pending_request_set_lock_(true),
     timer_("RequestCtrlTimer", this, &RequestController::onTimer, true)
 {
@@ -64,25 +67,40 @@ RequestController::~RequestController() {
   }
 
   pool_.clear();
-  mobile_request_list_.clear();
-  pending_request_set_.clear();
+  mobile_request_lanes_.clear();
+  lanes_statistics_.clear();
+  ready_lanes_.clear();
+  pending_request_set_.Clear();
 }
 
 void RequestController::InitializeThreadpool()
 {
   LOG4CXX_TRACE_ENTER(logger_);
-  // TODO: Consider lazy loading threads instead of creating all at once
+  AutoLock auto_lock(mobile_request_list_lock_);
   pool_state_ = TPoolState::STARTED;
-  for (uint32_t i = 0; i < pool_size_; i++) {
-    char name [50];
-    snprintf(name, sizeof(name)/sizeof(name[0]),
-             "AM Pool %d", i);
-    pool_.push_back(threads::CreateThread(name, new Worker(this)));
-    pool_[i]->start();
-    LOG4CXX_INFO(logger_, "Request thread initialized: " << name);
+  if (0 != pool_size_) {
+    pool_.push_back(threads::CreateThread("AM Pool 0", new Worker(this)));
+    pool_.back()->start();
+    LOG4CXX_INFO(logger_, "Request thread initialized: AM Pool 0");
   }
 }
 
+void RequestController::GrowThreadpoolIfNeeded() {
+  if (TPoolState::STARTED != pool_state_ ||
+      pool_.size() >= pool_size_ ||
+      ready_lanes_.size() <= idle_workers_) {
+    return;
+  }
+  DeleteRetiredWorkers();
+  char name [50];
+  snprintf(name, sizeof(name)/sizeof(name[0]),
+           "AM Pool %d", static_cast<int32_t>(pool_.size()));
+  pool_.push_back(threads::CreateThread(name, new Worker(this)));
+  pool_.back()->start();
+  LOG4CXX_INFO(logger_, "Request thread initialized: " << name
+               << ", ready lanes " << ready_lanes_.size());
+}
+
 void RequestController::DestroyThreadpool() {
   LOG4CXX_TRACE_ENTER(logger_);
   {
@@ -91,11 +109,40 @@ void RequestController::DestroyThreadpool() {
     LOG4CXX_INFO(logger_, "Broadcasting STOP signal to all threads...");
     cond_var_.Broadcast(); // notify all threads we are shutting down
   }
-  for (uint32_t i = 0; i < pool_size_; i++) {
+  for (size_t i = 0; i < pool_.size(); i++) {
     pool_[i]->stop();
     threads::DeleteThread(pool_[i]);
   }
-  LOG4CXX_INFO(logger_, "Threads exited from the thread pool " << pool_size_);
+  LOG4CXX_INFO(logger_, "Threads exited from the thread pool " << pool_.size());
+  sync_primitives::AutoLock auto_lock(mobile_request_list_lock_);
+  DeleteRetiredWorkers();
+}
+
+bool RequestController::RetireWorker(const Worker* worker) {
+  if (pool_.size() <= 1) {
+    return false;
+  }
+  for (std::vector<Thread*>::iterator it = pool_.begin();
+       pool_.end() != it; ++it) {
+    if ((*it)->delegate() == worker) {
+      LOG4CXX_INFO(logger_, "Idle worker retired, pool size "
+                   << pool_.size() - 1);
+      retired_workers_.push_back(*it);
+      pool_.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void RequestController::DeleteRetiredWorkers() {
+  // Retired worker doesn't take the lock after it is retired,
+  // so it is joined under the lock
+  for (size_t i = 0; i < retired_workers_.size(); ++i) {
+    retired_workers_[i]->join();
+    threads::DeleteThread(retired_workers_[i]);
+  }
+  retired_workers_.clear();
 }
 
 RequestController::TResult RequestController::addMobileRequest(
@@ -109,10 +156,48 @@ RequestController::TResult RequestController::addMobileRequest(
     return INVALID_DATA;
   }
 
-  TResult result = SUCCESS;
   const commands::CommandRequestImpl* request_impl =
       static_cast<commands::CommandRequestImpl*>(request.get());
   LOG4CXX_DEBUG(logger_, "addMobileRequest " << request_impl->correlation_id());
+
+  {
+    AutoLock auto_lock(mobile_request_list_lock_);
+
+    if (profile::Profile::instance()->pending_requests_amount() <=
+        mobile_request_count_) {
+      LOG4CXX_ERROR(logger_, "Too many pending request");
+      LOG4CXX_TRACE_EXIT(logger_);
+      return TOO_MANY_PENDING_REQUESTS;
+    }
+
+    const uint32_t connection_key = request_impl->connection_key();
+    Lane& lane = mobile_request_lanes_[connection_key];
+    if (!lane.busy && lane.requests.empty()) {
+      ready_lanes_.push_back(connection_key);
+    }
+    lane.requests.push_back(
+        QueuedRequest(request, date_time::DateTime::getCurrentTime()));
+    LaneStatistics& statistics = lanes_statistics_[connection_key];
+    statistics.max_depth =
+        std::max(statistics.max_depth, lane.requests.size());
+    ++mobile_request_count_;
+    LOG4CXX_INFO(logger_, "mobile requests queued " << mobile_request_count_
+                 << " lane of " << connection_key << " depth is "
+                 << lane.requests.size()
+                 << " pending_request_set_ size is "
+                 << pending_request_set_.Size()
+                 );
+    GrowThreadpoolIfNeeded();
+  }
+
+  // wake up one thread that is waiting for a task to be available
+  cond_var_.NotifyOne();
+  LOG4CXX_TRACE_EXIT(logger_);
+  return SUCCESS;
+}
+
+RequestController::TResult RequestController::checkRequestLimits(
+    const uint32_t& connection_key) {
   const uint32_t& app_hmi_level_none_time_scale =
       profile::Profile::instance()->app_hmi_level_none_time_scale();
 
@@ -125,38 +210,34 @@ RequestController::TResult RequestController::addMobileRequest(
   const uint32_t& max_request_per_time_scale =
       profile::Profile::instance()->app_time_scale_max_requests();
 
-  const uint32_t& pending_requests_amount =
-      profile::Profile::instance()->pending_requests_amount();
-
   if (!checkHMILevelTimeScaleMaxRequest(mobile_apis::HMILevel::HMI_NONE,
-                                        request_impl->connection_key(),
+                                        connection_key,
                                         app_hmi_level_none_time_scale,
                                         app_hmi_level_none_max_request_per_time_scale)) {
     LOG4CXX_ERROR(logger_, "Too many application requests in hmi level NONE");
-    result = RequestController::NONE_HMI_LEVEL_MANY_REQUESTS;
+    return RequestController::NONE_HMI_LEVEL_MANY_REQUESTS;
   } else if (!checkTimeScaleMaxRequest(
-        request_impl->connection_key(),
+        connection_key,
         app_time_scale, max_request_per_time_scale)) {
     LOG4CXX_ERROR(logger_, "Too many application requests");
-    result = RequestController::TOO_MANY_REQUESTS;
-  } else if (pending_requests_amount == mobile_request_list_.size()) {
-    LOG4CXX_ERROR(logger_, "Too many pending request");
-    result = RequestController::TOO_MANY_PENDING_REQUESTS;
+    return RequestController::TOO_MANY_REQUESTS;
   }
-  {
-    AutoLock auto_lock(mobile_request_list_lock_);
+  return SUCCESS;
+}
 
-    mobile_request_list_.push_back(request);
-    LOG4CXX_INFO(logger_, "mobile_request_list_ size is "
-                 << mobile_request_list_.size()
-                 << " pending_request_set_ size is "
-                 << pending_request_set_.size()
-                 );
+RequestController::LaneStatistics RequestController::GetLaneStatistics(
+    const uint32_t& connection_key) const {
+  AutoLock auto_lock(mobile_request_list_lock_);
+  LanesStatistics::const_iterator statistics =
+      lanes_statistics_.find(connection_key);
+  if (lanes_statistics_.end() == statistics) {
+    return LaneStatistics();
+  }
+  LaneStatistics result = statistics->second;
+  Lanes::const_iterator lane = mobile_request_lanes_.find(connection_key);
+  if (mobile_request_lanes_.end() != lane) {
+    result.depth = lane->second.requests.size();
   }
-
-  // wake up one thread that is waiting for a task to be available
-  cond_var_.NotifyOne();
-  LOG4CXX_TRACE_EXIT(logger_);
   return result;
 }
 
@@ -173,9 +254,12 @@ RequestController::TResult RequestController::addHMIRequest(
 
   if (0 != timeout_in_seconds) {
     pending_request_set_lock_.Acquire();
-    pending_request_set_.insert(request_info_ptr);
+    if (!pending_request_set_.Add(request_info_ptr)) {
+      LOG4CXX_ERROR(logger_, "HMI request with correlation id "
+                    << request_info_ptr->requestId() << " is already pending");
+    }
     LOG4CXX_INFO(logger_, "pending_request_set_ size is "
-                 << pending_request_set_.size());
+                 << pending_request_set_.Size());
     UpdateTimer();
     pending_request_set_lock_.Release();
   } else {
@@ -205,51 +289,42 @@ void RequestController::removeNotification(const commands::Command* notification
 }
 
 void RequestController::terminateMobileRequest(
+    const uint32_t& connection_key,
     const uint32_t& mobile_correlation_id) {
   LOG4CXX_TRACE_ENTER(logger_);
 
   AutoLock auto_lock(pending_request_set_lock_);
-  RequestInfoSet::iterator it = pending_request_set_.begin();
-  for (; pending_request_set_.end() != it; ++it) {
-    RequestInfo* mobile_request_info = it->get();
-    if (NULL == mobile_request_info) {
-      continue;
-    }
-    if (mobile_correlation_id == mobile_request_info->requestId()) {
-      mobile_request_info->request()->CleanUp();
-      pending_request_set_.erase(it);
-      LOG4CXX_INFO(logger_, "Mobile request terminated: " << mobile_correlation_id <<
-                   " pending_request_set_ size : " << pending_request_set_.size());
-      UpdateTimer();
-      LOG4CXX_TRACE_EXIT(logger_);
-      return;
-    }
+  RequestInfoPtr mobile_request_info = pending_request_set_.Find(
+      RequestInfo::MobileRequest, connection_key, mobile_correlation_id);
+  if (mobile_request_info.valid()) {
+    pending_request_set_.RemoveRequest(mobile_request_info);
+    mobile_request_info->request()->CleanUp();
+    LOG4CXX_INFO(logger_, "Mobile request terminated: " << mobile_correlation_id <<
+                 " pending_request_set_ size : " << pending_request_set_.Size());
+    UpdateTimer();
+    LOG4CXX_TRACE_EXIT(logger_);
+    return;
   }
   LOG4CXX_INFO(logger_, "Mobile request NOT terminated: " << mobile_correlation_id <<
-                        " pending_request_set_ size : " << pending_request_set_.size());
+                        " pending_request_set_ size : " << pending_request_set_.Size());
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
 void RequestController::terminateHMIRequest(const uint32_t &correlation_id) {
   LOG4CXX_TRACE_ENTER(logger_);
   AutoLock auto_lock(pending_request_set_lock_);
-  RequestInfoSet::iterator it = pending_request_set_.begin();
-  for (; pending_request_set_.end() != it; ++it) {
-    RequestInfo* hmi_request_info = it->get();
-    if (NULL == hmi_request_info) {
-      continue;
-    }
-    if (correlation_id == hmi_request_info->requestId()) {
-      hmi_request_info->request()->CleanUp();
-      pending_request_set_.erase(it);
-      LOG4CXX_DEBUG(logger_, "HMI request terminated: " << correlation_id);
-      UpdateTimer();
-      LOG4CXX_TRACE_EXIT(logger_);
-      return;
-    }
+  RequestInfoPtr hmi_request_info = pending_request_set_.Find(
+      RequestInfo::HMIRequest, 0, correlation_id);
+  if (hmi_request_info.valid()) {
+    pending_request_set_.RemoveRequest(hmi_request_info);
+    hmi_request_info->request()->CleanUp();
+    LOG4CXX_DEBUG(logger_, "HMI request terminated: " << correlation_id);
+    UpdateTimer();
+    LOG4CXX_TRACE_EXIT(logger_);
+    return;
   }
   LOG4CXX_INFO(logger_, "HMI request NOT terminated: " << correlation_id <<
-                        " pending_request_set_ size : " << pending_request_set_.size());
+                        " pending_request_set_ size : " << pending_request_set_.Size());
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
@@ -257,23 +332,35 @@ void RequestController::terminateAppRequests(
     const uint32_t& app_id) {
   LOG4CXX_TRACE_ENTER(logger_);
 
-  AutoLock auto_lock(pending_request_set_lock_);
-  RequestInfoSet::iterator it = pending_request_set_.begin();
-  while (pending_request_set_.end() != it) {
-    RequestInfo* mobile_request_info = it->get();
-    if (NULL == mobile_request_info) {
-      ++it;
-      continue;
+  // Queued requests are dropped without running, they are destroyed
+  // after the lock is released
+  std::list<QueuedRequest> dropped;
+  {
+    AutoLock auto_lock(mobile_request_list_lock_);
+    lanes_statistics_.erase(app_id);
+    Lanes::iterator lane = mobile_request_lanes_.find(app_id);
+    if (mobile_request_lanes_.end() != lane) {
+      dropped.swap(lane->second.requests);
+      mobile_request_count_ -= dropped.size();
+      // Lane of request being executed now is released by its worker
+      if (!lane->second.busy) {
+        ready_lanes_.remove(app_id);
+        mobile_request_lanes_.erase(lane);
+      }
     }
+  }
+  LOG4CXX_INFO(logger_, "dropped " << dropped.size()
+               << " queued app requests : " << app_id);
 
-    if (mobile_request_info->app_id() == app_id) {
-      mobile_request_info->request()->CleanUp();
-      pending_request_set_.erase(it++);
-      LOG4CXX_INFO(logger_, "terminated all app requests : " << app_id);
-    } else {
-      ++it;
-    }
+  AutoLock auto_lock(pending_request_set_lock_);
+  const std::vector<RequestInfoPtr> terminated =
+      pending_request_set_.RemoveByConnectionKey(app_id);
+  std::vector<RequestInfoPtr>::const_iterator it = terminated.begin();
+  for (; terminated.end() != it; ++it) {
+    (*it)->request()->CleanUp();
   }
+  LOG4CXX_INFO(logger_, "terminated " << terminated.size()
+               << " app requests : " << app_id);
   UpdateTimer();
   LOG4CXX_TRACE_EXIT(logger_);
 }
@@ -281,17 +368,14 @@ void RequestController::terminateAppRequests(
 void RequestController::terminateAllHMIRequests() {
   LOG4CXX_TRACE_ENTER(logger_);
   AutoLock auto_lock(pending_request_set_lock_);
-  RequestInfoSet::iterator it = pending_request_set_.begin();
-  while (pending_request_set_.end() != it) {
-    RequestInfo* hmi_request_info = it->get();
-    if (NULL == hmi_request_info) {
-      ++it;
-      continue;
-    }
-    hmi_request_info->request()->CleanUp();
-    pending_request_set_.erase(it++);
-    LOG4CXX_INFO(logger_, "HMI request terminated: ");
+  const std::vector<RequestInfoPtr> terminated =
+      pending_request_set_.RemoveByType(RequestInfo::HMIRequest);
+  std::vector<RequestInfoPtr>::const_iterator it = terminated.begin();
+  for (; terminated.end() != it; ++it) {
+    (*it)->request()->CleanUp();
   }
+  LOG4CXX_INFO(logger_, "HMI requests terminated: " << terminated.size());
+  UpdateTimer();
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
@@ -303,36 +387,14 @@ void RequestController::updateRequestTimeout(
   LOG4CXX_TRACE_ENTER(logger_);
 
   AutoLock auto_lock(pending_request_set_lock_);
-  RequestInfoSet::iterator it = pending_request_set_.begin();
-  RequestInfo* mobile_request_info = NULL;
-  RequestInfoPtr request_info;
-  for (; pending_request_set_.end() != it; ++it) {
-    request_info = *it;
-    if (false == request_info.valid()) {
-      LOG4CXX_ERROR(logger_, "Invalid request, can't update timeout");
-      continue;
-    }
-    mobile_request_info = request_info.get();
-    if (NULL == mobile_request_info) {
-      continue;
-    }
-    if (app_id == mobile_request_info->app_id() &&
-        mobile_correlation_id == mobile_request_info->requestId()) {
-      break;
-    }
-  }
-
-  if (it != pending_request_set_.end()) {
-    DCHECK(mobile_request_info);
-    DCHECK(request_info.valid());
+  RequestInfoPtr request_info = pending_request_set_.Find(
+      RequestInfo::MobileRequest, app_id, mobile_correlation_id);
 
+  if (request_info.valid()) {
     uint32_t timeout_in_seconds = new_timeout/date_time::DateTime::MILLISECONDS_IN_SECOND;
-    mobile_request_info->updateTimeOut(timeout_in_seconds);
-    pending_request_set_.erase(it);
-    pending_request_set_.insert(request_info);
-    // erase and insert need to update ordering of set
+    pending_request_set_.UpdateTimeOut(request_info, timeout_in_seconds);
     UpdateTimer();
-    LOG4CXX_ERROR(logger_, "Timeout updated for "
+    LOG4CXX_INFO(logger_, "Timeout updated for "
                   << " app_id " << app_id
                   << " mobile_correlation_id " << mobile_correlation_id
                   << " new_timeout " << new_timeout);
@@ -346,23 +408,17 @@ void RequestController::updateRequestTimeout(
 void RequestController::onTimer() {
   LOG4CXX_TRACE_ENTER(logger_);
   AutoLock auto_lock(pending_request_set_lock_);
-  RequestInfoSet::iterator probably_expired = pending_request_set_.begin();
-  while (pending_request_set_.end() != probably_expired) {
-    RequestInfoPtr request = *probably_expired;
-    if (request->timeout_sec() == 0) {
-      LOG4CXX_INFO(logger_, "Ignore " << request->requestId());
-      ++probably_expired;
-      // This request should not be observed for TIME_OUT
-      continue;
-    }
-    if (request->isExpired()) {
-      pending_request_set_.erase(probably_expired);
-      request->request()->onTimeOut();
-      request->request()->CleanUp();
-      LOG4CXX_INFO(logger_, "Timeout for request id " << request->requestId() << " expired");
-      probably_expired = pending_request_set_.begin();
-      break;
-    }
+  RequestInfoPtr probably_expired =
+      pending_request_set_.FrontWithNotNullTimeout();
+  while (probably_expired.valid() && probably_expired->isExpired()) {
+    // Request is removed before its handlers run, they may terminate
+    // other requests, so front is taken again after each of them
+    pending_request_set_.RemoveRequest(probably_expired);
+    probably_expired->request()->onTimeOut();
+    probably_expired->request()->CleanUp();
+    LOG4CXX_INFO(logger_, "Timeout for request id "
+                 << probably_expired->requestId() << " expired");
+    probably_expired = pending_request_set_.FrontWithNotNullTimeout();
   }
   UpdateTimer();
   LOG4CXX_TRACE_EXIT(logger_);
@@ -383,45 +439,100 @@ void RequestController::Worker::threadMain() {
     // Try to pick a request
     sync_primitives::AutoLock auto_lock(request_controller_->mobile_request_list_lock_);
 
+    bool retired = false;
     while ((request_controller_->pool_state_ != TPoolState::STOPPED) &&
-        (request_controller_->mobile_request_list_.empty())) {
+        (request_controller_->ready_lanes_.empty()) && !retired) {
       // Wait until there is a task in the queue
       // Unlock mutex while wait, then lock it back when signaled
       LOG4CXX_INFO(logger_, "Unlocking and waiting");
-      request_controller_->cond_var_.Wait(auto_lock);
+      ++request_controller_->idle_workers_;
+      const sync_primitives::ConditionalVariable::WaitStatus wait_status =
+          request_controller_->cond_var_.WaitFor(
+              auto_lock, request_controller_->idle_worker_timeout_);
+      --request_controller_->idle_workers_;
       LOG4CXX_INFO(logger_, "Signaled and locking");
+      if (sync_primitives::ConditionalVariable::kTimeout == wait_status &&
+          request_controller_->ready_lanes_.empty() &&
+          request_controller_->pool_state_ != TPoolState::STOPPED) {
+        retired = request_controller_->RetireWorker(this);
+      }
     }
 
-    // If the thread was shutdown, return from here
-    if (request_controller_->pool_state_ == TPoolState::STOPPED) {
+    // If the thread was shutdown or retired, return from here
+    if (request_controller_->pool_state_ == TPoolState::STOPPED || retired) {
       break;
     }
 
-    MobileRequestPtr request(request_controller_->mobile_request_list_.front());
-
-    request_controller_->mobile_request_list_.pop_front();
-    bool init_res = request->Init(); // to setup specific default timeout
-
-    uint32_t timeout_in_seconds = request->default_timeout()/date_time::DateTime::MILLISECONDS_IN_SECOND;
-    RequestInfoPtr request_info_ptr(new MobileRequestInfo(request,
-                                                          timeout_in_seconds));
+    // Lane stays busy until its request is executed, so next request
+    // of the same application is not taken by other worker
+    const uint32_t connection_key = request_controller_->ready_lanes_.front();
+    request_controller_->ready_lanes_.pop_front();
+    Lane& lane = request_controller_->mobile_request_lanes_[connection_key];
+    const QueuedRequest queued = lane.requests.front();
+    lane.requests.pop_front();
+    lane.busy = true;
+    --request_controller_->mobile_request_count_;
+    const int64_t wait_time =
+        date_time::DateTime::calculateTimeSpan(queued.enqueue_time);
+    LaneStatistics& statistics =
+        request_controller_->lanes_statistics_[connection_key];
+    ++statistics.executed;
+    statistics.total_wait_time += wait_time;
+    statistics.max_wait_time = std::max(statistics.max_wait_time, wait_time);
+    LOG4CXX_DEBUG(logger_, "Request of lane " << connection_key << " waited "
+                  << wait_time << " ms, lane depth " << lane.requests.size()
+                  << " max depth " << statistics.max_depth);
 
-    request_controller_->pending_request_set_lock_.Acquire();
-    request_controller_->pending_request_set_.insert(request_info_ptr);
-    if (0 != timeout_in_seconds) {
-      LOG4CXX_INFO(logger_, "Add Request " << request_info_ptr->requestId() <<
-                            " with timeout: " << timeout_in_seconds);
-      request_controller_->UpdateTimer();
-    } else {
-      LOG4CXX_INFO(logger_, "Default timeout was set to 0."
-                   "RequestController will not track timeout of this request.");
+    {
+      AutoUnlock unlock(auto_lock);
+      const MobileRequestPtr& request = queued.request;
+      bool init_res = request->Init(); // to setup specific default timeout
+
+      uint32_t timeout_in_seconds = request->default_timeout()/date_time::DateTime::MILLISECONDS_IN_SECOND;
+      RequestInfoPtr request_info_ptr(new MobileRequestInfo(request,
+                                                            timeout_in_seconds));
+
+      request_controller_->pending_request_set_lock_.Acquire();
+      if (!request_controller_->pending_request_set_.Add(request_info_ptr)) {
+        LOG4CXX_ERROR(logger_, "Request " << request_info_ptr->requestId() <<
+                      " of application " << request_info_ptr->app_id() <<
+                      " is already pending");
+      }
+      if (0 != timeout_in_seconds) {
+        LOG4CXX_INFO(logger_, "Add Request " << request_info_ptr->requestId() <<
+                              " with timeout: " << timeout_in_seconds);
+        request_controller_->UpdateTimer();
+      } else {
+        LOG4CXX_INFO(logger_, "Default timeout was set to 0."
+                     "RequestController will not track timeout of this request.");
+      }
+      request_controller_->pending_request_set_lock_.Release();
+
+      // execute
+      if (request->CheckPermissions() && init_res) {
+#ifdef TIME_TESTER
+        ApplicationManagerImpl::instance()->request_traces().Mark(
+            request->connection_key(), request->correlation_id(),
+            protocol_handler::MessageTrace::kCommandRun);
+#endif  // TIME_TESTER
+        request->Run();
+      }
+      LOG4CXX_DEBUG(logger_, "Request " << request_info_ptr->requestId()
+                    << " of lane " << connection_key << " executed "
+                    << date_time::DateTime::calculateTimeSpan(queued.enqueue_time)
+                    << " ms after it was queued");
     }
-    request_controller_->pending_request_set_lock_.Release();
-    AutoUnlock unlock(auto_lock);
 
-    // execute
-    if (request->CheckPermissions() && init_res) {
-      request->Run();
+    // Lane is released and scheduled again behind other ready lanes,
+    // so one application can't hold worker while others wait
+    Lane& released_lane =
+        request_controller_->mobile_request_lanes_[connection_key];
+    released_lane.busy = false;
+    if (released_lane.requests.empty()) {
+      request_controller_->mobile_request_lanes_.erase(connection_key);
+    } else {
+      request_controller_->ready_lanes_.push_back(connection_key);
+      request_controller_->cond_var_.NotifyOne();
     }
   }
 
@@ -449,7 +560,7 @@ bool RequestController::checkTimeScaleMaxRequest(
     TimeScale scale(start, end, app_id);
     uint32_t count = 0;
 
-    count = count_if (pending_request_set_.begin(), pending_request_set_.end(), scale);
+    count = pending_request_set_.CountAppRequests(app_id, scale);
     if (count == max_request_per_time_scale ) {
       LOG4CXX_ERROR(logger_, "Requests count " << count <<
                     " exceed application limit " << max_request_per_time_scale);
@@ -474,7 +585,7 @@ bool RequestController::checkHMILevelTimeScaleMaxRequest(
       HMILevelTimeScale scale(start, end, app_id, hmi_level);
       uint32_t count = 0;
 
-      count = count_if (pending_request_set_.begin(), pending_request_set_.end(), scale);
+      count = pending_request_set_.CountAppRequests(app_id, scale);
       if (count == max_request_per_time_scale ) {
         LOG4CXX_ERROR(logger_, "Requests count " << count
                       << " exceed application limit " << max_request_per_time_scale
@@ -488,19 +599,18 @@ bool RequestController::checkHMILevelTimeScaleMaxRequest(
 void RequestController::UpdateTimer() {
   LOG4CXX_TRACE_ENTER(logger_);
   uint32_t sleep_time = dafault_sleep_time_;
-  RequestInfoSet::iterator it = pending_request_set_.begin();
-
-  while (it != pending_request_set_.end()) {
-    RequestInfoPtr request = *it;
-    DCHECK(request.valid());
-    if (0 == request->timeout_sec()) {
-      ++it;
-      // This request should not be observed for TIME_OUT
-      continue;
+  RequestInfoPtr request = pending_request_set_.FrontWithNotNullTimeout();
+  if (request.valid()) {
+    const TimevalStruct current_time = date_time::DateTime::getCurrentTime();
+    // Timer counts whole seconds, so time left is rounded up
+    // not to wake up before request is expired
+    sleep_time = 0;
+    if (date_time::DateTime::Greater(request->end_time(), current_time)) {
+      sleep_time = request->end_time().tv_sec - current_time.tv_sec;
+      if (request->end_time().tv_usec > current_time.tv_usec) {
+        ++sleep_time;
+      }
     }
-    sleep_time = request->end_time().tv_sec -
-                           date_time::DateTime::getCurrentTime().tv_sec;
-    break;
   }
   timer_.updateTimeOut(sleep_time);
   LOG4CXX_INFO(logger_, "Sleep for: " << sleep_time);
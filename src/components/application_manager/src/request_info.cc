@@ -34,6 +34,9 @@
 */
 
 #include "application_manager/request_info.h"
+
+#include <utility>
+
 namespace application_manager {
 
 namespace request_controller {
@@ -41,7 +44,7 @@ namespace request_controller {
 HMIRequestInfo::HMIRequestInfo(
     RequestPtr request,
     const uint64_t timeout_sec):
-  RequestInfo(timeout_sec),
+  RequestInfo(timeout_sec, HMIRequest),
   request_(request) {
     correlation_id_ = request_->correlation_id();
 }
@@ -50,7 +53,7 @@ HMIRequestInfo::HMIRequestInfo(
     RequestPtr request,
     const TimevalStruct &start_time,
     const uint64_t timeout_sec):
-  RequestInfo(start_time, timeout_sec),
+  RequestInfo(start_time, timeout_sec, HMIRequest),
   request_(request) {
     correlation_id_ = request_->correlation_id();
 }
@@ -58,7 +61,7 @@ HMIRequestInfo::HMIRequestInfo(
 MobileRequestInfo::MobileRequestInfo(
     RequestPtr request,
     const uint64_t timeout_sec):
-  RequestInfo(timeout_sec),
+  RequestInfo(timeout_sec, MobileRequest),
   request_(request) {
     mobile_correlation_id_ = request_.get()->correlation_id();
     app_id_ = request_.get()->connection_key();
@@ -68,12 +71,117 @@ MobileRequestInfo::MobileRequestInfo(
     RequestPtr request,
     const TimevalStruct &start_time,
     const uint64_t timeout_sec):
-  RequestInfo(start_time, timeout_sec),
+  RequestInfo(start_time, timeout_sec, MobileRequest),
   request_(request) {
     mobile_correlation_id_ = request_.get()->correlation_id();
     app_id_ = request_.get()->connection_key();
 }
 
+bool RequestInfoSet::RequestId::operator<(const RequestId& other) const {
+  if (request_type != other.request_type) {
+    return request_type < other.request_type;
+  }
+  if (app_id != other.app_id) {
+    return app_id < other.app_id;
+  }
+  return correlation_id < other.correlation_id;
+}
+
+RequestInfoSet::RequestId RequestInfoSet::IdOf(
+    const RequestInfoPtr& request_info) {
+  return RequestId(request_info->request_type(), request_info->app_id(),
+                   request_info->requestId());
+}
+
+bool RequestInfoSet::Add(RequestInfoPtr request_info) {
+  DCHECK(request_info.valid());
+  const bool inserted = requests_by_id_.insert(
+      std::make_pair(IdOf(request_info), request_info)).second;
+  if (inserted && 0 != request_info->timeout_sec()) {
+    requests_by_end_time_.insert(request_info);
+  }
+  return inserted;
+}
+
+RequestInfoPtr RequestInfoSet::Find(RequestInfo::RequestType request_type,
+                                    uint32_t app_id,
+                                    uint32_t correlation_id) const {
+  RequestsById::const_iterator it =
+      requests_by_id_.find(RequestId(request_type, app_id, correlation_id));
+  if (requests_by_id_.end() == it) {
+    return RequestInfoPtr();
+  }
+  return it->second;
+}
+
+RequestInfoPtr RequestInfoSet::FrontWithNotNullTimeout() const {
+  if (requests_by_end_time_.empty()) {
+    return RequestInfoPtr();
+  }
+  return *requests_by_end_time_.begin();
+}
+
+void RequestInfoSet::Erase(RequestsById::iterator it) {
+  requests_by_end_time_.erase(it->second);
+  requests_by_id_.erase(it);
+}
+
+bool RequestInfoSet::RemoveRequest(const RequestInfoPtr& request_info) {
+  RequestsById::iterator it = requests_by_id_.find(IdOf(request_info));
+  if (requests_by_id_.end() == it || it->second.get() != request_info.get()) {
+    return false;
+  }
+  Erase(it);
+  return true;
+}
+
+std::vector<RequestInfoPtr> RequestInfoSet::RemoveByConnectionKey(
+    uint32_t app_id) {
+  std::vector<RequestInfoPtr> removed;
+  RequestsById::iterator it = requests_by_id_.lower_bound(
+      RequestId(RequestInfo::MobileRequest, app_id, 0));
+  while (requests_by_id_.end() != it &&
+         RequestInfo::MobileRequest == it->first.request_type &&
+         app_id == it->first.app_id) {
+    removed.push_back(it->second);
+    Erase(it++);
+  }
+  return removed;
+}
+
+std::vector<RequestInfoPtr> RequestInfoSet::RemoveByType(
+    RequestInfo::RequestType request_type) {
+  std::vector<RequestInfoPtr> removed;
+  RequestsById::iterator it = requests_by_id_.lower_bound(
+      RequestId(request_type, 0, 0));
+  while (requests_by_id_.end() != it &&
+         request_type == it->first.request_type) {
+    removed.push_back(it->second);
+    Erase(it++);
+  }
+  return removed;
+}
+
+void RequestInfoSet::UpdateTimeOut(const RequestInfoPtr& request_info,
+                                   uint64_t timeout_sec) {
+  // Position in timeout order depends on end time, so request
+  // has to be reinserted
+  requests_by_end_time_.erase(request_info);
+  request_info->updateTimeOut(timeout_sec);
+  if (0 != timeout_sec) {
+    requests_by_end_time_.insert(request_info);
+  }
+}
+
+size_t RequestInfoSet::Size() const {
+  return requests_by_id_.size();
+}
+
+void RequestInfoSet::Clear() {
+  requests_by_end_time_.clear();
+  requests_by_id_.clear();
+}
+
 } // namespace request_controller
 
 } // namespace application_manager
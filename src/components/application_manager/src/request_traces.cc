@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/request_traces.h"
+
+namespace application_manager {
+
+using protocol_handler::MessageTrace;
+using protocol_handler::MessageTracePtr;
+
+RequestTraces::RequestTraces() {
+}
+
+void RequestTraces::Start(uint32_t connection_key, uint32_t correlation_id,
+                          const MessageTracePtr& trace) {
+  if (!trace) {
+    return;
+  }
+  sync_primitives::AutoLock lock(lock_);
+  traces_[RequestId(connection_key, correlation_id)] = trace;
+}
+
+void RequestTraces::Mark(uint32_t connection_key, uint32_t correlation_id,
+                         MessageTrace::Stage stage) {
+  sync_primitives::AutoLock lock(lock_);
+  Traces::iterator it = traces_.find(RequestId(connection_key,
+                                               correlation_id));
+  if (traces_.end() != it) {
+    it->second->Mark(stage);
+  }
+}
+
+void RequestTraces::OnHmiRequest(uint32_t hmi_correlation_id,
+                                 uint32_t connection_key,
+                                 uint32_t correlation_id) {
+  sync_primitives::AutoLock lock(lock_);
+  const RequestId request(connection_key, correlation_id);
+  Traces::iterator it = traces_.find(request);
+  if (traces_.end() == it) {
+    return;
+  }
+  if (!it->second->IsMarked(MessageTrace::kHmiRequestSent)) {
+    it->second->Mark(MessageTrace::kHmiRequestSent);
+  }
+  hmi_requests_[hmi_correlation_id] = request;
+}
+
+void RequestTraces::OnHmiResponse(uint32_t hmi_correlation_id) {
+  sync_primitives::AutoLock lock(lock_);
+  HmiRequests::iterator hmi_it = hmi_requests_.find(hmi_correlation_id);
+  if (hmi_requests_.end() == hmi_it) {
+    return;
+  }
+  Traces::iterator it = traces_.find(hmi_it->second);
+  if (traces_.end() != it) {
+    // Last response of request which asked several HMI interfaces is marked
+    it->second->Mark(MessageTrace::kHmiResponseReceived);
+  }
+  hmi_requests_.erase(hmi_it);
+}
+
+MessageTracePtr RequestTraces::Finish(uint32_t connection_key,
+                                      uint32_t correlation_id) {
+  sync_primitives::AutoLock lock(lock_);
+  const RequestId request(connection_key, correlation_id);
+  Traces::iterator it = traces_.find(request);
+  if (traces_.end() == it) {
+    return MessageTracePtr();
+  }
+  const MessageTracePtr trace = it->second;
+  traces_.erase(it);
+  ForgetHmiRequests(request);
+  return trace;
+}
+
+void RequestTraces::Forget(uint32_t connection_key) {
+  sync_primitives::AutoLock lock(lock_);
+  Traces::iterator it = traces_.lower_bound(RequestId(connection_key, 0));
+  while (traces_.end() != it && connection_key == it->first.first) {
+    ForgetHmiRequests(it->first);
+    traces_.erase(it++);
+  }
+}
+
+size_t RequestTraces::size() const {
+  sync_primitives::AutoLock lock(lock_);
+  return traces_.size();
+}
+
+void RequestTraces::ForgetHmiRequests(const RequestId& request) {
+  HmiRequests::iterator it = hmi_requests_.begin();
+  while (hmi_requests_.end() != it) {
+    if (request == it->second) {
+      hmi_requests_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace application_manager
@@ -30,10 +30,10 @@ void ResumeCtrl::SaveAllApplications() {
   LOG4CXX_INFO(logger_, "ResumeCtrl::SaveApplications()");
   DCHECK(app_mngr_);
 
-  std::set<ApplicationSharedPtr>::iterator it =
-                  app_mngr_->application_list_.begin();
-  std::set<ApplicationSharedPtr>::iterator it_end =
-                   app_mngr_->application_list_.end();
+  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  const std::set<ApplicationSharedPtr>& applications = accessor.applications();
+  std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
+  std::set<ApplicationSharedPtr>::const_iterator it_end = applications.end();
   for (; it != it_end; ++it) {
     SaveApplication(*it);
   }
@@ -212,7 +212,7 @@ bool ResumeCtrl::SetupHMILevel(ApplicationSharedPtr application,
         //AudioStreamingState=AUDIBLE
         bool application_exist_with_audible_state = false;
         ApplicationManagerImpl::ApplicationListAccessor accessor;
-        const std::set<ApplicationSharedPtr> app_list = accessor.applications();
+        const std::set<ApplicationSharedPtr>& app_list = accessor.applications();
         std::set<ApplicationSharedPtr>::const_iterator app_list_it = app_list
             .begin();
         uint32_t app_id = application->app_id();
@@ -423,7 +423,8 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
          json_it != subscribtions_buttons.end(); ++json_it) {
       mobile_apis::ButtonName::eType btn;
       btn = static_cast<mobile_apis::ButtonName::eType>((*json_it).asInt());
-      application->SubscribeToButton(btn);
+      ApplicationManagerImpl::instance()->SubscribeAppToButton(application,
+                                                               btn);
     }
 
     for (Json::Value::iterator json_it = subscribtions_ivi.begin();
@@ -434,7 +435,7 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
 #ifdef ENABLE_LOG
       bool result =
 #endif
-      application->SubscribeToIVI(ivi);
+      ApplicationManagerImpl::instance()->SubscribeAppToIVI(application, ivi);
       LOG4CXX_INFO(logger_, "result = :" <<  result);
     }
     requests = MessageHelper::GetIVISubscribtionRequests(application->app_id());
@@ -457,10 +458,10 @@ bool ResumeCtrl::IsHMIApplicationIdExist(uint32_t hmi_app_id) {
     }
   }
 
-  std::set<ApplicationSharedPtr>::iterator it =
-                                  app_mngr_->application_list_.begin();
-  std::set<ApplicationSharedPtr>::iterator it_end =
-                                   app_mngr_->application_list_.end();
+  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  const std::set<ApplicationSharedPtr>& applications = accessor.applications();
+  std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
+  std::set<ApplicationSharedPtr>::const_iterator it_end = applications.end();
   for (;it != it_end; ++it) {
     if (hmi_app_id == (*it)->hmi_app_id()) {
       return true;
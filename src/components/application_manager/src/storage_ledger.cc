@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/storage_ledger.h"
+
+#include <vector>
+
+#include "utils/file_system.h"
+#include "utils/logger.h"
+
+namespace application_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "StorageLedger");
+
+StorageLedger::StorageLedger(time_t reconcile_period)
+  : reconcile_period_(reconcile_period),
+    reconcile_timer_("StorageLedger", this, &StorageLedger::OnReconcileTimer,
+                     true) {
+}
+
+StorageLedger::~StorageLedger() {
+  reconcile_timer_.stop();
+}
+
+void StorageLedger::Seed(const std::string& storage_folder) {
+  const std::vector<std::string> folders =
+      file_system::ListFiles(storage_folder);
+  for (std::vector<std::string>::const_iterator it = folders.begin();
+       folders.end() != it; ++it) {
+    const std::string app_folder = storage_folder + "/" + *it;
+    if (file_system::IsDirectory(app_folder)) {
+      Reconcile(app_folder, false);
+    }
+  }
+  LOG4CXX_INFO(logger_, "Storage " << storage_folder << " has "
+               << entries_.size() << " application folders");
+  if (reconcile_period_ > 0) {
+    reconcile_timer_.start(reconcile_period_);
+  }
+}
+
+uint64_t StorageLedger::UsedSpace(const std::string& app_folder) {
+  {
+    sync_primitives::AutoLock auto_lock(entries_lock_);
+    Entries::const_iterator it = entries_.find(app_folder);
+    if (entries_.end() != it) {
+      return it->second;
+    }
+  }
+  return Reconcile(app_folder, false);
+}
+
+void StorageLedger::Update(const std::string& app_folder,
+                           int64_t previous_size, int64_t size) {
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  Entries::iterator it = entries_.find(app_folder);
+  if (entries_.end() == it) {
+    // Folder will be walked on next request
+    return;
+  }
+  uint64_t& used = it->second;
+  if (size >= previous_size) {
+    used += size - previous_size;
+  } else {
+    const uint64_t freed = previous_size - size;
+    used = used > freed ? used - freed : 0;
+  }
+}
+
+void StorageLedger::Forget(const std::string& app_folder) {
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  entries_.erase(app_folder);
+}
+
+uint64_t StorageLedger::Reconcile(const std::string& app_folder,
+                                  bool known_only) {
+  // Folder is walked without lock, changes made meanwhile are
+  // overwritten and picked up by next reconciliation
+  const uint64_t used = file_system::DirectoryExists(app_folder) ?
+                        file_system::DirectorySize(app_folder) : 0;
+  LOG4CXX_INFO(logger_, "Folder " << app_folder << " uses " << used);
+
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  if (known_only && entries_.end() == entries_.find(app_folder)) {
+    return used;
+  }
+  entries_[app_folder] = used;
+  return used;
+}
+
+void StorageLedger::OnReconcileTimer() {
+  std::vector<std::string> folders;
+  {
+    sync_primitives::AutoLock auto_lock(entries_lock_);
+    folders.reserve(entries_.size());
+    for (Entries::const_iterator it = entries_.begin();
+         entries_.end() != it; ++it) {
+      folders.push_back(it->first);
+    }
+  }
+  for (std::vector<std::string>::const_iterator it = folders.begin();
+       folders.end() != it; ++it) {
+    Reconcile(*it, true);
+  }
+}
+
+}  // namespace application_manager
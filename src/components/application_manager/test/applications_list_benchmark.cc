@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/utils/benchmark_helpers.h"
+#include "utils/atomic.h"
+#include "utils/lock.h"
+#include "utils/shared_ptr.h"
+#include "utils/snapshot_holder.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace applications_list_benchmark {
+
+/**
+ * @brief Default number of reader threads and duration of each run.
+ * Can be overridden with SDL_BENCHMARK_READERS and
+ * SDL_BENCHMARK_MILLISECONDS environment variables.
+ */
+const size_t kDefaultReaders = 8;
+const size_t kDefaultMilliseconds = 500;
+
+/**
+ * @brief Applications registered before run and period of churn:
+ * every period one application is registered and oldest one is
+ * unregistered.
+ */
+const uint32_t kRegisteredApps = 16;
+const useconds_t kChurnPeriodUs = 1000;
+
+/**
+ * @brief Every kBroadcastEvery-th read iterates all applications like
+ * broadcast notifications do, other reads look up single application.
+ */
+const uint32_t kBroadcastEvery = 16;
+
+struct FakeApplication {
+  explicit FakeApplication(uint32_t id)
+    : app_id(id) {
+  }
+  uint32_t app_id;
+};
+
+typedef utils::SharedPtr<FakeApplication> FakeApplicationSharedPtr;
+
+struct ApplicationsList {
+  std::set<FakeApplicationSharedPtr> applications;
+  std::map<uint32_t, FakeApplicationSharedPtr> by_app_id;
+
+  void Add(uint32_t app_id) {
+    FakeApplicationSharedPtr app(new FakeApplication(app_id));
+    applications.insert(app);
+    by_app_id[app_id] = app;
+  }
+
+  void Remove(uint32_t app_id) {
+    std::map<uint32_t, FakeApplicationSharedPtr>::iterator it =
+        by_app_id.find(app_id);
+    if (by_app_id.end() != it) {
+      applications.erase(it->second);
+      by_app_id.erase(it);
+    }
+  }
+
+  bool IsConsistent() const {
+    return applications.size() == by_app_id.size();
+  }
+};
+
+/**
+ * @brief Former way of access: lock is held during whole read and
+ * broadcast readers copy list, like ApplicationListAccessor did.
+ */
+class LockedApplicationsList {
+ public:
+  LockedApplicationsList()
+    : lock_(true) {
+  }
+
+  bool Lookup(uint32_t app_id) const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return list_.by_app_id.end() != list_.by_app_id.find(app_id);
+  }
+
+  bool Broadcast(uint32_t* visited) const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    const std::set<FakeApplicationSharedPtr> applications = list_.applications;
+    *visited += applications.size();
+    return list_.IsConsistent();
+  }
+
+  void Register(uint32_t app_id) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    list_.Add(app_id);
+  }
+
+  void Unregister(uint32_t app_id) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    list_.Remove(app_id);
+  }
+
+ private:
+  ApplicationsList list_;
+  mutable sync_primitives::Lock lock_;
+};
+
+/**
+ * @brief Snapshot access used by ApplicationManagerImpl now.
+ */
+class SnapshotApplicationsList {
+ public:
+  bool Lookup(uint32_t app_id) const {
+    const Snapshot snapshot = holder_.Get();
+    return snapshot->by_app_id.end() != snapshot->by_app_id.find(app_id);
+  }
+
+  bool Broadcast(uint32_t* visited) const {
+    const Snapshot snapshot = holder_.Get();
+    *visited += snapshot->applications.size();
+    return snapshot->IsConsistent();
+  }
+
+  void Register(uint32_t app_id) {
+    sync_primitives::AutoLock auto_lock(writers_lock_);
+    utils::SharedPtr<ApplicationsList> copy = holder_.Copy();
+    copy->Add(app_id);
+    holder_.Publish(copy);
+  }
+
+  void Unregister(uint32_t app_id) {
+    sync_primitives::AutoLock auto_lock(writers_lock_);
+    utils::SharedPtr<ApplicationsList> copy = holder_.Copy();
+    copy->Remove(app_id);
+    holder_.Publish(copy);
+  }
+
+ private:
+  typedef utils::SnapshotHolder<ApplicationsList>::Snapshot Snapshot;
+  utils::SnapshotHolder<ApplicationsList> holder_;
+  sync_primitives::Lock writers_lock_;
+};
+
+using ::test::benchmark::EnvironmentValue;
+using ::test::benchmark::Now;
+
+struct RunResult {
+  RunResult()
+    : reads(0),
+      writes(0),
+      consistent(true) {
+  }
+  uint64_t reads;
+  uint64_t writes;
+  bool consistent;
+};
+
+template<typename List>
+class ContentionRun {
+ public:
+  ContentionRun(size_t readers, size_t milliseconds)
+    : readers_(readers),
+      milliseconds_(milliseconds),
+      stop_(0),
+      next_app_id_(1) {
+  }
+
+  RunResult Run() {
+    for (uint32_t i = 0; i < kRegisteredApps; ++i) {
+      list_.Register(next_app_id_++);
+    }
+
+    std::vector<pthread_t> threads(readers_);
+    std::vector<ReaderContext> contexts(readers_);
+    for (size_t i = 0; i < readers_; ++i) {
+      contexts[i].run = this;
+      contexts[i].seed = static_cast<uint32_t>(i + 1);
+      pthread_create(&threads[i], NULL, &ContentionRun::Reader, &contexts[i]);
+    }
+    pthread_t writer;
+    pthread_create(&writer, NULL, &ContentionRun::Writer, this);
+
+    usleep(milliseconds_ * 1000);
+    atomic_post_set(&stop_);
+
+    pthread_join(writer, NULL);
+    RunResult result;
+    result.writes = writes_;
+    for (size_t i = 0; i < readers_; ++i) {
+      pthread_join(threads[i], NULL);
+      result.reads += contexts[i].reads;
+      result.consistent = result.consistent && contexts[i].consistent;
+    }
+    return result;
+  }
+
+ private:
+  struct ReaderContext {
+    ReaderContext()
+      : run(NULL),
+        seed(0),
+        reads(0),
+        visited(0),
+        consistent(true) {
+    }
+    ContentionRun* run;
+    uint32_t seed;
+    uint64_t reads;
+    uint32_t visited;
+    bool consistent;
+  };
+
+  static void* Reader(void* data) {
+    ReaderContext* context = static_cast<ReaderContext*>(data);
+    ContentionRun* run = context->run;
+    while (!run->stop_) {
+      context->seed = context->seed * 1103515245 + 12345;
+      if (0 == context->reads % kBroadcastEvery) {
+        context->consistent = run->list_.Broadcast(&context->visited) &&
+                              context->consistent;
+      } else {
+        run->list_.Lookup(context->seed % (run->next_app_id_ + 1));
+      }
+      ++context->reads;
+    }
+    return NULL;
+  }
+
+  static void* Writer(void* data) {
+    ContentionRun* run = static_cast<ContentionRun*>(data);
+    uint32_t oldest = 1;
+    run->writes_ = 0;
+    while (!run->stop_) {
+      run->list_.Register(run->next_app_id_++);
+      run->list_.Unregister(oldest++);
+      run->writes_ += 2;
+      usleep(kChurnPeriodUs);
+    }
+    return NULL;
+  }
+
+  List list_;
+  const size_t readers_;
+  const size_t milliseconds_;
+  volatile unsigned int stop_;
+  volatile uint32_t next_app_id_;
+  uint64_t writes_;
+};
+
+template<typename List>
+RunResult RunAndReport(const char* name) {
+  const size_t readers = EnvironmentValue("SDL_BENCHMARK_READERS",
+                                          kDefaultReaders);
+  const size_t milliseconds = EnvironmentValue("SDL_BENCHMARK_MILLISECONDS",
+                                               kDefaultMilliseconds);
+  ContentionRun<List> run(readers, milliseconds);
+  const double start = Now();
+  const RunResult result = run.Run();
+  const double elapsed = Now() - start;
+  printf("%-10s readers %3zu  reads/s %12.0f  writes/s %8.0f\n", name,
+         readers, result.reads / elapsed, result.writes / elapsed);
+  return result;
+}
+
+TEST(ApplicationsListBenchmark, ReadersWithRegistrationChurn) {
+  const RunResult locked = RunAndReport<LockedApplicationsList>("locked");
+  const RunResult snapshot = RunAndReport<SnapshotApplicationsList>("snapshot");
+
+  EXPECT_LT(0u, locked.reads);
+  EXPECT_LT(0u, locked.writes);
+  EXPECT_TRUE(locked.consistent);
+  EXPECT_LT(0u, snapshot.reads);
+  EXPECT_LT(0u, snapshot.writes);
+  EXPECT_TRUE(snapshot.consistent);
+}
+
+TEST(ApplicationsListBenchmark, PublishedSnapshotIsNotChanged) {
+  utils::SnapshotHolder<ApplicationsList> holder;
+  const utils::SnapshotHolder<ApplicationsList>::Snapshot before = holder.Get();
+
+  utils::SharedPtr<ApplicationsList> copy = holder.Copy();
+  copy->Add(1);
+  holder.Publish(copy);
+
+  EXPECT_TRUE(before->applications.empty());
+  EXPECT_EQ(1u, holder.Get()->applications.size());
+  EXPECT_EQ(1u, holder.Get()->by_app_id.count(1));
+}
+
+}  // namespace applications_list_benchmark
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
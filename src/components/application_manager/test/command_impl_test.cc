@@ -2,6 +2,8 @@
 #include "gmock/gmock.h"
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/commands/command_request_impl.h"
+#include "application_manager/commands/mobile/put_file_request.h"
+#include "application_manager/message.h"
 #include "application_manager/message_helper.h"
 #include "application_manager/smart_object_keys.h"
 #include "interfaces/MOBILE_API.h"
@@ -43,3 +45,25 @@ TEST(MobileCommandsTest, CommandImplTimeOut) {
   request.onTimeOut();
   application_manager::ApplicationManagerImpl::destroy();
 }
+
+TEST(MobileCommandsTest, PutFileRejectedBeforeRunReleasesChunk) {
+  const uint32_t kConnectionKey = 1;
+  const uint32_t kCorrelationId = 5;
+  application_manager::ApplicationManagerImpl* am = application_manager::ApplicationManagerImpl::instance();
+  application_manager::MessageSharedPtr so(
+      new smart_objects::SmartObject(smart_objects::SmartType_Map));
+  (*so)[application_manager::strings::params]
+       [application_manager::strings::connection_key] = kConnectionKey;
+  (*so)[application_manager::strings::params]
+       [application_manager::strings::correlation_id] = kCorrelationId;
+  utils::SharedPtr<application_manager::Message> chunk(
+      new application_manager::Message(
+          protocol_handler::MessagePriority::kDefault));
+  EXPECT_CALL((*am), TakeFileChunk(kConnectionKey, kCorrelationId))
+      .WillOnce(Return(chunk));
+  {
+    // Request rejected by limits is deleted without Run
+    application_manager::commands::PutFileRequest request(so);
+  }
+  application_manager::ApplicationManagerImpl::destroy();
+}
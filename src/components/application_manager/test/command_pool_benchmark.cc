@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/utils/benchmark_helpers.h"
+#include "utils/free_list_pool.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace command_pool_benchmark {
+
+/**
+ * @brief Default amount of created commands per thread. Can be overridden
+ * with SDL_BENCHMARK_ITERATIONS environment variable.
+ */
+const size_t kDefaultIterations = 200000;
+const size_t kThreads = 4;
+
+/**
+ * @brief Commands alive at the same time per thread: requests waiting for
+ * responses keep their command objects.
+ */
+const size_t kOutstandingCommands = 64;
+
+// Same limits as CommandImpl pool
+const size_t kMaxPooledCommandSize = 1024;
+const size_t kMaxFreeCommandsPerSize = 64;
+
+utils::FreeListPool& pool() {
+  static utils::FreeListPool* pool =
+      new utils::FreeListPool(kMaxPooledCommandSize, kMaxFreeCommandsPerSize);
+  return *pool;
+}
+
+class HeapCommand {
+ public:
+  virtual ~HeapCommand() {
+  }
+  virtual uint32_t Run() const = 0;
+};
+
+/**
+ * @brief Command allocated like CommandImpl does
+ */
+class PooledCommand {
+ public:
+  virtual ~PooledCommand() {
+  }
+  virtual uint32_t Run() const = 0;
+
+  static void* operator new(size_t size) {
+    return pool().Allocate(size);
+  }
+
+  static void operator delete(void* command, size_t size) {
+    pool().Deallocate(command, size);
+  }
+};
+
+/**
+ * @brief Commands of different types have different sizes
+ */
+template<typename Base, size_t kPayload>
+class FakeCommand : public Base {
+ public:
+  explicit FakeCommand(uint32_t id) {
+    payload_[0] = static_cast<char>(id);
+  }
+
+  virtual uint32_t Run() const {
+    return static_cast<unsigned char>(payload_[0]);
+  }
+
+ private:
+  char payload_[kPayload];
+};
+
+template<typename Base>
+Base* CreateCommand(uint32_t id) {
+  switch (id % 4) {
+    case 0:
+      return new FakeCommand<Base, 48>(id);
+    case 1:
+      return new FakeCommand<Base, 96>(id);
+    case 2:
+      return new FakeCommand<Base, 200>(id);
+    default:
+      return new FakeCommand<Base, 400>(id);
+  }
+}
+
+using ::test::benchmark::EnvironmentValue;
+using ::test::benchmark::Now;
+
+size_t Iterations() {
+  return EnvironmentValue("SDL_BENCHMARK_ITERATIONS", kDefaultIterations);
+}
+
+template<typename Base>
+void* CreateAndDestroy(void* data) {
+  const size_t iterations = *static_cast<size_t*>(data);
+  std::vector<Base*> outstanding(kOutstandingCommands, NULL);
+  uint32_t checksum = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    Base*& slot = outstanding[i % kOutstandingCommands];
+    delete slot;
+    slot = CreateCommand<Base>(static_cast<uint32_t>(i));
+    checksum += slot->Run();
+  }
+  for (size_t i = 0; i < kOutstandingCommands; ++i) {
+    delete outstanding[i];
+  }
+  return reinterpret_cast<void*>(checksum);
+}
+
+template<typename Base>
+double RunAndReport(const char* name) {
+  size_t iterations = Iterations();
+  std::vector<pthread_t> threads(kThreads);
+  const double start = Now();
+  for (size_t i = 0; i < kThreads; ++i) {
+    pthread_create(&threads[i], NULL, &CreateAndDestroy<Base>, &iterations);
+  }
+  for (size_t i = 0; i < kThreads; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+  const double elapsed = Now() - start;
+  const double ns_per_command = elapsed * 1e9 / (iterations * kThreads);
+  printf("%-7s threads %zu  commands %8zu  ns per command %8.1f\n", name,
+         kThreads, iterations * kThreads, ns_per_command);
+  return ns_per_command;
+}
+
+TEST(CommandPoolBenchmark, CreateAndDestroyCommands) {
+  RunAndReport<HeapCommand>("heap");
+  RunAndReport<PooledCommand>("pooled");
+
+  const utils::FreeListPool::Statistics statistics = pool().statistics();
+  printf("pool allocations %llu reused %llu heap allocations %llu "
+         "heap releases %llu\n",
+         static_cast<unsigned long long>(statistics.allocations),
+         static_cast<unsigned long long>(statistics.reused),
+         static_cast<unsigned long long>(statistics.heap_allocations),
+         static_cast<unsigned long long>(statistics.heap_releases));
+  EXPECT_EQ(0u, statistics.live);
+  EXPECT_EQ(statistics.allocations,
+            statistics.reused + statistics.heap_allocations);
+  EXPECT_LT(statistics.heap_allocations, statistics.reused);
+}
+
+}  // namespace command_pool_benchmark
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "application_manager/policies/compiled_permissions.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace compiled_permissions_test {
+
+using ::policy::CompiledPermissions;
+using ::policy::PermissionsGenerations;
+namespace FunctionID = mobile_apis::FunctionID;
+namespace HMILevel = mobile_apis::HMILevel;
+namespace VehicleDataType = mobile_apis::VehicleDataType;
+
+const uint32_t kGeneration = 3;
+
+CompiledPermissions::RpcPermissions Allowed() {
+  CompiledPermissions::RpcPermissions permissions;
+  permissions.hmi_level_permitted = policy::kRpcAllowed;
+  return permissions;
+}
+
+TEST(CompiledPermissionsTest, RpcIsFoundOnlyAfterItIsStored) {
+  CompiledPermissions permissions(kGeneration);
+  EXPECT_EQ(kGeneration, permissions.generation());
+  EXPECT_TRUE(NULL == permissions.Find(FunctionID::ShowID,
+                                       HMILevel::HMI_FULL));
+
+  EXPECT_TRUE(permissions.Set(FunctionID::ShowID, HMILevel::HMI_FULL,
+                              Allowed()));
+  const CompiledPermissions::RpcPermissions* found =
+    permissions.Find(FunctionID::ShowID, HMILevel::HMI_FULL);
+  ASSERT_TRUE(NULL != found);
+  EXPECT_EQ(policy::kRpcAllowed, found->hmi_level_permitted);
+  EXPECT_TRUE(NULL == permissions.Find(FunctionID::ShowID,
+                                       HMILevel::HMI_NONE));
+}
+
+TEST(CompiledPermissionsTest, RequestsAndNotificationsDontOverlap) {
+  CompiledPermissions permissions(kGeneration);
+  CompiledPermissions::RpcPermissions disallowed;
+  disallowed.hmi_level_permitted = policy::kRpcUserDisallowed;
+  ASSERT_TRUE(permissions.Set(FunctionID::RegisterAppInterfaceID,
+                              HMILevel::HMI_NONE, Allowed()));
+  ASSERT_TRUE(permissions.Set(FunctionID::OnHMIStatusID,
+                              HMILevel::HMI_NONE, disallowed));
+
+  EXPECT_EQ(policy::kRpcAllowed,
+            permissions.Find(FunctionID::RegisterAppInterfaceID,
+                             HMILevel::HMI_NONE)->hmi_level_permitted);
+  EXPECT_EQ(policy::kRpcUserDisallowed,
+            permissions.Find(FunctionID::OnHMIStatusID,
+                             HMILevel::HMI_NONE)->hmi_level_permitted);
+}
+
+TEST(CompiledPermissionsTest, FunctionsOutOfTableAreNotStored) {
+  CompiledPermissions permissions(kGeneration);
+  EXPECT_TRUE(CompiledPermissions::Contains(FunctionID::SendLocationID));
+  EXPECT_TRUE(CompiledPermissions::Contains(FunctionID::OnHashChangeID));
+  EXPECT_FALSE(CompiledPermissions::Contains(FunctionID::INVALID_ENUM));
+
+  const FunctionID::eType out_of_table = static_cast<FunctionID::eType>(
+    FunctionID::OnHMIStatusID + CompiledPermissions::kNotificationsCount);
+  EXPECT_FALSE(CompiledPermissions::Contains(out_of_table));
+  EXPECT_FALSE(permissions.Set(out_of_table, HMILevel::HMI_FULL, Allowed()));
+  EXPECT_TRUE(NULL == permissions.Find(out_of_table, HMILevel::HMI_FULL));
+
+  EXPECT_FALSE(permissions.Set(FunctionID::ShowID, HMILevel::INVALID_ENUM,
+                               Allowed()));
+  EXPECT_TRUE(NULL == permissions.Find(FunctionID::ShowID,
+                                       HMILevel::INVALID_ENUM));
+}
+
+TEST(CompiledPermissionsTest, ParametersAreKeptPerRpcAndLevel) {
+  CompiledPermissions permissions(kGeneration);
+  CompiledPermissions::RpcPermissions background = Allowed();
+  background.allowed_params.set(VehicleDataType::VEHICLEDATA_GPS);
+  background.disallowed_params.set(VehicleDataType::VEHICLEDATA_SPEED);
+  CompiledPermissions::RpcPermissions full = background;
+  full.allowed_params.set(VehicleDataType::VEHICLEDATA_SPEED);
+  full.disallowed_params.reset();
+  ASSERT_TRUE(permissions.Set(FunctionID::GetVehicleDataID,
+                              HMILevel::HMI_BACKGROUND, background));
+  ASSERT_TRUE(permissions.Set(FunctionID::GetVehicleDataID,
+                              HMILevel::HMI_FULL, full));
+
+  const CompiledPermissions::RpcPermissions* found =
+    permissions.Find(FunctionID::GetVehicleDataID, HMILevel::HMI_BACKGROUND);
+  ASSERT_TRUE(NULL != found);
+  EXPECT_TRUE(found->allowed_params.test(VehicleDataType::VEHICLEDATA_GPS));
+  EXPECT_FALSE(found->allowed_params.test(VehicleDataType::VEHICLEDATA_SPEED));
+  EXPECT_TRUE(found->disallowed_params.test(
+                VehicleDataType::VEHICLEDATA_SPEED));
+  EXPECT_TRUE(found->undefined_params.none());
+
+  found = permissions.Find(FunctionID::GetVehicleDataID, HMILevel::HMI_FULL);
+  ASSERT_TRUE(NULL != found);
+  EXPECT_EQ(2u, found->allowed_params.count());
+  EXPECT_TRUE(found->disallowed_params.none());
+}
+
+TEST(PermissionsGenerationsTest, CompiledPermissionsAreActualUntilChange) {
+  const uint32_t kAppId = 65537;
+  PermissionsGenerations generations;
+  CompiledPermissions permissions(generations.Current());
+  ASSERT_TRUE(permissions.Set(FunctionID::ShowID, HMILevel::HMI_FULL,
+                              Allowed()));
+  EXPECT_TRUE(generations.IsActual(kAppId, permissions));
+
+  generations.OnAppChanged(kAppId);
+  EXPECT_FALSE(generations.IsActual(kAppId, permissions));
+
+  CompiledPermissions recompiled(generations.Current());
+  EXPECT_TRUE(generations.IsActual(kAppId, recompiled));
+}
+
+TEST(PermissionsGenerationsTest, ChangeOfAppOutdatesOnlyItsPermissions) {
+  const uint32_t kAppId = 65537;
+  const uint32_t kOtherAppId = 65538;
+  PermissionsGenerations generations;
+  CompiledPermissions app_permissions(generations.Current());
+  CompiledPermissions other_permissions(generations.Current());
+
+  generations.OnAppChanged(kAppId);
+  EXPECT_FALSE(generations.IsActual(kAppId, app_permissions));
+  EXPECT_TRUE(generations.IsActual(kOtherAppId, other_permissions));
+}
+
+TEST(PermissionsGenerationsTest, ChangeOfPolicyOutdatesAllPermissions) {
+  const uint32_t kAppId = 65537;
+  const uint32_t kOtherAppId = 65538;
+  PermissionsGenerations generations;
+  generations.OnAppChanged(kAppId);
+  CompiledPermissions app_permissions(generations.Current());
+  CompiledPermissions other_permissions(generations.Current());
+
+  generations.OnPolicyChanged();
+  EXPECT_FALSE(generations.IsActual(kAppId, app_permissions));
+  EXPECT_FALSE(generations.IsActual(kOtherAppId, other_permissions));
+
+  CompiledPermissions recompiled(generations.Current());
+  EXPECT_TRUE(generations.IsActual(kAppId, recompiled));
+  EXPECT_TRUE(generations.IsActual(kOtherAppId, recompiled));
+}
+
+TEST(PermissionsGenerationsTest, PermissionsCompiledDuringChangeAreOutdated) {
+  const uint32_t kAppId = 65537;
+  PermissionsGenerations generations;
+  // Compilation starts, then policy of application changes before
+  // compiled table is published
+  const uint32_t generation = generations.Current();
+  generations.OnAppChanged(kAppId);
+  CompiledPermissions permissions(generation);
+  EXPECT_FALSE(generations.IsActual(kAppId, permissions));
+}
+
+}  // namespace compiled_permissions_test
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/utils/benchmark_helpers.h"
+#include "utils/atomic.h"
+#include "smart_objects/smart_object.h"
+#include "interfaces/HMI_API.h"
+#include "application_manager/smart_object_keys.h"
+#include "application_manager/event_engine/event.h"
+#include "application_manager/event_engine/event_observer.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace event_dispatcher_stress_test {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = ::application_manager::strings;
+
+using ::application_manager::event_engine::Event;
+using ::application_manager::event_engine::EventObserver;
+
+/**
+ * @brief Default amount of outstanding HMI requests. Can be overridden
+ * with SDL_BENCHMARK_REQUESTS environment variable.
+ */
+const size_t kDefaultRequests = 500;
+
+/**
+ * @brief Threads raising responses and threads subscribing and
+ * unsubscribing other observers at the same time.
+ */
+const size_t kRaisingThreads = 4;
+const size_t kChurningThreads = 2;
+
+const Event::EventID kEventIds[] = {
+  hmi_apis::FunctionID::UI_Show,
+  hmi_apis::FunctionID::UI_Alert,
+  hmi_apis::FunctionID::TTS_Speak,
+  hmi_apis::FunctionID::VR_AddCommand
+};
+const size_t kEventIdsCount = sizeof(kEventIds) / sizeof(kEventIds[0]);
+
+class TestObserver : public EventObserver {
+ public:
+  TestObserver()
+    : calls_(0),
+      unsubscribe_on_event_(false),
+      victim_(NULL) {
+  }
+
+  void Subscribe(const Event::EventID& event_id, int32_t correlation_id) {
+    subscribe_on_event(event_id, correlation_id);
+  }
+
+  void Unsubscribe() {
+    unsubscribe_from_all_events();
+  }
+
+  /**
+   * @brief Observer unsubscribes itself on event, like HMI requests do
+   * when response is received
+   */
+  void set_unsubscribe_on_event(bool unsubscribe) {
+    unsubscribe_on_event_ = unsubscribe;
+  }
+
+  /**
+   * @brief Observer unsubscribes victim on event
+   */
+  void set_victim(TestObserver* victim) {
+    victim_ = victim;
+  }
+
+  uint32_t calls() const {
+    return calls_;
+  }
+
+  virtual void on_event(const Event& event) {
+    atomic_post_inc(&calls_);
+    if (victim_) {
+      victim_->Unsubscribe();
+    }
+    if (unsubscribe_on_event_) {
+      Unsubscribe();
+    }
+  }
+
+ private:
+  volatile uint32_t calls_;
+  bool unsubscribe_on_event_;
+  TestObserver* victim_;
+};
+
+void Raise(const Event::EventID& event_id,
+           hmi_apis::messageType::eType message_type,
+           int32_t correlation_id) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  message[strings::params][strings::message_type] =
+      static_cast<int32_t>(message_type);
+  message[strings::params][strings::correlation_id] = correlation_id;
+  Event event(event_id);
+  event.set_smart_object(message);
+  event.raise();
+}
+
+using ::test::benchmark::EnvironmentValue;
+using ::test::benchmark::Now;
+
+size_t RequestsAmount() {
+  return EnvironmentValue("SDL_BENCHMARK_REQUESTS", kDefaultRequests);
+}
+
+struct RaiserContext {
+  size_t first;
+  size_t step;
+  size_t requests;
+};
+
+void* RaiseResponses(void* data) {
+  const RaiserContext* context = static_cast<RaiserContext*>(data);
+  for (size_t i = context->first; i < context->requests; i += context->step) {
+    Raise(kEventIds[i % kEventIdsCount], hmi_apis::messageType::response,
+          static_cast<int32_t>(i + 1));
+  }
+  return NULL;
+}
+
+struct ChurnerContext {
+  size_t index;
+  volatile unsigned int* stop;
+  uint32_t cycles;
+};
+
+void* ChurnObservers(void* data) {
+  ChurnerContext* context = static_cast<ChurnerContext*>(data);
+  const int32_t correlation_id = -1 - static_cast<int32_t>(context->index);
+  while (!*context->stop) {
+    TestObserver observer;
+    observer.Subscribe(kEventIds[context->cycles % kEventIdsCount],
+                       correlation_id);
+    observer.Unsubscribe();
+    ++context->cycles;
+  }
+  return NULL;
+}
+
+TEST(EventDispatcherStressTest, ResponsesToOutstandingHMIRequests) {
+  const size_t requests = RequestsAmount();
+  std::vector<TestObserver*> observers;
+  for (size_t i = 0; i < requests; ++i) {
+    TestObserver* observer = new TestObserver();
+    observer->set_unsubscribe_on_event(true);
+    observer->Subscribe(kEventIds[i % kEventIdsCount],
+                        static_cast<int32_t>(i + 1));
+    observers.push_back(observer);
+  }
+
+  volatile unsigned int stop = 0;
+  std::vector<ChurnerContext> churners(kChurningThreads);
+  std::vector<pthread_t> churner_threads(kChurningThreads);
+  for (size_t i = 0; i < kChurningThreads; ++i) {
+    churners[i].index = i;
+    churners[i].stop = &stop;
+    churners[i].cycles = 0;
+    pthread_create(&churner_threads[i], NULL, &ChurnObservers, &churners[i]);
+  }
+
+  const double start = Now();
+  std::vector<RaiserContext> raisers(kRaisingThreads);
+  std::vector<pthread_t> raiser_threads(kRaisingThreads);
+  for (size_t i = 0; i < kRaisingThreads; ++i) {
+    raisers[i].first = i;
+    raisers[i].step = kRaisingThreads;
+    raisers[i].requests = requests;
+    pthread_create(&raiser_threads[i], NULL, &RaiseResponses, &raisers[i]);
+  }
+  for (size_t i = 0; i < kRaisingThreads; ++i) {
+    pthread_join(raiser_threads[i], NULL);
+  }
+  const double elapsed = Now() - start;
+
+  atomic_post_set(&stop);
+  uint32_t churn_cycles = 0;
+  for (size_t i = 0; i < kChurningThreads; ++i) {
+    pthread_join(churner_threads[i], NULL);
+    churn_cycles += churners[i].cycles;
+  }
+  printf("outstanding requests %6zu  responses/s %10.0f  churn cycles %u\n",
+         requests, requests / elapsed, churn_cycles);
+
+  // Every observer unsubscribed itself, so repeated responses are lost
+  RaiserContext repeat = { 0, 1, requests };
+  RaiseResponses(&repeat);
+
+  size_t called_once = 0;
+  for (size_t i = 0; i < requests; ++i) {
+    if (1 == observers[i]->calls()) {
+      ++called_once;
+    }
+    delete observers[i];
+  }
+  EXPECT_EQ(requests, called_once);
+}
+
+TEST(EventDispatcherStressTest, ObserverRemovedDuringDispatchIsNotCalled) {
+  TestObserver first;
+  TestObserver second;
+  first.set_victim(&second);
+  first.Subscribe(hmi_apis::FunctionID::UI_Show, 1);
+  second.Subscribe(hmi_apis::FunctionID::UI_Show, 1);
+
+  Raise(hmi_apis::FunctionID::UI_Show, hmi_apis::messageType::response, 1);
+
+  EXPECT_EQ(1u, first.calls());
+  EXPECT_EQ(0u, second.calls());
+}
+
+TEST(EventDispatcherStressTest, NotificationReachesAllObservers) {
+  TestObserver first;
+  TestObserver second;
+  first.Subscribe(hmi_apis::FunctionID::UI_OnSystemContext, 0);
+  second.Subscribe(hmi_apis::FunctionID::UI_OnSystemContext, 2);
+
+  Raise(hmi_apis::FunctionID::UI_OnSystemContext,
+        hmi_apis::messageType::notification, 0);
+
+  EXPECT_EQ(1u, first.calls());
+  EXPECT_EQ(1u, second.calls());
+}
+
+}  // namespace event_dispatcher_stress_test
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
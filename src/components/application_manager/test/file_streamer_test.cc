@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "application_manager/file_streamer.h"
+#include "utils/file_system.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace file_streamer_test {
+
+using ::application_manager::BinaryData;
+using ::application_manager::FileStreamer;
+using ::application_manager::Message;
+
+const uint32_t kAppId = 1;
+const uint32_t kOtherAppId = 2;
+
+class FileStreamerTest : public ::testing::Test {
+ protected:
+  FileStreamerTest()
+    : file_path_("file_streamer_test.bin"),
+      other_file_path_("file_streamer_test_other.bin") {
+  }
+
+  virtual void TearDown() {
+    file_system::DeleteFile(file_path_);
+    file_system::DeleteFile(other_file_path_);
+  }
+
+  static BinaryData Chunk(size_t size, uint8_t value) {
+    return BinaryData(size, value);
+  }
+
+  mobile_apis::Result::eType Write(uint32_t app_id, const std::string& path,
+                                   const BinaryData& data, int64_t offset,
+                                   int64_t file_size) {
+    return streamer_.Write(app_id, path, &data[0], data.size(), offset,
+                           file_size);
+  }
+
+  BinaryData Content(const std::string& path) {
+    std::vector<uint8_t> content;
+    file_system::ReadBinaryFile(path, content);
+    return content;
+  }
+
+  FileStreamer streamer_;
+  const std::string file_path_;
+  const std::string other_file_path_;
+};
+
+TEST_F(FileStreamerTest, WholeFileIsWrittenByOneChunk) {
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(16, 1), 0, 0));
+  EXPECT_EQ(Chunk(16, 1), Content(file_path_));
+}
+
+TEST_F(FileStreamerTest, ChunksAreAppendedToOpenFile) {
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(8, 1), 0, 24));
+  EXPECT_EQ(8, file_system::FileSize(file_path_));
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(8, 2), 8, 0));
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(8, 3), 16, 0));
+
+  BinaryData expected = Chunk(8, 1);
+  const BinaryData second = Chunk(8, 2);
+  const BinaryData third = Chunk(8, 3);
+  expected.insert(expected.end(), second.begin(), second.end());
+  expected.insert(expected.end(), third.begin(), third.end());
+  EXPECT_EQ(expected, Content(file_path_));
+}
+
+TEST_F(FileStreamerTest, OffsetNotMatchingFileIsRejected) {
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(8, 1), 0, 24));
+  EXPECT_EQ(mobile_apis::Result::INVALID_DATA,
+            Write(kAppId, file_path_, Chunk(8, 2), 12, 0));
+  EXPECT_EQ(Chunk(8, 1), Content(file_path_));
+}
+
+TEST_F(FileStreamerTest, ZeroOffsetRewritesFile) {
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(16, 1), 0, 0));
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(4, 2), 0, 0));
+  EXPECT_EQ(Chunk(4, 2), Content(file_path_));
+}
+
+TEST_F(FileStreamerTest, ApplicationsDownloadFilesIndependently) {
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(4, 1), 0, 8));
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kOtherAppId, other_file_path_, Chunk(4, 2), 0, 8));
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(4, 1), 4, 0));
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kOtherAppId, other_file_path_, Chunk(4, 2), 4, 0));
+  EXPECT_EQ(Chunk(8, 1), Content(file_path_));
+  EXPECT_EQ(Chunk(8, 2), Content(other_file_path_));
+}
+
+TEST_F(FileStreamerTest, ClosedApplicationFileIsReopened) {
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(8, 1), 0, 24));
+  streamer_.Close(kAppId);
+  EXPECT_EQ(mobile_apis::Result::SUCCESS,
+            Write(kAppId, file_path_, Chunk(8, 2), 8, 0));
+
+  BinaryData expected = Chunk(8, 1);
+  const BinaryData second = Chunk(8, 2);
+  expected.insert(expected.end(), second.begin(), second.end());
+  EXPECT_EQ(expected, Content(file_path_));
+}
+
+TEST_F(FileStreamerTest, ChunkIsTakenOnce) {
+  utils::SharedPtr<Message> message(
+      new Message(protocol_handler::MessagePriority::kDefault));
+  streamer_.HoldChunk(kAppId, 5, message);
+
+  EXPECT_FALSE(streamer_.TakeChunk(kAppId, 6));
+  EXPECT_EQ(message.get(), streamer_.TakeChunk(kAppId, 5).get());
+  EXPECT_FALSE(streamer_.TakeChunk(kAppId, 5));
+}
+
+TEST_F(FileStreamerTest, ClosedApplicationChunksAreDropped) {
+  utils::SharedPtr<Message> message(
+      new Message(protocol_handler::MessagePriority::kDefault));
+  streamer_.HoldChunk(kAppId, 5, message);
+  streamer_.HoldChunk(kOtherAppId, 5, message);
+
+  streamer_.Close(kAppId);
+  EXPECT_FALSE(streamer_.TakeChunk(kAppId, 5));
+  EXPECT_TRUE(streamer_.TakeChunk(kOtherAppId, 5));
+}
+
+}  // namespace file_streamer_test
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "application_manager/message.h"
+#include "protocol_handler/protocol_payload.h"
+#include "utils/bitstream.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace message_payload_test {
+
+using ::application_manager::BinaryData;
+using ::application_manager::Message;
+using ::protocol_handler::RawMessage;
+using ::protocol_handler::RawMessagePtr;
+
+const uint32_t kConnectionKey = 1;
+const uint32_t kFunctionId = 32;
+const uint32_t kCorrelationId = 7;
+
+void AppendWord(uint32_t word, std::vector<uint8_t>* data) {
+  data->push_back(word >> 24);
+  data->push_back(word >> 16);
+  data->push_back(word >> 8);
+  data->push_back(word);
+}
+
+// Builds protocol version 2 RPC request with binary data
+RawMessagePtr MakeRawMessage(const std::string& json,
+                             const BinaryData& binary_data) {
+  std::vector<uint8_t> data;
+  AppendWord(kFunctionId, &data);
+  AppendWord(kCorrelationId, &data);
+  AppendWord(json.size(), &data);
+  data.insert(data.end(), json.begin(), json.end());
+  data.insert(data.end(), binary_data.begin(), binary_data.end());
+  return RawMessagePtr(new RawMessage(kConnectionKey, 2, &data[0],
+                                      data.size()));
+}
+
+class MessagePayloadTest : public ::testing::Test {
+ protected:
+  MessagePayloadTest()
+    : json_("{\"syncFileName\":\"icon.png\"}"),
+      binary_data_(16, 0xAB),
+      raw_message_(MakeRawMessage(json_, binary_data_)),
+      message_(protocol_handler::MessagePriority::kDefault) {
+  }
+
+  virtual void SetUp() {
+    utils::BitStream message_bytestream(raw_message_->data(),
+                                        raw_message_->data_size());
+    protocol_handler::Extract(&message_bytestream, &payload_,
+                              raw_message_->data_size());
+    ASSERT_TRUE(message_bytestream.IsGood());
+    message_.set_payload(raw_message_, payload_.json,
+                         payload_.header.json_size, payload_.data,
+                         payload_.data_size);
+  }
+
+  const std::string json_;
+  const BinaryData binary_data_;
+  RawMessagePtr raw_message_;
+  protocol_handler::ProtocolPayloadV2 payload_;
+  Message message_;
+};
+
+TEST_F(MessagePayloadTest, PayloadPointsToRawMessage) {
+  const uint8_t* begin = raw_message_->data();
+  const uint8_t* end = begin + raw_message_->data_size();
+
+  EXPECT_EQ(kFunctionId, payload_.header.rpc_function_id);
+  EXPECT_EQ(kCorrelationId, payload_.header.corellation_id);
+  EXPECT_EQ(json_.size(), payload_.header.json_size);
+  EXPECT_EQ(binary_data_.size(), payload_.data_size);
+  EXPECT_TRUE(begin < payload_.json && payload_.json < end);
+  EXPECT_EQ(payload_.json + json_.size(), payload_.data);
+  EXPECT_EQ(end, payload_.data + payload_.data_size);
+}
+
+TEST_F(MessagePayloadTest, MessageKeepsRawMessageAlive) {
+  raw_message_ = RawMessagePtr();
+
+  ASSERT_EQ(json_.size(), message_.json_size());
+  EXPECT_EQ(json_, std::string(message_.json_begin(), message_.json_size()));
+  ASSERT_TRUE(message_.has_binary_data());
+  ASSERT_EQ(binary_data_.size(), message_.binary_data_size());
+  EXPECT_EQ(binary_data_,
+            BinaryData(message_.binary_data_begin(),
+                       message_.binary_data_begin() +
+                       message_.binary_data_size()));
+}
+
+TEST_F(MessagePayloadTest, CopiesAreMadeOnlyOnRequest) {
+  EXPECT_EQ(json_, message_.json_message());
+  ASSERT_TRUE(NULL != message_.binary_data());
+  EXPECT_EQ(binary_data_, *message_.binary_data());
+  EXPECT_EQ(payload_.data, message_.binary_data_begin());
+}
+
+TEST_F(MessagePayloadTest, CopyOfMessageOwnsItsBinaryData) {
+  message_.set_binary_data(new BinaryData(binary_data_));
+  Message* copy = new Message(message_);
+  delete copy;
+
+  ASSERT_TRUE(message_.has_binary_data());
+  EXPECT_EQ(binary_data_, *message_.binary_data());
+}
+
+TEST_F(MessagePayloadTest, SettersReplaceRawPayload) {
+  message_.set_json_message("{}");
+  message_.set_binary_data(new BinaryData(2, 0x01));
+
+  EXPECT_EQ("{}", std::string(message_.json_begin(), message_.json_size()));
+  ASSERT_EQ(2u, message_.binary_data_size());
+  EXPECT_EQ(0x01, message_.binary_data_begin()[0]);
+  EXPECT_EQ(BinaryData(2, 0x01), *message_.binary_data());
+}
+
+}  // namespace message_payload_test
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -47,6 +47,10 @@ class SmartObject;
 }
 }
 
+namespace policy {
+class CompiledPermissions;
+}
+
 namespace application_manager {
 
 namespace mobile_api = mobile_apis;
@@ -510,6 +514,16 @@ class Application : public virtual InitialApplicationData,
      */
     virtual UsageStatistics& usage_report() = 0;
 
+    /**
+     * @brief Policy permissions compiled for application
+     * @return NULL if permissions were not compiled yet
+     */
+    virtual utils::SharedPtr<const policy::CompiledPermissions>
+    compiled_permissions() const = 0;
+    virtual void set_compiled_permissions(
+        const utils::SharedPtr<const policy::CompiledPermissions>&
+        permissions) = 0;
+
     /**
      * @brief Keeps id of softbuttons which is created in commands:
      * Alert, Show, ScrollableMessage, ShowConstantTBT, AlertManeuver, UpdateTurnList
@@ -44,6 +44,7 @@
 #include "application_manager/hmi_capabilities.h"
 #include "application_manager/message.h"
 #include "application_manager/request_controller.h"
+#include "application_manager/request_traces.h"
 #include "application_manager/resume_ctrl.h"
 #include "application_manager/vehicle_info_data.h"
 #include "protocol_handler/protocol_observer.h"
@@ -71,6 +72,7 @@
 #include "utils/shared_ptr.h"
 #include "utils/message_queue.h"
 #include "utils/prioritized_queue.h"
+#include "utils/fair_prioritized_queue.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/message_loop_thread.h"
 #include "utils/lock.h"
@@ -92,6 +94,13 @@ struct MessageFromMobile: public utils::SharedPtr<Message> {
   size_t PriorityOrder() const {
     return (*this)->Priority().OrderingValue();
   }
+  // FairPrioritizedQueue shares priority levels between applications
+  uint32_t FairQueueKey() const {
+    return (*this)->connection_key();
+  }
+  size_t FairQueueCost() const {
+    return (*this)->data_size();
+  }
 };
 
 struct MessageToMobile: public utils::SharedPtr<Message> {
@@ -128,7 +137,7 @@ struct MessageToHmi: public utils::SharedPtr<Message> {
   }
 };
 
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromMobile> > FromMobileQueue;
+typedef threads::MessageLoopThread<utils::FairPrioritizedQueue<MessageFromMobile> > FromMobileQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToMobile> > ToMobileQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromHmi> > FromHmiQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToHmi> > ToHmiQueue;
@@ -156,8 +165,14 @@ class ApplicationManagerImpl : public ApplicationManager,
   MOCK_METHOD0(Stop, bool());
   MOCK_METHOD1(OnMessageReceived, void (utils::SharedPtr<application_manager::Message>));
   MOCK_METHOD1(OnErrorSending, void (utils::SharedPtr<application_manager::Message>));
+  MOCK_METHOD1(OnMessageSuperseded, void (utils::SharedPtr<application_manager::Message>));
   MOCK_METHOD1(OnMessageReceived, void (const ::protocol_handler::RawMessagePtr));
   MOCK_METHOD1(OnMobileMessageSent, void (const ::protocol_handler::RawMessagePtr));
+  MOCK_CONST_METHOD0(GetMessagesFromMobileCount, size_t ());
+  MOCK_CONST_METHOD1(GetMessagesFromMobileCount, size_t (uint32_t));
+  MOCK_CONST_METHOD1(GetRequestLaneStatistics,
+                     request_controller::RequestController::LaneStatistics
+                     (uint32_t));
   MOCK_METHOD1(OnDeviceListUpdated, void (const connection_handler::DeviceMap&));
   MOCK_METHOD0(OnFindNewApplicationsRequest, void ());
   MOCK_METHOD1(RemoveDevice, void (const connection_handler::DeviceHandle&));
@@ -179,6 +194,7 @@ class ApplicationManagerImpl : public ApplicationManager,
   //ApplicationManagerImpl methods:
 
   MOCK_METHOD1(SetTimeMetricObserver, void(AMMetricObserver*));
+  MOCK_METHOD0(request_traces, RequestTraces&());
   MOCK_METHOD1(RegisterApplication,
                 ApplicationSharedPtr(const utils::SharedPtr<smart_objects::SmartObject>&));
   MOCK_METHOD0(hmi_capabilities, HMICapabilities& ());
@@ -188,6 +204,8 @@ class ApplicationManagerImpl : public ApplicationManager,
   MOCK_METHOD2(SendMessageToMobile, bool (const utils::SharedPtr<smart_objects::SmartObject>&,
                                           bool));
   MOCK_METHOD1(SendMessageToMobile, bool (const utils::SharedPtr<smart_objects::SmartObject>&));
+  MOCK_METHOD2(MulticastMessageToMobile, void (const smart_objects::SmartObject&,
+                                               const std::vector<ApplicationSharedPtr>&));
   MOCK_METHOD1(GetDeviceName, std::string (connection_handler::DeviceHandle));
   MOCK_METHOD1(application, ApplicationSharedPtr (uint32_t));
   MOCK_METHOD1(application_by_policy_id, ApplicationSharedPtr (const std::string&));
@@ -208,10 +226,15 @@ class ApplicationManagerImpl : public ApplicationManager,
                                                            mobile_apis::FunctionID::eType,
                                                            const RPCParams&,
                                                            CommandParametersPermissions*));
+  MOCK_METHOD3(CheckPolicyPermissions, mobile_apis::Result::eType(ApplicationSharedPtr,
+                                                           mobile_apis::FunctionID::eType,
+                                                           CommandParametersPermissions*));
   MOCK_METHOD3(updateRequestTimeout, void(uint32_t, uint32_t, uint32_t));
   MOCK_METHOD0(GenerateGrammarID, uint32_t());
   MOCK_METHOD0(GenerateNewHMIAppID, uint32_t());
   MOCK_METHOD1(GetAvailableSpaceForApp, uint32_t(const std::string&));
+  MOCK_METHOD3(UpdateUsedSpaceForApp, void(const std::string&, int64_t,
+                                           int64_t));
   MOCK_METHOD0(begin_audio_pass_thru, bool ());
   MOCK_METHOD0(end_audio_pass_thru, uint32_t());
   MOCK_METHOD1(StopAudioPassThru, void(uint32_t));
@@ -220,12 +243,26 @@ class ApplicationManagerImpl : public ApplicationManager,
   MOCK_METHOD1(applications_by_ivi, std::vector<ApplicationSharedPtr>(uint32_t));
   MOCK_METHOD2(IviInfoUpdated, std::vector<utils::SharedPtr<Application>> (VehicleDataType,
                                                                    int));
+  MOCK_METHOD2(SubscribeAppToButton, bool(ApplicationSharedPtr,
+                                          mobile_apis::ButtonName::eType));
+  MOCK_METHOD2(UnsubscribeAppFromButton, bool(ApplicationSharedPtr,
+                                              mobile_apis::ButtonName::eType));
+  MOCK_METHOD2(SubscribeAppToIVI, bool(ApplicationSharedPtr, uint32_t));
+  MOCK_METHOD2(UnsubscribeAppFromIVI, bool(ApplicationSharedPtr, uint32_t));
   MOCK_METHOD6(StartAudioPassThruThread, void(uint32_t, uint32_t, uint32_t,
                                             uint32_t, uint32_t, uint32_t));
   MOCK_METHOD4(SaveBinary, mobile_apis::Result::eType(const std::vector<uint8_t>&,
                                 const std::string&,
                                 const std::string&,
                                 const int64_t));
+  MOCK_METHOD2(TakeFileChunk, utils::SharedPtr<Message>(uint32_t, uint32_t));
+  MOCK_METHOD7(SaveFileChunk, mobile_apis::Result::eType(uint32_t,
+                                const uint8_t*,
+                                const size_t,
+                                const std::string&,
+                                const std::string&,
+                                const int64_t,
+                                const int64_t));
   MOCK_METHOD1(ReplaceHMIByMobileAppId, void(smart_objects::SmartObject&));
   MOCK_METHOD1(ReplaceMobileByHMIAppId, void(smart_objects::SmartObject&));
   MOCK_METHOD0(resume_controller, ResumeCtrl&());
@@ -288,8 +325,6 @@ class ApplicationManagerImpl : public ApplicationManager,
   friend class ApplicationListAccessor;
 
   private:
-    //FIXME(AKutsan) In resume_controller is is nessesery to change realisation for remove using application_list_
-    std::set<ApplicationSharedPtr> application_list_;
   FRIEND_BASE_SINGLETON_CLASS(ApplicationManagerImpl);
 };
 
@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_COMMAND_IMPL_H_
 
 #include "application_manager/commands/command.h"
+#include "utils/free_list_pool.h"
 #include "utils/logger.h"
 
 namespace application_manager {
@@ -118,6 +119,18 @@ class CommandImpl : public Command {
    */
   virtual void onTimeOut();
 
+  /*
+   * @brief Commands are created for every message, so memory of destroyed
+   * commands is kept in pool and reused by new commands of the same size
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* command, size_t size);
+
+  /*
+   * @brief Retrieves counters of command objects pool
+   */
+  static utils::FreeListPool::Statistics pool_statistics();
+
   // members
   static const int32_t hmi_protocol_type_;
   static const int32_t mobile_protocol_type_;
@@ -59,17 +59,30 @@ class PutFileRequest : public CommandRequestImpl {
    **/
   virtual ~PutFileRequest();
 
+  /**
+   * @brief Releases binary data of request which is not allowed to run
+   **/
+  virtual bool CheckPermissions();
+
   /**
    * @brief Execute command
    **/
   virtual void Run();
 
  private:
+    /**
+     * @brief Takes binary data of request from application manager,
+     * it is held there until request takes it
+     **/
+    utils::SharedPtr<Message> TakeChunk();
+
     int64_t                     offset_;
     std::string                  sync_file_name_;
     int64_t                     length_;
     mobile_apis::FileType::eType file_type_;
     bool                         is_persistent_file_;
+    // Binary data was taken, request doesn't release it on destruction
+    bool                         chunk_taken_;
 
     void SendOnPutFileNotification();
   DISALLOW_COPY_AND_ASSIGN(PutFileRequest);
@@ -33,8 +33,8 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_DISPATCHER_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_DISPATCHER_H_
 
-#include <list>
 #include <map>
+#include <vector>
 
 #include "utils/lock.h"
 #include "utils/singleton.h"
@@ -50,7 +50,8 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
  public:
 
   /*
-   * @brief Delivers the event to all subscribers
+   * @brief Delivers the event to all subscribers. Observers unsubscribed
+   * by other observers during delivery are not called.
    *
    * @param event Received event
    */
@@ -102,13 +103,69 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
   FRIEND_BASE_SINGLETON_CLASS(EventDispatcher);
 
   // Data types section
-  typedef std::list<EventObserver*>                   ObserverList;
-  typedef std::map<int32_t, ObserverList>             ObserversMap;
+  struct ObserverEntry {
+    ObserverEntry(EventObserver* const observer, uint64_t subscription)
+      : observer(observer),
+        subscription(subscription) {}
+
+    // NULL if observer was removed while shard was dispatching
+    EventObserver*                                    observer;
+    // Sequence number of subscription within the shard
+    uint64_t                                          subscription;
+  };
+
+  typedef std::vector<ObserverEntry>                  ObserverEntries;
+  typedef std::map<int32_t, ObserverEntries>          ObserversMap;
   typedef std::map<Event::EventID, ObserversMap>      EventObserverMap;
 
+  /*
+   * @brief Observers of events with the same shard index, indexed by event
+   * ID and HMI correlation ID. While event is dispatched, entries are not
+   * moved: removed observers are only marked and erased when last dispatch
+   * of shard is finished.
+   */
+  struct Shard {
+    Shard()
+      : subscriptions(0),
+        dispatching(0),
+        has_removed(false) {}
+
+    sync_primitives::Lock                             lock;
+    EventObserverMap                                  observers;
+    uint64_t                                          subscriptions;
+    uint32_t                                          dispatching;
+    bool                                              has_removed;
+  };
+
+  static const uint32_t kShardsCount = 16;
+
+  Shard& shard(const Event::EventID& event_id);
+
+  /*
+   * @brief Calls observers subscribed before dispatch was started.
+   * Must be called with shard lock acquired, lock is released while
+   * observer is called.
+   */
+  void notify_observers(const ObserverEntries& entries,
+                        uint64_t subscriptions,
+                        sync_primitives::AutoLock& auto_lock,
+                        const Event& event);
+
+  /*
+   * @brief Marks entries of observer as removed.
+   * Must be called with shard lock acquired.
+   */
+  void remove_from_observers(Shard& shard, ObserversMap& observers,
+                             const EventObserver* const observer);
+
+  /*
+   * @brief Erases marked entries if shard is not dispatching.
+   * Must be called with shard lock acquired.
+   */
+  void compact_shard(Shard& shard);
+
   // Members section
-  sync_primitives::Lock                               state_lock_;
-  EventObserverMap                                    observers_;
+  Shard                                               shards_[kShardsCount];
 };
 
 }
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_FILE_STREAMER_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_FILE_STREAMER_H_
+
+#include <stdint.h>
+#include <map>
+#include <queue>
+#include <string>
+#include <utility>
+
+#include "application_manager/message.h"
+#include "interfaces/MOBILE_API.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/shared_ptr.h"
+#include "utils/threads/message_loop_thread.h"
+
+namespace application_manager {
+
+typedef threads::MessageLoopThread<std::queue<int> > FileSyncQueue;
+
+/**
+ * @brief Writes PutFile payloads to application storage.
+ *
+ * Payload of PutFile request stays in incoming message and is not copied
+ * to smart object: request takes it by connection key and correlation id
+ * and it is written straight to the file. Descriptor of file being
+ * downloaded is kept open for next chunks of the same application, space
+ * for whole file is reserved with first chunk. Completed files are synced
+ * to disk and closed on separate thread.
+ */
+class FileStreamer {
+ public:
+  FileStreamer();
+  ~FileStreamer();
+
+  /**
+   * @brief Keeps message with PutFile payload until request takes it
+   */
+  void HoldChunk(uint32_t connection_key, uint32_t correlation_id,
+                 const utils::SharedPtr<Message>& message);
+
+  /**
+   * @brief Returns message with payload of request and forgets it,
+   * returns empty pointer if request has no payload
+   */
+  utils::SharedPtr<Message> TakeChunk(uint32_t connection_key,
+                                      uint32_t correlation_id);
+
+  /**
+   * @brief Writes chunk of file
+   *
+   * @param app_id Application downloading the file
+   * @param full_file_path Path of file
+   * @param data Chunk of file
+   * @param size Size of chunk
+   * @param offset Offset of chunk, 0 starts new file (overwrites existing)
+   * @param file_size Expected size of whole file, used to reserve space and
+   * to detect last chunk. Chunk is considered as whole file if it is 0.
+   *
+   * @return SUCCESS if chunk was written, other code otherwise
+   */
+  mobile_apis::Result::eType Write(uint32_t app_id,
+                                   const std::string& full_file_path,
+                                   const uint8_t* data,
+                                   size_t size,
+                                   int64_t offset,
+                                   int64_t file_size);
+
+  /**
+   * @brief Closes file being downloaded by application and drops
+   * payloads of its requests
+   */
+  void Close(uint32_t app_id);
+
+ private:
+  /**
+   * @brief Syncs and closes descriptors of completed files
+   */
+  struct FileSync : public FileSyncQueue::Handler {
+    virtual void Handle(const int fd) OVERRIDE;
+  };
+
+  struct OpenFile {
+    OpenFile()
+      : fd(-1),
+        end(0),
+        file_size(0),
+        writing(false),
+        closed(false) {
+    }
+    std::string path;
+    int fd;
+    int64_t end;
+    int64_t file_size;
+    // Chunk is being written, descriptor is owned by writer
+    bool writing;
+    // Application was closed while chunk was written
+    bool closed;
+  };
+  typedef std::map<uint32_t, OpenFile> OpenFiles;
+  typedef std::pair<uint32_t, uint32_t> ChunkId;
+  typedef std::map<ChunkId, utils::SharedPtr<Message> > Chunks;
+
+  /**
+   * @brief Opens file for chunk at offset, checks that offset matches
+   * size of existing file
+   */
+  mobile_apis::Result::eType Open(const std::string& full_file_path,
+                                  int64_t offset, int64_t file_size,
+                                  OpenFile* file);
+
+  /**
+   * @brief Writes chunk to file, opens file if needed. Completed or
+   * failed file is released and its descriptor is reset.
+   */
+  mobile_apis::Result::eType WriteChunk(const std::string& full_file_path,
+                                        const uint8_t* data,
+                                        size_t size,
+                                        int64_t offset,
+                                        int64_t file_size,
+                                        OpenFile* file);
+
+  /**
+   * @brief Passes descriptor to sync thread, which closes it
+   */
+  void Release(const OpenFile& file);
+
+  OpenFiles open_files_;
+  sync_primitives::Lock open_files_lock_;
+  Chunks chunks_;
+  sync_primitives::Lock chunks_lock_;
+  // Handler must outlive queue, which drains it on destruction
+  FileSync file_sync_;
+  FileSyncQueue sync_queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileStreamer);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_FILE_STREAMER_H_
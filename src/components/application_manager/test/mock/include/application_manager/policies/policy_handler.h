@@ -39,6 +39,7 @@
 #include <vector>
 #include "policy/policy_manager.h"
 #include "application_manager/policies/policy_event_observer.h"
+#include "application_manager/policies/compiled_permissions.h"
 #include "application_manager/policies/pt_exchange_handler.h"
 #include "utils/logger.h"
 #include "utils/singleton.h"
@@ -48,6 +49,10 @@ namespace Json {
 class Value;
 }
 
+namespace application_manager {
+class Application;
+}
+
 namespace policy {
 typedef std::vector<uint32_t> AppIds;
 typedef std::vector<uint32_t> DeviceHandles;
@@ -78,6 +83,15 @@ class PolicyHandler :
                    const RPCParams& rpc_params,
                    CheckPermissionResult& result);
 
+  /**
+   * @brief Returns policy permissions of application compiled for checks
+   * on message path. Permissions are compiled on first use after change of
+   * policy affecting application and are kept by application.
+   * @return NULL if policy library is not loaded
+   */
+  CompiledPermissionsPtr GetCompiledPermissions(
+      application_manager::Application& app);
+
   uint32_t GetNotificationsNumber(const std::string& priority);
   DeviceConsent GetUserConsentForDevice(const std::string& device_id);
   bool GetDefaultHmi(const std::string& policy_app_id,
@@ -349,6 +363,38 @@ protected:
    */
   const std::string ConvertUpdateStatus(policy::PolicyTableStatus status);
 
+  /**
+   * @brief Makes permissions compiled for all applications out of date, must
+   * be called after policy table is loaded, reset or updated
+   */
+  void OnPermissionsChanged();
+
+  /**
+   * @brief Makes permissions compiled for registered applications with
+   * given policy id out of date
+   * @param policy_app_id Policy id of application which permissions changed
+   */
+  void OnPermissionsChanged(const std::string& policy_app_id);
+
+  /**
+   * @brief Makes permissions compiled for applications registered from
+   * device out of date, called after consent of device was changed
+   * @param device_handle Handle of device
+   */
+  void OnDevicePermissionsChanged(uint32_t device_handle);
+
+  /**
+   * @brief Makes permissions compiled for application out of date
+   */
+  void OnAppPermissionsChanged(const application_manager::Application& app);
+
+  /**
+   * @brief Compiles permissions of application from current policy table
+   * @param generation Generation of policy permissions are compiled from
+   */
+  CompiledPermissionsPtr CompilePermissions(const std::string& policy_app_id,
+                                            uint32_t generation);
+
 private:
 
   class StatisticManagerImpl: public usage_statistics::StatisticsManager {
@@ -407,6 +453,12 @@ private:
 
   utils::SharedPtr<StatisticManagerImpl> statistic_manager_impl_;
 
+  /**
+   * @brief Changes of policy which permissions compiled for applications
+   * must be compiled again after
+   */
+  PermissionsGenerations permissions_generations_;
+
 
   DISALLOW_COPY_AND_ASSIGN(PolicyHandler);
   FRIEND_BASE_SINGLETON_CLASS_WITH_DELETER(PolicyHandler,
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_TRACES_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_TRACES_H_
+
+#include <stdint.h>
+#include <map>
+#include <utility>
+
+#include "protocol/message_trace.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+/**
+ * @brief Keeps traces of mobile requests between their arrival and
+ * response, so stages passed while request is processed are marked on
+ * trace of request.
+ *
+ * Requests to HMI are linked to mobile request which sent them by HMI
+ * correlation id, so round trip to HMI is marked on trace of mobile
+ * request when HMI response arrives.
+ */
+class RequestTraces {
+ public:
+  RequestTraces();
+
+  /**
+   * @brief Starts following trace of mobile request
+   */
+  void Start(uint32_t connection_key, uint32_t correlation_id,
+             const protocol_handler::MessageTracePtr& trace);
+
+  /**
+   * @brief Marks stage on trace of request if request is followed
+   */
+  void Mark(uint32_t connection_key, uint32_t correlation_id,
+            protocol_handler::MessageTrace::Stage stage);
+
+  /**
+   * @brief Links request to HMI with mobile request which sent it,
+   * first request to HMI marks when HMI request was sent
+   */
+  void OnHmiRequest(uint32_t hmi_correlation_id, uint32_t connection_key,
+                    uint32_t correlation_id);
+
+  /**
+   * @brief Marks when HMI response was received on trace of linked
+   * mobile request
+   */
+  void OnHmiResponse(uint32_t hmi_correlation_id);
+
+  /**
+   * @brief Stops following trace of request when its response is sent
+   * @return Trace of request, empty if request is not followed
+   */
+  protocol_handler::MessageTracePtr Finish(uint32_t connection_key,
+                                           uint32_t correlation_id);
+
+  /**
+   * @brief Forgets traces of all requests of application
+   */
+  void Forget(uint32_t connection_key);
+
+  /**
+   * @brief Number of followed requests
+   */
+  size_t size() const;
+
+ private:
+  typedef std::pair<uint32_t, uint32_t> RequestId;
+  typedef std::map<RequestId, protocol_handler::MessageTracePtr> Traces;
+  typedef std::map<uint32_t, RequestId> HmiRequests;
+
+  void ForgetHmiRequests(const RequestId& request);
+
+  Traces traces_;
+  HmiRequests hmi_requests_;
+  mutable sync_primitives::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(RequestTraces);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_TRACES_H_
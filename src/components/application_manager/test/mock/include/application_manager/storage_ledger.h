@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_STORAGE_LEDGER_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_STORAGE_LEDGER_H_
+
+#include <stdint.h>
+#include <time.h>
+#include <map>
+#include <string>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/timer_thread.h"
+
+namespace application_manager {
+
+/**
+ * @brief Keeps space used by application folders in memory, so quota
+ * checks don't walk the folders.
+ *
+ * Folders of storage are walked once on start and folder of application
+ * which wasn't seen before is walked on first request. Afterwards used
+ * space is changed by callers which save and delete files. Known folders
+ * are walked again only by timer thread, which reconciles the ledger with
+ * file system once in reconcile period.
+ */
+class StorageLedger {
+ public:
+  /**
+   * @brief Creates ledger
+   * @param reconcile_period Seconds after which folder is walked again
+   */
+  explicit StorageLedger(time_t reconcile_period);
+
+  ~StorageLedger();
+
+  /**
+   * @brief Walks all application folders in storage folder and starts
+   * reconciliation timer
+   */
+  void Seed(const std::string& storage_folder);
+
+  /**
+   * @brief Returns space used by application folder. Only folder which
+   * is not in the ledger yet is walked.
+   */
+  uint64_t UsedSpace(const std::string& app_folder);
+
+  /**
+   * @brief Changes space used by application folder after one of its
+   * files was saved or deleted
+   * @param previous_size Size of file before change, 0 for new file
+   * @param size Size of file after change, 0 for deleted file
+   */
+  void Update(const std::string& app_folder, int64_t previous_size,
+              int64_t size);
+
+  /**
+   * @brief Forgets application folder, it is walked again when needed
+   */
+  void Forget(const std::string& app_folder);
+
+ private:
+  typedef std::map<std::string, uint64_t> Entries;
+
+  /**
+   * @brief Walks folder and records its size
+   * @param known_only Size is not recorded if folder was forgotten while
+   * it was walked
+   */
+  uint64_t Reconcile(const std::string& app_folder, bool known_only);
+
+  /**
+   * @brief Walks all folders in the ledger, called by timer thread
+   */
+  void OnReconcileTimer();
+
+  const time_t reconcile_period_;
+  Entries entries_;
+  sync_primitives::Lock entries_lock_;
+  timer::TimerThread<StorageLedger> reconcile_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(StorageLedger);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_STORAGE_LEDGER_H_
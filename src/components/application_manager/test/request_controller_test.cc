@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "application_manager/application_manager_impl.h"
+#include "application_manager/request_controller.h"
+#include "application_manager/request_traces.h"
+#include "application_manager/commands/command_request_impl.h"
+#include "application_manager/smart_object_keys.h"
+#include "config_profile/profile.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+
+namespace test {
+namespace components {
+namespace request_controller_test {
+
+using ::testing::ReturnRef;
+using ::application_manager::request_controller::RequestController;
+
+namespace strings = ::application_manager::strings;
+
+typedef std::pair<uint32_t, uint32_t> RequestId;
+
+/**
+ * @brief Records requests in order they were run, runs of one application
+ * may be held until they are released by test
+ */
+class RunLog {
+ public:
+  RunLog()
+    : held_key_(0),
+      holding_(false),
+      held_(false) {
+  }
+
+  void Hold(uint32_t connection_key) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    held_key_ = connection_key;
+    holding_ = true;
+  }
+
+  void Release() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    holding_ = false;
+    cond_var_.Broadcast();
+  }
+
+  void OnRun(uint32_t connection_key, uint32_t correlation_id) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    runs_.push_back(RequestId(connection_key, correlation_id));
+    cond_var_.Broadcast();
+    while (holding_ && held_key_ == connection_key) {
+      held_ = true;
+      cond_var_.Broadcast();
+      cond_var_.Wait(auto_lock);
+    }
+  }
+
+  /**
+   * @brief Waits until runs are recorded, false if they were not in time
+   */
+  bool WaitForRuns(size_t count) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (runs_.size() < count) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          cond_var_.WaitFor(auto_lock, kWaitTimeout)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool WaitUntilHeld() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (!held_) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          cond_var_.WaitFor(auto_lock, kWaitTimeout)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<RequestId> runs() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return runs_;
+  }
+
+ private:
+  static const uint32_t kWaitTimeout = 5000;
+
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable cond_var_;
+  std::vector<RequestId> runs_;
+  uint32_t held_key_;
+  bool holding_;
+  bool held_;
+};
+
+class FakeRequest : public ::application_manager::commands::CommandRequestImpl {
+ public:
+  FakeRequest(const ::application_manager::MessageSharedPtr& message,
+              RunLog* log)
+    : CommandRequestImpl(message),
+      log_(log) {
+  }
+
+  virtual bool Init() {
+    // Timeout is not tracked, so requests stay pending until test ends
+    default_timeout_ = 0;
+    return true;
+  }
+
+  virtual bool CheckPermissions() {
+    return true;
+  }
+
+  virtual bool CleanUp() {
+    return true;
+  }
+
+  virtual void Run() {
+    log_->OnRun(connection_key(), correlation_id());
+  }
+
+ private:
+  RunLog* log_;
+};
+
+class RequestControllerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    profile::Profile::instance()->config_file_name(
+        "request_controller_test.ini");
+    am_ = ::application_manager::ApplicationManagerImpl::instance();
+    ON_CALL(*am_, request_traces()).WillByDefault(ReturnRef(traces_));
+  }
+
+  virtual void TearDown() {
+    ::application_manager::ApplicationManagerImpl::destroy();
+  }
+
+  ::application_manager::request_controller::MobileRequestPtr MakeRequest(
+      uint32_t connection_key, uint32_t correlation_id) {
+    ::application_manager::MessageSharedPtr message(
+        new smart_objects::SmartObject(smart_objects::SmartType_Map));
+    (*message)[strings::params][strings::connection_key] = connection_key;
+    (*message)[strings::params][strings::correlation_id] = correlation_id;
+    return new FakeRequest(message, &log_);
+  }
+
+  RequestController::TResult Add(RequestController& controller,
+                                 uint32_t connection_key,
+                                 uint32_t correlation_id) {
+    return controller.addMobileRequest(
+        MakeRequest(connection_key, correlation_id),
+        mobile_apis::HMILevel::HMI_FULL);
+  }
+
+  ::application_manager::ApplicationManagerImpl* am_;
+  ::application_manager::RequestTraces traces_;
+  RunLog log_;
+};
+
+TEST_F(RequestControllerTest, RequestsOfApplicationRunInOrder) {
+  RequestController controller;
+  const uint32_t kRequestsCount = 4;
+  for (uint32_t i = 0; i < kRequestsCount; ++i) {
+    ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, i));
+    ASSERT_EQ(RequestController::SUCCESS, Add(controller, 2, i));
+  }
+  ASSERT_TRUE(log_.WaitForRuns(2 * kRequestsCount));
+
+  const std::vector<RequestId> runs = log_.runs();
+  uint32_t next_correlation_id[3] = {0, 0, 0};
+  for (size_t i = 0; i < runs.size(); ++i) {
+    EXPECT_EQ(next_correlation_id[runs[i].first]++, runs[i].second);
+  }
+  EXPECT_EQ(kRequestsCount, controller.GetLaneStatistics(1).executed);
+  EXPECT_EQ(0u, controller.GetLaneStatistics(1).depth);
+}
+
+TEST_F(RequestControllerTest, TerminatedApplicationQueueIsDropped) {
+  RequestController controller;
+  log_.Hold(1);
+  ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, 0));
+  ASSERT_TRUE(log_.WaitUntilHeld());
+  ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, 1));
+  ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, 2));
+  EXPECT_EQ(2u, controller.GetLaneStatistics(1).depth);
+
+  controller.terminateAppRequests(1);
+  log_.Release();
+
+  // Requests queued after termination run as usual
+  ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, 3));
+  ASSERT_EQ(RequestController::SUCCESS, Add(controller, 2, 0));
+  ASSERT_TRUE(log_.WaitForRuns(3));
+  controller.DestroyThreadpool();
+
+  const std::vector<RequestId> runs = log_.runs();
+  ASSERT_EQ(3u, runs.size());
+  EXPECT_EQ(RequestId(1, 0), runs[0]);
+  EXPECT_TRUE(runs.end() != std::find(runs.begin(), runs.end(),
+                                      RequestId(1, 3)));
+  EXPECT_TRUE(runs.end() != std::find(runs.begin(), runs.end(),
+                                      RequestId(2, 0)));
+}
+
+TEST_F(RequestControllerTest, QueuedRequestsAreLimited) {
+  RequestController controller;
+  const uint32_t limit =
+      profile::Profile::instance()->pending_requests_amount();
+  log_.Hold(1);
+  ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, 0));
+  ASSERT_TRUE(log_.WaitUntilHeld());
+  for (uint32_t i = 1; i <= limit; ++i) {
+    ASSERT_EQ(RequestController::SUCCESS, Add(controller, 1, i));
+  }
+  EXPECT_EQ(RequestController::TOO_MANY_PENDING_REQUESTS,
+            Add(controller, 1, limit + 1));
+
+  controller.terminateAppRequests(1);
+  EXPECT_EQ(RequestController::SUCCESS, Add(controller, 2, 0));
+  log_.Release();
+  ASSERT_TRUE(log_.WaitForRuns(2));
+}
+
+}  // namespace request_controller_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/utils/benchmark_helpers.h"
+#include "application_manager/request_info.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace request_info_set_benchmark {
+
+using ::application_manager::request_controller::RequestInfo;
+using ::application_manager::request_controller::RequestInfoPtr;
+using ::application_manager::request_controller::RequestInfoSet;
+using ::application_manager::request_controller::RequestInfoComparator;
+
+/**
+ * @brief Default amount of requests in flight. Can be overridden with
+ * SDL_BENCHMARK_REQUESTS environment variable.
+ */
+const size_t kDefaultRequests = 5000;
+
+/**
+ * @brief Requests are spread over applications with equal correlation
+ * ids, like real applications numbering their requests from 1.
+ */
+const uint32_t kApplications = 10;
+
+struct FakeRequestInfo : public RequestInfo {
+  FakeRequestInfo(uint32_t app_id, uint32_t correlation_id,
+                  uint64_t timeout_sec)
+    : RequestInfo(timeout_sec, MobileRequest),
+      correlation_id_(correlation_id) {
+    app_id_ = app_id;
+  }
+
+  virtual uint32_t requestId() {
+    return correlation_id_;
+  }
+
+  virtual ::application_manager::commands::Command* request() {
+    return NULL;
+  }
+
+  void set_end_time(const TimevalStruct& end_time) {
+    end_time_ = end_time;
+  }
+
+ private:
+  uint32_t correlation_id_;
+};
+
+/**
+ * @brief Former tracking: single set ordered by end time, lookups
+ * scan it from the beginning.
+ */
+class LinearRequestInfoSet {
+ public:
+  void Add(const RequestInfoPtr& request_info) {
+    requests_.insert(request_info);
+  }
+
+  RequestInfoPtr Find(uint32_t app_id, uint32_t correlation_id) const {
+    Requests::const_iterator it = requests_.begin();
+    for (; requests_.end() != it; ++it) {
+      if (app_id == (*it)->app_id() &&
+          correlation_id == (*it)->requestId()) {
+        return *it;
+      }
+    }
+    return RequestInfoPtr();
+  }
+
+  void RemoveRequest(const RequestInfoPtr& request_info) {
+    requests_.erase(request_info);
+  }
+
+  void UpdateTimeOut(const RequestInfoPtr& request_info,
+                     uint64_t timeout_sec) {
+    requests_.erase(request_info);
+    request_info->updateTimeOut(timeout_sec);
+    requests_.insert(request_info);
+  }
+
+  size_t Size() const {
+    return requests_.size();
+  }
+
+ private:
+  typedef std::set<RequestInfoPtr, RequestInfoComparator> Requests;
+  Requests requests_;
+};
+
+class IndexedRequestInfoSet {
+ public:
+  void Add(const RequestInfoPtr& request_info) {
+    requests_.Add(request_info);
+  }
+
+  RequestInfoPtr Find(uint32_t app_id, uint32_t correlation_id) const {
+    return requests_.Find(RequestInfo::MobileRequest, app_id, correlation_id);
+  }
+
+  void RemoveRequest(const RequestInfoPtr& request_info) {
+    requests_.RemoveRequest(request_info);
+  }
+
+  void UpdateTimeOut(const RequestInfoPtr& request_info,
+                     uint64_t timeout_sec) {
+    requests_.UpdateTimeOut(request_info, timeout_sec);
+  }
+
+  size_t Size() const {
+    return requests_.Size();
+  }
+
+ private:
+  RequestInfoSet requests_;
+};
+
+struct RequestKey {
+  RequestKey(uint32_t app, uint32_t correlation)
+    : app_id(app),
+      correlation_id(correlation) {
+  }
+  uint32_t app_id;
+  uint32_t correlation_id;
+};
+
+using ::test::benchmark::EnvironmentValue;
+using ::test::benchmark::Now;
+
+size_t RequestsAmount() {
+  return EnvironmentValue("SDL_BENCHMARK_REQUESTS", kDefaultRequests);
+}
+
+/**
+ * @brief Adds requests, updates timeout of every request and
+ * terminates all of them by response in shuffled order, the way
+ * RequestController handles them.
+ * @return true if every request was found and removed
+ */
+template<typename Set>
+bool RunAndReport(const char* name, const std::vector<RequestKey>& keys) {
+  Set requests;
+  const double start = Now();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    requests.Add(new FakeRequestInfo(keys[i].app_id, keys[i].correlation_id,
+                                     10 + i % 20));
+  }
+  bool found_all = true;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const RequestInfoPtr request =
+        requests.Find(keys[i].app_id, keys[i].correlation_id);
+    found_all = found_all && request.valid();
+    if (request.valid()) {
+      requests.UpdateTimeOut(request, 30 - i % 20);
+    }
+  }
+  for (size_t i = keys.size(); i > 0; --i) {
+    const RequestInfoPtr request =
+        requests.Find(keys[i - 1].app_id, keys[i - 1].correlation_id);
+    found_all = found_all && request.valid();
+    if (request.valid()) {
+      requests.RemoveRequest(request);
+    }
+  }
+  const double elapsed = Now() - start;
+  printf("%-8s requests %6zu  operations/s %12.0f\n", name, keys.size(),
+         keys.size() * 3 / elapsed);
+  return found_all && 0 == requests.Size();
+}
+
+TEST(RequestInfoSetBenchmark, TerminateAndUpdateThousandsOfRequests) {
+  std::vector<RequestKey> keys;
+  const size_t amount = RequestsAmount();
+  for (size_t i = 0; i < amount; ++i) {
+    keys.push_back(RequestKey(i % kApplications + 1, i / kApplications + 1));
+  }
+  srand(1);
+  std::random_shuffle(keys.begin(), keys.end());
+
+  EXPECT_TRUE(RunAndReport<LinearRequestInfoSet>("linear", keys));
+  EXPECT_TRUE(RunAndReport<IndexedRequestInfoSet>("indexed", keys));
+}
+
+TEST(RequestInfoSetBenchmark, RequestsWithEqualEndTimeAreKept) {
+  RequestInfoSet requests;
+  const TimevalStruct end_time = date_time::DateTime::getCurrentTime();
+  for (uint32_t correlation_id = 1; correlation_id <= 3; ++correlation_id) {
+    FakeRequestInfo* request = new FakeRequestInfo(1, correlation_id, 10);
+    request->set_end_time(end_time);
+    EXPECT_TRUE(requests.Add(request));
+  }
+  EXPECT_EQ(3u, requests.Size());
+  EXPECT_FALSE(requests.Add(new FakeRequestInfo(1, 2, 10)));
+  EXPECT_EQ(3u, requests.Size());
+}
+
+TEST(RequestInfoSetBenchmark, RequestsAreFoundByConnectionKey) {
+  RequestInfoSet requests;
+  const RequestInfoPtr first_app_request = new FakeRequestInfo(1, 5, 10);
+  const RequestInfoPtr second_app_request = new FakeRequestInfo(2, 5, 10);
+  requests.Add(first_app_request);
+  requests.Add(second_app_request);
+
+  EXPECT_EQ(second_app_request.get(),
+            requests.Find(RequestInfo::MobileRequest, 2, 5).get());
+  EXPECT_FALSE(requests.Find(RequestInfo::HMIRequest, 0, 5).valid());
+
+  const std::vector<RequestInfoPtr> removed =
+      requests.RemoveByConnectionKey(1);
+  ASSERT_EQ(1u, removed.size());
+  EXPECT_EQ(first_app_request.get(), removed[0].get());
+  EXPECT_TRUE(requests.Find(RequestInfo::MobileRequest, 2, 5).valid());
+}
+
+TEST(RequestInfoSetBenchmark, FrontIsRequestExpiringFirst) {
+  RequestInfoSet requests;
+  const RequestInfoPtr not_tracked = new FakeRequestInfo(1, 1, 0);
+  const RequestInfoPtr late = new FakeRequestInfo(1, 2, 20);
+  const RequestInfoPtr early = new FakeRequestInfo(1, 3, 10);
+  requests.Add(not_tracked);
+  requests.Add(late);
+  requests.Add(early);
+  EXPECT_EQ(early.get(), requests.FrontWithNotNullTimeout().get());
+
+  requests.UpdateTimeOut(early, 30);
+  EXPECT_EQ(late.get(), requests.FrontWithNotNullTimeout().get());
+
+  requests.RemoveRequest(late);
+  requests.RemoveRequest(early);
+  EXPECT_FALSE(requests.FrontWithNotNullTimeout().valid());
+  EXPECT_EQ(1u, requests.Size());
+}
+
+}  // namespace request_info_set_benchmark
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
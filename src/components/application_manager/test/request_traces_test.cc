@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "application_manager/request_traces.h"
+#include "protocol/message_trace.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace request_traces_test {
+
+using ::application_manager::RequestTraces;
+using ::protocol_handler::MessageTrace;
+using ::protocol_handler::MessageTracePtr;
+
+const uint32_t kConnectionKey = 65537;
+const uint32_t kOtherConnectionKey = 65538;
+const uint32_t kCorrelationId = 7;
+const uint32_t kHmiCorrelationId = 100;
+
+MessageTracePtr StartedTrace() {
+  MessageTracePtr trace(new MessageTrace());
+  trace->Mark(MessageTrace::kTransportReceived);
+  return trace;
+}
+
+TEST(MessageTraceTest, StagesAreMeasuredFromTransportReceive) {
+  MessageTrace trace;
+  EXPECT_FALSE(trace.IsMarked(MessageTrace::kTransportReceived));
+  trace.Mark(MessageTrace::kTransportReceived);
+  usleep(1000);
+  trace.Mark(MessageTrace::kParsed);
+
+  EXPECT_TRUE(trace.IsMarked(MessageTrace::kParsed));
+  EXPECT_FALSE(trace.IsMarked(MessageTrace::kCommandRun));
+  EXPECT_LE(1000, trace.TimeFromStart(MessageTrace::kParsed));
+  EXPECT_EQ(0, trace.TimeFromStart(MessageTrace::kTransportReceived));
+  EXPECT_STREQ("parsed", MessageTrace::StageName(MessageTrace::kParsed));
+}
+
+TEST(RequestTracesTest, StagesAreMarkedUntilResponseIsSent) {
+  RequestTraces traces;
+  const MessageTracePtr trace = StartedTrace();
+  traces.Start(kConnectionKey, kCorrelationId, trace);
+  traces.Mark(kConnectionKey, kCorrelationId, MessageTrace::kCommandRun);
+  traces.Mark(kOtherConnectionKey, kCorrelationId, MessageTrace::kParsed);
+
+  EXPECT_TRUE(trace->IsMarked(MessageTrace::kCommandRun));
+  EXPECT_FALSE(trace->IsMarked(MessageTrace::kParsed));
+
+  EXPECT_EQ(trace.get(), traces.Finish(kConnectionKey, kCorrelationId).get());
+  EXPECT_EQ(0u, traces.size());
+  EXPECT_FALSE(traces.Finish(kConnectionKey, kCorrelationId));
+}
+
+TEST(RequestTracesTest, HmiRoundTripIsMarkedOnMobileRequest) {
+  RequestTraces traces;
+  const MessageTracePtr trace = StartedTrace();
+  traces.Start(kConnectionKey, kCorrelationId, trace);
+
+  traces.OnHmiRequest(kHmiCorrelationId, kConnectionKey, kCorrelationId);
+  const int64_t first_request = trace->time(MessageTrace::kHmiRequestSent);
+  usleep(1000);
+  traces.OnHmiRequest(kHmiCorrelationId + 1, kConnectionKey, kCorrelationId);
+  EXPECT_EQ(first_request, trace->time(MessageTrace::kHmiRequestSent));
+
+  traces.OnHmiResponse(kHmiCorrelationId);
+  const int64_t first_response =
+      trace->time(MessageTrace::kHmiResponseReceived);
+  EXPECT_LE(first_request, first_response);
+  usleep(1000);
+  traces.OnHmiResponse(kHmiCorrelationId + 1);
+  EXPECT_LT(first_response, trace->time(MessageTrace::kHmiResponseReceived));
+
+  // Response to forgotten HMI request doesn't change trace
+  const int64_t last_response =
+      trace->time(MessageTrace::kHmiResponseReceived);
+  traces.OnHmiResponse(kHmiCorrelationId);
+  EXPECT_EQ(last_response, trace->time(MessageTrace::kHmiResponseReceived));
+}
+
+TEST(RequestTracesTest, FinishedRequestIsNotMarkedByLateHmiResponse) {
+  RequestTraces traces;
+  const MessageTracePtr trace = StartedTrace();
+  traces.Start(kConnectionKey, kCorrelationId, trace);
+  traces.OnHmiRequest(kHmiCorrelationId, kConnectionKey, kCorrelationId);
+  traces.Finish(kConnectionKey, kCorrelationId);
+
+  traces.Start(kConnectionKey, kCorrelationId, StartedTrace());
+  traces.OnHmiResponse(kHmiCorrelationId);
+  EXPECT_FALSE(trace->IsMarked(MessageTrace::kHmiResponseReceived));
+  EXPECT_FALSE(traces.Finish(kConnectionKey, kCorrelationId)->IsMarked(
+      MessageTrace::kHmiResponseReceived));
+}
+
+TEST(RequestTracesTest, UnregisteredApplicationIsForgotten) {
+  RequestTraces traces;
+  traces.Start(kConnectionKey, kCorrelationId, StartedTrace());
+  traces.Start(kConnectionKey, kCorrelationId + 1, StartedTrace());
+  traces.Start(kOtherConnectionKey, kCorrelationId, StartedTrace());
+  traces.Start(kOtherConnectionKey, kCorrelationId + 1, MessageTracePtr());
+
+  traces.Forget(kConnectionKey);
+  EXPECT_EQ(1u, traces.size());
+  EXPECT_FALSE(traces.Finish(kConnectionKey, kCorrelationId));
+  EXPECT_TRUE(traces.Finish(kOtherConnectionKey, kCorrelationId));
+}
+
+}  // namespace request_traces_test
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "application_manager/storage_ledger.h"
+#include "utils/file_system.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+namespace storage_ledger_test {
+
+using ::application_manager::StorageLedger;
+
+const time_t kNeverReconcile = 3600;
+const time_t kReconcilePeriod = 1;
+const uint32_t kReconcileTimeoutMs = 5000;
+
+class StorageLedgerTest : public ::testing::Test {
+ protected:
+  StorageLedgerTest()
+    : storage_("storage_ledger_test_storage"),
+      app_folder_(storage_ + "/app"),
+      other_app_folder_(storage_ + "/other_app") {
+  }
+
+  virtual void SetUp() {
+    file_system::CreateDirectoryRecursively(app_folder_);
+    file_system::CreateDirectoryRecursively(other_app_folder_ + "/nested");
+    WriteFile(app_folder_ + "/icon.png", 100);
+    WriteFile(other_app_folder_ + "/nested/image.png", 30);
+  }
+
+  virtual void TearDown() {
+    file_system::RemoveDirectory(storage_, true);
+  }
+
+  static void WriteFile(const std::string& path, size_t size) {
+    file_system::WriteBinaryFile(path, std::vector<uint8_t>(size, 1));
+  }
+
+  const std::string storage_;
+  const std::string app_folder_;
+  const std::string other_app_folder_;
+};
+
+TEST_F(StorageLedgerTest, SeededFoldersAreNotWalkedAgain) {
+  StorageLedger ledger(kNeverReconcile);
+  ledger.Seed(storage_);
+  EXPECT_EQ(100u, ledger.UsedSpace(app_folder_));
+  EXPECT_EQ(30u, ledger.UsedSpace(other_app_folder_));
+
+  WriteFile(app_folder_ + "/unknown.png", 50);
+  EXPECT_EQ(100u, ledger.UsedSpace(app_folder_));
+}
+
+TEST_F(StorageLedgerTest, UpdatesChangeUsedSpace) {
+  StorageLedger ledger(kNeverReconcile);
+  ledger.Seed(storage_);
+
+  ledger.Update(app_folder_, 0, 40);
+  EXPECT_EQ(140u, ledger.UsedSpace(app_folder_));
+  ledger.Update(app_folder_, 40, 10);
+  EXPECT_EQ(110u, ledger.UsedSpace(app_folder_));
+  ledger.Update(app_folder_, 500, 0);
+  EXPECT_EQ(0u, ledger.UsedSpace(app_folder_));
+  EXPECT_EQ(30u, ledger.UsedSpace(other_app_folder_));
+}
+
+TEST_F(StorageLedgerTest, UnknownAndForgottenFoldersAreWalked) {
+  StorageLedger ledger(kNeverReconcile);
+  EXPECT_EQ(100u, ledger.UsedSpace(app_folder_));
+  EXPECT_EQ(0u, ledger.UsedSpace(storage_ + "/not_existing"));
+
+  WriteFile(app_folder_ + "/new.png", 50);
+  ledger.Forget(app_folder_);
+  EXPECT_EQ(150u, ledger.UsedSpace(app_folder_));
+}
+
+TEST_F(StorageLedgerTest, FoldersAreReconciledByTimer) {
+  StorageLedger ledger(kReconcilePeriod);
+  ledger.Seed(storage_);
+  ledger.Update(app_folder_, 0, 1000);
+  EXPECT_EQ(1100u, ledger.UsedSpace(app_folder_));
+
+  // Lookups don't walk the folder, it is reconciled by timer thread
+  const uint32_t kWaitStepMs = 100;
+  uint32_t waited_ms = 0;
+  while (1100u == ledger.UsedSpace(app_folder_) &&
+         waited_ms < kReconcileTimeoutMs) {
+    usleep(kWaitStepMs * 1000);
+    waited_ms += kWaitStepMs;
+  }
+  EXPECT_EQ(100u, ledger.UsedSpace(app_folder_));
+}
+
+}  // namespace storage_ledger_test
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -108,9 +108,15 @@ class Profile : public utils::Singleton<Profile> {
     const uint16_t& audio_streaming_port() const;
 
     /**
-      * @brief Returns port for time reports
+      * @brief Returns time in milliseconds messages to HMI are collected
+      * for to be sent in one batch, 0 if they are sent one by one
       */
-    const uint16_t& time_testing_port() const;
+    uint32_t hmi_coalescing_window() const;
+
+    /**
+      * @brief Returns path of UNIX socket for time reports
+      */
+    const std::string& time_testing_socket() const;
 
     /**
      * @brief Returns hmi capabilities file name
@@ -542,7 +548,8 @@ class Profile : public utils::Singleton<Profile> {
     uint16_t                        server_port_;
     uint16_t                        video_streaming_port_;
     uint16_t                        audio_streaming_port_;
-    uint16_t                        time_testing_port_;
+    uint32_t                        hmi_coalescing_window_;
+    std::string                     time_testing_socket_;
     std::string                     hmi_capabilities_file_name_;
     std::vector<std::string>        help_prompt_;
     std::vector<std::string>        time_out_promt_;
@@ -102,7 +102,8 @@ const char* kTCPAdapterPortKey = "TCPAdapterPort";
 const char* kServerPortKey = "ServerPort";
 const char* kVideoStreamingPortKey = "VideoStreamingPort";
 const char* kAudioStreamingPortKey = "AudioStreamingPort";
-const char* kTimeTestingPortKey = "TimeTestingPort";
+const char* kHmiCoalescingWindowKey = "HMICoalescingWindow";
+const char* kTimeTestingSocketKey = "TimeTestingSocket";
 const char* kThreadStackSizeKey = "ThreadStackSize";
 const char* kMaxCmdIdKey = "MaxCmdID";
 const char* kPutFileRequestKey = "PutFileRequest";
@@ -146,6 +147,7 @@ const char* kDefaultPreloadedPTFileName = "sdl_preloaded_pt.json";
 const char* kDefaultServerAddress = "127.0.0.1";
 const char* kDefaultAppInfoFileName = "app_info.dat";
 const char* kDefaultSystemFilesPath = "/tmp/fs/mp/images/ivsu_cache";
+const char* kDefaultTimeTestingSocket = "/tmp/sdl_time_tester.sock";
 const char* kDefaultTtsDelimiter = ",";
 const char* kDefaultMmeDatabaseName = "/dev/qdb/mediaservice_db";
 const char* kDefaultEventMQ = "/dev/mqueue/ToSDLCoreUSBAdapter";
@@ -165,7 +167,7 @@ const uint16_t kDefautTransportManagerTCPPort = 12345;
 const uint16_t kDefaultServerPort = 8087;
 const uint16_t kDefaultVideoStreamingPort = 5050;
 const uint16_t kDefaultAudioStreamingPort = 5080;
-const uint16_t kDefaultTimeTestingPort = 5090;
+const uint32_t kDefaultHmiCoalescingWindow = 0;
 const uint32_t kDefaultMaxCmdId = 2000000000;
 const uint32_t kDefaultPutFileRequestInNone = 5;
 const uint32_t kDefaultDeleteFileRequestInNone = 5;
@@ -204,7 +206,8 @@ Profile::Profile()
     server_port_(kDefaultServerPort),
     video_streaming_port_(kDefaultVideoStreamingPort),
     audio_streaming_port_(kDefaultAudioStreamingPort),
-    time_testing_port_(kDefaultTimeTestingPort),
+    hmi_coalescing_window_(kDefaultHmiCoalescingWindow),
+    time_testing_socket_(kDefaultTimeTestingSocket),
     hmi_capabilities_file_name_(kDefaultHmiCapabilitiesFileName),
     help_prompt_(),
     time_out_promt_(),
@@ -330,8 +333,12 @@ const uint16_t& Profile::audio_streaming_port() const {
   return audio_streaming_port_;
 }
 
-const uint16_t& Profile::time_testing_port() const {
-  return time_testing_port_;
+uint32_t Profile::hmi_coalescing_window() const {
+  return hmi_coalescing_window_;
+}
+
+const std::string& Profile::time_testing_socket() const {
+  return time_testing_socket_;
 }
 
 
@@ -614,12 +621,20 @@ ReadStringValue(&app_info_storage_, kDefaultAppInfoFileName,
     LOG_UPDATED_VALUE(audio_streaming_port_, kAudioStreamingPortKey,
                       kHmiSection);
 
+  // HMI coalescing window
+  ReadUIntValue(&hmi_coalescing_window_, kDefaultHmiCoalescingWindow,
+                kHmiSection, kHmiCoalescingWindowKey);
+
+  LOG_UPDATED_VALUE(hmi_coalescing_window_, kHmiCoalescingWindowKey,
+                    kHmiSection);
 
-    // Time testing port
-    ReadUIntValue(&time_testing_port_, kDefaultTimeTestingPort, kMainSection,
-                  kTimeTestingPortKey);
 
-    LOG_UPDATED_VALUE(time_testing_port_, kTimeTestingPortKey, kMainSection);
+    // Time testing socket
+    ReadStringValue(&time_testing_socket_, kDefaultTimeTestingSocket,
+                    kMainSection, kTimeTestingSocketKey);
+
+    LOG_UPDATED_VALUE(time_testing_socket_, kTimeTestingSocketKey,
+                      kMainSection);
 
     // Minimum thread stack size
     ReadUIntValue(&min_tread_stack_size_, threads::Thread::kMinStackSize,
@@ -112,6 +112,42 @@ class CFormatterJsonSDLRPCv2 : public CFormatterJsonBase {
                          FunctionId functionId, MessageType messageType,
                          int32_t correlationId);
 
+  /**
+   * @brief Creates a SmartObject from JSON in range of characters.
+   *
+   * JSON is parsed right from the range without copying it to string.
+   *
+   * @param begin Beginning of JSON in SDLRPCv2 format
+   * @param end End of JSON
+   * @param out Output SmartObject
+   * @param functionId The corresponding field in SmartObject is filled with this param.
+   * @param messageType The corresponding field in SmartObject is filled with this param.
+   * @return true if success, otherwise - false
+   */
+  template<typename FunctionId, typename MessageType>
+  static bool fromString(const char* begin, const char* end,
+                         NsSmartDeviceLink::NsSmartObjects::SmartObject &out,
+                         FunctionId functionId, MessageType messageType);
+
+  /**
+   * @brief Creates a SmartObject from JSON in range of characters.
+   *
+   * Version with CorrelationID.
+   *
+   * @param begin Beginning of JSON in SDLRPCv2 format
+   * @param end End of JSON
+   * @param out Output SmartObject
+   * @param functionId The corresponding field in SmartObject is filled with this param.
+   * @param messageType The corresponding field in SmartObject is filled with this param.
+   * @param correlatioId The corresponding field in SmartObject is filled with this param.
+   * @return true if success, otherwise - false
+   */
+  template<typename FunctionId, typename MessageType>
+  static bool fromString(const char* begin, const char* end,
+                         NsSmartDeviceLink::NsSmartObjects::SmartObject &out,
+                         FunctionId functionId, MessageType messageType,
+                         int32_t correlationId);
+
   /**
    * @brief Converts to string the smart object against the given schema
    *
@@ -130,6 +166,15 @@ template<typename FunctionId, typename MessageType>
 inline bool CFormatterJsonSDLRPCv2::fromString(
     const std::string& str, NsSmartDeviceLink::NsSmartObjects::SmartObject& out,
     FunctionId functionId, MessageType messageType) {
+  return fromString(str.data(), str.data() + str.size(), out, functionId,
+                    messageType);
+}
+
+template<typename FunctionId, typename MessageType>
+inline bool CFormatterJsonSDLRPCv2::fromString(
+    const char* begin, const char* end,
+    NsSmartDeviceLink::NsSmartObjects::SmartObject& out,
+    FunctionId functionId, MessageType messageType) {
   bool result = true;
 
   try {
@@ -137,7 +182,7 @@ inline bool CFormatterJsonSDLRPCv2::fromString(
     Json::Reader reader;
 
     namespace strings = NsSmartDeviceLink::NsJSONHandler::strings;
-    bool result = reader.parse(str, root);
+    bool result = reader.parse(begin, end, root);
 
     if (true == result) {
       out[strings::S_PARAMS][strings::S_MESSAGE_TYPE] = messageType;
@@ -159,7 +204,17 @@ inline bool CFormatterJsonSDLRPCv2::fromString(
     const std::string& str, NsSmartDeviceLink::NsSmartObjects::SmartObject& out,
     FunctionId functionId, MessageType messageType, int32_t correlationId) {
 
-  bool result = fromString(str, out, functionId, messageType);
+  return fromString(str.data(), str.data() + str.size(), out, functionId,
+                    messageType, correlationId);
+}
+
+template<typename FunctionId, typename MessageType>
+inline bool CFormatterJsonSDLRPCv2::fromString(
+    const char* begin, const char* end,
+    NsSmartDeviceLink::NsSmartObjects::SmartObject& out,
+    FunctionId functionId, MessageType messageType, int32_t correlationId) {
+
+  bool result = fromString(begin, end, out, functionId, messageType);
   namespace strings = NsSmartDeviceLink::NsJSONHandler::strings;
 
   if (true == result) {
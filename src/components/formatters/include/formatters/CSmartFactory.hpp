@@ -37,6 +37,7 @@
 
 #include "smart_objects/smart_object.h"
 #include "smart_objects/smart_schema.h"
+#include "smart_objects/compiled_schema_item.h"
 #include <map>
 #include <string>
 
@@ -234,8 +235,43 @@ namespace NsSmartDeviceLink
               const StructIdEnum struct_id,
               NsSmartDeviceLink::NsSmartObjects::CSmartSchema &result);
 
+          /**
+           * @brief Get reference SmartSchema for specific function.
+           *
+           * Reference schema is the dynamic schema built from the interface
+           * definition. It validates objects the same way the compiled
+           * validator attached by GetSchema/attachSchema does and is kept
+           * to check compiled validators against it.
+           *
+           * @param function_id FunctionID of the function.
+           * @param message_type messageType of the function.
+           * @param[out] result Copy of the reference function SmartSchema
+           *                    if it is found.
+           *
+           * @return True if reference schema for specified input parameters
+           *         is found or false otherwise.
+           */
+          bool GetReferenceSchema(
+              const FunctionIdEnum function_id,
+              const MessageTypeEnum message_type,
+              NsSmartDeviceLink::NsSmartObjects::CSmartSchema &result);
+
         protected:
 
+          /**
+           * @brief Adds function schema validated by generated code.
+           *
+           * @param function_id FunctionID of the function.
+           * @param message_type messageType of the function.
+           * @param reference_schema Schema built from interface definition.
+           * @param validator Validator generated from the same definition.
+           */
+          void AddCompiledFunctionSchema(
+              const FunctionIdEnum function_id,
+              const MessageTypeEnum message_type,
+              const NsSmartDeviceLink::NsSmartObjects::CSmartSchema &reference_schema,
+              NsSmartDeviceLink::NsSmartObjects::CompiledValidator validator);
+
           /**
            * @brief Defines map of SmartSchemaKeys to the SmartSchemes.
            *
@@ -265,12 +301,19 @@ namespace NsSmartDeviceLink
            * @brief Map of all struct shemes for this factory.
            */
           StructsSchemesMap structs_schemes_;
+
+          /**
+           * @brief Map of reference schemes of functions with compiled
+           *        validators.
+           */
+          FuncionsSchemesMap functions_reference_schemes_;
         };
 
         template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
         CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::CSmartFactory(void)
         : functions_schemes_(),
-          structs_schemes_()
+          structs_schemes_(),
+          functions_reference_schemes_()
         {
         }
 
@@ -398,6 +441,46 @@ namespace NsSmartDeviceLink
         return false;
       }
 
+      template <class FunctionIdEnum,
+          class MessageTypeEnum,
+          class StructIdEnum>
+      bool CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::
+      GetReferenceSchema(const FunctionIdEnum function_id,
+                         const MessageTypeEnum message_type,
+                         NsSmartDeviceLink::NsSmartObjects::CSmartSchema &result) {
+        SmartSchemaKey<FunctionIdEnum, MessageTypeEnum> key(function_id,
+                                                            message_type);
+
+        typename FuncionsSchemesMap::iterator schema_iterator =
+            functions_reference_schemes_.find(key);
+
+        if(schema_iterator != functions_reference_schemes_.end()) {
+          result = schema_iterator->second;
+          return true;
+        }
+
+        return GetSchema(function_id, message_type, result);
+      }
+
+      template <class FunctionIdEnum,
+          class MessageTypeEnum,
+          class StructIdEnum>
+      void CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::
+      AddCompiledFunctionSchema(
+          const FunctionIdEnum function_id,
+          const MessageTypeEnum message_type,
+          const NsSmartDeviceLink::NsSmartObjects::CSmartSchema &reference_schema,
+          NsSmartDeviceLink::NsSmartObjects::CompiledValidator validator) {
+        SmartSchemaKey<FunctionIdEnum, MessageTypeEnum> key(function_id,
+                                                            message_type);
+        functions_reference_schemes_.insert(
+            std::make_pair(key, reference_schema));
+        functions_schemes_.insert(std::make_pair(
+            key, NsSmartDeviceLink::NsSmartObjects::CSmartSchema(
+                NsSmartDeviceLink::NsSmartObjects::CCompiledSchemaItem::create(
+                    reference_schema, validator))));
+      }
+
         template <class FunctionIdEnum, class MessageTypeEnum>
         SmartSchemaKey<FunctionIdEnum, MessageTypeEnum>::SmartSchemaKey(FunctionIdEnum functionIdParam, MessageTypeEnum messageTypeParam)
         : functionId(functionIdParam)
@@ -0,0 +1,103 @@
+/**
+ * @file formatter_binary_rpc.h
+ * @brief FormatterBinaryRpc header file.
+ */
+// Copyright (c) 2014, Ford Motor Company
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following
+// disclaimer in the documentation and/or other materials provided with the
+// distribution.
+//
+// Neither the name of the Ford Motor Company nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 'A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SMARTDEVICELINK_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_FORMATTER_BINARY_RPC_H_
+#define SMARTDEVICELINK_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_FORMATTER_BINARY_RPC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "smart_objects/smart_object.h"
+
+namespace NsSmartDeviceLink {
+namespace NsJSONHandler {
+namespace Formatters {
+
+/**
+ * @brief Formatter for compact binary RPC format.
+ *
+ * Encodes SmartObject as CBOR (RFC 7049) data item: maps, arrays,
+ * strings, binaries, integers, doubles, booleans and null. Unlike
+ * FormatterJsonRpc whole message object is encoded as is, so params
+ * keep their names and enum values stay integers. Encoded message always
+ * starts with CBOR map header which can't be first byte of JSON text,
+ * so both formats may share one transport.
+ */
+class FormatterBinaryRpc {
+  public:
+    /**
+     * @brief Maximal nesting of maps and arrays accepted by FromBinary.
+     */
+    static const size_t kMaxDepth = 64;
+
+    /**
+     * @brief Creates binary message from a SmartObject.
+     *
+     * @param obj Input SmartObject, must be a map.
+     * @param out Resulting binary message.
+     *
+     * @return true if success, false otherwise.
+     */
+    static bool ToBinary(const NsSmartObjects::SmartObject& obj,
+                         NsSmartObjects::SmartBinary& out);
+
+    /**
+     * @brief Creates a SmartObject from binary message.
+     *
+     * @param data Input binary message.
+     * @param size Size of input message.
+     * @param out The resulting SmartObject.
+     *
+     * @return true if whole input is a single valid data item,
+     *         false otherwise.
+     */
+    static bool FromBinary(const uint8_t* data, size_t size,
+                           NsSmartObjects::SmartObject& out);
+
+    /**
+     * @brief Checks if data looks like message created by ToBinary.
+     *
+     * @param data Input message.
+     * @param size Size of input message.
+     *
+     * @return true if data starts with CBOR map header.
+     */
+    static bool IsBinaryMessage(const uint8_t* data, size_t size);
+};
+
+} // namespace Formatters
+} // namespace NsJSONHandler
+} // namespace NsSmartDeviceLink
+
+#endif // SMARTDEVICELINK_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_FORMATTER_BINARY_RPC_H_
@@ -0,0 +1,351 @@
+/**
+ * @file formatter_binary_rpc.cc
+ * @brief formatter_binary_rpc source file.
+ */
+// Copyright (c) 2014, Ford Motor Company
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following
+// disclaimer in the documentation and/or other materials provided with the
+// distribution.
+//
+// Neither the name of the Ford Motor Company nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 'A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <string.h>
+#include <limits>
+
+#include "formatters/formatter_binary_rpc.h"
+
+namespace NsSmartDeviceLink {
+namespace NsJSONHandler {
+namespace Formatters {
+
+namespace {
+
+namespace smart = NsSmartObjects;
+
+// CBOR major types
+const uint8_t kUnsigned = 0;
+const uint8_t kNegative = 1;
+const uint8_t kBytes = 2;
+const uint8_t kText = 3;
+const uint8_t kArray = 4;
+const uint8_t kMap = 5;
+const uint8_t kSimple = 7;
+
+// CBOR additional information values
+const uint8_t kOneByte = 24;
+const uint8_t kTwoBytes = 25;
+const uint8_t kFourBytes = 26;
+const uint8_t kEightBytes = 27;
+
+const uint8_t kFalse = 0xF4;
+const uint8_t kTrue = 0xF5;
+const uint8_t kNull = 0xF6;
+const uint8_t kDouble = 0xFB;
+
+const uint64_t kMaxInt64 = std::numeric_limits<int64_t>::max();
+
+void PutBigEndian(uint64_t value, size_t size, smart::SmartBinary& out) {
+  for (size_t i = size; i > 0; --i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+  }
+}
+
+void PutHead(uint8_t major, uint64_t value, smart::SmartBinary& out) {
+  const uint8_t type = major << 5;
+  if (value < kOneByte) {
+    out.push_back(type | static_cast<uint8_t>(value));
+  } else if (value <= 0xFFu) {
+    out.push_back(type | kOneByte);
+    PutBigEndian(value, 1, out);
+  } else if (value <= 0xFFFFu) {
+    out.push_back(type | kTwoBytes);
+    PutBigEndian(value, 2, out);
+  } else if (value <= 0xFFFFFFFFu) {
+    out.push_back(type | kFourBytes);
+    PutBigEndian(value, 4, out);
+  } else {
+    out.push_back(type | kEightBytes);
+    PutBigEndian(value, 8, out);
+  }
+}
+
+void PutText(const std::string& text, smart::SmartBinary& out) {
+  PutHead(kText, text.size(), out);
+  out.insert(out.end(), text.begin(), text.end());
+}
+
+bool PutItem(const smart::SmartObject& obj, smart::SmartBinary& out) {
+  switch (obj.getType()) {
+    case smart::SmartType_Null:
+      out.push_back(kNull);
+      return true;
+    case smart::SmartType_Boolean:
+      out.push_back(obj.asBool() ? kTrue : kFalse);
+      return true;
+    case smart::SmartType_Integer: {
+      const int64_t value = obj.asInt64();
+      if (value >= 0) {
+        PutHead(kUnsigned, static_cast<uint64_t>(value), out);
+      } else {
+        PutHead(kNegative, static_cast<uint64_t>(-(value + 1)), out);
+      }
+      return true;
+    }
+    case smart::SmartType_Double: {
+      const double value = obj.asDouble();
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      out.push_back(kDouble);
+      PutBigEndian(bits, sizeof(bits), out);
+      return true;
+    }
+    case smart::SmartType_Character:
+      PutText(std::string(1, obj.asChar()), out);
+      return true;
+    case smart::SmartType_String:
+      PutText(obj.asString(), out);
+      return true;
+    case smart::SmartType_Binary: {
+      const smart::SmartBinary binary = obj.asBinary();
+      PutHead(kBytes, binary.size(), out);
+      out.insert(out.end(), binary.begin(), binary.end());
+      return true;
+    }
+    case smart::SmartType_Array: {
+      const size_t length = obj.length();
+      PutHead(kArray, length, out);
+      for (size_t i = 0; i < length; ++i) {
+        if (!PutItem(obj.getElement(i), out)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case smart::SmartType_Map: {
+      PutHead(kMap, obj.length(), out);
+      for (smart::SmartMap::const_iterator it = obj.map_begin();
+           it != obj.map_end(); ++it) {
+        PutText(it->first, out);
+        if (!PutItem(it->second, out)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Sequential reader of CBOR data items with bounds checks.
+ */
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size)
+    : current_(data),
+      end_(data + size) {
+  }
+
+  bool AtEnd() const {
+    return current_ == end_;
+  }
+
+  bool GetItem(smart::SmartObject& obj, size_t depth) {
+    uint8_t major;
+    uint8_t info;
+    uint64_t value;
+    if (!GetHead(&major, &info, &value)) {
+      return false;
+    }
+    switch (major) {
+      case kUnsigned:
+        if (value > kMaxInt64) {
+          return false;
+        }
+        obj = static_cast<int64_t>(value);
+        return true;
+      case kNegative:
+        if (value > kMaxInt64) {
+          return false;
+        }
+        obj = -1 - static_cast<int64_t>(value);
+        return true;
+      case kBytes: {
+        if (!Has(value)) {
+          return false;
+        }
+        obj = smart::SmartBinary(current_, current_ + value);
+        current_ += value;
+        return true;
+      }
+      case kText: {
+        std::string text;
+        if (!GetText(value, text)) {
+          return false;
+        }
+        obj = text;
+        return true;
+      }
+      case kArray: {
+        // Each element takes at least one byte
+        if (depth >= FormatterBinaryRpc::kMaxDepth || !Has(value)) {
+          return false;
+        }
+        obj = smart::SmartObject(smart::SmartType_Array);
+        for (uint64_t i = 0; i < value; ++i) {
+          if (!GetItem(obj[static_cast<int32_t>(i)], depth + 1)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      case kMap: {
+        if (depth >= FormatterBinaryRpc::kMaxDepth || !Has(value)) {
+          return false;
+        }
+        obj = smart::SmartObject(smart::SmartType_Map);
+        for (uint64_t i = 0; i < value; ++i) {
+          std::string key;
+          if (!GetKey(key) || !GetItem(obj[key], depth + 1)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      case kSimple:
+        return GetSimple(info, value, obj);
+      default:
+        return false;
+    }
+  }
+
+ private:
+  bool Has(uint64_t size) const {
+    return size <= static_cast<uint64_t>(end_ - current_);
+  }
+
+  bool GetHead(uint8_t* major, uint8_t* info, uint64_t* value) {
+    if (!Has(1)) {
+      return false;
+    }
+    *major = *current_ >> 5;
+    *info = *current_ & 0x1F;
+    ++current_;
+    size_t size = 0;
+    if (*info < kOneByte) {
+      *value = *info;
+      return true;
+    }
+    switch (*info) {
+      case kOneByte: size = 1; break;
+      case kTwoBytes: size = 2; break;
+      case kFourBytes: size = 4; break;
+      case kEightBytes: size = 8; break;
+      default:
+        // Indefinite lengths and reserved values are not supported
+        return false;
+    }
+    if (!Has(size)) {
+      return false;
+    }
+    *value = 0;
+    for (size_t i = 0; i < size; ++i) {
+      *value = (*value << 8) | *current_++;
+    }
+    return true;
+  }
+
+  bool GetText(uint64_t size, std::string& text) {
+    if (!Has(size)) {
+      return false;
+    }
+    text.assign(reinterpret_cast<const char*>(current_), size);
+    current_ += size;
+    return true;
+  }
+
+  bool GetKey(std::string& key) {
+    uint8_t major;
+    uint8_t info;
+    uint64_t value;
+    return GetHead(&major, &info, &value) && kText == major &&
+        GetText(value, key);
+  }
+
+  bool GetSimple(uint8_t info, uint64_t value, smart::SmartObject& obj) {
+    switch (info) {
+      case kFalse & 0x1F:
+        obj = false;
+        return true;
+      case kTrue & 0x1F:
+        obj = true;
+        return true;
+      case kNull & 0x1F:
+        obj = smart::SmartObject();
+        return true;
+      case kDouble & 0x1F: {
+        double result;
+        memcpy(&result, &value, sizeof(result));
+        obj = result;
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  const uint8_t* current_;
+  const uint8_t* const end_;
+};
+
+}  // namespace
+
+bool FormatterBinaryRpc::ToBinary(const NsSmartObjects::SmartObject& obj,
+                                  NsSmartObjects::SmartBinary& out) {
+  out.clear();
+  if (NsSmartObjects::SmartType_Map != obj.getType()) {
+    return false;
+  }
+  return PutItem(obj, out);
+}
+
+bool FormatterBinaryRpc::FromBinary(const uint8_t* data, size_t size,
+                                    NsSmartObjects::SmartObject& out) {
+  if (!IsBinaryMessage(data, size)) {
+    return false;
+  }
+  Reader reader(data, size);
+  return reader.GetItem(out, 0) && reader.AtEnd();
+}
+
+bool FormatterBinaryRpc::IsBinaryMessage(const uint8_t* data, size_t size) {
+  return size > 0 && kMap == (data[0] >> 5);
+}
+
+} // namespace Formatters
+} // namespace NsJSONHandler
+} // namespace NsSmartDeviceLink
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "smart_objects/smart_object.h"
+#include "smart_objects/smart_schema.h"
+#include "smart_objects/enum_schema_item.h"
+#include "formatters/CSmartFactory.hpp"
+#include "interfaces/MOBILE_API_schema.h"
+#include "interfaces/HMI_API_schema.h"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+namespace smart = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = NsSmartDeviceLink::NsJSONHandler::strings;
+
+namespace {
+
+typedef std::vector<smart::SmartObject> Values;
+
+/**
+ * @brief Values every member is replaced with to break the message
+ * in all ways schemas are able to detect: wrong type, out of range
+ * numbers, too long strings and arrays of wrong elements.
+ */
+Values MutationValues() {
+  Values values;
+  values.push_back(smart::SmartObject(true));
+  values.push_back(smart::SmartObject(-1));
+  values.push_back(smart::SmartObject(1000000000));
+  values.push_back(smart::SmartObject(1.5));
+  values.push_back(smart::SmartObject(std::string()));
+  values.push_back(smart::SmartObject(std::string(1000, 'a')));
+  values.push_back(smart::SmartObject(smart::SmartType_Map));
+  smart::SmartObject array(smart::SmartType_Array);
+  array[0] = 1;
+  values.push_back(array);
+  values.push_back(smart::SmartObject(smart::SmartType_Array));
+  return values;
+}
+
+template<typename Factory, typename FunctionId, typename MessageType>
+class DifferentialChecker {
+ public:
+  DifferentialChecker(Factory& factory,
+                      FunctionId function_id,
+                      MessageType message_type,
+                      const smart::CSmartSchema& reference)
+    : factory_(factory),
+      function_id_(function_id),
+      message_type_(message_type),
+      reference_(reference),
+      mutations_(MutationValues()),
+      checked_(0) {
+  }
+
+  void Check(const smart::SmartObject& object) {
+    smart::SmartObject compiled_object(object);
+    ASSERT_TRUE(factory_.attachSchema(compiled_object));
+    EXPECT_EQ(reference_.validate(object), compiled_object.validate())
+        << "function_id " << function_id_
+        << ", message_type " << message_type_;
+    ++checked_;
+  }
+
+  /**
+   * @brief Checks object with every member of object[key] erased or
+   * replaced, descending into nested structs and first array elements.
+   */
+  void CheckMembers(smart::SmartObject& root, smart::SmartObject& target,
+                    int depth) {
+    const std::set<std::string> keys = target.enumerate();
+    for (std::set<std::string>::const_iterator it = keys.begin();
+         it != keys.end(); ++it) {
+      // Function id and message type select the schema itself
+      if (strings::S_FUNCTION_ID == *it || strings::S_MESSAGE_TYPE == *it) {
+        continue;
+      }
+      const smart::SmartObject original = target[*it];
+      target.erase(*it);
+      Check(root);
+      for (Values::const_iterator value = mutations_.begin();
+           value != mutations_.end(); ++value) {
+        target[*it] = *value;
+        Check(root);
+      }
+      target[*it] = original;
+      if (depth > 0) {
+        if (smart::SmartType_Map == target[*it].getType()) {
+          CheckMembers(root, target[*it], depth - 1);
+        } else if (smart::SmartType_Array == target[*it].getType() &&
+                   target[*it].length() > 0 &&
+                   smart::SmartType_Map == target[*it][0].getType()) {
+          CheckMembers(root, target[*it][0], depth - 1);
+        }
+      }
+    }
+  }
+
+  size_t checked() const {
+    return checked_;
+  }
+
+ private:
+  Factory& factory_;
+  const FunctionId function_id_;
+  const MessageType message_type_;
+  smart::CSmartSchema reference_;
+  const Values mutations_;
+  size_t checked_;
+};
+
+template<typename Factory, typename FunctionId, typename MessageType>
+size_t CheckAllFunctions(Factory& factory) {
+  typedef smart::EnumConversionHelper<FunctionId> FunctionIds;
+  typedef smart::EnumConversionHelper<MessageType> MessageTypes;
+  size_t checked = 0;
+
+  for (typename FunctionIds::EnumToCStringMap::const_iterator function =
+         FunctionIds::enum_to_cstring_map().begin();
+       function != FunctionIds::enum_to_cstring_map().end(); ++function) {
+    for (typename MessageTypes::EnumToCStringMap::const_iterator type =
+           MessageTypes::enum_to_cstring_map().begin();
+         type != MessageTypes::enum_to_cstring_map().end(); ++type) {
+      smart::CSmartSchema reference;
+      if (!factory.GetReferenceSchema(function->first, type->first,
+                                      reference)) {
+        continue;
+      }
+
+      smart::SmartObject object;
+      reference.BuildObjectBySchema(smart::SmartObject(), object);
+      smart::SmartObject& params = object[strings::S_PARAMS];
+      params[strings::S_FUNCTION_ID] = function->first;
+      params[strings::S_MESSAGE_TYPE] = type->first;
+      params[strings::S_PROTOCOL_VERSION] = 2;
+      params[strings::S_PROTOCOL_TYPE] = 0;
+      params[strings::S_CORRELATION_ID] = 1;
+      params[strings::kCode] = 0;
+
+      DifferentialChecker<Factory, FunctionId, MessageType> checker(
+          factory, function->first, type->first, reference);
+      checker.Check(object);
+      checker.CheckMembers(object, object[strings::S_PARAMS], 0);
+      checker.CheckMembers(object, object[strings::S_MSG_PARAMS], 2);
+      checked += checker.checked();
+    }
+  }
+  return checked;
+}
+
+}  // namespace
+
+TEST(CompiledValidatorsTest, MobileApiMatchesReferenceSchemas) {
+  mobile_apis::MOBILE_API factory;
+  EXPECT_LT(0u, (CheckAllFunctions<mobile_apis::MOBILE_API,
+                                   mobile_apis::FunctionID::eType,
+                                   mobile_apis::messageType::eType>(factory)));
+}
+
+TEST(CompiledValidatorsTest, HmiApiMatchesReferenceSchemas) {
+  hmi_apis::HMI_API factory;
+  EXPECT_LT(0u, (CheckAllFunctions<hmi_apis::HMI_API,
+                                   hmi_apis::FunctionID::eType,
+                                   hmi_apis::messageType::eType>(factory)));
+}
+
+TEST(CompiledValidatorsTest, MissingParamsAreRejected) {
+  mobile_apis::MOBILE_API factory;
+  smart::SmartObject object;
+  object[strings::S_PARAMS][strings::S_FUNCTION_ID] =
+      mobile_apis::FunctionID::AddCommandID;
+  object[strings::S_PARAMS][strings::S_MESSAGE_TYPE] =
+      mobile_apis::messageType::request;
+  ASSERT_TRUE(factory.attachSchema(object));
+  EXPECT_NE(smart::Errors::OK, object.validate());
+}
+
+}  // namespace formatters
+}  // namespace components
+}  // namespace test
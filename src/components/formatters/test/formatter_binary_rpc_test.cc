@@ -0,0 +1,238 @@
+// Copyright (c) 2014, Ford Motor Company
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following
+// disclaimer in the documentation and/or other materials provided with the
+// distribution.
+//
+// Neither the name of the Ford Motor Company nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR 'A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <iostream>
+
+#include "gtest/gtest.h"
+#include "test/utils/benchmark_helpers.h"
+#include "formatters/formatter_binary_rpc.h"
+#include "formatters/generic_json_formatter.h"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+namespace smartobj = NsSmartDeviceLink::NsSmartObjects;
+namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+using ::test::benchmark::Now;
+
+namespace {
+
+bool Decode(const smartobj::SmartBinary& binary, smartobj::SmartObject& out) {
+  return formatters::FormatterBinaryRpc::FromBinary(
+      binary.empty() ? NULL : &binary[0], binary.size(), out);
+}
+
+smartobj::SmartObject RoundTrip(const smartobj::SmartObject& obj) {
+  smartobj::SmartBinary binary;
+  EXPECT_TRUE(formatters::FormatterBinaryRpc::ToBinary(obj, binary));
+  smartobj::SmartObject result;
+  EXPECT_TRUE(Decode(binary, result));
+  return result;
+}
+
+/**
+ * @brief Builds object looking like VehicleInfo.OnVehicleData notification.
+ */
+smartobj::SmartObject VehicleDataNotification() {
+  smartobj::SmartObject obj(smartobj::SmartType_Map);
+  obj["params"]["function_id"] = 524294;
+  obj["params"]["message_type"] = 2;
+  obj["params"]["protocol_type"] = 1;
+  obj["params"]["protocol_version"] = 2;
+  smartobj::SmartObject& msg_params = obj["msg_params"];
+  msg_params["speed"] = 80.5;
+  msg_params["rpm"] = 2500;
+  msg_params["fuelLevel"] = 45.2;
+  msg_params["externalTemperature"] = -12.5;
+  msg_params["odometer"] = 123456;
+  msg_params["driverBraking"] = 1;
+  msg_params["gps"]["longitudeDegrees"] = 42.5;
+  msg_params["gps"]["latitudeDegrees"] = -83.3;
+  msg_params["gps"]["utcYear"] = 2014;
+  msg_params["gps"]["utcMonth"] = 5;
+  msg_params["gps"]["utcDay"] = 12;
+  msg_params["gps"]["compassDirection"] = 3;
+  msg_params["gps"]["actual"] = false;
+  msg_params["gps"]["dimension"] = 2;
+  for (int32_t i = 0; i < 4; ++i) {
+    msg_params["tirePressure"]["tires"][i]["status"] = i;
+  }
+  msg_params["vin"] = "1FAHP3F21CL123456";
+  return obj;
+}
+
+}  // namespace
+
+TEST(FormatterBinaryRpc, RoundTrip) {
+  smartobj::SmartObject obj(smartobj::SmartType_Map);
+  obj["null"] = smartobj::SmartObject();
+  obj["true"] = true;
+  obj["false"] = false;
+  obj["small"] = 10;
+  obj["byte"] = 200;
+  obj["short"] = 60000;
+  obj["int"] = 100500;
+  obj["negative"] = -25;
+  obj["int64"] = static_cast<int64_t>(-100000000000LL);
+  obj["double"] = 15.25;
+  obj["string"] = "string";
+  obj["long_string"] = std::string(300, 's');
+  obj["empty"] = std::string();
+  obj["binary"] = smartobj::SmartBinary(3, 0xFF);
+  obj["array"][0] = 1;
+  obj["array"][1]["key"] = "value";
+  obj["array"][2][0] = 2.5;
+  obj["map"]["nested"]["deeper"] = 1;
+
+  EXPECT_EQ(obj, RoundTrip(obj));
+
+  smartobj::SmartObject empty(smartobj::SmartType_Map);
+  EXPECT_EQ(empty, RoundTrip(empty));
+}
+
+TEST(FormatterBinaryRpc, Encoding) {
+  smartobj::SmartObject obj(smartobj::SmartType_Map);
+  obj["a"] = 1;
+  obj["b"][0] = -1;
+  obj["b"][1] = 500;
+
+  smartobj::SmartBinary binary;
+  ASSERT_TRUE(formatters::FormatterBinaryRpc::ToBinary(obj, binary));
+
+  const uint8_t expected[] = {
+    0xA2,                          // map of 2 pairs
+    0x61, 'a', 0x01,               // "a": 1
+    0x61, 'b', 0x82,               // "b": array of 2
+    0x20,                          // -1
+    0x19, 0x01, 0xF4               // 500
+  };
+  ASSERT_EQ(sizeof(expected), binary.size());
+  EXPECT_TRUE(std::equal(binary.begin(), binary.end(), expected));
+}
+
+TEST(FormatterBinaryRpc, OnlyMapsAreMessages) {
+  smartobj::SmartBinary binary;
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::ToBinary(
+      smartobj::SmartObject(10), binary));
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::ToBinary(
+      smartobj::SmartObject(smartobj::SmartType_Array), binary));
+
+  const std::string json = "{\"a\":1}";
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::IsBinaryMessage(
+      reinterpret_cast<const uint8_t*>(json.c_str()), json.size()));
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::IsBinaryMessage(NULL, 0));
+}
+
+TEST(FormatterBinaryRpc, MalformedInput) {
+  smartobj::SmartObject obj(smartobj::SmartType_Map);
+  obj["key"]["nested"] = "value";
+  smartobj::SmartBinary binary;
+  ASSERT_TRUE(formatters::FormatterBinaryRpc::ToBinary(obj, binary));
+
+  smartobj::SmartObject result;
+  // Every truncated message is rejected
+  for (size_t size = 0; size < binary.size(); ++size) {
+    EXPECT_FALSE(formatters::FormatterBinaryRpc::FromBinary(
+        &binary[0], size, result));
+  }
+
+  // Trailing data
+  smartobj::SmartBinary trailing(binary);
+  trailing.push_back(0);
+  EXPECT_FALSE(Decode(trailing, result));
+
+  // Indefinite length map
+  const uint8_t indefinite[] = { 0xBF, 0x61, 'a', 0x01, 0xFF };
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::FromBinary(
+      indefinite, sizeof(indefinite), result));
+
+  // Integer key
+  const uint8_t integer_key[] = { 0xA1, 0x01, 0x01 };
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::FromBinary(
+      integer_key, sizeof(integer_key), result));
+
+  // Length larger than input
+  const uint8_t long_string[] = { 0xA1, 0x61, 'a', 0x7A, 0xFF, 0xFF, 0xFF,
+                                  0xFF, 'b' };
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::FromBinary(
+      long_string, sizeof(long_string), result));
+
+  // Unsigned integer out of int64 range
+  const uint8_t huge[] = { 0xA1, 0x61, 'a', 0x1B, 0xFF, 0xFF, 0xFF, 0xFF,
+                           0xFF, 0xFF, 0xFF, 0xFF };
+  EXPECT_FALSE(formatters::FormatterBinaryRpc::FromBinary(
+      huge, sizeof(huge), result));
+
+  // Nesting deeper than allowed
+  smartobj::SmartBinary deep(1, 0xA1);
+  for (size_t i = 0; i < formatters::FormatterBinaryRpc::kMaxDepth; ++i) {
+    deep.push_back(0x61);
+    deep.push_back('a');
+    deep.push_back(0x81);
+  }
+  deep.push_back(0x01);
+  EXPECT_FALSE(Decode(deep, result));
+}
+
+TEST(FormatterBinaryRpc, LoopbackBenchmark) {
+  const smartobj::SmartObject notification = VehicleDataNotification();
+  const int32_t kIterations = 2000;
+
+  std::string json;
+  smartobj::SmartObject json_result;
+  const double json_start = Now();
+  for (int32_t i = 0; i < kIterations; ++i) {
+    formatters::GenericJsonFormatter::ToString(notification, json);
+    formatters::GenericJsonFormatter::FromString(json, json_result);
+  }
+  const double json_time = Now() - json_start;
+
+  smartobj::SmartBinary binary;
+  smartobj::SmartObject binary_result;
+  const double binary_start = Now();
+  for (int32_t i = 0; i < kIterations; ++i) {
+    formatters::FormatterBinaryRpc::ToBinary(notification, binary);
+    Decode(binary, binary_result);
+  }
+  const double binary_time = Now() - binary_start;
+
+  std::cout << "OnVehicleData x " << kIterations << ": JSON "
+            << json.size() << " bytes, " << json_time << " s; binary "
+            << binary.size() << " bytes, " << binary_time << " s"
+            << std::endl;
+
+  EXPECT_EQ(notification, binary_result);
+  EXPECT_LT(binary.size(), json.size());
+}
+
+} // formatters
+} // components
+} // test
@@ -30,20 +30,9 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_MECTRIC_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_MECTRIC_H_
+#include "gmock/gmock.h"
 
-#include <string>
-#include "metric_wrapper.h"
-#include "transport_manager_observer.h"
-
-namespace time_tester {
-
-class TransportManagerMecticWrapper: public MetricWrapper {
- public:
-  utils::SharedPtr<transport_manager::TMMetricObserver::MessageMetric> message_metric;
-  protected:
-    virtual Json::Value GetJsonMetric();
-};
-}  // namespace time_tester
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_MECTRIC_H_
+int main(int argc, char** argv) {
+ testing::InitGoogleMock(&argc, argv);
+ return RUN_ALL_TESTS();
+}
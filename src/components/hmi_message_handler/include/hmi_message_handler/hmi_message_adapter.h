@@ -56,6 +56,14 @@ class HMIMessageAdapter : public HMIMessageSender {
    */
   virtual ~HMIMessageAdapter();
 
+  /**
+   * \brief Sends messages to HMI in the given order.
+   * Adapters able to pass several messages in one write to their transport
+   * should override it, by default messages are sent one by one.
+   * \param messages Messages to send
+   */
+  virtual void SendMessagesToHMI(const MessageBatch& messages);
+
  protected:
   /**
    * \brief Interface for subscriptions.
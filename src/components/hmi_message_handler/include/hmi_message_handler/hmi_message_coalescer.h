@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_COALESCER_H_
+#define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_COALESCER_H_
+
+#include <stdint.h>
+#include <list>
+#include <map>
+#include <string>
+
+#include "hmi_message_handler/hmi_message_sender.h"
+#include "utils/conditional_variable.h"
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace hmi_message_handler {
+
+/**
+ * \class HMIMessageCoalescer
+ * \brief Collects messages to HMI for a short window starting with the first
+ * message of a burst and passes them to sink in one batch.
+ * Messages carrying only the latest state of something, like UpdateAppList,
+ * are superseded by the next message of the same kind within the window:
+ * older one is dropped and newer one takes its place at the end of batch,
+ * so that HMI never gets state older than the messages preceding it.
+ */
+class HMIMessageCoalescer : public threads::ThreadDelegate {
+ public:
+  /**
+   * \brief Receiver of coalesced messages, called on coalescer thread
+   */
+  struct Sink {
+    virtual void SendMessagesToHMI(const MessageBatch& messages) = 0;
+    /**
+     * \brief Called for message dropped in favor of newer one, on thread
+     * adding the newer message
+     */
+    virtual void OnMessageSuperseded(MessageSharedPointer message) = 0;
+    virtual ~Sink() {}
+  };
+
+  /**
+   * \brief Counters of messages passed through coalescer
+   */
+  struct Statistics {
+    Statistics();
+    // Messages added to coalescer
+    uint64_t received;
+    // Messages dropped because newer message of the same kind came
+    uint64_t superseded;
+    // Messages given to sink
+    uint64_t sent;
+    // Batches given to sink
+    uint64_t batches;
+    // Size of the largest batch
+    uint64_t largest_batch;
+  };
+
+  /**
+   * \brief Starts coalescer thread
+   * \param window_ms Time in milliseconds messages are collected for
+   * \param sink Receiver of batches, has to outlive coalescer
+   */
+  HMIMessageCoalescer(uint32_t window_ms, Sink* sink,
+                      const threads::ThreadOptions& thread_options =
+                          threads::ThreadOptions());
+  /**
+   * \brief Stops coalescer thread passing pending messages to sink
+   */
+  ~HMIMessageCoalescer();
+
+  /**
+   * \brief Puts message to current batch, starting a new window if
+   * there is no pending messages. Thread-safe.
+   */
+  void Add(const MessageSharedPointer& message);
+
+  Statistics statistics() const;
+
+  /**
+   * \brief Key of state |message| carries if it can be superseded
+   * by a later message with the same key, empty otherwise
+   */
+  static std::string SupersedingKey(const application_manager::Message& message);
+
+  // threads::ThreadDelegate overrides
+  virtual void threadMain() OVERRIDE;
+  virtual bool exitThreadMain() OVERRIDE;
+
+ private:
+  typedef std::list<MessageSharedPointer> PendingMessages;
+  typedef std::map<std::string, PendingMessages::iterator> PendingKeys;
+
+  // Passes pending messages to sink, |auto_lock| is released meanwhile
+  void Flush(sync_primitives::AutoLock& auto_lock);
+
+  const uint32_t window_ms_;
+  Sink& sink_;
+
+  mutable sync_primitives::Lock pending_lock_;
+  sync_primitives::ConditionalVariable pending_cond_;
+  PendingMessages pending_;
+  // Pending messages which can be superseded
+  PendingKeys pending_keys_;
+  // Time the first of pending messages was added
+  TimevalStruct window_start_;
+  Statistics statistics_;
+
+  bool stop_requested_;
+  // Set when threadMain is done, exitThreadMain waits for it
+  bool finished_;
+  sync_primitives::ConditionalVariable finished_cond_;
+
+  threads::Thread* thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(HMIMessageCoalescer);
+};
+
+}  // namespace hmi_message_handler
+
+#endif  // SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_COALESCER_H_
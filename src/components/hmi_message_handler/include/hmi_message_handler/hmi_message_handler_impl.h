@@ -35,10 +35,12 @@
 
 #include <set>
 #include "hmi_message_handler/hmi_message_adapter.h"
+#include "hmi_message_handler/hmi_message_coalescer.h"
 #include "hmi_message_handler/hmi_message_handler.h"
 #include "utils/macro.h"
 #include "utils/message_queue.h"
 #include "utils/prioritized_queue.h"
+#include "utils/shared_ptr.h"
 #include "utils/threads/message_loop_thread.h"
 #include "utils/threads/thread.h"
 #include "utils/singleton.h"
@@ -81,6 +83,7 @@ class HMIMessageHandlerImpl
     : public HMIMessageHandler,
       public impl::FromHmiQueue::Handler,
       public impl::ToHmiQueue::Handler,
+      public HMIMessageCoalescer::Sink,
       public utils::Singleton<HMIMessageHandlerImpl> {
  public:
   ~HMIMessageHandlerImpl();
@@ -101,12 +104,24 @@ class HMIMessageHandlerImpl
   virtual void Handle(const impl::MessageFromHmi message) OVERRIDE;
   // CALLED ON messages_to_hmi_ THREAD!
   virtual void Handle(const impl::MessageToHmi message) OVERRIDE;
+
+  // HMIMessageCoalescer::Sink implementation
+  // CALLED ON coalescer_ THREAD!
+  virtual void SendMessagesToHMI(const MessageBatch& messages) OVERRIDE;
+  // Also HMIMessageObserver implementation
+  // CALLED ON messages_to_hmi_ THREAD!
+  virtual void OnMessageSuperseded(MessageSharedPointer message) OVERRIDE;
  private:
 
   HMIMessageObserver* observer_;
   mutable sync_primitives::Lock observer_locker_;
   std::set<HMIMessageAdapter*> message_adapters_;
 
+  // Batches messages to hmi, null if coalescing is disabled.
+  // Declared before messages_to_hmi_ to get messages drained from it
+  // on destruction.
+  utils::SharedPtr<HMIMessageCoalescer> coalescer_;
+
   // Construct message threads when everything is already created
 
   // Thread that pumps messages being passed to hmi.
@@ -47,6 +47,9 @@ class HMIMessageObserver {
       utils::SharedPtr<application_manager::Message> message) = 0;
   virtual void OnErrorSending(
       utils::SharedPtr<application_manager::Message> message) = 0;
+  // Message to HMI was dropped, newer message of the same kind is sent
+  virtual void OnMessageSuperseded(
+      utils::SharedPtr<application_manager::Message> message) = 0;
 };
 }
 
@@ -33,10 +33,13 @@
 #ifndef SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_SENDER_H_
 #define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_SENDER_H_
 
+#include <vector>
+
 #include "application_manager/message.h"
 
 namespace hmi_message_handler {
   typedef utils::SharedPtr<application_manager::Message> MessageSharedPointer;
+  typedef std::vector<MessageSharedPointer> MessageBatch;
 
 class HMIMessageSender {
  public:
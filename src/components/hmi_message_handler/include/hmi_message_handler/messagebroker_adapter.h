@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_MESSAGEBROKER_ADAPTER_H_
 
 #include <string>
+#include <vector>
 
 #include "mb_controller.hpp"
 #include "hmi_message_handler/hmi_message_adapter.h"
@@ -49,6 +50,10 @@ class MessageBrokerAdapter : public HMIMessageAdapter,
                                 server_address, uint16_t port);
   ~MessageBrokerAdapter();
   void SendMessageToHMI(MessageSharedPointer message);
+  /**
+   * \brief Writes all messages to RPCBus at once.
+   */
+  void SendMessagesToHMI(const MessageBatch& messages);
 
   /*Methods from CMessageBrokerController*/
   /**
@@ -35,6 +35,7 @@
 
 #include <memory>
 #include <mqueue.h>
+#include "utils/lock.h"
 #include "utils/threads/thread.h"
 #include "hmi_message_handler/hmi_message_adapter.h"
 
@@ -42,20 +43,47 @@ namespace hmi_message_handler {
 
 /**
  * \brief HMI message adapter for mqueue
+ *
+ * Messages are JSON RPC strings by default. HMI may switch the link to
+ * compact binary format (see formatters::FormatterBinaryRpc) by sending
+ * its first message, normally BasicCommunication.OnReady, in binary
+ * format. After that all messages to HMI are sent in binary format,
+ * messages from HMI are accepted in both formats.
  */
 class MqueueAdapter : public HMIMessageAdapter {
  public:
+  enum MessageFormat {
+    kNotNegotiated,
+    kJsonFormat,
+    kBinaryFormat
+  };
+
   MqueueAdapter(HMIMessageHandler* hmi_message_handler);
   virtual ~MqueueAdapter();
 
+  /**
+   * \brief Format of messages sent to HMI
+   */
+  MessageFormat message_format() const;
+
  protected:
   virtual void SendMessageToHMI(MessageSharedPointer message);
   virtual void SubscribeTo();
 
  private:
+  friend class ReceiverThreadDelegate;
+
+  /**
+   * \brief Converts data received from HMI into message
+   * and negotiates message format on first call.
+   */
+  void ProcessReceived(const char* data, size_t size);
+
   mqd_t sdl_to_hmi_mqueue_;
   mqd_t hmi_to_sdl_mqueue_;
   threads::Thread* receiver_thread_;
+  MessageFormat message_format_;
+  mutable sync_primitives::Lock message_format_lock_;
 };
 
 }  // namespace hmi_message_handler
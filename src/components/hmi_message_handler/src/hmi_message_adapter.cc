@@ -41,4 +41,11 @@ HMIMessageAdapter::~HMIMessageAdapter() {
   handler_ = 0;
 }
 
+void HMIMessageAdapter::SendMessagesToHMI(const MessageBatch& messages) {
+  for (MessageBatch::const_iterator it = messages.begin();
+       it != messages.end(); ++it) {
+    SendMessageToHMI(*it);
+  }
+}
+
 }  // namespace hmi_message_handler
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hmi_message_handler/hmi_message_coalescer.h"
+
+#include <sstream>
+
+#include "application_manager/smart_object_keys.h"
+#include "interfaces/HMI_API.h"
+#include "utils/logger.h"
+
+namespace hmi_message_handler {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
+
+namespace {
+
+struct SupersedingRule {
+  hmi_apis::FunctionID::eType function_id;
+  application_manager::MessageType type;
+  // State is kept per application, message is keyed by its appID
+  bool per_application;
+};
+
+// Messages whose only content is the latest state of something,
+// so that HMI loses nothing if it gets only the last one of them.
+// Sink is told about superseded requests to stop waiting for response.
+const SupersedingRule kSupersedingRules[] = {
+  { hmi_apis::FunctionID::BasicCommunication_UpdateAppList,
+    application_manager::kRequest, false },
+  { hmi_apis::FunctionID::BasicCommunication_UpdateDeviceList,
+    application_manager::kRequest, false },
+  { hmi_apis::FunctionID::SDL_OnStatusUpdate,
+    application_manager::kNotification, false },
+  { hmi_apis::FunctionID::BasicCommunication_OnResumeAudioSource,
+    application_manager::kNotification, true }
+};
+
+}  // namespace
+
+HMIMessageCoalescer::Statistics::Statistics()
+  : received(0),
+    superseded(0),
+    sent(0),
+    batches(0),
+    largest_batch(0) {
+}
+
+HMIMessageCoalescer::HMIMessageCoalescer(
+    uint32_t window_ms, Sink* sink,
+    const threads::ThreadOptions& thread_options)
+  : window_ms_(window_ms),
+    sink_(*sink),
+    window_start_(),
+    stop_requested_(false),
+    finished_(false),
+    thread_(threads::CreateThread("HMH Coalescer", this)) {
+  DCHECK(sink);
+  if (!thread_->startWithOptions(thread_options)) {
+    LOG4CXX_ERROR(logger_, "Failed to start coalescer thread");
+  }
+}
+
+HMIMessageCoalescer::~HMIMessageCoalescer() {
+  thread_->stop();
+  // Thread object is still used after threadMain returns
+  thread_->join();
+  threads::DeleteThread(thread_);
+  LOG4CXX_INFO(logger_, "Coalesced messages to HMI: received "
+               << statistics_.received << ", superseded "
+               << statistics_.superseded << ", sent " << statistics_.sent
+               << " in " << statistics_.batches << " batches, largest "
+               << statistics_.largest_batch);
+}
+
+void HMIMessageCoalescer::Add(const MessageSharedPointer& message) {
+  const std::string key = SupersedingKey(*message);
+  MessageSharedPointer superseded;
+  {
+    sync_primitives::AutoLock auto_lock(pending_lock_);
+    ++statistics_.received;
+    if (pending_.empty()) {
+      window_start_ = date_time::DateTime::getCurrentTime();
+      pending_cond_.NotifyOne();
+    }
+    if (key.empty()) {
+      pending_.push_back(message);
+      return;
+    }
+    PendingKeys::iterator found = pending_keys_.find(key);
+    if (found != pending_keys_.end()) {
+      LOG4CXX_DEBUG(logger_, "Message " << key << " is superseded");
+      superseded = *found->second;
+      pending_.erase(found->second);
+      ++statistics_.superseded;
+    }
+    pending_keys_[key] = pending_.insert(pending_.end(), message);
+  }
+  if (superseded) {
+    sink_.OnMessageSuperseded(superseded);
+  }
+}
+
+HMIMessageCoalescer::Statistics HMIMessageCoalescer::statistics() const {
+  sync_primitives::AutoLock auto_lock(pending_lock_);
+  return statistics_;
+}
+
+std::string HMIMessageCoalescer::SupersedingKey(
+    const application_manager::Message& message) {
+  namespace strings = application_manager::strings;
+  const size_t rules_count =
+      sizeof(kSupersedingRules) / sizeof(kSupersedingRules[0]);
+  for (size_t i = 0; i < rules_count; ++i) {
+    const SupersedingRule& rule = kSupersedingRules[i];
+    if (rule.function_id != message.function_id() ||
+        rule.type != message.type()) {
+      continue;
+    }
+    std::stringstream key;
+    key << message.function_id() << ':' << message.type();
+    if (rule.per_application) {
+      const smart_objects::SmartObject& app_id =
+          message.smart_object()[strings::msg_params][strings::app_id];
+      if (smart_objects::SmartType_Integer != app_id.getType()) {
+        return std::string();
+      }
+      key << ':' << app_id.asUInt();
+    }
+    return key.str();
+  }
+  return std::string();
+}
+
+void HMIMessageCoalescer::threadMain() {
+  sync_primitives::AutoLock auto_lock(pending_lock_);
+  while (!stop_requested_) {
+    if (pending_.empty()) {
+      pending_cond_.Wait(auto_lock);
+      continue;
+    }
+    const int64_t elapsed = date_time::DateTime::calculateTimeSpan(
+        window_start_);
+    if (elapsed < window_ms_) {
+      pending_cond_.WaitFor(auto_lock, window_ms_ - elapsed);
+      continue;
+    }
+    Flush(auto_lock);
+  }
+  // Pass leftover messages
+  Flush(auto_lock);
+  finished_ = true;
+  finished_cond_.Broadcast();
+}
+
+bool HMIMessageCoalescer::exitThreadMain() {
+  sync_primitives::AutoLock auto_lock(pending_lock_);
+  stop_requested_ = true;
+  pending_cond_.NotifyOne();
+  // Prevent canceling thread until pending messages are sent
+  while (!finished_) {
+    finished_cond_.Wait(auto_lock);
+  }
+  return true;
+}
+
+void HMIMessageCoalescer::Flush(sync_primitives::AutoLock& auto_lock) {
+  if (pending_.empty()) {
+    return;
+  }
+  const MessageBatch batch(pending_.begin(), pending_.end());
+  pending_.clear();
+  pending_keys_.clear();
+  ++statistics_.batches;
+  statistics_.sent += batch.size();
+  if (batch.size() > statistics_.largest_batch) {
+    statistics_.largest_batch = batch.size();
+  }
+  LOG4CXX_DEBUG(logger_, "Sending batch of " << batch.size()
+                << " messages to HMI");
+  sync_primitives::AutoUnlock auto_unlock(auto_lock);
+  sink_.SendMessagesToHMI(batch);
+}
+
+}  // namespace hmi_message_handler
@@ -40,12 +40,23 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
 
 HMIMessageHandlerImpl::HMIMessageHandlerImpl()
     : observer_(NULL),
+      coalescer_(),
       messages_to_hmi_("HMH ToHMI", this,
                  threads::ThreadOptions(
                      profile::Profile::instance()->thread_min_stack_size())),
       messages_from_hmi_("HMH FromHMI", this,
                  threads::ThreadOptions(
                      profile::Profile::instance()->thread_min_stack_size())) {
+  const uint32_t window =
+      profile::Profile::instance()->hmi_coalescing_window();
+  if (window > 0) {
+    LOG4CXX_INFO(logger_, "Messages to HMI are coalesced for "
+                 << window << " ms");
+    coalescer_ = new HMIMessageCoalescer(
+        window, this,
+        threads::ThreadOptions(
+            profile::Profile::instance()->thread_min_stack_size()));
+  }
 }
 
 HMIMessageHandlerImpl::~HMIMessageHandlerImpl() {
@@ -114,6 +125,10 @@ void HMIMessageHandlerImpl::Handle(const impl::MessageFromHmi message) {
 
 }
 void HMIMessageHandlerImpl::Handle(const impl::MessageToHmi message) {
+  if (coalescer_) {
+    coalescer_->Add(message);
+    return;
+  }
   for (std::set<HMIMessageAdapter*>::iterator it =
       message_adapters_.begin();
       it != message_adapters_.end();
@@ -122,5 +137,24 @@ void HMIMessageHandlerImpl::Handle(const impl::MessageToHmi message) {
   }
 }
 
+void HMIMessageHandlerImpl::SendMessagesToHMI(const MessageBatch& messages) {
+  for (std::set<HMIMessageAdapter*>::iterator it =
+      message_adapters_.begin();
+      it != message_adapters_.end();
+      ++it) {
+    (*it)->SendMessagesToHMI(messages);
+  }
+}
+
+void HMIMessageHandlerImpl::OnMessageSuperseded(
+    MessageSharedPointer message) {
+  sync_primitives::AutoLock lock(observer_locker_);
+  if (!observer_) {
+    LOG4CXX_WARN(logger_, "No HMI message observer set!");
+    return;
+  }
+  observer_->OnMessageSuperseded(message);
+}
+
 
 }  //  namespace hmi_message_handler
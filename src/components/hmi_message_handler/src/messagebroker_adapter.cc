@@ -72,6 +72,26 @@ void MessageBrokerAdapter::SendMessageToHMI(
   sendJsonMessage(json_value);
 }
 
+void MessageBrokerAdapter::SendMessagesToHMI(const MessageBatch& messages) {
+  LOG4CXX_INFO(logger_, "MessageBrokerAdapter::SendMessagesToHMI");
+  Json::Reader reader;
+  std::vector<Json::Value> json_values;
+  json_values.reserve(messages.size());
+  for (MessageBatch::const_iterator it = messages.begin();
+       it != messages.end(); ++it) {
+    Json::Value json_value;
+    if (!reader.parse((*it)->json_message(), json_value, false)) {
+      LOG4CXX_ERROR(logger_, "Invalid json message to HMI");
+      continue;
+    }
+    json_values.push_back(json_value);
+  }
+  if (json_values.empty()) {
+    return;
+  }
+  sendJsonMessages(json_values);
+}
+
 void MessageBrokerAdapter::processResponse(std::string method,
     Json::Value& root) {
   LOG4CXX_INFO(logger_, "MessageBrokerAdapter::processResponse");
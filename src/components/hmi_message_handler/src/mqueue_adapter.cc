@@ -32,6 +32,8 @@
 
 #include "hmi_message_handler/mqueue_adapter.h"
 #include "hmi_message_handler/hmi_message_handler.h"
+#include "formatters/formatter_binary_rpc.h"
+#include "formatters/formatter_json_rpc.h"
 #include "utils/logger.h"
 
 namespace hmi_message_handler {
@@ -43,12 +45,14 @@ const char* kHmiToSdlQueue = "/hmi_to_sdl";
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
 
+namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+
 class ReceiverThreadDelegate : public threads::ThreadDelegate {
  public:
   ReceiverThreadDelegate(mqd_t mqueue_descriptor,
-                         HMIMessageHandler* hmi_message_handler)
+                         MqueueAdapter* adapter)
       : mqueue_descriptor_(mqueue_descriptor),
-        hmi_message_handler_(hmi_message_handler) {}
+        adapter_(adapter) {}
 
  private:
   virtual void threadMain() {
@@ -60,25 +64,20 @@ class ReceiverThreadDelegate : public threads::ThreadDelegate {
         LOG4CXX_ERROR(logger_, "Message queue receive failed, error " << errno);
         continue;
       }
-      const std::string message_string(buffer, buffer + size);
-      LOG4CXX_INFO(logger_, "Message: " << message_string);
-      MessageSharedPointer message(new application_manager::Message(
-          protocol_handler::MessagePriority::kDefault));
-      message->set_json_message(message_string);
-      message->set_protocol_version(application_manager::ProtocolVersion::kHMI);
-      hmi_message_handler_->OnMessageReceived(message);
+      adapter_->ProcessReceived(buffer, size);
     }
   }
 
   const mqd_t mqueue_descriptor_;
-  HMIMessageHandler* hmi_message_handler_;
+  MqueueAdapter* adapter_;
 };
 
 MqueueAdapter::MqueueAdapter(HMIMessageHandler* hmi_message_handler)
     : HMIMessageAdapter(hmi_message_handler),
       sdl_to_hmi_mqueue_(-1),
       hmi_to_sdl_mqueue_(-1),
-      receiver_thread_() {
+      receiver_thread_(),
+      message_format_(kNotNegotiated) {
   mq_attr mq_attributes;
   mq_attributes.mq_maxmsg = kMqueueSize;
   mq_attributes.mq_msgsize = kMqueueMessageSize;
@@ -97,7 +96,7 @@ MqueueAdapter::MqueueAdapter(HMIMessageHandler* hmi_message_handler)
     return;
   }
   ReceiverThreadDelegate* receiver_thread_delegate =
-      new ReceiverThreadDelegate(hmi_to_sdl_mqueue_, hmi_message_handler);
+      new ReceiverThreadDelegate(hmi_to_sdl_mqueue_, this);
   receiver_thread_ =
       threads::CreateThread("MqueueAdapter", receiver_thread_delegate);
   receiver_thread_->start();
@@ -121,12 +120,34 @@ void MqueueAdapter::SendMessageToHMI(const MessageSharedPointer message) {
     LOG4CXX_ERROR(logger_, "Message queue is not opened");
     return;
   }
-  const std::string& json = message->json_message();
-  if (json.size() > kMqueueMessageSize) {
-    LOG4CXX_ERROR(logger_, "Message size " << json.size() << " is too big");
+  const NsSmartDeviceLink::NsSmartObjects::SmartObject& smart_object =
+      message->smart_object();
+  const bool has_smart_object =
+      NsSmartDeviceLink::NsSmartObjects::SmartType_Map ==
+      smart_object.getType();
+
+  std::string data;
+  if (kBinaryFormat == message_format() && has_smart_object) {
+    NsSmartDeviceLink::NsSmartObjects::SmartBinary binary;
+    if (!formatters::FormatterBinaryRpc::ToBinary(smart_object, binary)) {
+      LOG4CXX_ERROR(logger_, "Could not create binary message");
+      return;
+    }
+    data.assign(binary.begin(), binary.end());
+  } else if (message->json_message().empty() && has_smart_object) {
+    if (!formatters::FormatterJsonRpc::ToString(smart_object, data)) {
+      LOG4CXX_ERROR(logger_, "Could not create JSON message");
+      return;
+    }
+  } else {
+    data = message->json_message();
+  }
+
+  if (data.size() > kMqueueMessageSize) {
+    LOG4CXX_ERROR(logger_, "Message size " << data.size() << " is too big");
     return;
   }
-  const int rc = mq_send(sdl_to_hmi_mqueue_, json.c_str(), json.size(), 0);
+  const int rc = mq_send(sdl_to_hmi_mqueue_, data.c_str(), data.size(), 0);
   if (0 != rc) {
     LOG4CXX_ERROR(logger_, "Could not send message, error " << errno);
     return;
@@ -139,4 +160,41 @@ void MqueueAdapter::SubscribeTo() {
   // empty implementation of pure virtual method, actually it's not called
 }
 
+MqueueAdapter::MessageFormat MqueueAdapter::message_format() const {
+  sync_primitives::AutoLock lock(message_format_lock_);
+  return message_format_;
+}
+
+void MqueueAdapter::ProcessReceived(const char* data, size_t size) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  const bool is_binary =
+      formatters::FormatterBinaryRpc::IsBinaryMessage(bytes, size);
+  {
+    sync_primitives::AutoLock lock(message_format_lock_);
+    if (kNotNegotiated == message_format_) {
+      message_format_ = is_binary ? kBinaryFormat : kJsonFormat;
+      LOG4CXX_INFO(logger_, "HMI message format is "
+                   << (is_binary ? "binary" : "JSON"));
+    }
+  }
+
+  MessageSharedPointer message(new application_manager::Message(
+      protocol_handler::MessagePriority::kDefault));
+  if (is_binary) {
+    NsSmartDeviceLink::NsSmartObjects::SmartObject smart_object;
+    if (!formatters::FormatterBinaryRpc::FromBinary(bytes, size,
+                                                    smart_object)) {
+      LOG4CXX_ERROR(logger_, "Invalid binary message of size " << size);
+      return;
+    }
+    message->set_smart_object(smart_object);
+  } else {
+    const std::string message_string(data, data + size);
+    LOG4CXX_INFO(logger_, "Message: " << message_string);
+    message->set_json_message(message_string);
+  }
+  message->set_protocol_version(application_manager::ProtocolVersion::kHMI);
+  handler()->OnMessageReceived(message);
+}
+
 }  // namespace hmi_message_handler
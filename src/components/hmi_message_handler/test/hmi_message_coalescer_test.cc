@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "application_manager/smart_object_keys.h"
+#include "hmi_message_handler/hmi_message_coalescer.h"
+#include "interfaces/HMI_API.h"
+#include "utils/lock.h"
+
+using hmi_message_handler::HMIMessageCoalescer;
+using hmi_message_handler::MessageBatch;
+using hmi_message_handler::MessageSharedPointer;
+using application_manager::Message;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+namespace {
+
+const uint32_t kWindowMs = 50;
+
+class RecordingSink : public HMIMessageCoalescer::Sink {
+ public:
+  virtual void SendMessagesToHMI(const MessageBatch& messages) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    batches_.push_back(messages);
+  }
+
+  virtual void OnMessageSuperseded(MessageSharedPointer message) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    superseded_.push_back(message);
+  }
+
+  std::vector<MessageBatch> batches() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return batches_;
+  }
+
+  MessageBatch superseded() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return superseded_;
+  }
+
+  // Waits up to a second for |count| batches
+  std::vector<MessageBatch> WaitForBatches(size_t count) const {
+    for (int i = 0; i < 100; ++i) {
+      if (batches().size() >= count) {
+        break;
+      }
+      usleep(10000);
+    }
+    return batches();
+  }
+
+ private:
+  mutable sync_primitives::Lock lock_;
+  std::vector<MessageBatch> batches_;
+  MessageBatch superseded_;
+};
+
+MessageSharedPointer CreateMessage(hmi_apis::FunctionID::eType function_id,
+                                   application_manager::MessageType type,
+                                   int32_t correlation_id = 0) {
+  MessageSharedPointer message(
+      new Message(protocol_handler::MessagePriority::kDefault));
+  message->set_function_id(function_id);
+  message->set_message_type(type);
+  message->set_correlation_id(correlation_id);
+  return message;
+}
+
+MessageSharedPointer CreateResumeAudioSource(uint32_t app_id) {
+  namespace strings = application_manager::strings;
+  MessageSharedPointer message =
+      CreateMessage(hmi_apis::FunctionID::BasicCommunication_OnResumeAudioSource,
+                    application_manager::kNotification);
+  smart_objects::SmartObject object(smart_objects::SmartType_Map);
+  object[strings::msg_params][strings::app_id] = app_id;
+  message->set_smart_object(object);
+  return message;
+}
+
+}  // namespace
+
+TEST(HMIMessageCoalescer, BatchesMessagesInOrder) {
+  RecordingSink sink;
+  HMIMessageCoalescer coalescer(kWindowMs, &sink);
+  MessageSharedPointer first =
+      CreateMessage(hmi_apis::FunctionID::UI_Show, application_manager::kRequest);
+  MessageSharedPointer second =
+      CreateMessage(hmi_apis::FunctionID::UI_Show, application_manager::kRequest);
+  coalescer.Add(first);
+  coalescer.Add(second);
+
+  const std::vector<MessageBatch> batches = sink.WaitForBatches(1);
+  ASSERT_EQ(1u, batches.size());
+  ASSERT_EQ(2u, batches[0].size());
+  EXPECT_EQ(first.get(), batches[0][0].get());
+  EXPECT_EQ(second.get(), batches[0][1].get());
+}
+
+TEST(HMIMessageCoalescer, SupersededMessageIsDropped) {
+  RecordingSink sink;
+  HMIMessageCoalescer coalescer(kWindowMs, &sink);
+  MessageSharedPointer old_list =
+      CreateMessage(hmi_apis::FunctionID::BasicCommunication_UpdateAppList,
+                    application_manager::kRequest, 1);
+  MessageSharedPointer show =
+      CreateMessage(hmi_apis::FunctionID::UI_Show, application_manager::kRequest);
+  MessageSharedPointer new_list =
+      CreateMessage(hmi_apis::FunctionID::BasicCommunication_UpdateAppList,
+                    application_manager::kRequest, 2);
+  coalescer.Add(old_list);
+  coalescer.Add(show);
+  coalescer.Add(new_list);
+
+  const std::vector<MessageBatch> batches = sink.WaitForBatches(1);
+  ASSERT_EQ(1u, batches.size());
+  ASSERT_EQ(2u, batches[0].size());
+  EXPECT_EQ(show.get(), batches[0][0].get());
+  EXPECT_EQ(new_list.get(), batches[0][1].get());
+
+  const MessageBatch superseded = sink.superseded();
+  ASSERT_EQ(1u, superseded.size());
+  EXPECT_EQ(old_list.get(), superseded[0].get());
+
+  const HMIMessageCoalescer::Statistics statistics = coalescer.statistics();
+  EXPECT_EQ(3u, statistics.received);
+  EXPECT_EQ(1u, statistics.superseded);
+  EXPECT_EQ(2u, statistics.sent);
+  EXPECT_EQ(1u, statistics.batches);
+  EXPECT_EQ(2u, statistics.largest_batch);
+}
+
+TEST(HMIMessageCoalescer, PerApplicationMessagesSupersedeSameApplication) {
+  RecordingSink sink;
+  HMIMessageCoalescer coalescer(kWindowMs, &sink);
+  coalescer.Add(CreateResumeAudioSource(1));
+  coalescer.Add(CreateResumeAudioSource(2));
+  MessageSharedPointer latest = CreateResumeAudioSource(1);
+  coalescer.Add(latest);
+
+  const std::vector<MessageBatch> batches = sink.WaitForBatches(1);
+  ASSERT_EQ(1u, batches.size());
+  ASSERT_EQ(2u, batches[0].size());
+  EXPECT_EQ(latest.get(), batches[0][1].get());
+  EXPECT_EQ(1u, coalescer.statistics().superseded);
+}
+
+TEST(HMIMessageCoalescer, RequestDoesNotSupersedeResponse) {
+  const MessageSharedPointer request =
+      CreateMessage(hmi_apis::FunctionID::BasicCommunication_UpdateAppList,
+                    application_manager::kRequest);
+  const MessageSharedPointer response =
+      CreateMessage(hmi_apis::FunctionID::BasicCommunication_UpdateAppList,
+                    application_manager::kResponse);
+  EXPECT_FALSE(HMIMessageCoalescer::SupersedingKey(*request).empty());
+  EXPECT_TRUE(HMIMessageCoalescer::SupersedingKey(*response).empty());
+}
+
+TEST(HMIMessageCoalescer, PendingMessagesAreSentOnDestruction) {
+  RecordingSink sink;
+  {
+    HMIMessageCoalescer coalescer(10000, &sink);
+    coalescer.Add(CreateMessage(hmi_apis::FunctionID::UI_Show,
+                                application_manager::kRequest));
+  }
+  const std::vector<MessageBatch> batches = sink.batches();
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_EQ(1u, batches[0].size());
+}
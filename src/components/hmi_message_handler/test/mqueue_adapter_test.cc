@@ -30,17 +30,22 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <gtest/gtest.h>
-#include <gmock/gmock.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
 
 #include "hmi_message_handler/hmi_message_handler.h"
 #include "hmi_message_handler/mqueue_adapter.h"
+#include "formatters/formatter_binary_rpc.h"
 
 using hmi_message_handler::MessageSharedPointer;
 using hmi_message_handler::HMIMessageHandler;
 using hmi_message_handler::HMIMessageAdapter;
 using hmi_message_handler::MqueueAdapter;
 using application_manager::Message;
+using NsSmartDeviceLink::NsJSONHandler::Formatters::FormatterBinaryRpc;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
 
 class MockHandler : public HMIMessageHandler {
  public:
@@ -48,6 +53,7 @@ class MockHandler : public HMIMessageHandler {
   virtual void AddHMIMessageAdapter(HMIMessageAdapter* adapter) {}
   virtual void RemoveHMIMessageAdapter(HMIMessageAdapter* adapter) {}
   virtual void OnErrorSending(MessageSharedPointer message) {}
+  virtual void OnMessageSuperseded(MessageSharedPointer message) {}
   virtual void SendMessageToHMI(MessageSharedPointer message) {}
 };
 
@@ -90,3 +96,57 @@ TEST(MqueueAdapter, Receive) {
 
   delete adapter;
 }
+
+TEST(MqueueAdapter, NegotiateBinaryFormat) {
+  MockHandler handler;
+  MqueueAdapter* adapter = new MqueueAdapter(&handler);
+  EXPECT_EQ(MqueueAdapter::kNotNegotiated, adapter->message_format());
+
+  smart_objects::SmartObject on_ready(smart_objects::SmartType_Map);
+  on_ready["params"]["function_id"] = 1;
+  on_ready["params"]["message_type"] = 2;
+  smart_objects::SmartBinary binary;
+  ASSERT_TRUE(FormatterBinaryRpc::ToBinary(on_ready, binary));
+
+  using ::testing::Property;
+  using ::testing::Pointee;
+  EXPECT_CALL(
+      handler,
+      OnMessageReceived(Property(
+          &MessageSharedPointer::get,
+          Pointee(Property(&Message::smart_object, on_ready)))));
+
+  mqd_t hmi_to_sdl = mq_open("/hmi_to_sdl", O_WRONLY);
+  ASSERT_NE(-1, hmi_to_sdl);
+  int rc = mq_send(hmi_to_sdl, reinterpret_cast<const char*>(&binary[0]),
+                   binary.size(), 0);
+  ASSERT_EQ(0, rc);
+
+  for (int i = 0; i < 100; ++i) {
+    if (MqueueAdapter::kNotNegotiated != adapter->message_format()) {
+      break;
+    }
+    usleep(10000);
+  }
+  ASSERT_EQ(MqueueAdapter::kBinaryFormat, adapter->message_format());
+
+  smart_objects::SmartObject request(smart_objects::SmartType_Map);
+  request["params"]["function_id"] = 2;
+  request["msg_params"]["text"] = "text";
+  MessageSharedPointer message(
+      new Message(protocol_handler::MessagePriority::kDefault));
+  message->set_smart_object(request);
+  static_cast<HMIMessageAdapter*>(adapter)->SendMessageToHMI(message);
+
+  mqd_t sdl_to_hmi = mq_open("/sdl_to_hmi", O_RDONLY);
+  ASSERT_NE(-1, sdl_to_hmi);
+  static uint8_t buf[65536];
+  ssize_t sz = mq_receive(sdl_to_hmi, reinterpret_cast<char*>(buf),
+                          sizeof(buf), NULL);
+  ASSERT_LT(0, sz);
+  smart_objects::SmartObject received;
+  ASSERT_TRUE(FormatterBinaryRpc::FromBinary(buf, sz, received));
+  EXPECT_EQ(request, received);
+
+  delete adapter;
+}
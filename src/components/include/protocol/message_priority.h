@@ -44,10 +44,24 @@ namespace protocol_handler {
 // prevent random priorities assignment in the code
 class MessagePriority {
  public:
+  // Urgency of message among messages of the same Service type
+  enum Urgency {
+    // Bulk binary data which may wait for other messages
+    kBulkData = 0,
+    kNormal,
+    // Control traffic which applications wait for: responses and
+    // changes of application state
+    kUrgent,
+    kUrgencyLevelsCount
+  };
   // Default (in other words non-prioritized) priority value
   static const MessagePriority kDefault;
   // Static constructor to get priority value of Service type
   static MessagePriority FromServiceType(ServiceType service_type);
+  // Static constructor to get priority value of message of Service type
+  // with given urgency, urgency orders messages of the same service only
+  static MessagePriority FromServiceType(ServiceType service_type,
+                                         Urgency urgency);
 
   // Trivial inline copy constructor
   MessagePriority(const MessagePriority &that);
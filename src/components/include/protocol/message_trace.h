@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_PROTOCOL_MESSAGE_TRACE_H_
+#define SRC_COMPONENTS_INCLUDE_PROTOCOL_MESSAGE_TRACE_H_
+
+#include <stdint.h>
+
+#include "utils/shared_ptr.h"
+
+namespace protocol_handler {
+
+/**
+ * \class MessageTrace
+ * \brief Times at which message from mobile passed stages of processing,
+ * from receiving by transport up to sending of response to it.
+ * Stages are marked by components one after another as message is passed
+ * between them, so trace is not locked.
+ */
+class MessageTrace {
+ public:
+  enum Stage {
+    kTransportReceived = 0,
+    kFrameAssembled,
+    kQueued,
+    kDequeued,
+    kParsed,
+    kCommandRun,
+    kHmiRequestSent,
+    kHmiResponseReceived,
+    kResponseSerialized,
+    kTransportSent,
+    kStagesCount
+  };
+
+  MessageTrace();
+
+  /**
+   * \brief Stores current time as time of |stage|
+   */
+  void Mark(Stage stage);
+
+  bool IsMarked(Stage stage) const;
+
+  /**
+   * \brief Time of |stage| in microseconds, zero if stage is not marked
+   */
+  int64_t time(Stage stage) const;
+
+  /**
+   * \brief Time from receiving of message to |stage| in microseconds
+   */
+  int64_t TimeFromStart(Stage stage) const;
+
+  int32_t function_id() const;
+  void set_function_id(int32_t function_id);
+
+  static const char* StageName(Stage stage);
+
+ private:
+  int64_t times_[kStagesCount];
+  int32_t function_id_;
+};
+
+typedef utils::SharedPtr<MessageTrace> MessageTracePtr;
+
+}  // namespace protocol_handler
+
+#endif  // SRC_COMPONENTS_INCLUDE_PROTOCOL_MESSAGE_TRACE_H_
@@ -36,6 +36,7 @@
 #include "utils/shared_ptr.h"
 #include "protocol/service_type.h"
 #include "protocol/message_priority.h"
+#include "protocol/message_trace.h"
 
 namespace protocol_handler {
 /**
@@ -58,6 +59,18 @@ class RawMessage {
              const uint8_t *const data_param, uint32_t data_size,
              uint8_t type = ServiceType::kRpc,
              uint32_t payload_size = 0);
+  /**
+   * \brief Creates message which takes ownership of |buffer| instead of
+   * copying it. Message data starts |header_room| bytes after beginning
+   * of buffer, so that protocol header can be written in front of data
+   * \param buffer Array allocated with new[] of header_room + data_size bytes
+   */
+  static RawMessage* CreateWithHeaderRoom(uint32_t connection_key,
+                                          uint32_t protocol_version,
+                                          uint8_t* buffer,
+                                          size_t header_room,
+                                          uint32_t data_size,
+                                          uint8_t type = ServiceType::kRpc);
   /**
    * \brief Destructor
    */
@@ -101,17 +114,57 @@ class RawMessage {
    */
   bool IsWaiting() const;
   void set_waiting(bool v);
+  /**
+   * \brief Size of room left in front of message data
+   */
+  size_t header_room() const;
+  /**
+   * \brief Extends message data |header_size| bytes back into room left
+   * in front of it
+   * \return New beginning of data where header has to be written
+   */
+  uint8_t *PrependHeader(size_t header_size);
+  /**
+   * \brief Trace of message processing, empty if message is not traced
+   */
+  MessageTracePtr trace() const;
+  void set_trace(const MessageTracePtr trace);
+  /**
+   * \brief Priority of message on its way to mobile,
+   * by default it is priority of message service type
+   */
+  MessagePriority priority() const;
+  void set_priority(const MessagePriority& priority);
 
  private:
   uint32_t connection_key_;
+  // Beginning of allocated array, data_ follows header room in it
+  uint8_t *buffer_;
+  size_t header_room_;
   uint8_t *data_;
   size_t data_size_;
   uint32_t protocol_version_;
   ServiceType service_type_;
   size_t payload_size_;
   bool waiting_;
+  MessageTracePtr trace_;
+  MessagePriority priority_;
   DISALLOW_COPY_AND_ASSIGN(RawMessage);
 };
 typedef  utils::SharedPtr<RawMessage> RawMessagePtr;
+
+/**
+ * \brief Raw message kept in utils::PrioritizedQueue according to
+ * its priority
+ */
+struct PrioritizedRawMessage: public RawMessagePtr {
+  PrioritizedRawMessage(const RawMessagePtr message)
+    : RawMessagePtr(message) {
+  }
+  // PrioritizedQueue requires this method to decide which priority to assign
+  size_t PriorityOrder() const {
+    return get()->priority().OrderingValue();
+  }
+};
 }  // namespace protocol_handler
 #endif  // SRC_COMPONENTS_INCLUDE_PROTOCOL_RAW_MESSAGE_H_
@@ -30,27 +30,42 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_MECTRIC_WRAPPER_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_MECTRIC_WRAPPER_H_
+#ifndef SRC_COMPONENTS_INCLUDE_TEST_UTILS_BENCHMARK_HELPERS_H_
+#define SRC_COMPONENTS_INCLUDE_TEST_UTILS_BENCHMARK_HELPERS_H_
 
-#include <string>
+#include <stdlib.h>
+#include <time.h>
 
-#include "metric_wrapper.h"
-#include "application_manager_observer.h"
+namespace test {
+namespace benchmark {
 
+/**
+ * @brief Returns monotonic time in seconds
+ */
+inline double Now() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
 
-namespace time_tester {
-
-class ApplicationManagerObserver;
-
-class ApplicationManagerMetricWrapper: public MetricWrapper {
-
-  public:
-    utils::SharedPtr<application_manager::AMMetricObserver::MessageMetric> message_metric;
+/**
+ * @brief Returns positive number set in environment variable, so benchmark
+ * load can be changed without rebuilding
+ * @param name Name of environment variable
+ * @param default_value Value returned if variable is not set or not positive
+ */
+inline size_t EnvironmentValue(const char* name, size_t default_value) {
+  const char* value = getenv(name);
+  if (value) {
+    const long parsed = strtol(value, NULL, 10);
+    if (parsed > 0) {
+      return static_cast<size_t>(parsed);
+    }
+  }
+  return default_value;
+}
 
-  protected:
-    virtual Json::Value GetJsonMetric();
-};
+}  // namespace benchmark
+}  // namespace test
 
-}
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_MECTRIC_WRAPPER_H_
+#endif  // SRC_COMPONENTS_INCLUDE_TEST_UTILS_BENCHMARK_HELPERS_H_
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_FAIR_PRIORITIZED_QUEUE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_FAIR_PRIORITIZED_QUEUE_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <queue>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Template queue class that gives out messages respecting their priority
+ * and shares each priority level between message sources with deficit
+ * round robin, so a source flooding the queue does not delay the others.
+ * Message class must have following methods implemented:
+ * size_t PriorityOrder() - priority of message, as for PrioritizedQueue
+ * uint32_t FairQueueKey() - source of message, e.g. connection key
+ * size_t FairQueueCost() - cost of message processing, e.g. its size
+ */
+template < typename M >
+class FairPrioritizedQueue {
+ public:
+  typedef M value_type;
+  typedef uint32_t key_type;
+  // Cost credited to source each time its turn comes
+  static const size_t kDefaultQuantum = 4096;
+
+  explicit FairPrioritizedQueue(size_t quantum = kDefaultQuantum)
+    : quantum_(std::max<size_t>(quantum, 1)),
+      total_size_(0) {
+  }
+  // All api mimics usual std queue interface
+  void push(const value_type& message) {
+    Level& level = levels_[message.PriorityOrder()];
+    const key_type key = message.FairQueueKey();
+    Source& source = level.sources[key];
+    if (source.messages.empty()) {
+      // Source which is new in round gets credit for its first turn
+      source.deficit = quantum_;
+      level.active.push_back(key);
+    }
+    source.messages.push(message);
+    ++sizes_[key];
+    ++total_size_;
+  }
+  size_t size() const {
+    return total_size_;
+  }
+  // Number of messages of |key| source on all priority levels
+  size_t size(key_type key) const {
+    typename Sizes::const_iterator it = sizes_.find(key);
+    return sizes_.end() == it ? 0 : it->second;
+  }
+  bool empty() const {
+    return levels_.empty();
+  }
+  value_type front() {
+    DCHECK(!levels_.empty());
+    return NextSource(levels_.rbegin()->second).messages.front();
+  }
+  void pop() {
+    DCHECK(!levels_.empty());
+    typename Levels::iterator last = --levels_.end();
+    Level& level = last->second;
+    Source& source = NextSource(level);
+    const key_type key = level.active.front();
+    source.deficit -= Cost(source.messages.front());
+    source.messages.pop();
+    --total_size_;
+    typename Sizes::iterator size = sizes_.find(key);
+    if (0 == --size->second) {
+      sizes_.erase(size);
+    }
+    if (source.messages.empty()) {
+      // Unused credit is not saved by source which left round
+      level.sources.erase(key);
+      level.active.pop_front();
+      if (level.active.empty()) {
+        levels_.erase(last);
+      }
+    }
+  }
+  void swap(FairPrioritizedQueue& other) {
+    std::swap(quantum_, other.quantum_);
+    levels_.swap(other.levels_);
+    sizes_.swap(other.sizes_);
+    std::swap(total_size_, other.total_size_);
+  }
+
+ private:
+  struct Source {
+    Source() : deficit(0) {}
+    std::queue<value_type> messages;
+    size_t deficit;
+  };
+  struct Level {
+    std::map<key_type, Source> sources;
+    // Sources having messages in order of their turns
+    std::deque<key_type> active;
+  };
+  // std::map guarantees it's contents is sorted by key
+  typedef std::map<size_t, Level> Levels;
+  typedef std::map<key_type, size_t> Sizes;
+
+  static size_t Cost(const value_type& message) {
+    // Free messages would let source to keep its turn forever
+    return std::max<size_t>(message.FairQueueCost(), 1);
+  }
+
+  // Source of level which turn it is, passes turn to next source until
+  // one has enough credit for its first message
+  Source& NextSource(Level& level) {
+    DCHECK(!level.active.empty());
+    for (;;) {
+      Source& source = level.sources[level.active.front()];
+      if (source.deficit >= Cost(source.messages.front())) {
+        return source;
+      }
+      source.deficit += quantum_;
+      level.active.push_back(level.active.front());
+      level.active.pop_front();
+    }
+  }
+
+  size_t quantum_;
+  Levels levels_;
+  Sizes sizes_;
+  size_t total_size_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_FAIR_PRIORITIZED_QUEUE_H_
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_FREE_LIST_POOL_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_FREE_LIST_POOL_H_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <set>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace utils {
+
+/**
+ * @brief Keeps freed memory blocks in free lists by size class and gives
+ * them out again instead of allocating from heap. Objects of one type
+ * always get blocks of one size class, so pool works as set of per type
+ * free lists for class which routes its operator new and delete here.
+ *
+ * Every thread has its own free lists, so allocation and deallocation
+ * take no lock. Block freed by other thread than allocated it goes to
+ * free lists of freeing thread. Free lists of exited thread are returned
+ * to heap.
+ *
+ * Blocks bigger than max_block_size are allocated from heap directly.
+ * Every size class of thread keeps at most max_free_blocks blocks, the
+ * rest are returned to heap.
+ */
+class FreeListPool {
+ public:
+  struct Statistics {
+    Statistics()
+      : allocations(0),
+        reused(0),
+        heap_allocations(0),
+        heap_releases(0),
+        live(0),
+        pooled(0) {
+    }
+    // Allocations requested from pool
+    uint64_t allocations;
+    // Allocations served from free lists
+    uint64_t reused;
+    // Allocations and releases passed to heap
+    uint64_t heap_allocations;
+    uint64_t heap_releases;
+    // Blocks given out and not freed yet
+    uint64_t live;
+    // Blocks kept in free lists
+    uint64_t pooled;
+  };
+
+  FreeListPool(size_t max_block_size, size_t max_free_blocks);
+
+  /**
+   * @brief Frees blocks of all free lists. Pool must not be used by other
+   * threads while it is destroyed.
+   */
+  ~FreeListPool();
+
+  void* Allocate(size_t size);
+
+  /**
+   * @param size Size of block given to Allocate
+   */
+  void Deallocate(void* memory, size_t size);
+
+  /**
+   * @brief Sums counters of all threads. Counters of running threads are
+   * read without synchronization, so they may be slightly behind.
+   */
+  Statistics statistics() const;
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Counters {
+    Counters()
+      : allocations(0),
+        deallocations(0),
+        reused(0),
+        heap_allocations(0),
+        heap_releases(0) {
+    }
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t reused;
+    uint64_t heap_allocations;
+    uint64_t heap_releases;
+  };
+
+  struct ThreadCache {
+    ThreadCache(FreeListPool* pool, size_t classes_count)
+      : pool(pool),
+        free_lists(classes_count, static_cast<FreeBlock*>(NULL)),
+        free_counts(classes_count, 0) {
+    }
+    FreeListPool* pool;
+    std::vector<FreeBlock*> free_lists;
+    std::vector<size_t> free_counts;
+    Counters counters;
+  };
+
+  static const size_t kGranularity = 16;
+
+  /**
+   * @brief Returns index of size class, which is not less than
+   * classes count for blocks not kept in pool
+   */
+  size_t SizeClass(size_t size) const;
+
+  ThreadCache* cache();
+
+  /**
+   * @brief Returns blocks of exited thread to heap and keeps its counters
+   */
+  static void ReleaseCache(void* cache);
+  void Release(ThreadCache* cache);
+
+  const size_t max_block_size_;
+  const size_t max_free_blocks_;
+  const size_t classes_count_;
+  pthread_key_t cache_key_;
+
+  std::set<ThreadCache*> caches_;
+  // Counters of exited threads
+  Counters released_counters_;
+  mutable sync_primitives::Lock caches_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(FreeListPool);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_FREE_LIST_POOL_H_
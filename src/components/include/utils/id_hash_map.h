@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_ID_HASH_MAP_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_ID_HASH_MAP_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+namespace utils {
+
+/*
+ * Map from uint32_t ids, e.g. application ids, to values kept in open
+ * addressing hash table with linear probing, so lookup usually costs
+ * hashing of id and a single comparison instead of a tree walk.
+ * Load factor is kept at most 1/2 so probing always meets an empty bucket.
+ * Erasing shifts following buckets back instead of leaving tombstones.
+ * Pointers to values are valid until map is changed.
+ */
+template <typename V>
+class IdHashMap {
+ public:
+  typedef uint32_t key_type;
+  typedef V mapped_type;
+
+  IdHashMap()
+    : size_(0) {
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return 0 == size_;
+  }
+
+  void clear() {
+    buckets_.clear();
+    size_ = 0;
+  }
+
+  /*
+   * Value of |key| or NULL if there is no such key
+   */
+  V* find(key_type key) {
+    if (buckets_.empty()) {
+      return NULL;
+    }
+    Bucket& bucket = buckets_[FindBucket(key)];
+    return bucket.used ? &bucket.value : NULL;
+  }
+
+  const V* find(key_type key) const {
+    return const_cast<IdHashMap*>(this)->find(key);
+  }
+
+  /*
+   * Value of |key|, default constructed value is inserted if there is none
+   */
+  V& operator[](key_type key) {
+    if (2 * (size_ + 1) > buckets_.size()) {
+      Grow();
+    }
+    Bucket& bucket = buckets_[FindBucket(key)];
+    if (!bucket.used) {
+      bucket.used = true;
+      bucket.key = key;
+      ++size_;
+    }
+    return bucket.value;
+  }
+
+  /*
+   * Removes |key|, returns false if there was no such key
+   */
+  bool erase(key_type key) {
+    if (buckets_.empty()) {
+      return false;
+    }
+    const size_t mask = buckets_.size() - 1;
+    size_t hole = FindBucket(key);
+    if (!buckets_[hole].used) {
+      return false;
+    }
+    for (size_t next = (hole + 1) & mask; buckets_[next].used;
+         next = (next + 1) & mask) {
+      // Bucket can move back to the hole unless its home bucket lies
+      // cyclically after the hole
+      const size_t home = Hash(buckets_[next].key) & mask;
+      const bool stays = (hole <= next) ?
+                         (hole < home && home <= next) :
+                         (hole < home || home <= next);
+      if (!stays) {
+        std::swap(buckets_[hole], buckets_[next]);
+        hole = next;
+      }
+    }
+    buckets_[hole] = Bucket();
+    --size_;
+    return true;
+  }
+
+ private:
+  struct Bucket {
+    Bucket()
+      : used(false),
+        key(0),
+        value() {
+    }
+    bool used;
+    key_type key;
+    V value;
+  };
+
+  static size_t Hash(key_type key) {
+    // Finalizer of MurmurHash3, ids often differ only in high bits
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+    return key;
+  }
+
+  // Bucket holding |key| or empty bucket where it has to be put
+  size_t FindBucket(key_type key) const {
+    const size_t mask = buckets_.size() - 1;
+    size_t index = Hash(key) & mask;
+    while (buckets_[index].used && buckets_[index].key != key) {
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  void Grow() {
+    std::vector<Bucket> old_buckets(std::max<size_t>(8, 2 * buckets_.size()));
+    old_buckets.swap(buckets_);
+    for (size_t i = 0; i < old_buckets.size(); ++i) {
+      if (old_buckets[i].used) {
+        std::swap(buckets_[FindBucket(old_buckets[i].key)], old_buckets[i]);
+      }
+    }
+  }
+
+  std::vector<Bucket> buckets_;
+  size_t size_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_ID_HASH_MAP_H_
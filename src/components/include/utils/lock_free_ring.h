@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_LOCK_FREE_RING_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_LOCK_FREE_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils/macro.h"
+#include "utils/memory_barrier.h"
+
+namespace utils {
+
+/**
+ * @brief Fixed size ring buffer for exactly one producer thread and one
+ * consumer thread which don't take any lock.
+ *
+ * Producer writes element before publishing new tail and consumer reads
+ * element before publishing new head, barriers keep this order visible to
+ * other thread. Full ring rejects new elements instead of overwriting
+ * ones which consumer may be reading.
+ * Capacity must be power of two.
+ */
+template<typename T, size_t Capacity>
+class LockFreeRing {
+ public:
+  LockFreeRing()
+    : head_(0),
+      tail_(0) {
+  }
+
+  /**
+   * @brief Appends element, called only by producer
+   * @return false if ring is full
+   */
+  bool Push(const T& element) {
+    const uint32_t tail = tail_;
+    if (tail - head_ == Capacity) {
+      return false;
+    }
+    // Slot is written only after consumer is seen to be done with it
+    memory_barrier();
+    elements_[tail & kMask] = element;
+    memory_barrier();
+    tail_ = tail + 1;
+    return true;
+  }
+
+  /**
+   * @brief Takes oldest element, called only by consumer
+   * @return false if ring is empty
+   */
+  bool Pop(T* element) {
+    const uint32_t head = head_;
+    if (head == tail_) {
+      return false;
+    }
+    memory_barrier();
+    *element = elements_[head & kMask];
+    memory_barrier();
+    head_ = head + 1;
+    return true;
+  }
+
+  size_t size() const {
+    return tail_ - head_;
+  }
+
+ private:
+  static const uint32_t kMask = Capacity - 1;
+  // Check that capacity is power of two at compile time
+  typedef char CapacityIsPowerOfTwo[(Capacity & kMask) == 0 ? 1 : -1];
+
+  T elements_[Capacity];
+  volatile uint32_t head_;
+  volatile uint32_t tail_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeRing);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_LOCK_FREE_RING_H_
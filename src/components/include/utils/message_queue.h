@@ -64,6 +64,13 @@ template<typename T, class Q = std::queue<T> > class MessageQueue {
      */
     size_t size() const;
 
+    /**
+     * \brief Returns number of elements with |key| in the queue,
+     * available if Queue keeps elements by keys.
+     */
+    template <typename K>
+    size_t size(const K& key) const;
+
     /**
      * \brief If queue is empty.
      * \return Is queue empty.
@@ -144,6 +151,12 @@ template<typename T, class Q> size_t MessageQueue<T, Q>::size() const {
   return queue_.size();
 }
 
+template<typename T, class Q> template<typename K>
+size_t MessageQueue<T, Q>::size(const K& key) const {
+  sync_primitives::AutoLock auto_lock(queue_lock_);
+  return queue_.size(key);
+}
+
 template<typename T, class Q> bool MessageQueue<T, Q>::empty() const {
   sync_primitives::AutoLock auto_lock(queue_lock_);
   return queue_.empty();
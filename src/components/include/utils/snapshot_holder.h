@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_SNAPSHOT_HOLDER_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_SNAPSHOT_HOLDER_H_
+
+#include <algorithm>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/shared_ptr.h"
+
+namespace utils {
+
+/**
+ * @brief Holds read-mostly data as immutable refcounted snapshots.
+ *
+ * Readers take current snapshot and use it as long as they need without
+ * blocking anybody: published snapshot is never changed. Writers copy
+ * current snapshot, modify the copy and publish it instead. Writers must
+ * be serialized by caller, otherwise changes of concurrent writers may be
+ * lost.
+ *
+ * Lock of holder guards only the pointer to current snapshot and is held
+ * for copying the pointer, never while snapshot is read, built or freed.
+ */
+template<typename T>
+class SnapshotHolder {
+ public:
+  typedef SharedPtr<const T> Snapshot;
+
+  SnapshotHolder()
+    : snapshot_(new T()) {
+  }
+
+  explicit SnapshotHolder(const T& data)
+    : snapshot_(new T(data)) {
+  }
+
+  /**
+   * @brief Returns current snapshot, which stays valid and unchanged
+   * while it is referenced
+   */
+  Snapshot Get() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return snapshot_;
+  }
+
+  /**
+   * @brief Returns copy of current snapshot to be modified and published
+   */
+  SharedPtr<T> Copy() const {
+    return SharedPtr<T>(new T(*Get()));
+  }
+
+  /**
+   * @brief Replaces current snapshot, readers holding previous one
+   * keep it alive until they are done
+   */
+  void Publish(const SharedPtr<T>& snapshot) {
+    Snapshot previous = snapshot;
+    {
+      sync_primitives::AutoLock auto_lock(lock_);
+      std::swap(previous, snapshot_);
+    }
+  }
+
+ private:
+  Snapshot snapshot_;
+  mutable sync_primitives::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotHolder);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_SNAPSHOT_HOLDER_H_
@@ -36,6 +36,7 @@
 #include <string>
 #include <queue>
 
+#include "utils/conditional_variable.h"
 #include "utils/logger.h"
 #include "utils/macro.h"
 #include "utils/message_queue.h"
@@ -79,6 +80,14 @@ class MessageLoopThread {
 
   // Places a message to the therad's queue. Thread-safe.
   void PostMessage(const Message& message);
+
+  // Number of messages waiting in the queue. Thread-safe.
+  size_t GetMessagesCount() const;
+
+  // Number of messages with |key| waiting in the queue, available for
+  // queues keeping messages by keys. Thread-safe.
+  template <typename K>
+  size_t GetMessagesCount(const K& key) const;
  private:
   /*
    * Implementation of ThreadDelegate that actually pumps the queue and is
@@ -100,6 +109,10 @@ class MessageLoopThread {
     // Message queue that is actually owned by MessageLoopThread
     MessageQueue<Message, Queue>& message_queue_;
     sync_primitives::Lock active_lock;
+    // Set when threadMain is done, exitThreadMain waits for it even if
+    // thread was not scheduled yet when it was stopped
+    bool finished_;
+    sync_primitives::ConditionalVariable finished_cond_;
   };
  private:
   MessageQueue<Message, Queue> message_queue_;
@@ -130,12 +143,24 @@ void MessageLoopThread<Q>::PostMessage(const Message& message) {
   message_queue_.push(message);
 }
 
+template <class Q>
+size_t MessageLoopThread<Q>::GetMessagesCount() const {
+  return message_queue_.size();
+}
+
+template <class Q>
+template <typename K>
+size_t MessageLoopThread<Q>::GetMessagesCount(const K& key) const {
+  return message_queue_.size(key);
+}
+
 //////////
 template<class Q>
 MessageLoopThread<Q>::LoopThreadDelegate::LoopThreadDelegate(
     MessageQueue<Message, Queue>* message_queue, Handler* handler)
     : handler_(*handler),
-      message_queue_(*message_queue) {
+      message_queue_(*message_queue),
+      finished_(false) {
   DCHECK(handler != NULL);
   DCHECK(message_queue != NULL);
 }
@@ -149,6 +174,8 @@ void MessageLoopThread<Q>::LoopThreadDelegate::threadMain() {
   }
   // Process leftover messages
   DrainQue();
+  finished_ = true;
+  finished_cond_.Broadcast();
 }
 
 template<class Q>
@@ -157,6 +184,9 @@ bool MessageLoopThread<Q>::LoopThreadDelegate::exitThreadMain() {
   {
     sync_primitives::AutoLock auto_lock(active_lock);
     // Prevent canceling thread until queue is drained
+    while (!finished_) {
+      finished_cond_.Wait(auto_lock);
+    }
   }
   return true;
 }
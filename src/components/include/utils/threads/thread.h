@@ -137,6 +137,12 @@ class Thread {
    */
   void stop();
 
+  /**
+   * Waits for joinable thread to exit, so that Thread object and its delegate
+   * may be deleted. Must not be called from the thread itself.
+   */
+  void join();
+
   /**
    * Get thread name.
    * @return thread name
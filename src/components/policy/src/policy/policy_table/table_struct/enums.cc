@@ -26,27 +26,32 @@ const char* EnumToJsonString(Priority val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, Priority* result) {
-  if ("EMERGENCY" == literal) {
-    *result = P_EMERGENCY;
-    return true;
-  } else if ("NAVIGATION" == literal) {
-    *result = P_NAVIGATION;
-    return true;
-  } else if ("VOICECOM" == literal) {
-    *result = P_VOICECOM;
-    return true;
-  } else if ("COMMUNICATION" == literal) {
-    *result = P_COMMUNICATION;
-    return true;
-  } else if ("NORMAL" == literal) {
-    *result = P_NORMAL;
-    return true;
-  } else if ("NONE" == literal) {
-    *result = P_NONE;
-    return true;
-  } else {
-    return false;
+  static const struct {
+    const char* literal;
+    Priority value;
+  } kLiterals[] = {
+    { "COMMUNICATION", P_COMMUNICATION },
+    { "EMERGENCY", P_EMERGENCY },
+    { "NAVIGATION", P_NAVIGATION },
+    { "NONE", P_NONE },
+    { "NORMAL", P_NORMAL },
+    { "VOICECOM", P_VOICECOM },
+  };
+  size_t first = 0;
+  size_t last = sizeof(kLiterals) / sizeof(kLiterals[0]);
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    const int order = literal.compare(kLiterals[middle].literal);
+    if (order == 0) {
+      *result = kLiterals[middle].value;
+      return true;
+    } else if (order < 0) {
+      last = middle;
+    } else {
+      first = middle + 1;
+    }
   }
+  return false;
 }
 
 bool IsValidEnum(HmiLevel val) {
@@ -68,21 +73,30 @@ const char* EnumToJsonString(HmiLevel val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, HmiLevel* result) {
-  if ("BACKGROUND" == literal) {
-    *result = HL_BACKGROUND;
-    return true;
-  } else if ("FULL" == literal) {
-    *result = HL_FULL;
-    return true;
-  } else if ("LIMITED" == literal) {
-    *result = HL_LIMITED;
-    return true;
-  } else if ("NONE" == literal) {
-    *result = HL_NONE;
-    return true;
-  } else {
-    return false;
+  static const struct {
+    const char* literal;
+    HmiLevel value;
+  } kLiterals[] = {
+    { "BACKGROUND", HL_BACKGROUND },
+    { "FULL", HL_FULL },
+    { "LIMITED", HL_LIMITED },
+    { "NONE", HL_NONE },
+  };
+  size_t first = 0;
+  size_t last = sizeof(kLiterals) / sizeof(kLiterals[0]);
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    const int order = literal.compare(kLiterals[middle].literal);
+    if (order == 0) {
+      *result = kLiterals[middle].value;
+      return true;
+    } else if (order < 0) {
+      last = middle;
+    } else {
+      first = middle + 1;
+    }
   }
+  return false;
 }
 
 bool IsValidEnum(Parameter val) {
@@ -146,84 +160,51 @@ const char* EnumToJsonString(Parameter val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, Parameter* result) {
-  if ("gps" == literal) {
-    *result = P_GPS;
-    return true;
-  } else if ("speed" == literal) {
-    *result = P_SPEED;
-    return true;
-  } else if ("engineTorque" == literal) {
-    *result = P_ENGINETORQUE;
-    return true;
-  } else if ("externalTemperature" == literal) {
-    *result = P_EXTERNALTEMPERATURE;
-    return true;
-  } else if ("fuelLevel" == literal) {
-    *result = P_FUELLEVEL;
-    return true;
-  } else if ("fuelLevel_State" == literal) {
-    *result = P_FUELLEVEL_STATE;
-    return true;
-  } else if ("headLampStatus" == literal) {
-    *result = P_HEADLAMPSTATUS;
-    return true;
-  } else if ("instantFuelConsumption" == literal) {
-    *result = P_INSTANTFUELCONSUMPTION;
-    return true;
-  } else if ("odometer" == literal) {
-    *result = P_ODOMETER;
-    return true;
-  } else if ("tirePressure" == literal) {
-    *result = P_TIREPRESSURE;
-    return true;
-  } else if ("wiperStatus" == literal) {
-    *result = P_WIPERSTATUS;
-    return true;
-  } else if ("vin" == literal) {
-    *result = P_VIN;
-    return true;
-  } else if ("accPedalPosition" == literal) {
-    *result = P_ACCPEDALPOSITION;
-    return true;
-  } else if ("beltStatus" == literal) {
-    *result = P_BELTSTATUS;
-    return true;
-  } else if ("driverBraking" == literal) {
-    *result = P_DRIVERBRAKING;
-    return true;
-  } else if ("prndl" == literal) {
-    *result = P_PRNDL;
-    return true;
-  } else if ("rpm" == literal) {
-    *result = P_RPM;
-    return true;
-  } else if ("steeringWheelAngle" == literal) {
-    *result = P_STEERINGWHEELANGLE;
-    return true;
-  } else if ("myKey" == literal) {
-    *result = P_MYKEY;
-    return true;
-  } else if ("airbagStatus" == literal) {
-    *result = P_AIRBAGSTATUS;
-    return true;
-  } else if ("bodyInformation" == literal) {
-    *result = P_BODYINFORMATION;
-    return true;
-  } else if ("clusterModeStatus" == literal) {
-    *result = P_CLUSTERMODESTATUS;
-    return true;
-  } else if ("deviceStatus" == literal) {
-    *result = P_DEVICESTATUS;
-    return true;
-  } else if ("emergencyEvent" == literal) {
-    *result = P_EMERGENCYEVENT;
-    return true;
-  } else if ("eCallInfo" == literal) {
-    *result = P_ECALLINFO;
-    return true;
-  } else {
-    return false;
+  static const struct {
+    const char* literal;
+    Parameter value;
+  } kLiterals[] = {
+    { "accPedalPosition", P_ACCPEDALPOSITION },
+    { "airbagStatus", P_AIRBAGSTATUS },
+    { "beltStatus", P_BELTSTATUS },
+    { "bodyInformation", P_BODYINFORMATION },
+    { "clusterModeStatus", P_CLUSTERMODESTATUS },
+    { "deviceStatus", P_DEVICESTATUS },
+    { "driverBraking", P_DRIVERBRAKING },
+    { "eCallInfo", P_ECALLINFO },
+    { "emergencyEvent", P_EMERGENCYEVENT },
+    { "engineTorque", P_ENGINETORQUE },
+    { "externalTemperature", P_EXTERNALTEMPERATURE },
+    { "fuelLevel", P_FUELLEVEL },
+    { "fuelLevel_State", P_FUELLEVEL_STATE },
+    { "gps", P_GPS },
+    { "headLampStatus", P_HEADLAMPSTATUS },
+    { "instantFuelConsumption", P_INSTANTFUELCONSUMPTION },
+    { "myKey", P_MYKEY },
+    { "odometer", P_ODOMETER },
+    { "prndl", P_PRNDL },
+    { "rpm", P_RPM },
+    { "speed", P_SPEED },
+    { "steeringWheelAngle", P_STEERINGWHEELANGLE },
+    { "tirePressure", P_TIREPRESSURE },
+    { "vin", P_VIN },
+    { "wiperStatus", P_WIPERSTATUS },
+  };
+  size_t first = 0;
+  size_t last = sizeof(kLiterals) / sizeof(kLiterals[0]);
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    const int order = literal.compare(kLiterals[middle].literal);
+    if (order == 0) {
+      *result = kLiterals[middle].value;
+      return true;
+    } else if (order < 0) {
+      last = middle;
+    } else {
+      first = middle + 1;
+    }
   }
+  return false;
 }
 
 bool IsValidEnum(AppHMIType val) {
@@ -257,39 +238,36 @@ const char* EnumToJsonString(AppHMIType val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, AppHMIType* result) {
-  if ("DEFAULT" == literal) {
-    *result = AHT_DEFAULT;
-    return true;
-  } else if ("COMMUNICATION" == literal) {
-    *result = AHT_COMMUNICATION;
-    return true;
-  } else if ("MEDIA" == literal) {
-    *result = AHT_MEDIA;
-    return true;
-  } else if ("MESSAGING" == literal) {
-    *result = AHT_MESSAGING;
-    return true;
-  } else if ("NAVIGATION" == literal) {
-    *result = AHT_NAVIGATION;
-    return true;
-  } else if ("INFORMATION" == literal) {
-    *result = AHT_INFORMATION;
-    return true;
-  } else if ("SOCIAL" == literal) {
-    *result = AHT_SOCIAL;
-    return true;
-  } else if ("BACKGROUND_PROCESS" == literal) {
-    *result = AHT_BACKGROUND_PROCESS;
-    return true;
-  } else if ("TESTING" == literal) {
-    *result = AHT_TESTING;
-    return true;
-  } else if ("SYSTEM" == literal) {
-    *result = AHT_SYSTEM;
-    return true;
-  } else {
-    return false;
+  static const struct {
+    const char* literal;
+    AppHMIType value;
+  } kLiterals[] = {
+    { "BACKGROUND_PROCESS", AHT_BACKGROUND_PROCESS },
+    { "COMMUNICATION", AHT_COMMUNICATION },
+    { "DEFAULT", AHT_DEFAULT },
+    { "INFORMATION", AHT_INFORMATION },
+    { "MEDIA", AHT_MEDIA },
+    { "MESSAGING", AHT_MESSAGING },
+    { "NAVIGATION", AHT_NAVIGATION },
+    { "SOCIAL", AHT_SOCIAL },
+    { "SYSTEM", AHT_SYSTEM },
+    { "TESTING", AHT_TESTING },
+  };
+  size_t first = 0;
+  size_t last = sizeof(kLiterals) / sizeof(kLiterals[0]);
+  while (first < last) {
+    const size_t middle = first + (last - first) / 2;
+    const int order = literal.compare(kLiterals[middle].literal);
+    if (order == 0) {
+      *result = kLiterals[middle].value;
+      return true;
+    } else if (order < 0) {
+      last = middle;
+    } else {
+      first = middle + 1;
+    }
   }
+  return false;
 }
 
 const std::string kDefaultApp = "default";
@@ -42,11 +42,19 @@ const MessagePriority MessagePriority::kDefault = MessagePriority(0);
 
 // static
 MessagePriority MessagePriority::FromServiceType(ServiceType service_type) {
+  return FromServiceType(service_type, kNormal);
+}
+
+// static
+MessagePriority MessagePriority::FromServiceType(ServiceType service_type,
+                                                 Urgency urgency) {
   size_t message_priority_value = size_t(service_type);
   DCHECK(message_priority_value <= 0xFF);
+  DCHECK(urgency < kUrgencyLevelsCount);
   // According to Applink Protocol Specification v5 service with numerically
   // lower service type identifiers have higher priority
-  return MessagePriority(0xFF - service_type);
+  return MessagePriority(
+      (0xFF - service_type) * kUrgencyLevelsCount + urgency);
 }
 
 MessagePriority::MessagePriority(const MessagePriority& that)
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "protocol/message_trace.h"
+
+#include <algorithm>
+
+#include "utils/date_time.h"
+
+namespace protocol_handler {
+
+namespace {
+const char* kStageNames[MessageTrace::kStagesCount] = {
+  "transport_received",
+  "frame_assembled",
+  "queued",
+  "dequeued",
+  "parsed",
+  "command_run",
+  "hmi_request_sent",
+  "hmi_response_received",
+  "response_serialized",
+  "transport_sent"
+};
+}  // namespace
+
+MessageTrace::MessageTrace()
+  : function_id_(-1) {
+  std::fill(times_, times_ + kStagesCount, 0);
+}
+
+void MessageTrace::Mark(Stage stage) {
+  times_[stage] =
+      date_time::DateTime::getuSecs(date_time::DateTime::getCurrentTime());
+}
+
+bool MessageTrace::IsMarked(Stage stage) const {
+  return 0 != times_[stage];
+}
+
+int64_t MessageTrace::time(Stage stage) const {
+  return times_[stage];
+}
+
+int64_t MessageTrace::TimeFromStart(Stage stage) const {
+  return times_[stage] - times_[kTransportReceived];
+}
+
+int32_t MessageTrace::function_id() const {
+  return function_id_;
+}
+
+void MessageTrace::set_function_id(int32_t function_id) {
+  function_id_ = function_id;
+}
+
+// static
+const char* MessageTrace::StageName(Stage stage) {
+  return kStageNames[stage];
+}
+
+}  // namespace protocol_handler
@@ -34,26 +34,47 @@
 
 #include <memory.h>
 
+#include "utils/macro.h"
+
 namespace protocol_handler {
 
 RawMessage::RawMessage(uint32_t connection_key, uint32_t protocol_version,
                        const uint8_t *const data_param, uint32_t data_sz,
                        uint8_t type, uint32_t payload_size)
   : connection_key_(connection_key),
+    buffer_(NULL),
+    header_room_(0),
     data_(NULL),
     data_size_(data_sz),
     protocol_version_(protocol_version),
     service_type_(ServiceTypeFromByte(type)),
     payload_size_(payload_size),
-    waiting_(false) {
+    waiting_(false),
+    priority_(MessagePriority::FromServiceType(service_type_)) {
   if (data_sz > 0) {
     data_ = new uint8_t[data_sz];
     memcpy(data_, data_param, sizeof(*data_) * data_sz);
   }
+  buffer_ = data_;
+}
+
+RawMessage* RawMessage::CreateWithHeaderRoom(uint32_t connection_key,
+                                             uint32_t protocol_version,
+                                             uint8_t* buffer,
+                                             size_t header_room,
+                                             uint32_t data_size,
+                                             uint8_t type) {
+  RawMessage* message =
+      new RawMessage(connection_key, protocol_version, NULL, 0, type);
+  message->buffer_ = buffer;
+  message->header_room_ = header_room;
+  message->data_ = buffer + header_room;
+  message->data_size_ = data_size;
+  return message;
 }
 
 RawMessage::~RawMessage() {
-  delete[] data_;
+  delete[] buffer_;
 }
 
 uint32_t RawMessage::connection_key() const {
@@ -88,4 +109,32 @@ void RawMessage::set_waiting(bool v) {
   waiting_ = v;
 }
 
+size_t RawMessage::header_room() const {
+  return header_room_;
+}
+
+uint8_t *RawMessage::PrependHeader(size_t header_size) {
+  DCHECK(header_size <= header_room_);
+  header_room_ -= header_size;
+  data_ -= header_size;
+  data_size_ += header_size;
+  return data_;
+}
+
+MessageTracePtr RawMessage::trace() const {
+  return trace_;
+}
+
+void RawMessage::set_trace(const MessageTracePtr trace) {
+  trace_ = trace;
+}
+
+MessagePriority RawMessage::priority() const {
+  return priority_;
+}
+
+void RawMessage::set_priority(const MessagePriority& priority) {
+  priority_ = priority;
+}
+
 }  // namespace protocol_handler
@@ -98,13 +98,20 @@ struct RawFordMessageFromMobile: public ProtocolFramePtr {
 struct RawFordMessageToMobile: public ProtocolFramePtr {
   explicit RawFordMessageToMobile(const ProtocolFramePtr message,
                                   bool final_message)
-    : ProtocolFramePtr(message), is_final(final_message) {}
+    : ProtocolFramePtr(message), is_final(final_message),
+      priority(MessagePriority::FromServiceType(
+          ServiceTypeFromByte(message->service_type()))) {}
+  RawFordMessageToMobile(const ProtocolFramePtr message, bool final_message,
+                         const MessagePriority& message_priority)
+    : ProtocolFramePtr(message), is_final(final_message),
+      priority(message_priority) {}
   // PrioritizedQueue requires this method to decide which priority to assign
   size_t PriorityOrder() const {
-    return MessagePriority::FromServiceType(
-          ServiceTypeFromByte(get()->service_type())).OrderingValue(); }
+    return priority.OrderingValue(); }
   // Signals whether connection to mobile must be closed after processing this message
   bool is_final;
+  // Priority of message the frame belongs to
+  MessagePriority priority;
 };
 
 // Short type names for prioritized message queues
@@ -331,8 +338,7 @@ class ProtocolHandlerImpl
    * \param session_id ID of session through which message is to be sent.
    * \param protocol_version Version of Protocol used in message.
    * \param service_type Type of session, RPC or BULK Data
-   * \param data_size Size of message excluding protocol header
-   * \param data Message string
+   * \param message Message which data is sent in frame without copying
    * \param is_final_message if is_final_message = true - it is last message
    * \return \saRESULT_CODE Status of operation
    */
@@ -340,8 +346,7 @@ class ProtocolHandlerImpl
                                      const uint8_t session_id,
                                      uint32_t protocol_version,
                                      const uint8_t service_type,
-                                     size_t data_size,
-                                     const uint8_t *data,
+                                     const RawMessagePtr message,
                                      const bool is_final_message);
 
   /**
@@ -355,6 +360,8 @@ class ProtocolHandlerImpl
    * \param data Message string
    * \param max_data_size Maximum allowed size of single frame.
    * \param is_final_message if is_final_message = true - it is last message
+   * \param message_trace Trace of message, passed with last frame
+   * \param priority Priority of message, all frames are sent with it
    * \return \saRESULT_CODE Status of operation
    */
   RESULT_CODE SendMultiFrameMessage(ConnectionID connection_id,
@@ -364,14 +371,18 @@ class ProtocolHandlerImpl
                                     const size_t data_size,
                                     const uint8_t *data,
                                     const size_t max_data_size,
-                                    const bool is_final_message);
+                                    const bool is_final_message,
+                                    const MessageTracePtr message_trace,
+                                    const MessagePriority& priority);
 
   /**
    * \brief Sends message already containing protocol header.
    * \param packet Message with protocol header
+   * \param priority Priority of frame in transport send queues
    * \return \saRESULT_CODE Status of operation
    */
-  RESULT_CODE SendFrame(const ProtocolFramePtr packet);
+  RESULT_CODE SendFrame(const ProtocolFramePtr packet,
+                        const MessagePriority& priority);
 
   /**
    * \brief Handles received message.
@@ -145,6 +145,21 @@ class ProtocolPacket {
                  uint8_t sessionId, uint32_t dataSize,
                  uint32_t messageID, const uint8_t *data = 0,
                  uint32_t packet_id = 0);
+
+  /**
+   * \brief Constructor of single frame packet which data is data of
+   * |message|. Data is not copied and if message has room for protocol
+   * header in front of data, packet is serialized in place.
+   * \param connection_id - Connection Identifier
+   * \param version Version of protocol
+   * \param serviceType Type of session (RPC/Bulk data)
+   * \param sessionID Number of frame within connection
+   * \param messageID ID of message or hash code - only for second protocol
+   * \param message Message which data is sent
+   */
+  ProtocolPacket(uint8_t connection_id, uint8_t version,
+                 uint8_t serviceType, uint8_t sessionId,
+                 uint32_t messageID, const RawMessagePtr message);
   /**
    * \brief Destructor
    */
@@ -268,6 +283,12 @@ class ProtocolPacket {
     */
   uint32_t payload_size() const;
 
+  /**
+    * \brief Trace of message processing packet belongs to
+    */
+  MessageTracePtr trace() const;
+  void set_trace(const MessageTracePtr trace);
+
  private:
   /**
    *\brief Protocol header
@@ -279,11 +300,27 @@ class ProtocolPacket {
    */
   ProtocolData packet_data_;
 
+  /**
+   *\brief Message which data is body of packet instead of packet_data_,
+   * header is written to room in front of data on serialization
+   */
+  mutable RawMessagePtr frame_;
+
+  /**
+   *\brief Size of header written to frame_, zero until it is serialized
+   */
+  mutable size_t frame_header_size_;
+
   /**
    *\brief Actual size of received data
    */
   uint32_t payload_size_;
 
+  /**
+   *\brief Trace of message, passed to messages created from packet
+   */
+  MessageTracePtr trace_;
+
   /**
    *\brief Offset for multiframe messages
    */
@@ -300,6 +337,12 @@ class ProtocolPacket {
     */
   uint8_t connection_id_;
 
+  /**
+   * \brief Writes protocol header to |header|
+   * \return Size of written header
+   */
+  size_t serializeHeader(uint8_t *header) const;
+
   DISALLOW_COPY_AND_ASSIGN(ProtocolPacket);
 };
 }  // namespace protocol_handler
@@ -33,9 +33,8 @@
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PROTOCOL_PAYLOAD_H_
 
 #include <stdint.h>
+#include <cstddef>
 #include <ostream>
-#include <string>
-#include <vector>
 
 #include "protocol/rpc_type.h"
 
@@ -57,10 +56,16 @@ struct ProtocolPayloadHeaderV2 {
 };
 
 // Applink Protocolv5 4.1.1 Protocol Message Payload
+// JSON and binary data are not copied, they point to the buffer payload
+// was extracted from and are valid as long as it is
 struct ProtocolPayloadV2 {
+  ProtocolPayloadV2()
+    : json(NULL), data(NULL), data_size(0) {}
   ProtocolPayloadHeaderV2 header;
-  std::string json;
-  std::vector<uint8_t> data;
+  // Size of JSON is header.json_size
+  const uint8_t* json;
+  const uint8_t* data;
+  size_t data_size;
 };
 
 // Procedures that extract and validate defined protocol structures from
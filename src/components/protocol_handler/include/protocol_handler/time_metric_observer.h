@@ -41,10 +41,14 @@ namespace protocol_handler {
 
 class PHMetricObserver {
  public:
+  /**
+   * @brief Values are copied from message when it is processed: sent
+   * message is framed in place and may be changed by other threads
+   */
   struct MessageMetric {
-    RawMessagePtr raw_msg;
+    size_t data_size;
     uint32_t message_id;
-    uint8_t connection_key;
+    uint32_t connection_key;
     TimevalStruct begin;
     TimevalStruct end;
   };
@@ -402,6 +402,10 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
                                  &sessionID);
 #ifdef TIME_TESTER
   uint32_t message_id = message_counters_[sessionID];
+  // Sent message is serialized in place with connection id as its key,
+  // so its size and key are taken before framing
+  const uint32_t connection_key = message->connection_key();
+  const size_t data_size = message->data_size();
   if (metric_observer_) {
     metric_observer_->StartMessageProcess(message_id, start_time);
   }
@@ -427,8 +431,7 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
     RESULT_CODE result = SendSingleFrameMessage(connection_handle, sessionID,
                                                 message->protocol_version(),
                                                 message->service_type(),
-                                                message->data_size(),
-                                                message->data(),
+                                                message,
                                                 final_message);
     if (result != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
@@ -444,7 +447,9 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
                                                message->service_type(),
                                                message->data_size(),
                                                message->data(),
-                                               maxDataSize, final_message);
+                                               maxDataSize, final_message,
+                                               message->trace(),
+                                               message->priority());
     if (result != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
           "ProtocolHandler failed to send multiframe messages.");
@@ -455,8 +460,8 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
         PHMetricObserver::MessageMetric *metric
             = new PHMetricObserver::MessageMetric();
         metric->message_id = message_id;
-        metric->connection_key = message->connection_key();
-        metric->raw_msg = message;
+        metric->connection_key = connection_key;
+        metric->data_size = data_size;
         metric_observer_->EndMessageProcess(metric);
       }
 #endif
@@ -506,6 +511,13 @@ void ProtocolHandlerImpl::OnTMMessageReceived(const RawMessagePtr tm_message) {
     if (metric_observer_) {
       metric_observer_->StartMessageProcess(msg->message_id(), start_time);
     }
+    if (tm_message->trace()) {
+      // Every frame gets own copy of trace started on transport receive
+      const MessageTracePtr trace(new MessageTrace(*tm_message->trace()));
+      trace->Mark(MessageTrace::kFrameAssembled);
+      trace->Mark(MessageTrace::kQueued);
+      frame->set_trace(trace);
+    }
 #endif  // TIME_TESTER
 
     raw_ford_messages_from_mobile_.PostMessage(msg);
@@ -590,7 +602,8 @@ void ProtocolHandlerImpl::OnConnectionClosed(
   incoming_data_handler_->RemoveConnection(connection_id);
 }
 
-RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet) {
+RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet,
+                                           const MessagePriority& priority) {
   LOG4CXX_TRACE_ENTER(logger_);
   if (!packet) {
     LOG4CXX_ERROR(logger_, "Failed to send empty packet.");
@@ -615,6 +628,10 @@ RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet) {
     LOG4CXX_ERROR(logger_, "Serialization error");
         return RESULT_FAIL;
   };
+  // Encrypted frames have to reach mobile in the same order they were
+  // encrypted in, so transport keeps them in order with the lowest priority
+  message_to_send->set_priority(packet->protection_flag()
+                                ? MessagePriority::kDefault : priority);
   LOG4CXX_INFO(logger_,
                "Message to send with connection id " <<
                static_cast<int>(packet->connection_id()));
@@ -638,16 +655,17 @@ RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet) {
 RESULT_CODE ProtocolHandlerImpl::SendSingleFrameMessage(
     ConnectionID connection_id, const uint8_t session_id,
     uint32_t protocol_version, const uint8_t service_type,
-    size_t data_size, const uint8_t *data,
+    const RawMessagePtr message,
     const bool is_final_message) {
   LOG4CXX_TRACE_ENTER(logger_);
 
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
-      protocol_version, PROTECTION_OFF, FRAME_TYPE_SINGLE, service_type, FRAME_DATA_SINGLE,
-      session_id, data_size, message_counters_[session_id]++, data));
+      protocol_version, service_type, session_id,
+      message_counters_[session_id]++, message));
 
   raw_ford_messages_to_mobile_.PostMessage(
-      impl::RawFordMessageToMobile(ptr, is_final_message));
+      impl::RawFordMessageToMobile(ptr, is_final_message,
+                                   message->priority()));
 
   LOG4CXX_TRACE_EXIT(logger_);
   return RESULT_OK;
@@ -657,7 +675,8 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
     ConnectionID connection_id, const uint8_t session_id,
     uint32_t protocol_version, const uint8_t service_type,
     const size_t data_size, const uint8_t *data,
-    const size_t maxdata_size, const bool is_final_message) {
+    const size_t maxdata_size, const bool is_final_message,
+    const MessageTracePtr message_trace, const MessagePriority& priority) {
   LOG4CXX_TRACE_ENTER(logger_);
 
   LOG4CXX_INFO_EXT(
@@ -700,7 +719,7 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
           message_id, out_data));
 
   raw_ford_messages_to_mobile_.PostMessage(
-      impl::RawFordMessageToMobile(firstPacket, false));
+      impl::RawFordMessageToMobile(firstPacket, false, priority));
   LOG4CXX_INFO_EXT(logger_, "First frame is sent.");
 
   for (uint32_t i = 0; i < frames_count; ++i) {
@@ -716,9 +735,14 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
         protocol_version, PROTECTION_OFF, FRAME_TYPE_CONSECUTIVE,
         service_type, data_type, session_id, frame_size, message_id,
         data + maxdata_size * i));
+#ifdef TIME_TESTER
+    if (is_last_frame) {
+      ptr->set_trace(message_trace);
+    }
+#endif  // TIME_TESTER
 
     raw_ford_messages_to_mobile_.PostMessage(
-          impl::RawFordMessageToMobile(ptr, is_final_packet));
+          impl::RawFordMessageToMobile(ptr, is_final_packet, priority));
   }
   LOG4CXX_TRACE_EXIT(logger_);
   return RESULT_OK;
@@ -783,12 +807,13 @@ RESULT_CODE ProtocolHandlerImpl::HandleSingleFrameMessage(
     return RESULT_FAIL;
   }
 #ifdef TIME_TESTER
+  rawMessage->set_trace(packet->trace());
       if (metric_observer_) {
         PHMetricObserver::MessageMetric *metric
             = new PHMetricObserver::MessageMetric();
         metric->message_id = packet->message_id();
         metric->connection_key = connection_key;
-        metric->raw_msg = rawMessage;
+        metric->data_size = rawMessage->data_size();
         metric_observer_->EndMessageProcess(metric);
       }
 #endif
@@ -883,10 +908,13 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
       }
 
 #ifdef TIME_TESTER
+      // First frame is where message processing started
+      rawMessage->set_trace(completePacket->trace());
       if (metric_observer_) {
         PHMetricObserver::MessageMetric *metric =
             new PHMetricObserver::MessageMetric();
-        metric->raw_msg = rawMessage;
+        metric->connection_key = rawMessage->connection_key();
+        metric->data_size = rawMessage->data_size();
         metric_observer_->EndMessageProcess(metric);
       }
 #endif  // TIME_TESTER
@@ -1150,6 +1178,11 @@ void ProtocolHandlerImpl::Handle(
         connection_handler::ConnectionHandlerImpl::instance();
   LOG4CXX_INFO(logger_, "Message : " << message.get());
   LOG4CXX_INFO(logger_, "session_observer_: " <<session_observer_);
+#ifdef TIME_TESTER
+  if (message->trace()) {
+    message->trace()->Mark(MessageTrace::kDequeued);
+  }
+#endif  // TIME_TESTER
   uint8_t c_id = message->connection_id();
   uint32_t m_id = message->session_id();
 
@@ -1184,7 +1217,7 @@ void ProtocolHandlerImpl::Handle(const impl::RawFordMessageToMobile message) {
                                      message->message_id()));
   }
 
-  SendFrame(message);
+  SendFrame(message, message.priority);
 }
 
 #ifdef ENABLE_SECURITY
@@ -39,7 +39,8 @@
 namespace protocol_handler {
 
 ProtocolPacket::ProtocolPacket()
-    : payload_size_(0),
+    : frame_header_size_(0),
+      payload_size_(0),
       packet_id_(0),
       connection_id_(0)  {
 }
@@ -54,6 +55,7 @@ ProtocolPacket::ProtocolPacket(uint8_t connection_id,
                                uint32_t packet_id)
   : packet_header_(version, protection, frameType, serviceType,
                    frameData, sessionID, dataSize, messageID),
+    frame_header_size_(0),
     payload_size_(0),
     packet_id_(packet_id),
     connection_id_(connection_id) {
@@ -61,9 +63,27 @@ ProtocolPacket::ProtocolPacket(uint8_t connection_id,
   DCHECK(MAXIMUM_FRAME_DATA_SIZE >= dataSize);
 }
 
+ProtocolPacket::ProtocolPacket(uint8_t connection_id, uint8_t version,
+                               uint8_t serviceType, uint8_t sessionID,
+                               uint32_t messageID,
+                               const RawMessagePtr message)
+  : packet_header_(version, PROTECTION_OFF, FRAME_TYPE_SINGLE, serviceType,
+                   FRAME_DATA_SINGLE, sessionID, message->data_size(),
+                   messageID),
+    frame_(message),
+    frame_header_size_(0),
+    payload_size_(0),
+    trace_(message->trace()),
+    packet_id_(0),
+    connection_id_(connection_id) {
+  packet_data_.totalDataBytes = message->data_size();
+  DCHECK(MAXIMUM_FRAME_DATA_SIZE >= message->data_size());
+}
+
 ProtocolPacket::ProtocolPacket(uint8_t connection_id, uint8_t *data_param,
                                uint32_t data_size)
-  : payload_size_(0),
+  : frame_header_size_(0),
+    payload_size_(0),
     packet_id_(0),
     connection_id_(connection_id) {
   RESULT_CODE result = deserializePacket(data_param, data_size);
@@ -78,40 +98,30 @@ ProtocolPacket::~ProtocolPacket() {
 
 // Serialization
 RawMessagePtr ProtocolPacket::serializePacket() const {
+  const size_t header_size = PROTOCOL_VERSION_1 == packet_header_.version
+      ? PROTOCOL_HEADER_V1_SIZE : PROTOCOL_HEADER_V2_SIZE;
+  if (frame_ &&
+      (frame_header_size_ || frame_->header_room() >= header_size)) {
+    // Header is written in front of data, data is sent without copying
+    if (!frame_header_size_) {
+      serializeHeader(frame_->PrependHeader(header_size));
+      frame_header_size_ = header_size;
+      frame_->set_connection_key(connection_id());
+    }
+    return frame_;
+  }
+
   uint8_t *packet = new (std::nothrow) uint8_t[MAXIMUM_FRAME_DATA_SIZE];
   if (!packet) {
     return RawMessagePtr();
   }
-  // version is low byte
-  const uint8_t version_byte = packet_header_.version << 4;
-  // protection is first bit of second byte
-  const uint8_t protection_byte = packet_header_.protection_flag ? (0x8) : 0x0;
-  // frame type is last 3 bits of second byte
-  const uint8_t frame_type_byte = packet_header_.frameType & 0x07;
-
-  uint8_t offset = 0;
-  packet[offset++] = version_byte | protection_byte | frame_type_byte;
-  packet[offset++] = packet_header_.serviceType;
-  packet[offset++] = packet_header_.frameData;
-  packet[offset++] = packet_header_.sessionId;
-
-  packet[offset++] = packet_header_.dataSize >> 24;
-  packet[offset++] = packet_header_.dataSize >> 16;
-  packet[offset++] = packet_header_.dataSize >> 8;
-  packet[offset++] = packet_header_.dataSize;
-
-  if (packet_header_.version != PROTOCOL_VERSION_1) {
-    packet[offset++] = packet_header_.messageId >> 24;
-    packet[offset++] = packet_header_.messageId >> 16;
-    packet[offset++] = packet_header_.messageId >> 8;
-    packet[offset++] = packet_header_.messageId;
-  }
+  const size_t offset = serializeHeader(packet);
 
   DCHECK((offset + packet_data_.totalDataBytes) <= MAXIMUM_FRAME_DATA_SIZE);
 
   size_t total_packet_size = offset;
-  if (packet_data_.data) {
-    memcpy(packet + offset, packet_data_.data, packet_data_.totalDataBytes);
+  if (data()) {
+    memcpy(packet + offset, data(), packet_data_.totalDataBytes);
     total_packet_size += packet_data_.totalDataBytes;
   }
 
@@ -119,11 +129,40 @@ RawMessagePtr ProtocolPacket::serializePacket() const {
         new RawMessage(
           connection_id(), packet_header_.version,
           packet, total_packet_size, packet_header_.serviceType) );
+  out_message->set_trace(trace_);
 
   delete[] packet;
   return out_message;
 }
 
+size_t ProtocolPacket::serializeHeader(uint8_t *header) const {
+  // version is low byte
+  const uint8_t version_byte = packet_header_.version << 4;
+  // protection is first bit of second byte
+  const uint8_t protection_byte = packet_header_.protection_flag ? (0x8) : 0x0;
+  // frame type is last 3 bits of second byte
+  const uint8_t frame_type_byte = packet_header_.frameType & 0x07;
+
+  uint8_t offset = 0;
+  header[offset++] = version_byte | protection_byte | frame_type_byte;
+  header[offset++] = packet_header_.serviceType;
+  header[offset++] = packet_header_.frameData;
+  header[offset++] = packet_header_.sessionId;
+
+  header[offset++] = packet_header_.dataSize >> 24;
+  header[offset++] = packet_header_.dataSize >> 16;
+  header[offset++] = packet_header_.dataSize >> 8;
+  header[offset++] = packet_header_.dataSize;
+
+  if (packet_header_.version != PROTOCOL_VERSION_1) {
+    header[offset++] = packet_header_.messageId >> 24;
+    header[offset++] = packet_header_.messageId >> 16;
+    header[offset++] = packet_header_.messageId >> 8;
+    header[offset++] = packet_header_.messageId;
+  }
+  return offset;
+}
+
 uint32_t ProtocolPacket::packet_id() const {
   return packet_id_;
 }
@@ -258,6 +297,9 @@ uint32_t ProtocolPacket::message_id() const {
 }
 
 uint8_t *ProtocolPacket::data() const {
+  if (frame_) {
+    return frame_->data() + frame_header_size_;
+  }
   return packet_data_.data;
 }
 
@@ -282,6 +324,8 @@ void ProtocolPacket::set_data(
       // TODO(EZamakhov): add log info about memory problem
       packet_header_.dataSize = packet_data_.totalDataBytes = 0;
     }
+    frame_.reset();
+    frame_header_size_ = 0;
   }
 }
 
@@ -297,5 +341,13 @@ uint32_t ProtocolPacket::payload_size() const {
   return payload_size_;
 }
 
+MessageTracePtr ProtocolPacket::trace() const {
+  return trace_;
+}
+
+void ProtocolPacket::set_trace(const MessageTracePtr trace) {
+  trace_ = trace;
+}
+
 // End of Deserialization
 }  // namespace protocol_handler
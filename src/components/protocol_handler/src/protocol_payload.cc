@@ -76,6 +76,7 @@ void Extract(utils::BitStream *bs, ProtocolPayloadV2 *payload,
         PayloadHeaderBits / CHAR_BIT;
     DCHECK(data_size < payload_size);
     utils::Extract(bs, &payload->data, data_size);
+    payload->data_size = data_size;
   }
 }
 
@@ -90,8 +91,8 @@ std::ostream &operator<<(std::ostream &os,
 
 std::ostream &operator<<(std::ostream &os, const ProtocolPayloadV2 &payload) {
   return os << "(ProtocolPayloadV2" << "  header: " << payload.header
-            << ", json (bytes): "   << payload.json.size() << ", data (bytes): "
-            << payload.data.size()  << ")";
+            << ", json (bytes): "   << payload.header.json_size
+            << ", data (bytes): "   << payload.data_size << ")";
 }
 
 size_t ProtocolPayloadV2SizeBits() {
@@ -30,22 +30,9 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "protocol_handler_metric.h"
-#include "json/json.h"
-#include "json_keys.h"
+#include "gmock/gmock.h"
 
-namespace time_tester {
-
-Json::Value ProtocolHandlerMecticWrapper::GetJsonMetric() {
-  Json::Value result = MetricWrapper::GetJsonMetric();
-  result[strings::logger] = "ProtocolHandler";
-  result[strings::begin] =
-      Json::Int64(date_time::DateTime::getuSecs(message_metric->begin));
-  result[strings::end] =
-      Json::Int64(date_time::DateTime::getuSecs(message_metric->end));
-  result[strings::message_id] = message_metric->message_id;
-  result[strings::connection_key] = message_metric->connection_key;
-  return result;
+int main(int argc, char** argv) {
+ testing::InitGoogleMock(&argc, argv);
+ return RUN_ALL_TESTS();
 }
-
-}  // namespace time_tester
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/macro.h"
+#include "protocol/common.h"
+#include "protocol/message_priority.h"
+#include "protocol/raw_message.h"
+#include "utils/prioritized_queue.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using namespace protocol_handler;
+
+namespace {
+size_t Order(ServiceType service_type, MessagePriority::Urgency urgency) {
+  return MessagePriority::FromServiceType(service_type,
+                                          urgency).OrderingValue();
+}
+
+RawMessagePtr MessageWithPriority(uint32_t connection_key,
+                                  MessagePriority::Urgency urgency) {
+  const uint8_t data = 0;
+  const RawMessagePtr message(new RawMessage(connection_key,
+                                             PROTOCOL_VERSION_2, &data, 1));
+  message->set_priority(MessagePriority::FromServiceType(kRpc, urgency));
+  return message;
+}
+}  // namespace
+
+TEST(MessagePriorityTest, ServiceTypeOutweighsUrgency) {
+  EXPECT_GT(Order(kControl, MessagePriority::kBulkData),
+            Order(kRpc, MessagePriority::kUrgent));
+  EXPECT_GT(Order(kRpc, MessagePriority::kBulkData),
+            Order(kAudio, MessagePriority::kUrgent));
+  EXPECT_GT(Order(kMobileNav, MessagePriority::kBulkData),
+            Order(kBulk, MessagePriority::kUrgent));
+}
+
+TEST(MessagePriorityTest, UrgencyOrdersMessagesOfService) {
+  EXPECT_GT(Order(kRpc, MessagePriority::kUrgent),
+            Order(kRpc, MessagePriority::kNormal));
+  EXPECT_GT(Order(kRpc, MessagePriority::kNormal),
+            Order(kRpc, MessagePriority::kBulkData));
+  EXPECT_EQ(Order(kRpc, MessagePriority::kNormal),
+            MessagePriority::FromServiceType(kRpc).OrderingValue());
+}
+
+TEST(MessagePriorityTest, DefaultIsLowest) {
+  EXPECT_GT(Order(kBulk, MessagePriority::kBulkData),
+            MessagePriority::kDefault.OrderingValue());
+}
+
+TEST(MessagePriorityTest, RawMessageHasPriorityOfService) {
+  const uint8_t data = 0;
+  RawMessage message(1, PROTOCOL_VERSION_2, &data, 1, kMobileNav);
+  EXPECT_EQ(MessagePriority::FromServiceType(kMobileNav).OrderingValue(),
+            message.priority().OrderingValue());
+}
+
+TEST(MessagePriorityTest, UrgentRawMessagesAreQueuedFirst) {
+  utils::PrioritizedQueue<PrioritizedRawMessage> queue;
+  queue.push(MessageWithPriority(1, MessagePriority::kBulkData));
+  queue.push(MessageWithPriority(2, MessagePriority::kNormal));
+  queue.push(MessageWithPriority(3, MessagePriority::kUrgent));
+  queue.push(MessageWithPriority(4, MessagePriority::kBulkData));
+  queue.push(MessageWithPriority(5, MessagePriority::kUrgent));
+
+  // Messages of the same priority keep their order
+  const uint32_t expected_keys[] = {3, 5, 2, 1, 4};
+  for (size_t i = 0; i < ARRAYSIZE(expected_keys); ++i) {
+    ASSERT_FALSE(queue.empty());
+    EXPECT_EQ(expected_keys[i], queue.front()->connection_key());
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/macro.h"
+#include "protocol_handler/protocol_packet.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using namespace protocol_handler;
+
+class ProtocolPacketTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    connection_id = 0x12;
+    session_id = 0x34;
+    message_id = 0xABCDEF0;
+    for (uint8_t i = 0; i < 16; ++i) {
+      some_data.push_back(i);
+    }
+  }
+
+  // Message with data placed after room for protocol header as
+  // MobileMessageHandler creates it
+  RawMessagePtr MessageWithHeaderRoom(uint32_t protocol_version) {
+    uint8_t *buffer = new uint8_t[PROTOCOL_HEADER_V2_SIZE + some_data.size()];
+    memcpy(buffer + PROTOCOL_HEADER_V2_SIZE, &some_data[0], some_data.size());
+    return RawMessagePtr(RawMessage::CreateWithHeaderRoom(
+        0xFFFF, protocol_version, buffer, PROTOCOL_HEADER_V2_SIZE,
+        some_data.size()));
+  }
+
+  // Frame serialized with copying of data
+  std::vector<uint8_t> CopiedFrame(uint8_t protocol_version) {
+    ProtocolPacket packet(connection_id, protocol_version, PROTECTION_OFF,
+                          FRAME_TYPE_SINGLE, kRpc, FRAME_DATA_SINGLE,
+                          session_id, some_data.size(), message_id,
+                          &some_data[0]);
+    const RawMessagePtr frame = packet.serializePacket();
+    return std::vector<uint8_t>(frame->data(),
+                                frame->data() + frame->data_size());
+  }
+
+  static std::vector<uint8_t> Bytes(const RawMessagePtr message) {
+    return std::vector<uint8_t>(message->data(),
+                                message->data() + message->data_size());
+  }
+
+  uint8_t connection_id;
+  uint8_t session_id;
+  uint32_t message_id;
+  std::vector<uint8_t> some_data;
+};
+
+TEST_F(ProtocolPacketTest, SingleFrameIsSerializedInPlace) {
+  const RawMessagePtr message = MessageWithHeaderRoom(PROTOCOL_VERSION_2);
+  const uint8_t *data = message->data();
+  ProtocolPacket packet(connection_id, PROTOCOL_VERSION_2, kRpc, session_id,
+                        message_id, message);
+  EXPECT_EQ(data, packet.data());
+  EXPECT_EQ(some_data.size(), packet.data_size());
+
+  const RawMessagePtr frame = packet.serializePacket();
+  EXPECT_EQ(message.get(), frame.get());
+  EXPECT_EQ(data - PROTOCOL_HEADER_V2_SIZE, frame->data());
+  EXPECT_EQ(connection_id, frame->connection_key());
+  EXPECT_EQ(CopiedFrame(PROTOCOL_VERSION_2), Bytes(frame));
+  EXPECT_EQ(data, packet.data());
+}
+
+TEST_F(ProtocolPacketTest, SingleFrameOfFirstVersionIsSerializedInPlace) {
+  const RawMessagePtr message = MessageWithHeaderRoom(PROTOCOL_VERSION_1);
+  ProtocolPacket packet(connection_id, PROTOCOL_VERSION_1, kRpc, session_id,
+                        message_id, message);
+
+  const RawMessagePtr frame = packet.serializePacket();
+  EXPECT_EQ(message.get(), frame.get());
+  EXPECT_EQ(PROTOCOL_HEADER_V1_SIZE + some_data.size(), frame->data_size());
+  EXPECT_EQ(CopiedFrame(PROTOCOL_VERSION_1), Bytes(frame));
+}
+
+TEST_F(ProtocolPacketTest, SerializedFrameIsReused) {
+  const RawMessagePtr message = MessageWithHeaderRoom(PROTOCOL_VERSION_2);
+  ProtocolPacket packet(connection_id, PROTOCOL_VERSION_2, kRpc, session_id,
+                        message_id, message);
+
+  const RawMessagePtr frame = packet.serializePacket();
+  const std::vector<uint8_t> bytes = Bytes(frame);
+  EXPECT_EQ(frame.get(), packet.serializePacket().get());
+  EXPECT_EQ(bytes, Bytes(frame));
+}
+
+TEST_F(ProtocolPacketTest, MessageWithoutHeaderRoomIsCopied) {
+  const RawMessagePtr message(new RawMessage(0xFFFF, PROTOCOL_VERSION_2,
+                                             &some_data[0],
+                                             some_data.size()));
+  ProtocolPacket packet(connection_id, PROTOCOL_VERSION_2, kRpc, session_id,
+                        message_id, message);
+
+  const RawMessagePtr frame = packet.serializePacket();
+  EXPECT_NE(message.get(), frame.get());
+  EXPECT_EQ(some_data.size(), message->data_size());
+  EXPECT_EQ(CopiedFrame(PROTOCOL_VERSION_2), Bytes(frame));
+}
+
+// Encryption replaces data of packet
+TEST_F(ProtocolPacketTest, ReplacedDataIsCopied) {
+  const RawMessagePtr message = MessageWithHeaderRoom(PROTOCOL_VERSION_2);
+  ProtocolPacket packet(connection_id, PROTOCOL_VERSION_2, kRpc, session_id,
+                        message_id, message);
+  std::reverse(some_data.begin(), some_data.end());
+  packet.set_data(&some_data[0], some_data.size());
+
+  const RawMessagePtr frame = packet.serializePacket();
+  EXPECT_NE(message.get(), frame.get());
+  EXPECT_EQ(CopiedFrame(PROTOCOL_VERSION_2), Bytes(frame));
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_COMPILED_SCHEMA_ITEM_H_
+#define SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_COMPILED_SCHEMA_ITEM_H_
+
+#include <string.h>
+
+#include "utils/macro.h"
+#include "utils/shared_ptr.h"
+#include "smart_objects/schema_item.h"
+#include "smart_objects/smart_schema.h"
+#include "smart_objects/smart_object.h"
+
+namespace NsSmartDeviceLink {
+namespace NsSmartObjects {
+
+/**
+ * @brief Validation function generated from interface definition.
+ *
+ * Must return exactly the same result as the schema it was generated from.
+ **/
+typedef Errors::eType (*CompiledValidator)(const SmartObject& object);
+
+/**
+ * @brief Schema item with validation performed by generated code.
+ *
+ * Validation is delegated to the compiled validator while schema
+ * application, unapplication and object building are delegated to
+ * the reference schema built from the same interface definition.
+ **/
+class CCompiledSchemaItem : public ISchemaItem {
+ public:
+  /**
+   * @brief Create a new schema item.
+   * @param reference_schema Schema that defines the reference behaviour.
+   * @param validator Generated validation function.
+   * @return Shared pointer to a new schema item.
+   **/
+  static utils::SharedPtr<CCompiledSchemaItem> create(
+    const CSmartSchema& reference_schema,
+    CompiledValidator validator);
+  /**
+   * @brief Validate smart object with compiled validator.
+   * @param Object Object to validate.
+   * @return NsSmartObjects::Errors::eType
+   **/
+  Errors::eType validate(const SmartObject& Object) OVERRIDE;
+  /**
+   * @brief Apply reference schema.
+   * @param Object Object to apply schema.
+   **/
+  void applySchema(SmartObject& Object) OVERRIDE;
+  /**
+   * @brief Unapply reference schema.
+   * @param Object Object to unapply schema.
+   **/
+  void unapplySchema(SmartObject& Object) OVERRIDE;
+  /**
+   * @brief Build smart object by reference schema
+   * @param pattern_object pattern object
+   * @param result_object object to build
+   */
+  void BuildObjectBySchema(const SmartObject& pattern_object,
+                           SmartObject& result_object) OVERRIDE;
+
+ private:
+  CCompiledSchemaItem(const CSmartSchema& reference_schema,
+                      CompiledValidator validator);
+  CSmartSchema reference_schema_;
+  const CompiledValidator validator_;
+  DISALLOW_COPY_AND_ASSIGN(CCompiledSchemaItem);
+};
+
+/**
+ * @brief Finds map member during ordered walk over map object.
+ *
+ * Generated validators request members in ascending key order, the same
+ * order SmartMap keeps them in, so whole object is checked in one pass
+ * without lookups and temporary key sets.
+ *
+ * @param it Current walk position, moved past the found member.
+ * @param end End of the map.
+ * @param key Member key.
+ * @return Pointer to member or NULL if object has no such member.
+ **/
+inline const SmartObject* FindMemberInOrder(SmartMap::const_iterator* it,
+                                            const SmartMap::const_iterator& end,
+                                            const char* key) {
+  while (end != *it) {
+    const int compare_result = strcmp((*it)->first.c_str(), key);
+    if (compare_result > 0) {
+      break;
+    }
+    const SmartObject* member = &((*it)++)->second;
+    if (0 == compare_result) {
+      return member;
+    }
+  }
+  return NULL;
+}
+
+}  // namespace NsSmartObjects
+}  // namespace NsSmartDeviceLink
+#endif  // SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_COMPILED_SCHEMA_ITEM_H_
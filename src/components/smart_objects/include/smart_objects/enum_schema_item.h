@@ -35,9 +35,14 @@
 
 #include <string.h>
 
+#include <stdint.h>
+
+#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "utils/shared_ptr.h"
 #include "smart_objects/default_shema_item.h"
@@ -112,11 +117,120 @@ struct CStringComparator {
   }
 };
 
+/**
+ * @brief Read-only lookup table of strings by enum value.
+ *
+ * Elements are kept sorted by value. Enums which values form a compact
+ * range (all generated enums except sparse ones like function ids) are
+ * additionally indexed with a dense array, so lookup is a single array
+ * access, otherwise binary search is used.
+ * Interface follows std::map used for this purpose before.
+ **/
+template <typename EnumType>
+class EnumToCStringTable {
+ public:
+  typedef std::pair<EnumType, const char*> value_type;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  /**
+   * @brief Builds table from pairs of values and their strings.
+   * If value is repeated the last string is used.
+   **/
+  EnumToCStringTable(const EnumType* values, const char* const* cstrings,
+                     size_t size);
+
+  const_iterator begin() const {
+    return elements_.begin();
+  }
+  const_iterator end() const {
+    return elements_.end();
+  }
+  size_t size() const {
+    return elements_.size();
+  }
+  bool empty() const {
+    return elements_.empty();
+  }
+  const_iterator find(EnumType value) const;
+
+ private:
+  struct ValueLess {
+    bool operator()(const value_type& a, const value_type& b) const {
+      return a.first < b.first;
+    }
+  };
+  /**
+   * @brief Dense index is used when it is not larger than
+   * kDenseFactor elements per value (plus kDenseSlack).
+   **/
+  static const int64_t kDenseFactor = 4;
+  static const int64_t kDenseSlack = 16;
+
+  std::vector<value_type> elements_;
+  /**
+   * @brief Indexes in elements_ by (value - min_value_), -1 if no value.
+   * Empty when values are too sparse.
+   **/
+  std::vector<int32_t> dense_index_;
+  int64_t min_value_;
+};
+
+/**
+ * @brief Read-only lookup table of enum values by their strings.
+ *
+ * Elements are kept sorted by string for ordered iteration and indexed
+ * with open addressing hash table, so lookup costs hashing of the string
+ * and usually a single string comparison instead of a tree walk.
+ * Interface follows std::map used for this purpose before.
+ **/
+template <typename EnumType>
+class CStringToEnumTable {
+ public:
+  typedef std::pair<const char*, EnumType> value_type;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  /**
+   * @brief Builds table from pairs of strings and their values.
+   * If string is repeated the last value is used.
+   **/
+  CStringToEnumTable(const char* const* cstrings, const EnumType* values,
+                     size_t size);
+
+  const_iterator begin() const {
+    return elements_.begin();
+  }
+  const_iterator end() const {
+    return elements_.end();
+  }
+  size_t size() const {
+    return elements_.size();
+  }
+  bool empty() const {
+    return elements_.empty();
+  }
+  const_iterator find(const char* str) const;
+
+ private:
+  struct CStringLess {
+    bool operator()(const value_type& a, const value_type& b) const {
+      return strcmp(a.first, b.first) < 0;
+    }
+  };
+  static uint32_t Hash(const char* str);
+
+  std::vector<value_type> elements_;
+  /**
+   * @brief Open addressing hash table of indexes in elements_,
+   * -1 marks empty bucket. Size is a power of two.
+   **/
+  std::vector<int32_t> buckets_;
+};
+
 template <typename EnumType>
 class EnumConversionHelper {
  public:
-  typedef std::map<EnumType, const char*> EnumToCStringMap;
-  typedef std::map<const char*, EnumType, CStringComparator> CStringToEnumMap;
+  typedef EnumToCStringTable<EnumType> EnumToCStringMap;
+  typedef CStringToEnumTable<EnumType> CStringToEnumMap;
 
   static const EnumToCStringMap& enum_to_cstring_map() {
     return enum_to_cstring_map_;
@@ -175,25 +289,137 @@ class EnumConversionHelper {
 
   static EnumToCStringMap InitEnumToCStringMap() {
     DCHECK(Size::value == sizeof(enum_values_) / sizeof(enum_values_[0]));
-    EnumToCStringMap result;
-    for (size_t i = 0; i < Size::value; ++i) {
-      result[enum_values_[i]] = cstring_values_[i];
-    }
-    return result;
+    return EnumToCStringMap(enum_values_, cstring_values_, Size::value);
   }
 
   static CStringToEnumMap InitCStringToEnumMap() {
     DCHECK(Size::value == sizeof(enum_values_) / sizeof(enum_values_[0]));
-    CStringToEnumMap result;
-    for (size_t i = 0; i < Size::value; ++i) {
-      result[cstring_values_[i]] = enum_values_[i];
-    }
-    return result;
+    return CStringToEnumMap(cstring_values_, enum_values_, Size::value);
   }
   DISALLOW_COPY_AND_ASSIGN(EnumConversionHelper<EnumType>);
 };
 
 
+template <typename EnumType>
+EnumToCStringTable<EnumType>::EnumToCStringTable(const EnumType* values,
+                                                 const char* const* cstrings,
+                                                 size_t size)
+  : min_value_(0) {
+  std::vector<value_type> elements;
+  elements.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    elements.push_back(value_type(values[i], cstrings[i]));
+  }
+  std::stable_sort(elements.begin(), elements.end(), ValueLess());
+  elements_.reserve(elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    // Keep the last of equal values
+    if (i + 1 < elements.size() &&
+        !ValueLess()(elements[i], elements[i + 1])) {
+      continue;
+    }
+    elements_.push_back(elements[i]);
+  }
+  if (elements_.empty()) {
+    return;
+  }
+
+  min_value_ = static_cast<int64_t>(elements_.front().first);
+  const int64_t range =
+    static_cast<int64_t>(elements_.back().first) - min_value_ + 1;
+  if (range > kDenseFactor * static_cast<int64_t>(elements_.size()) +
+      kDenseSlack) {
+    return;
+  }
+  dense_index_.assign(static_cast<size_t>(range), -1);
+  for (size_t i = 0; i < elements_.size(); ++i) {
+    const int64_t offset =
+      static_cast<int64_t>(elements_[i].first) - min_value_;
+    dense_index_[static_cast<size_t>(offset)] = static_cast<int32_t>(i);
+  }
+}
+
+template <typename EnumType>
+typename EnumToCStringTable<EnumType>::const_iterator
+EnumToCStringTable<EnumType>::find(EnumType value) const {
+  if (!dense_index_.empty()) {
+    const int64_t offset = static_cast<int64_t>(value) - min_value_;
+    if (offset < 0 || offset >= static_cast<int64_t>(dense_index_.size())) {
+      return end();
+    }
+    const int32_t index = dense_index_[static_cast<size_t>(offset)];
+    return index < 0 ? end() : begin() + index;
+  }
+  const const_iterator it = std::lower_bound(
+    begin(), end(), value_type(value, static_cast<const char*>(NULL)),
+    ValueLess());
+  return (it != end() && !(value < it->first)) ? it : end();
+}
+
+template <typename EnumType>
+CStringToEnumTable<EnumType>::CStringToEnumTable(const char* const* cstrings,
+                                                 const EnumType* values,
+                                                 size_t size) {
+  std::vector<value_type> elements;
+  elements.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    elements.push_back(value_type(cstrings[i], values[i]));
+  }
+  std::stable_sort(elements.begin(), elements.end(), CStringLess());
+  elements_.reserve(elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    // Keep the last of equal strings
+    if (i + 1 < elements.size() &&
+        !CStringLess()(elements[i], elements[i + 1])) {
+      continue;
+    }
+    elements_.push_back(elements[i]);
+  }
+
+  // Load factor is kept below 1/2 so probing always meets an empty bucket
+  size_t bucket_count = 1;
+  while (bucket_count < 2 * elements_.size()) {
+    bucket_count <<= 1;
+  }
+  buckets_.assign(bucket_count, -1);
+  const size_t mask = bucket_count - 1;
+  for (size_t i = 0; i < elements_.size(); ++i) {
+    size_t bucket = Hash(elements_[i].first) & mask;
+    while (buckets_[bucket] >= 0) {
+      bucket = (bucket + 1) & mask;
+    }
+    buckets_[bucket] = static_cast<int32_t>(i);
+  }
+}
+
+template <typename EnumType>
+typename CStringToEnumTable<EnumType>::const_iterator
+CStringToEnumTable<EnumType>::find(const char* str) const {
+  if (NULL == str) {
+    return end();
+  }
+  const size_t mask = buckets_.size() - 1;
+  for (size_t bucket = Hash(str) & mask; buckets_[bucket] >= 0;
+       bucket = (bucket + 1) & mask) {
+    const int32_t index = buckets_[bucket];
+    if (0 == strcmp(elements_[index].first, str)) {
+      return begin() + index;
+    }
+  }
+  return end();
+}
+
+template <typename EnumType>
+uint32_t CStringToEnumTable<EnumType>::Hash(const char* str) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (; *str; ++str) {
+    hash ^= static_cast<uint8_t>(*str);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
 template<typename EnumType>
 utils::SharedPtr<TEnumSchemaItem<EnumType> > TEnumSchemaItem<EnumType>::create(
   const std::set<EnumType>& AllowedElements,
@@ -30,25 +30,39 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "application_manager_metric.h"
-#include "json_keys.h"
-#include "application_manager/smart_object_keys.h"
-
-namespace time_tester {
-
-Json::Value ApplicationManagerMetricWrapper::GetJsonMetric() {
-  Json::Value result = MetricWrapper::GetJsonMetric();
-  result[strings::logger] = "ApplicationManager";
-  result[strings::begin] =
-      Json::Int64(date_time::DateTime::getuSecs(message_metric->begin));
-  result[strings::end] =
-      Json::Int64(date_time::DateTime::getuSecs(message_metric->end));
-  const NsSmartDeviceLink::NsSmartObjects::SmartObject& params =
-      message_metric->message->getElement(application_manager::strings::params);
-  result[strings::correlation_id] =
-      params[application_manager::strings::correlation_id].asInt();
-  result[strings::connection_key] =
-      params[application_manager::strings::connection_key].asInt();
-  return result;
+#include "smart_objects/compiled_schema_item.h"
+
+namespace NsSmartDeviceLink {
+namespace NsSmartObjects {
+
+utils::SharedPtr<CCompiledSchemaItem> CCompiledSchemaItem::create(
+    const CSmartSchema& reference_schema,
+    CompiledValidator validator) {
+  return new CCompiledSchemaItem(reference_schema, validator);
+}
+
+Errors::eType CCompiledSchemaItem::validate(const SmartObject& Object) {
+  return validator_(Object);
 }
-}  // namespace time_tester
+
+void CCompiledSchemaItem::applySchema(SmartObject& Object) {
+  reference_schema_.applySchema(Object);
+}
+
+void CCompiledSchemaItem::unapplySchema(SmartObject& Object) {
+  reference_schema_.unapplySchema(Object);
+}
+
+void CCompiledSchemaItem::BuildObjectBySchema(
+    const SmartObject& pattern_object, SmartObject& result_object) {
+  reference_schema_.BuildObjectBySchema(pattern_object, result_object);
+}
+
+CCompiledSchemaItem::CCompiledSchemaItem(const CSmartSchema& reference_schema,
+                                         CompiledValidator validator)
+  : reference_schema_(reference_schema),
+    validator_(validator) {
+}
+
+}  // namespace NsSmartObjects
+}  // namespace NsSmartDeviceLink
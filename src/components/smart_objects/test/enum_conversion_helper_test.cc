@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <set>
+
+#include "gtest/gtest.h"
+#include "smart_objects/enum_schema_item.h"
+
+namespace test {
+namespace components {
+namespace smart_objects {
+
+namespace TestType {
+enum eType {
+  INVALID_ENUM = -1,
+  USER_EXIT = 0,
+  IGNITION_OFF,
+  BLUETOOTH_OFF,
+  USB_DISCONNECTED,
+  TOO_MANY_REQUESTS,
+  MASTER_RESET,
+  FACTORY_DEFAULTS,
+  APP_UNAUTHORIZED
+};
+}  // namespace TestType
+
+}  // namespace smart_objects
+}  // namespace components
+}  // namespace test
+
+namespace NsSmartDeviceLink {
+namespace NsSmartObjects {
+
+typedef test::components::smart_objects::TestType::eType TestEnum;
+
+template<>
+const char* const EnumConversionHelper<TestEnum>::cstring_values_[] = {
+  "USER_EXIT",
+  "IGNITION_OFF",
+  "BLUETOOTH_OFF",
+  "USB_DISCONNECTED",
+  "TOO_MANY_REQUESTS",
+  "MASTER_RESET",
+  "FACTORY_DEFAULTS",
+  "APP_UNAUTHORIZED"
+};
+
+template<>
+const TestEnum EnumConversionHelper<TestEnum>::enum_values_[] = {
+  test::components::smart_objects::TestType::USER_EXIT,
+  test::components::smart_objects::TestType::IGNITION_OFF,
+  test::components::smart_objects::TestType::BLUETOOTH_OFF,
+  test::components::smart_objects::TestType::USB_DISCONNECTED,
+  test::components::smart_objects::TestType::TOO_MANY_REQUESTS,
+  test::components::smart_objects::TestType::MASTER_RESET,
+  test::components::smart_objects::TestType::FACTORY_DEFAULTS,
+  test::components::smart_objects::TestType::APP_UNAUTHORIZED
+};
+
+template<>
+const EnumConversionHelper<TestEnum>::EnumToCStringMap
+EnumConversionHelper<TestEnum>::enum_to_cstring_map_ =
+  EnumConversionHelper<TestEnum>::InitEnumToCStringMap();
+
+template<>
+const EnumConversionHelper<TestEnum>::CStringToEnumMap
+EnumConversionHelper<TestEnum>::cstring_to_enum_map_ =
+  EnumConversionHelper<TestEnum>::InitCStringToEnumMap();
+
+}  // namespace NsSmartObjects
+}  // namespace NsSmartDeviceLink
+
+namespace test {
+namespace components {
+namespace smart_objects {
+
+using NsSmartDeviceLink::NsSmartObjects::EnumConversionHelper;
+using NsSmartDeviceLink::NsSmartObjects::EnumToCStringTable;
+using NsSmartDeviceLink::NsSmartObjects::CStringToEnumTable;
+
+TEST(EnumConversionHelperTest, LookupsInBothDirections) {
+  typedef EnumConversionHelper<TestType::eType> Helper;
+  std::set<TestType::eType> all;
+  for (int32_t i = TestType::USER_EXIT; i <= TestType::APP_UNAUTHORIZED; ++i) {
+    all.insert(static_cast<TestType::eType>(i));
+  }
+
+  for (std::set<TestType::eType>::const_iterator it = all.begin();
+       it != all.end(); ++it) {
+    const char* str = NULL;
+    ASSERT_TRUE(Helper::EnumToCString(*it, &str));
+    TestType::eType value = TestType::INVALID_ENUM;
+    ASSERT_TRUE(Helper::CStringToEnum(str, &value));
+    EXPECT_EQ(*it, value);
+  }
+  EXPECT_EQ(all.size(), Helper::enum_to_cstring_map().size());
+  EXPECT_EQ(all.size(), Helper::cstring_to_enum_map().size());
+
+  const char* str = NULL;
+  EXPECT_FALSE(Helper::EnumToCString(TestType::INVALID_ENUM, &str));
+  EXPECT_FALSE(Helper::EnumToCString(
+      static_cast<TestType::eType>(TestType::APP_UNAUTHORIZED + 1), &str));
+  TestType::eType value = TestType::INVALID_ENUM;
+  EXPECT_FALSE(Helper::CStringToEnum("USER_EXI", &value));
+  EXPECT_FALSE(Helper::CStringToEnum("", &value));
+  EXPECT_FALSE(Helper::CStringToEnum(NULL, &value));
+  EXPECT_EQ(TestType::INVALID_ENUM, value);
+}
+
+TEST(EnumConversionTableTest, SparseAndRepeatedElements) {
+  const TestType::eType far_away = static_cast<TestType::eType>(100000);
+  const TestType::eType values[] = {
+    TestType::APP_UNAUTHORIZED, far_away,
+    TestType::USER_EXIT, TestType::USER_EXIT
+  };
+  const char* const strings[] = {
+    "APP_UNAUTHORIZED", "FAR_AWAY", "USER_EXIT", "EXIT"
+  };
+  const size_t size = sizeof(values) / sizeof(values[0]);
+
+  const EnumToCStringTable<TestType::eType> enum_to_cstring(
+      values, strings, size);
+  ASSERT_EQ(3u, enum_to_cstring.size());
+  EXPECT_EQ(TestType::USER_EXIT, enum_to_cstring.begin()->first);
+  EXPECT_STREQ("EXIT", enum_to_cstring.find(TestType::USER_EXIT)->second);
+  EXPECT_STREQ("FAR_AWAY", enum_to_cstring.find(far_away)->second);
+  EXPECT_TRUE(enum_to_cstring.end() ==
+              enum_to_cstring.find(TestType::IGNITION_OFF));
+
+  const CStringToEnumTable<TestType::eType> cstring_to_enum(
+      strings, values, size);
+  ASSERT_EQ(4u, cstring_to_enum.size());
+  EXPECT_STREQ("APP_UNAUTHORIZED", cstring_to_enum.begin()->first);
+  EXPECT_EQ(TestType::USER_EXIT, cstring_to_enum.find("EXIT")->second);
+  EXPECT_EQ(far_away, cstring_to_enum.find("FAR_AWAY")->second);
+  EXPECT_TRUE(cstring_to_enum.end() == cstring_to_enum.find("FAR"));
+
+  const CStringToEnumTable<TestType::eType> empty(strings, values, 0);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(empty.end() == empty.find("EXIT"));
+}
+
+}  // namespace smart_objects
+}  // namespace components
+}  // namespace test
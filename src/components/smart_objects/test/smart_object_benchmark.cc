@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/utils/benchmark_helpers.h"
+#include "smart_objects/smart_object.h"
+#include "formatters/CFormatterJsonSDLRPCv2.hpp"
+#include "interfaces/MOBILE_API_schema.h"
+
+namespace {
+
+/**
+ * @brief Allocation statistics of the whole process, collected by
+ * the replaced global operators new and delete below.
+ */
+size_t g_allocations = 0;
+size_t g_allocated_bytes = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++g_allocations;
+  g_allocated_bytes += size;
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* ptr) throw() {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) throw() {
+  free(ptr);
+}
+
+namespace test {
+namespace components {
+namespace smart_objects {
+
+namespace smart = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = NsSmartDeviceLink::NsJSONHandler::strings;
+using NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonSDLRPCv2;
+
+/**
+ * @brief Number of times each phase is repeated for each message.
+ * Can be overridden with SDL_BENCHMARK_ITERATIONS environment variable.
+ */
+const size_t kDefaultIterations = 200;
+
+/**
+ * @brief Key application manager keeps binary payload of a message under.
+ */
+const char kBinaryData[] = "binary_data";
+
+const size_t kPutFilePayloadSize = 64 * 1024;
+
+struct Sample {
+  std::string name;
+  mobile_apis::FunctionID::eType function_id;
+  mobile_apis::messageType::eType message_type;
+  std::string json;
+  smart::SmartBinary binary;
+};
+
+typedef std::vector<Sample> Corpus;
+
+smart::SmartObject RegisterAppInterfaceParams() {
+  smart::SmartObject msg_params(smart::SmartType_Map);
+  msg_params["syncMsgVersion"]["majorVersion"] = 3;
+  msg_params["syncMsgVersion"]["minorVersion"] = 0;
+  msg_params["appName"] = "Benchmark Media Player";
+  msg_params["ngnMediaScreenAppName"] = "Benchmark";
+  for (int i = 0; i < 5; ++i) {
+    char text[32];
+    snprintf(text, sizeof(text), "Benchmark player %d", i);
+    msg_params["ttsName"][i]["text"] = text;
+    msg_params["ttsName"][i]["type"] = "TEXT";
+    msg_params["vrSynonyms"][i] = text;
+  }
+  msg_params["isMediaApplication"] = true;
+  msg_params["languageDesired"] = "EN-US";
+  msg_params["hmiDisplayLanguageDesired"] = "EN-US";
+  msg_params["appHMIType"][0] = "MEDIA";
+  msg_params["appHMIType"][1] = "NAVIGATION";
+  msg_params["hashID"] = "0123456789abcdef0123456789abcdef";
+  msg_params["deviceInfo"]["hardware"] = "Phone model 12 rev B";
+  msg_params["deviceInfo"]["firmwareRev"] = "FW 4.4.2 build 1024";
+  msg_params["deviceInfo"]["os"] = "Android";
+  msg_params["deviceInfo"]["osVersion"] = "4.4.2";
+  msg_params["deviceInfo"]["carrier"] = "Benchmark Mobile";
+  msg_params["deviceInfo"]["maxNumberRFCOMMPorts"] = 5;
+  msg_params["appID"] = "584421907";
+  return msg_params;
+}
+
+smart::SmartObject CreateInteractionChoiceSetParams() {
+  smart::SmartObject msg_params(smart::SmartType_Map);
+  msg_params["interactionChoiceSetID"] = 1001;
+  for (int i = 0; i < 100; ++i) {
+    char text[64];
+    smart::SmartObject& choice = msg_params["choiceSet"][i];
+    choice["choiceID"] = 2000 + i;
+    snprintf(text, sizeof(text), "Destination number %d", i);
+    choice["menuName"] = text;
+    choice["secondaryText"] = "Recently visited";
+    choice["tertiaryText"] = "12 miles away";
+    choice["vrCommands"][0] = text;
+    snprintf(text, sizeof(text), "Destination %d", i);
+    choice["vrCommands"][1] = text;
+    snprintf(text, sizeof(text), "icon_%d.png", i);
+    choice["image"]["value"] = text;
+    choice["image"]["imageType"] = "DYNAMIC";
+  }
+  return msg_params;
+}
+
+smart::SmartObject OnVehicleDataParams() {
+  smart::SmartObject msg_params(smart::SmartType_Map);
+  smart::SmartObject& gps = msg_params["gps"];
+  gps["longitudeDegrees"] = 42.5;
+  gps["latitudeDegrees"] = -83.3;
+  gps["utcYear"] = 2014;
+  gps["utcMonth"] = 6;
+  gps["utcDay"] = 15;
+  gps["utcHours"] = 12;
+  gps["utcMinutes"] = 30;
+  gps["utcSeconds"] = 45;
+  gps["compassDirection"] = "NORTH";
+  gps["pdop"] = 1.5;
+  gps["hdop"] = 1.2;
+  gps["vdop"] = 0.9;
+  gps["actual"] = true;
+  gps["satellites"] = 9;
+  gps["dimension"] = "3D";
+  gps["altitude"] = 190.5;
+  gps["heading"] = 271.25;
+  gps["speed"] = 88.5;
+  msg_params["speed"] = 88.5;
+  msg_params["rpm"] = 2500;
+  msg_params["fuelLevel"] = 55.5;
+  msg_params["fuelLevel_State"] = "NORMAL";
+  msg_params["instantFuelConsumption"] = 7.25;
+  msg_params["externalTemperature"] = 21.5;
+  msg_params["vin"] = "1FAHP3F29CL123456";
+  msg_params["prndl"] = "DRIVE";
+  const char* tires[] = {"leftFront", "rightFront", "leftRear", "rightRear",
+                         "innerLeftRear", "innerRightRear"};
+  msg_params["tirePressure"]["pressureTelltale"] = "OFF";
+  for (size_t i = 0; i < sizeof(tires) / sizeof(tires[0]); ++i) {
+    msg_params["tirePressure"][tires[i]]["status"] = "NORMAL";
+  }
+  msg_params["odometer"] = 23456;
+  const char* belts[] = {
+    "driverBeltDeployed", "passengerBeltDeployed", "passengerBuckleBelted",
+    "driverBuckleBelted", "leftRow2BuckleBelted", "passengerChildDetected",
+    "rightRow2BuckleBelted", "middleRow2BuckleBelted",
+    "middleRow3BuckleBelted", "leftRow3BuckleBelted", "rightRow3BuckleBelted",
+    "leftRearInflatableBelted", "rightRearInflatableBelted",
+    "middleRow1BeltDeployed", "middleRow1BuckleBelted"};
+  for (size_t i = 0; i < sizeof(belts) / sizeof(belts[0]); ++i) {
+    msg_params["beltStatus"][belts[i]] = "NO_EVENT";
+  }
+  msg_params["bodyInformation"]["parkBrakeActive"] = false;
+  msg_params["bodyInformation"]["ignitionStableStatus"] = "IGNITION_SWITCH_STABLE";
+  msg_params["bodyInformation"]["ignitionStatus"] = "RUN";
+  msg_params["driverBraking"] = "NO";
+  msg_params["headLampStatus"]["lowBeamsOn"] = true;
+  msg_params["headLampStatus"]["highBeamsOn"] = false;
+  msg_params["headLampStatus"]["ambientLightSensorStatus"] = "NIGHT";
+  msg_params["engineTorque"] = 250.5;
+  msg_params["accPedalPosition"] = 35.5;
+  msg_params["steeringWheelAngle"] = -12.5;
+  return msg_params;
+}
+
+smart::SmartObject PutFileParams() {
+  smart::SmartObject msg_params(smart::SmartType_Map);
+  msg_params["syncFileName"] = "album_cover.png";
+  msg_params["fileType"] = "GRAPHIC_PNG";
+  msg_params["persistentFile"] = false;
+  msg_params["systemFile"] = false;
+  msg_params["offset"] = 0;
+  msg_params["length"] = static_cast<int>(kPutFilePayloadSize);
+  return msg_params;
+}
+
+void AddSample(Corpus& corpus, const std::string& name,
+               mobile_apis::FunctionID::eType function_id,
+               mobile_apis::messageType::eType message_type,
+               const smart::SmartObject& msg_params,
+               size_t binary_size) {
+  smart::SmartObject object(smart::SmartType_Map);
+  object[strings::S_MSG_PARAMS] = msg_params;
+
+  Sample sample;
+  sample.name = name;
+  sample.function_id = function_id;
+  sample.message_type = message_type;
+  CFormatterJsonSDLRPCv2::toString(object, sample.json);
+  for (size_t i = 0; i < binary_size; ++i) {
+    sample.binary.push_back(static_cast<uint8_t>(i * 31));
+  }
+  corpus.push_back(sample);
+}
+
+Corpus MakeCorpus() {
+  Corpus corpus;
+  AddSample(corpus, "RegisterAppInterface",
+            mobile_apis::FunctionID::RegisterAppInterfaceID,
+            mobile_apis::messageType::request,
+            RegisterAppInterfaceParams(), 0);
+  AddSample(corpus, "CreateInteractionChoiceSet",
+            mobile_apis::FunctionID::CreateInteractionChoiceSetID,
+            mobile_apis::messageType::request,
+            CreateInteractionChoiceSetParams(), 0);
+  AddSample(corpus, "OnVehicleData",
+            mobile_apis::FunctionID::OnVehicleDataID,
+            mobile_apis::messageType::notification,
+            OnVehicleDataParams(), 0);
+  AddSample(corpus, "PutFile",
+            mobile_apis::FunctionID::PutFileID,
+            mobile_apis::messageType::request,
+            PutFileParams(), kPutFilePayloadSize);
+  return corpus;
+}
+
+using ::test::benchmark::EnvironmentValue;
+using ::test::benchmark::Now;
+
+size_t Iterations() {
+  return EnvironmentValue("SDL_BENCHMARK_ITERATIONS", kDefaultIterations);
+}
+
+/**
+ * @brief Measures wall time and allocations of a benchmark phase.
+ */
+class PhaseMeter {
+ public:
+  PhaseMeter()
+    : start_(Now()),
+      allocations_(g_allocations),
+      allocated_bytes_(g_allocated_bytes) {
+  }
+
+  /**
+   * @brief Prints phase statistics for given number of processed messages.
+   * @param phase Phase name
+   * @param messages Number of messages processed in phase
+   * @param bytes Size of messages processed in phase
+   */
+  void Report(const char* phase, size_t messages, size_t bytes) const {
+    const double seconds = Now() - start_;
+    const size_t allocations = g_allocations - allocations_;
+    const size_t allocated_bytes = g_allocated_bytes - allocated_bytes_;
+    printf("  %-10s %12.0f msg/s %10.2f MB/s %10.1f allocs/msg"
+           " %12.1f bytes/msg\n",
+           phase,
+           seconds > 0 ? messages / seconds : 0,
+           seconds > 0 ? bytes / seconds / (1024 * 1024) : 0,
+           static_cast<double>(allocations) / messages,
+           static_cast<double>(allocated_bytes) / messages);
+  }
+
+ private:
+  const double start_;
+  const size_t allocations_;
+  const size_t allocated_bytes_;
+};
+
+bool Parse(const Sample& sample, smart::SmartObject& object) {
+  if (!CFormatterJsonSDLRPCv2::fromString(sample.json, object,
+                                           sample.function_id,
+                                           sample.message_type, 1)) {
+    return false;
+  }
+  if (!sample.binary.empty()) {
+    object[strings::S_PARAMS][kBinaryData] = sample.binary;
+  }
+  return true;
+}
+
+void RunBenchmark(const Sample& sample, size_t iterations) {
+  mobile_apis::MOBILE_API factory;
+  const size_t size = sample.json.size() + sample.binary.size();
+  const size_t total_size = size * iterations;
+  printf("%s: %u bytes of JSON, %u bytes of binary data\n",
+         sample.name.c_str(), static_cast<unsigned>(sample.json.size()),
+         static_cast<unsigned>(sample.binary.size()));
+
+  std::vector<smart::SmartObject*> objects(iterations);
+  {
+    PhaseMeter meter;
+    for (size_t i = 0; i < iterations; ++i) {
+      objects[i] = new smart::SmartObject;
+      ASSERT_TRUE(Parse(sample, *objects[i]));
+    }
+    meter.Report("parse", iterations, total_size);
+  }
+  {
+    PhaseMeter meter;
+    for (size_t i = 0; i < iterations; ++i) {
+      ASSERT_TRUE(factory.attachSchema(*objects[i]));
+      ASSERT_EQ(smart::Errors::OK, objects[i]->validate());
+    }
+    meter.Report("validate", iterations, total_size);
+  }
+  {
+    PhaseMeter meter;
+    std::string json;
+    for (size_t i = 0; i < iterations; ++i) {
+      ASSERT_TRUE(CFormatterJsonSDLRPCv2::toString(*objects[i], json));
+    }
+    meter.Report("serialize", iterations, total_size);
+  }
+  std::vector<smart::SmartObject*> copies(iterations);
+  {
+    PhaseMeter meter;
+    for (size_t i = 0; i < iterations; ++i) {
+      copies[i] = new smart::SmartObject(*objects[i]);
+    }
+    meter.Report("copy", iterations, total_size);
+  }
+  {
+    PhaseMeter meter;
+    for (size_t i = 0; i < iterations; ++i) {
+      delete copies[i];
+      delete objects[i];
+    }
+    meter.Report("destroy", 2 * iterations, 2 * total_size);
+  }
+}
+
+TEST(SmartObjectBenchmark, MobileApiCorpus) {
+  const Corpus corpus = MakeCorpus();
+  const size_t iterations = Iterations();
+  printf("%u iterations per phase\n", static_cast<unsigned>(iterations));
+  for (Corpus::const_iterator it = corpus.begin(); it != corpus.end(); ++it) {
+    RunBenchmark(*it, iterations);
+  }
+}
+
+}  // namespace smart_objects
+}  // namespace components
+}  // namespace test
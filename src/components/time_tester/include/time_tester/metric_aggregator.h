@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_AGGREGATOR_H_
+#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_AGGREGATOR_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "metric_record.h"
+#include "utils/macro.h"
+
+namespace time_tester {
+
+/**
+ * @brief Aggregates metric records into counters and histograms of
+ * duration per source, stage and function id.
+ *
+ * Buckets are powers of two of microseconds, bucket i counts durations in
+ * range [2^(i-1), 2^i) and the last bucket counts all longer durations.
+ * Aggregator is used by single thread which drains records and makes
+ * snapshots, so it is not locked.
+ */
+class MetricAggregator {
+ public:
+  static const uint32_t kBucketsCount = 24;
+
+  /**
+   * @brief Snapshot starts with this value, in host byte order
+   */
+  static const uint32_t kSnapshotMagic = 0x4D4C4453;  // "SDLM"
+  static const uint16_t kSnapshotVersion = 1;
+
+  MetricAggregator();
+
+  void Add(const MetricRecord& record);
+
+  /**
+   * @brief Counts records which were not recorded because ring was full
+   */
+  void AddDropped(uint32_t dropped);
+
+  /**
+   * @brief Binary snapshot of counters and histograms in host byte order:
+   *   header: uint32 magic, uint16 version, uint16 buckets count,
+   *           uint64 records, uint64 dropped, uint32 histograms count
+   *   every histogram: uint8 source, uint8 stage, uint16 reserved,
+   *           int32 function id, uint64 count, uint64 sum of durations,
+   *           uint32 max duration, uint32 reserved,
+   *           uint32 counts of every bucket
+   */
+  std::string Snapshot() const;
+
+  static uint32_t Bucket(uint32_t duration);
+
+  uint64_t records() const {
+    return records_;
+  }
+
+  uint64_t dropped() const {
+    return dropped_;
+  }
+
+ private:
+  struct Histogram {
+    Histogram();
+    void Add(uint32_t duration);
+    uint32_t buckets[kBucketsCount];
+    uint64_t count;
+    uint64_t sum;
+    uint32_t max;
+  };
+  // Source and stage, function id
+  typedef std::pair<uint16_t, int32_t> Key;
+  typedef std::map<Key, Histogram> Histograms;
+
+  Histograms histograms_;
+  uint64_t records_;
+  uint64_t dropped_;
+
+  DISALLOW_COPY_AND_ASSIGN(MetricAggregator);
+};
+
+}  // namespace time_tester
+#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_AGGREGATOR_H_
@@ -30,30 +30,45 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
+#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_RECORD_H_
+#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_RECORD_H_
 
-#include <string>
-#include "utils/resource_usage.h"
-#include "json/json.h"
+#include <stdint.h>
 
 namespace time_tester {
 
-class MetricWrapper {
-  utils::ResourseUsage* resources;
-  public:
-    MetricWrapper();
-    /*
-     * @brief get current cpu and memory info and store it as member
-     */
-    bool grabResources();
-    virtual std::string GetStyledString();
-    virtual ~MetricWrapper();
-  protected:
-    virtual Json::Value GetJsonMetric();
-    void Clear();
-};
+/**
+ * @brief Fixed size binary record of one measured event
+ */
+struct MetricRecord {
+  enum Source {
+    kApplicationManager = 0,
+    kProtocolHandler,
+    kTransportManager,
+    // Time from transport receive of request to stage of its processing
+    kLatency,
+    kSourcesCount
+  };
 
+  MetricRecord()
+    : source(kApplicationManager),
+      stage(0),
+      reserved(0),
+      function_id(-1),
+      data_size(0),
+      duration(0) {
+  }
+
+  uint8_t source;
+  // protocol_handler::MessageTrace::Stage of kLatency records
+  uint8_t stage;
+  uint16_t reserved;
+  // Function id of RPC, -1 if it is unknown to source
+  int32_t function_id;
+  uint32_t data_size;
+  // Microseconds
+  uint32_t duration;
+};
 
 }  // namespace time_tester
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
+#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_RECORD_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_RECORDER_H_
+#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_RECORDER_H_
+
+#include <pthread.h>
+#include <vector>
+
+#include "metric_record.h"
+#include "utils/lock.h"
+#include "utils/lock_free_ring.h"
+#include "utils/macro.h"
+
+namespace time_tester {
+
+class MetricAggregator;
+
+/**
+ * @brief Collects metric records of all threads without locking them.
+ *
+ * Every thread which records metrics gets own ring of records, which is
+ * registered under lock once, on first record of thread. Afterwards thread
+ * only pushes records to its ring and single drainer thread moves them to
+ * aggregator. Record which doesn't fit into full ring is counted as
+ * dropped. Ring of exited thread is marked dead and freed by drainer after
+ * its last records are drained.
+ */
+class MetricRecorder {
+ public:
+  static const size_t kRingCapacity = 1024;
+
+  MetricRecorder();
+  ~MetricRecorder();
+
+  /**
+   * @brief Records metric of calling thread
+   */
+  void Record(const MetricRecord& record);
+
+  /**
+   * @brief Moves records of all threads to aggregator, called by one
+   * thread at a time
+   */
+  void Drain(MetricAggregator* aggregator);
+
+ private:
+  struct ThreadRing {
+    ThreadRing()
+      : dropped(0),
+        dropped_drained(0),
+        dead(0) {
+    }
+    utils::LockFreeRing<MetricRecord, kRingCapacity> records;
+    // Written by owning thread only
+    volatile uint32_t dropped;
+    // Read by drainer only
+    uint32_t dropped_drained;
+    // Set when owning thread exits
+    volatile unsigned int dead;
+  };
+
+  ThreadRing* CurrentThreadRing();
+
+  /**
+   * @brief Destructor of ring key, marks ring of exiting thread as dead
+   */
+  static void MarkRingDead(void* ring);
+
+  pthread_key_t ring_key_;
+  std::vector<ThreadRing*> rings_;
+  sync_primitives::Lock rings_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(MetricRecorder);
+};
+
+}  // namespace time_tester
+#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_METRIC_RECORDER_H_
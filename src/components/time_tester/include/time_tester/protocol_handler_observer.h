@@ -33,8 +33,10 @@
 #ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_PROTOCOL_HANDLER_OBSERVER_H_
 #define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_PROTOCOL_HANDLER_OBSERVER_H_
 
+#include <map>
+
 #include "protocol_handler/time_metric_observer.h"
-#include "utils/message_queue.h"
+#include "utils/lock.h"
 
 namespace time_tester {
 
@@ -51,6 +53,7 @@ class ProtocolHandlerObserver: public protocol_handler::PHMetricObserver {
  private:
   TimeManager* time_manager_;
   std::map<uint32_t, TimevalStruct> time_starts;
+  sync_primitives::Lock time_starts_lock_;
 };
 }  // namespace time_tester
 #endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_PROTOCOL_HANDLER_OBSERVER_H_
@@ -35,12 +35,13 @@
 
 #include <string>
 
-#include "utils/shared_ptr.h"
-#include "utils/message_queue.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
 #include "utils/threads/thread.h"
-#include "utils/singleton.h"
 #include "utils/threads/thread_delegate.h"
-#include "metric_wrapper.h"
+#include "metric_record.h"
+#include "metric_recorder.h"
+#include "metric_aggregator.h"
 #include "application_manager_observer.h"
 #include "application_manager/application_manager_impl.h"
 #include "transport_manager_observer.h"
@@ -50,40 +51,55 @@
 
 namespace time_tester {
 
+/**
+ * @brief Collects metrics of components as binary records and exports
+ * their aggregated snapshot.
+ *
+ * Records are aggregated in process all the time. Client which wants
+ * metrics connects to UNIX socket, reads snapshot and is disconnected, so
+ * nothing is lost while there is no client and nothing is serialized per
+ * event.
+ */
 class TimeManager {
  public:
   TimeManager();
   ~TimeManager();
   void Init(protocol_handler::ProtocolHandlerImpl* ph);
   void Stop();
-  void SendMetric(utils::SharedPtr<MetricWrapper> metric);
+  /**
+   * @brief Records metric of calling thread without locking
+   */
+  void Record(const MetricRecord& record);
+  /**
+   * @brief Records latency of every stage of message which response
+   * was sent
+   */
+  void OnTraceCompleted(const protocol_handler::MessageTracePtr& trace);
  private:
 
-  class Streamer : public threads::ThreadDelegate {
+  class Exporter : public threads::ThreadDelegate {
    public:
-    explicit Streamer(TimeManager* const server);
-    ~Streamer();
+    explicit Exporter(TimeManager* const server);
     void threadMain() OVERRIDE;
     bool exitThreadMain() OVERRIDE;
-    bool IsReady() const;
-    void Start();
-    void Stop();
-    bool Send(const std::string &msg);
-  volatile bool is_client_connected_;
-  private:
+   private:
+    bool Listen();
+    void SendSnapshot();
     TimeManager* const server_;
-    int32_t new_socket_fd_;  
+    int32_t socket_fd_;
     volatile bool stop_flag_;
-    DISALLOW_COPY_AND_ASSIGN(Streamer);
+    DISALLOW_COPY_AND_ASSIGN(Exporter);
   };
 
-  int16_t port_;
-  std::string ip_;
-  int32_t socket_fd_;
-  bool is_ready_;
+  std::string socket_path_;
   threads::Thread* thread_;
-  MessageQueue<utils::SharedPtr<MetricWrapper> > messages_;
-  Streamer* streamer_;
+  MetricRecorder recorder_;
+  // Used by exporter thread only
+  MetricAggregator aggregator_;
+  // Set when exporter is done with recorder and aggregator
+  bool exporter_finished_;
+  sync_primitives::Lock exporter_lock_;
+  sync_primitives::ConditionalVariable exporter_finished_cond_;
   ApplicationManagerObserver app_observer;
   TransportManagerObserver tm_observer;
   ProtocolHandlerObserver ph_observer;
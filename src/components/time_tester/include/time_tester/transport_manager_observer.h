@@ -34,8 +34,6 @@
 #define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_OBSERVER_H_
 
 #include "transport_manager/time_metric_observer.h"
-#include "utils/message_queue.h"
-#include "utils/date_time.h"
 
 namespace time_tester {
 
@@ -48,7 +46,6 @@ class TransportManagerObserver: public transport_manager::TMMetricObserver {
   virtual void StopRawMsg(const protocol_handler::RawMessage* ptr);
  private:
   TimeManager* time_manager_;
-  std::map<const protocol_handler::RawMessage*, TimevalStruct> time_starts;
 };
 }  // namespace time_tester
 #endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_OBSERVER_H_
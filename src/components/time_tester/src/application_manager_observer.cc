@@ -32,7 +32,6 @@
 #include "application_manager_observer.h"
 #include "utils/shared_ptr.h"
 #include "time_manager.h"
-#include "application_manager_metric.h"
 
 namespace time_tester {
 
@@ -41,9 +40,15 @@ ApplicationManagerObserver::ApplicationManagerObserver(TimeManager* time_manager
 }
 
 void ApplicationManagerObserver::OnMessage(utils::SharedPtr<MessageMetric> metric) {
-  ApplicationManagerMetricWrapper* m = new ApplicationManagerMetricWrapper();
-  m->message_metric = metric;
-  m->grabResources();
-  time_manager_->SendMetric(m);
+  MetricRecord record;
+  record.source = MetricRecord::kApplicationManager;
+  const smart_objects::SmartObject& params =
+      metric->message->getElement(application_manager::strings::params);
+  record.function_id =
+      params[application_manager::strings::function_id].asInt();
+  record.duration = static_cast<uint32_t>(
+      date_time::DateTime::getuSecs(metric->end) -
+      date_time::DateTime::getuSecs(metric->begin));
+  time_manager_->Record(record);
 }
 }  // namespace time_tester
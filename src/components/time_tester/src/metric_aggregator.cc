@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metric_aggregator.h"
+
+#include <string.h>
+
+namespace time_tester {
+
+namespace {
+template<typename T>
+void Append(std::string* snapshot, const T& value) {
+  snapshot->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+}  // namespace
+
+const uint32_t MetricAggregator::kBucketsCount;
+const uint32_t MetricAggregator::kSnapshotMagic;
+const uint16_t MetricAggregator::kSnapshotVersion;
+
+MetricAggregator::Histogram::Histogram()
+  : count(0),
+    sum(0),
+    max(0) {
+  memset(buckets, 0, sizeof(buckets));
+}
+
+void MetricAggregator::Histogram::Add(uint32_t duration) {
+  ++buckets[Bucket(duration)];
+  ++count;
+  sum += duration;
+  if (duration > max) {
+    max = duration;
+  }
+}
+
+MetricAggregator::MetricAggregator()
+  : records_(0),
+    dropped_(0) {
+}
+
+uint32_t MetricAggregator::Bucket(uint32_t duration) {
+  uint32_t bucket = 0;
+  while (duration > 0 && bucket < kBucketsCount - 1) {
+    duration >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void MetricAggregator::Add(const MetricRecord& record) {
+  const uint16_t source_stage = (record.source << 8) | record.stage;
+  histograms_[Key(source_stage, record.function_id)].Add(record.duration);
+  ++records_;
+}
+
+void MetricAggregator::AddDropped(uint32_t dropped) {
+  dropped_ += dropped;
+}
+
+std::string MetricAggregator::Snapshot() const {
+  std::string snapshot;
+  const size_t histogram_size = 2 * sizeof(uint8_t) + sizeof(uint16_t) +
+      sizeof(int32_t) + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t) +
+      kBucketsCount * sizeof(uint32_t);
+  snapshot.reserve(32 + histograms_.size() * histogram_size);
+
+  Append(&snapshot, kSnapshotMagic);
+  Append(&snapshot, kSnapshotVersion);
+  Append(&snapshot, static_cast<uint16_t>(kBucketsCount));
+  Append(&snapshot, records_);
+  Append(&snapshot, dropped_);
+  Append(&snapshot, static_cast<uint32_t>(histograms_.size()));
+
+  const uint16_t reserved16 = 0;
+  const uint32_t reserved32 = 0;
+  for (Histograms::const_iterator it = histograms_.begin();
+       histograms_.end() != it; ++it) {
+    const Histogram& histogram = it->second;
+    Append(&snapshot, static_cast<uint8_t>(it->first.first >> 8));
+    Append(&snapshot, static_cast<uint8_t>(it->first.first & 0xFF));
+    Append(&snapshot, reserved16);
+    Append(&snapshot, it->first.second);
+    Append(&snapshot, histogram.count);
+    Append(&snapshot, histogram.sum);
+    Append(&snapshot, histogram.max);
+    Append(&snapshot, reserved32);
+    snapshot.append(reinterpret_cast<const char*>(histogram.buckets),
+                    sizeof(histogram.buckets));
+  }
+  return snapshot;
+}
+
+}  // namespace time_tester
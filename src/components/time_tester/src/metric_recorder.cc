@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metric_recorder.h"
+
+#include "metric_aggregator.h"
+#include "utils/atomic.h"
+
+namespace time_tester {
+
+const size_t MetricRecorder::kRingCapacity;
+
+MetricRecorder::MetricRecorder() {
+  pthread_key_create(&ring_key_, &MetricRecorder::MarkRingDead);
+}
+
+MetricRecorder::~MetricRecorder() {
+  pthread_key_delete(ring_key_);
+  sync_primitives::AutoLock lock(rings_lock_);
+  for (std::vector<ThreadRing*>::iterator it = rings_.begin();
+       rings_.end() != it; ++it) {
+    delete *it;
+  }
+  rings_.clear();
+}
+
+void MetricRecorder::Record(const MetricRecord& record) {
+  ThreadRing* ring = CurrentThreadRing();
+  if (!ring->records.Push(record)) {
+    ring->dropped = ring->dropped + 1;
+  }
+}
+
+void MetricRecorder::Drain(MetricAggregator* aggregator) {
+  DCHECK(aggregator);
+  sync_primitives::AutoLock lock(rings_lock_);
+  MetricRecord record;
+  std::vector<ThreadRing*>::iterator it = rings_.begin();
+  while (rings_.end() != it) {
+    ThreadRing* ring = *it;
+    // Dead thread pushed its last record before it was marked
+    const bool dead = 0 != atomic_post_clr(&ring->dead);
+    while (ring->records.Pop(&record)) {
+      aggregator->Add(record);
+    }
+    const uint32_t dropped = ring->dropped;
+    aggregator->AddDropped(dropped - ring->dropped_drained);
+    ring->dropped_drained = dropped;
+    if (dead) {
+      delete ring;
+      it = rings_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+MetricRecorder::ThreadRing* MetricRecorder::CurrentThreadRing() {
+  ThreadRing* ring = static_cast<ThreadRing*>(pthread_getspecific(ring_key_));
+  if (ring) {
+    return ring;
+  }
+  // Ring of exited thread is kept until its records are drained
+  ring = new ThreadRing();
+  {
+    sync_primitives::AutoLock lock(rings_lock_);
+    rings_.push_back(ring);
+  }
+  pthread_setspecific(ring_key_, ring);
+  return ring;
+}
+
+void MetricRecorder::MarkRingDead(void* ring) {
+  atomic_post_set(&static_cast<ThreadRing*>(ring)->dead);
+}
+
+}  // namespace time_tester
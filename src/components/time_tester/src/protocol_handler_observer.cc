@@ -32,7 +32,6 @@
 
 #include "protocol_handler_observer.h"
 #include "utils/date_time.h"
-#include "protocol_handler_metric.h"
 #include "time_manager.h"
 
 namespace time_tester {
@@ -48,6 +47,7 @@ void ProtocolHandlerObserver::StartMessageProcess(uint32_t message_id,
   if (message_id == 0) {
     return;
   }
+  sync_primitives::AutoLock lock(time_starts_lock_);
   if (time_starts.find(message_id) != time_starts.end()) {
     LOG4CXX_INFO(logger_, "Message ID already wait for stop processing" << message_id);
     return;
@@ -57,16 +57,23 @@ void ProtocolHandlerObserver::StartMessageProcess(uint32_t message_id,
 
 void ProtocolHandlerObserver::EndMessageProcess(utils::SharedPtr<MessageMetric> m) {
   uint32_t message_id = m->message_id;
-  std::map<uint32_t, TimevalStruct>::const_iterator it = time_starts.find(message_id);
-  if (it == time_starts.end()) {
-    LOG4CXX_WARN(logger_, "Cant find start time for message" << message_id);
-    return;
+  {
+    sync_primitives::AutoLock lock(time_starts_lock_);
+    std::map<uint32_t, TimevalStruct>::iterator it = time_starts.find(message_id);
+    if (it == time_starts.end()) {
+      LOG4CXX_WARN(logger_, "Cant find start time for message" << message_id);
+      return;
+    }
+    m->begin = it->second;
+    time_starts.erase(it);
   }
-  m->begin= time_starts[message_id];
   m->end = date_time::DateTime::getCurrentTime();
-  ProtocolHandlerMecticWrapper* metric = new ProtocolHandlerMecticWrapper();
-  metric->message_metric = m;
-  metric->grabResources();
-  time_manager_->SendMetric(metric);
+  MetricRecord record;
+  record.source = MetricRecord::kProtocolHandler;
+  record.data_size = m->data_size;
+  record.duration = static_cast<uint32_t>(
+      date_time::DateTime::getuSecs(m->end) -
+      date_time::DateTime::getuSecs(m->begin));
+  time_manager_->Record(record);
 }
 }  //namespace time_tester
@@ -36,29 +36,36 @@
 #include <sys/types.h>
 #include <sys/select.h>
 #include <sys/time.h>
-#include <netinet/in.h>
-#include <arpa/inet.h>
+#include <sys/un.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 
 #include "transport_manager/transport_manager_default.h"
 #include "config_profile/profile.h"
-#include "utils/resource_usage.h"
 
 namespace time_tester {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "TimeManager")
 
+namespace {
+// Records are moved from rings of threads to aggregator this often
+const int32_t kDrainPeriodMs = 100;
+
+bool SetNonBlocking(int fd) {
+  const int flags = fcntl(fd, F_GETFL);
+  return -1 != flags && -1 != fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+}  // namespace
+
 TimeManager::TimeManager():
-  socket_fd_(0),
   thread_(NULL),
-  messages_(),
-  streamer_(NULL),
+  exporter_finished_(false),
   app_observer(this),
   tm_observer(this),
   ph_observer(this) {
-    ip_ = profile::Profile::instance()->server_address();
-    port_ = profile::Profile::instance()->time_testing_port();
+    socket_path_ = profile::Profile::instance()->time_testing_socket();
 }
 
 TimeManager::~TimeManager() {
@@ -69,172 +76,166 @@ TimeManager::~TimeManager() {
 void TimeManager::Init(protocol_handler::ProtocolHandlerImpl* ph) {
   DCHECK(ph);
   if (!thread_) {
-    streamer_ = new Streamer(this);
-    thread_ = threads::CreateThread("TimeManager", streamer_ );
+    thread_ = threads::CreateThread("TimeManager", new Exporter(this));
     application_manager::ApplicationManagerImpl::instance()->SetTimeMetricObserver(&app_observer);
     transport_manager::TransportManagerDefault::instance()->SetTimeMetricObserver(&tm_observer);
     ph->SetTimeMetricObserver(&ph_observer);
     thread_->startWithOptions(threads::ThreadOptions());
-    LOG4CXX_INFO(logger_, "Create and start sending thread");
+    LOG4CXX_INFO(logger_, "Create and start exporting thread");
     }
 }
 
 void TimeManager::Stop() {
   if (thread_) {
+    // Waits until exporter is done with recorder and aggregator
     thread_->stop();
+    threads::DeleteThread(thread_);
     thread_ = NULL;
-    if (socket_fd_ != -1) {
-      ::close(socket_fd_);
-    }
   }
-  messages_.Reset();
   LOG4CXX_INFO(logger_, "TimeManager stopped");
 }
 
-void TimeManager::SendMetric(utils::SharedPtr<MetricWrapper> metric) {
-  if ((NULL != streamer_ )&& streamer_->is_client_connected_) {
-    messages_.push(metric);
-  }
+void TimeManager::Record(const MetricRecord& record) {
+  recorder_.Record(record);
 }
 
-TimeManager::Streamer::Streamer(
-  TimeManager* const server)
-  : is_client_connected_(false),
-    server_(server),
-    new_socket_fd_(0),
-    stop_flag_(false) {
+void TimeManager::OnTraceCompleted(
+    const protocol_handler::MessageTracePtr& trace) {
+  using protocol_handler::MessageTrace;
+  MetricRecord record;
+  record.source = MetricRecord::kLatency;
+  record.function_id = trace->function_id();
+  for (int stage = MessageTrace::kTransportReceived + 1;
+       stage < MessageTrace::kStagesCount; ++stage) {
+    const MessageTrace::Stage current = static_cast<MessageTrace::Stage>(stage);
+    if (trace->IsMarked(current)) {
+      record.stage = static_cast<uint8_t>(stage);
+      record.duration = static_cast<uint32_t>(trace->TimeFromStart(current));
+      recorder_.Record(record);
+    }
+  }
 }
 
-TimeManager::Streamer::~Streamer() {
-  Stop();
+TimeManager::Exporter::Exporter(TimeManager* const server)
+  : server_(server),
+    socket_fd_(-1),
+    stop_flag_(false) {
 }
 
-void TimeManager::Streamer::threadMain() {
-  LOG4CXX_INFO(logger_, "Streamer::threadMain");
-
-  Start();
+void TimeManager::Exporter::threadMain() {
+  LOG4CXX_INFO(logger_, "Exporter::threadMain");
 
+  // Records are aggregated even if snapshots can't be exported
+  Listen();
   while (!stop_flag_) {
-    new_socket_fd_ = accept(server_->socket_fd_, NULL, NULL);
-    if (0 > new_socket_fd_) {
-      LOG4CXX_ERROR(logger_, "Cant open socket . Socket is busy ");
-      Stop();
-      break;
+    fd_set fds;
+    FD_ZERO(&fds);
+    if (-1 != socket_fd_) {
+      FD_SET(socket_fd_, &fds);
     }
-
-    is_client_connected_ = true;
-    while (is_client_connected_) {
-      while (!server_->messages_.empty()) {
-        utils::SharedPtr<MetricWrapper> metric = server_->messages_.pop();
-        is_client_connected_ = Send(metric->GetStyledString());
-      }
-
-      if (!IsReady()) {
-        LOG4CXX_INFO(logger_, "Client disconnected.");
-        Stop();
-        break;
-      }
-
-      server_->messages_.wait();
+    TimevalStruct tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = kDrainPeriodMs * date_time::DateTime::MICROSECONDS_IN_MILLISECONDS;
+    const int ready = select(socket_fd_ + 1, &fds, NULL, NULL, &tv);
+
+    server_->recorder_.Drain(&server_->aggregator_);
+    if (0 < ready && -1 != socket_fd_ && FD_ISSET(socket_fd_, &fds)) {
+      SendSnapshot();
     }
   }
+
+  if (-1 != socket_fd_) {
+    close(socket_fd_);
+    unlink(server_->socket_path_.c_str());
+    socket_fd_ = -1;
+  }
+  sync_primitives::AutoLock auto_lock(server_->exporter_lock_);
+  server_->exporter_finished_ = true;
+  server_->exporter_finished_cond_.Broadcast();
 }
 
-bool TimeManager::Streamer::exitThreadMain() {
-  LOG4CXX_INFO(logger_, "Streamer::exitThreadMain");
+bool TimeManager::Exporter::exitThreadMain() {
+  LOG4CXX_INFO(logger_, "Exporter::exitThreadMain");
   stop_flag_ = true;
-  Stop();
-  server_->messages_.Shutdown();
-  return false;
+  sync_primitives::AutoLock auto_lock(server_->exporter_lock_);
+  while (!server_->exporter_finished_) {
+    server_->exporter_finished_cond_.Wait(auto_lock);
+  }
+  return true;
 }
 
-void TimeManager::Streamer::Start() {
-  server_->socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-
-  if (0 >= server_->socket_fd_) {
-    LOG4CXX_ERROR_EXT(logger_, "Server open error");
-    return;
+bool TimeManager::Exporter::Listen() {
+  const std::string& path = server_->socket_path_;
+  sockaddr_un address = { 0 };
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    LOG4CXX_ERROR(logger_, "Invalid metrics socket path " << path);
+    return false;
   }
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
 
-  int32_t optval = 1;
-  if (-1 == setsockopt(server_->socket_fd_, SOL_SOCKET, SO_REUSEADDR,
-                       &optval, sizeof optval)) {
-    LOG4CXX_ERROR_EXT(logger_, "Unable to set sockopt");
-    return;
+  socket_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (-1 == socket_fd_) {
+    LOG4CXX_ERROR(logger_, "Unable to open metrics socket " << strerror(errno));
+    return false;
   }
-
-  sockaddr_in serv_addr_ = { 0 };
-  serv_addr_.sin_addr.s_addr = inet_addr(server_->ip_.c_str());
-  serv_addr_.sin_family = AF_INET;
-  serv_addr_.sin_port = htons(server_->port_);
-
-  if (-1 == bind(server_->socket_fd_,
-                 reinterpret_cast<struct sockaddr*>(&serv_addr_),
-                 sizeof(serv_addr_))) {
-    LOG4CXX_ERROR(logger_, "Unable to bind server "
-                  << server_->ip_.c_str() << ':' << server_->port_);
-    return;
+  // Client may be gone before it is accepted, accept must not wait then
+  if (!SetNonBlocking(socket_fd_)) {
+    LOG4CXX_ERROR(logger_, "Unable to make metrics socket non-blocking "
+                  << strerror(errno));
+    close(socket_fd_);
+    socket_fd_ = -1;
+    return false;
   }
-  if (-1 == listen(server_->socket_fd_, 1)) {
-    LOG4CXX_ERROR(logger_, "Streamer listen error " << strerror(errno) );
-    return;
+  // Socket file left by previous run would fail bind
+  unlink(path.c_str());
+  if (-1 == bind(socket_fd_, reinterpret_cast<sockaddr*>(&address),
+                 sizeof(address)) ||
+      -1 == listen(socket_fd_, 1)) {
+    LOG4CXX_ERROR(logger_, "Unable to listen on metrics socket "
+                  << path << ": " << strerror(errno));
+    close(socket_fd_);
+    socket_fd_ = -1;
+    return false;
   }
-  LOG4CXX_INFO(logger_, "Streamer is listetning for connections");
+  LOG4CXX_INFO(logger_, "Metrics snapshot is available on " << path);
+  return true;
 }
 
-void TimeManager::Streamer::Stop() {
-  LOG4CXX_INFO(logger_, "SocketStreamerAdapter::Streamer::stop");
-  if (!new_socket_fd_) {
+void TimeManager::Exporter::SendSnapshot() {
+  const int client_fd = accept(socket_fd_, NULL, NULL);
+  if (-1 == client_fd) {
+    LOG4CXX_ERROR(logger_, "Unable to accept metrics client " << strerror(errno));
     return;
   }
-
-  if (-1 == shutdown(new_socket_fd_, SHUT_RDWR)) {
-    LOG4CXX_ERROR(logger_, "Unable to shutdown socket");
-    return;
-  }
-
-  if (-1 == close(new_socket_fd_)) {
-    LOG4CXX_ERROR(logger_, "Unable to close socket");
+  // Exporter also drains rings of threads, so it never waits for client:
+  // snapshot which doesn't fit into socket buffer is dropped
+  if (!SetNonBlocking(client_fd)) {
+    LOG4CXX_ERROR(logger_, "Unable to make metrics client non-blocking "
+                  << strerror(errno));
+    close(client_fd);
     return;
   }
-
-  new_socket_fd_ = -1;
-  is_client_connected_ = false;
-}
-
-bool TimeManager::Streamer::IsReady() const {
-  bool result = true;
-  fd_set fds;
-  FD_ZERO(&fds);
-  FD_SET(new_socket_fd_, &fds);
-  TimevalStruct tv;
-  tv.tv_sec = 5;                       // set a 5 second timeout
-  tv.tv_usec = 0;
-
-  const int retval = select(new_socket_fd_ + 1, 0, &fds, 0, &tv);
-
-  if (-1 == retval) {
-    LOG4CXX_ERROR_EXT(logger_, "An error occurred");
-    result = false;
-  } else if (0 == retval) {
-    LOG4CXX_ERROR_EXT(logger_, "The timeout expired");
-    result = false;
-  }
-
-  return result;
-}
-
-bool TimeManager::Streamer::Send(const std::string& msg) {
-  if (!IsReady()) {
-    LOG4CXX_ERROR_EXT(logger_, " Socket is not ready");
-    return false;
-  }
-
-  if (-1 == ::send(new_socket_fd_, msg.c_str(),
-                   msg.size(), MSG_NOSIGNAL)) {
-    LOG4CXX_ERROR_EXT(logger_, " Unable to send");
-    return false;
+  const std::string snapshot = server_->aggregator_.Snapshot();
+  size_t sent = 0;
+  while (sent < snapshot.size()) {
+    const ssize_t result = ::send(client_fd, snapshot.data() + sent,
+                                  snapshot.size() - sent, MSG_NOSIGNAL);
+    if (-1 == result) {
+      if (EINTR == errno) {
+        continue;
+      }
+      if (EAGAIN == errno || EWOULDBLOCK == errno) {
+        LOG4CXX_WARN(logger_, "Metrics client doesn't read, dropped "
+                     << snapshot.size() - sent << " bytes of snapshot");
+      } else {
+        LOG4CXX_ERROR(logger_, "Unable to send metrics snapshot "
+                      << strerror(errno));
+      }
+      break;
+    }
+    sent += result;
   }
-  return true;
+  close(client_fd);
 }
 }  // namespace time_tester
@@ -31,33 +31,41 @@
 */
 #include "transport_manager_observer.h"
 
-#include <time.h>
-
-#include "transport_manager_metric.h"
+#include "utils/date_time.h"
 #include "time_manager.h"
 
 namespace time_tester {
 
+using protocol_handler::MessageTrace;
+
 TransportManagerObserver::TransportManagerObserver(TimeManager* time_manager):
   time_manager_ (time_manager) {
 }
 
 void TransportManagerObserver::StartRawMsg(const protocol_handler::RawMessage* ptr) {
-  time_starts[ptr] = date_time::DateTime::getCurrentTime();
+  // Start of received message is marked on its trace by transport adapter
 }
 
 void TransportManagerObserver::StopRawMsg(const protocol_handler::RawMessage* ptr) {
-    std::map<const protocol_handler::RawMessage*, TimevalStruct>::const_iterator it;
-    it = time_starts.find(ptr);
-    if (it != time_starts.end()) {
-      TransportManagerMecticWrapper* m = new TransportManagerMecticWrapper();
-      m->message_metric = new transport_manager::TMMetricObserver::MessageMetric();
-      m->message_metric->begin = it->second;
-      m->message_metric->end = date_time::DateTime::getCurrentTime();
-      m->message_metric->data_size = ptr->data_size();
-      m->grabResources();
-      time_manager_->SendMetric(m);
-    }
+  const protocol_handler::MessageTracePtr trace = ptr->trace();
+  if (!trace) {
+    return;
+  }
+  if (trace->IsMarked(MessageTrace::kTransportSent)) {
+    time_manager_->OnTraceCompleted(trace);
+    return;
+  }
+  if (trace->IsMarked(MessageTrace::kResponseSerialized)) {
+    // Response wasn't sent
+    return;
+  }
+  MetricRecord record;
+  record.source = MetricRecord::kTransportManager;
+  record.data_size = ptr->data_size();
+  record.duration = static_cast<uint32_t>(
+      date_time::DateTime::getuSecs(date_time::DateTime::getCurrentTime()) -
+      trace->time(MessageTrace::kTransportReceived));
+  time_manager_->Record(record);
 }
 
 } //namespace time_tester
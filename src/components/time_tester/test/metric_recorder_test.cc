@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "metric_aggregator.h"
+#include "metric_recorder.h"
+#include "utils/lock_free_ring.h"
+
+namespace test {
+namespace components {
+namespace time_tester {
+namespace metric_recorder_test {
+
+using ::time_tester::MetricAggregator;
+using ::time_tester::MetricRecord;
+using ::time_tester::MetricRecorder;
+
+const uint32_t kThreads = 4;
+const uint32_t kRecordsPerThread = 100000;
+const uint32_t kFewRecords = 10;
+
+MetricRecord Record(MetricRecord::Source source, int32_t function_id,
+                    uint32_t duration) {
+  MetricRecord record;
+  record.source = source;
+  record.function_id = function_id;
+  record.duration = duration;
+  return record;
+}
+
+template<typename T>
+T Read(const std::string& snapshot, size_t* offset) {
+  T value;
+  memcpy(&value, snapshot.data() + *offset, sizeof(value));
+  *offset += sizeof(value);
+  return value;
+}
+
+TEST(LockFreeRingTest, FullRingRejectsElements) {
+  utils::LockFreeRing<int, 4> ring;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.Push(i));
+  }
+  EXPECT_FALSE(ring.Push(4));
+
+  int element = -1;
+  EXPECT_TRUE(ring.Pop(&element));
+  EXPECT_EQ(0, element);
+  EXPECT_TRUE(ring.Push(4));
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(ring.Pop(&element));
+    EXPECT_EQ(i, element);
+  }
+  EXPECT_FALSE(ring.Pop(&element));
+}
+
+void* Produce(void* data) {
+  MetricRecorder* recorder = static_cast<MetricRecorder*>(data);
+  for (uint32_t i = 0; i < kRecordsPerThread; ++i) {
+    recorder->Record(
+        Record(MetricRecord::kApplicationManager, i % 4, i));
+  }
+  return NULL;
+}
+
+TEST(MetricRecorderTest, RecordsOfAllThreadsAreDrainedOrCountedAsDropped) {
+  MetricRecorder recorder;
+  MetricAggregator aggregator;
+  pthread_t threads[kThreads];
+  for (uint32_t i = 0; i < kThreads; ++i) {
+    pthread_create(&threads[i], NULL, &Produce, &recorder);
+  }
+  for (uint32_t i = 0; i < kThreads; ++i) {
+    // Drain concurrently with producers
+    recorder.Drain(&aggregator);
+  }
+  for (uint32_t i = 0; i < kThreads; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+  recorder.Drain(&aggregator);
+
+  EXPECT_EQ(kThreads * kRecordsPerThread,
+            aggregator.records() + aggregator.dropped());
+  EXPECT_LT(0u, aggregator.records());
+}
+
+void* ProduceFew(void* data) {
+  MetricRecorder* recorder = static_cast<MetricRecorder*>(data);
+  for (uint32_t i = 0; i < kFewRecords; ++i) {
+    recorder->Record(Record(MetricRecord::kProtocolHandler, 0, i));
+  }
+  return NULL;
+}
+
+TEST(MetricRecorderTest, RecordsOfExitedThreadsAreDrained) {
+  MetricRecorder recorder;
+  MetricAggregator aggregator;
+  for (uint32_t i = 0; i < kThreads; ++i) {
+    pthread_t thread;
+    pthread_create(&thread, NULL, &ProduceFew, &recorder);
+    pthread_join(thread, NULL);
+  }
+  // Rings of exited threads are freed by first drain
+  recorder.Drain(&aggregator);
+  recorder.Drain(&aggregator);
+
+  EXPECT_EQ(kThreads * kFewRecords, aggregator.records());
+  EXPECT_EQ(0u, aggregator.dropped());
+}
+
+TEST(MetricAggregatorTest, DurationsArePutIntoPowerOfTwoBuckets) {
+  EXPECT_EQ(0u, MetricAggregator::Bucket(0));
+  EXPECT_EQ(1u, MetricAggregator::Bucket(1));
+  EXPECT_EQ(2u, MetricAggregator::Bucket(2));
+  EXPECT_EQ(2u, MetricAggregator::Bucket(3));
+  EXPECT_EQ(11u, MetricAggregator::Bucket(1024));
+  EXPECT_EQ(MetricAggregator::kBucketsCount - 1,
+            MetricAggregator::Bucket(0xFFFFFFFF));
+}
+
+TEST(MetricAggregatorTest, SnapshotContainsHistogramPerSourceAndFunction) {
+  MetricAggregator aggregator;
+  aggregator.Add(Record(MetricRecord::kApplicationManager, 12, 100));
+  aggregator.Add(Record(MetricRecord::kApplicationManager, 12, 300));
+  aggregator.Add(Record(MetricRecord::kTransportManager, -1, 5));
+  aggregator.AddDropped(2);
+
+  const std::string snapshot = aggregator.Snapshot();
+  size_t offset = 0;
+  EXPECT_EQ(MetricAggregator::kSnapshotMagic,
+            Read<uint32_t>(snapshot, &offset));
+  EXPECT_EQ(MetricAggregator::kSnapshotVersion,
+            Read<uint16_t>(snapshot, &offset));
+  const uint16_t buckets_count = Read<uint16_t>(snapshot, &offset);
+  EXPECT_EQ(MetricAggregator::kBucketsCount, buckets_count);
+  EXPECT_EQ(3u, Read<uint64_t>(snapshot, &offset));
+  EXPECT_EQ(2u, Read<uint64_t>(snapshot, &offset));
+  ASSERT_EQ(2u, Read<uint32_t>(snapshot, &offset));
+
+  EXPECT_EQ(MetricRecord::kApplicationManager,
+            Read<uint8_t>(snapshot, &offset));
+  EXPECT_EQ(0u, Read<uint8_t>(snapshot, &offset));
+  Read<uint16_t>(snapshot, &offset);
+  EXPECT_EQ(12, Read<int32_t>(snapshot, &offset));
+  EXPECT_EQ(2u, Read<uint64_t>(snapshot, &offset));
+  EXPECT_EQ(400u, Read<uint64_t>(snapshot, &offset));
+  EXPECT_EQ(300u, Read<uint32_t>(snapshot, &offset));
+  Read<uint32_t>(snapshot, &offset);
+  offset += buckets_count * sizeof(uint32_t);
+
+  EXPECT_EQ(MetricRecord::kTransportManager,
+            Read<uint8_t>(snapshot, &offset));
+  offset += sizeof(uint8_t) + sizeof(uint16_t);
+  EXPECT_EQ(-1, Read<int32_t>(snapshot, &offset));
+  EXPECT_EQ(1u, Read<uint64_t>(snapshot, &offset));
+  EXPECT_EQ(5u, Read<uint64_t>(snapshot, &offset));
+  EXPECT_EQ(5u, Read<uint32_t>(snapshot, &offset));
+  Read<uint32_t>(snapshot, &offset);
+  for (uint16_t i = 0; i < buckets_count; ++i) {
+    const uint32_t count = Read<uint32_t>(snapshot, &offset);
+    EXPECT_EQ(MetricAggregator::Bucket(5) == i ? 1u : 0u, count);
+  }
+  EXPECT_EQ(snapshot.size(), offset);
+}
+
+}  // namespace metric_recorder_test
+}  // namespace time_tester
+}  // namespace components
+}  // namespace test
@@ -42,6 +42,7 @@
 #include "protocol/common.h"
 #include "utils/threads/thread_delegate.h"
 #include "utils/threads/thread.h"
+#include "utils/prioritized_queue.h"
 
 using ::transport_manager::transport_adapter::Connection;
 
@@ -143,9 +144,11 @@ class ThreadedSocketConnection : public Connection,
 
   TransportAdapterController* controller_;
   /**
-   * @brief Frames that must be sent to remote device.
+   * @brief Frames that must be sent to remote device,
+   * urgent frames are sent first.
    **/
-  typedef std::queue<protocol_handler::RawMessagePtr> FrameQueue;
+  typedef utils::PrioritizedQueue<protocol_handler::PrioritizedRawMessage>
+      FrameQueue;
   FrameQueue frames_to_send_;
   mutable pthread_mutex_t frames_to_send_mutex_;
 
@@ -51,15 +51,23 @@
 #include "transport_manager/time_metric_observer.h"
 #endif  // TIME_TESTER
 #include "utils/threads/message_loop_thread.h"
+#include "utils/prioritized_queue.h"
 #include "transport_manager/transport_adapter/transport_adapter_event.h"
 
 namespace transport_manager {
 
+/**
+ * @brief Queue of messages to devices, urgent messages are sent first.
+ */
+typedef threads::MessageLoopThread<
+    utils::PrioritizedQueue<protocol_handler::PrioritizedRawMessage> >
+    RawMessageLoopThread;
+
 /**
  * @brief Implementation of transport manager.s
  */
 class TransportManagerImpl : public TransportManager,
-                             public threads::MessageLoopThread<std::queue<protocol_handler::RawMessagePtr> >::Handler,
+                             public RawMessageLoopThread::Handler,
                              public threads::MessageLoopThread<std::queue<TransportAdapterEvent> >::Handler {
  public:
   struct Connection {
@@ -240,7 +248,7 @@ class TransportManagerImpl : public TransportManager,
    **/
   void PostMessage(const ::protocol_handler::RawMessagePtr message);
 
-  void Handle(::protocol_handler::RawMessagePtr msg);
+  void Handle(::protocol_handler::PrioritizedRawMessage msg);
   void Handle(TransportAdapterEvent msg);
 
   /**
@@ -326,7 +334,7 @@ class TransportManagerImpl : public TransportManager,
   /** For keep listeners which were add TMImpl */
   std::map<TransportAdapter*, TransportAdapterListenerImpl*>
       transport_adapter_listeners_;
-  threads::MessageLoopThread<std::queue<protocol_handler::RawMessagePtr> > message_queue_;
+  RawMessageLoopThread message_queue_;
   threads::MessageLoopThread<std::queue<TransportAdapterEvent> > event_queue_;
 
   typedef std::vector<std::pair<const TransportAdapter*, DeviceInfo> >
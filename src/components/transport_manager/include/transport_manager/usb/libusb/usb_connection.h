@@ -36,6 +36,7 @@
 #include <list>
 
 #include "utils/lock.h"
+#include "utils/prioritized_queue.h"
 
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 #include "transport_manager/transport_adapter/connection.h"
@@ -81,7 +82,9 @@ class UsbConnection : public Connection {
   libusb_transfer* in_transfer_;
   libusb_transfer* out_transfer_;
 
-  std::list<protocol_handler::RawMessagePtr> out_messages_;
+  // Urgent messages are sent first
+  utils::PrioritizedQueue<protocol_handler::PrioritizedRawMessage>
+      out_messages_;
   protocol_handler::RawMessagePtr current_out_message_;
   sync_primitives::Lock out_messages_mutex_;
   size_t bytes_sent_;
@@ -38,6 +38,7 @@
 
 #include <pthread.h>
 
+#include "utils/prioritized_queue.h"
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 #include "transport_manager/transport_adapter/connection.h"
 #include "transport_manager/usb/common.h"
@@ -86,7 +87,9 @@ class UsbConnection : public Connection {
   usbd_urb* in_urb_;
   usbd_urb* out_urb_;
 
-  std::list<protocol_handler::RawMessagePtr> out_messages_;
+  // Urgent messages are sent first
+  utils::PrioritizedQueue<protocol_handler::PrioritizedRawMessage>
+      out_messages_;
   ::protocol_handler::RawMessagePtr current_out_message_;
   pthread_mutex_t out_messages_mutex_;
   size_t bytes_sent_;
@@ -553,6 +553,11 @@ void TransportAdapterImpl::DataReceiveDone(const DeviceUID& device_id,
 #ifdef TIME_TESTER
   if (metric_observer_) {
     metric_observer_->StartRawMsg(message.get());
+    // Trace is followed through all components until response is sent
+    const ::protocol_handler::MessageTracePtr trace(
+        new ::protocol_handler::MessageTrace());
+    trace->Mark(::protocol_handler::MessageTrace::kTransportReceived);
+    message->set_trace(trace);
   }
 #endif  // TIME_TESTER
   for (TransportAdapterListenerList::iterator it = listeners_.begin();
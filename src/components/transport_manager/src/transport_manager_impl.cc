@@ -623,6 +623,10 @@ void TransportManagerImpl::Handle(TransportAdapterEvent event) {
     case TransportAdapterListenerImpl::EventTypeEnum::ON_SEND_DONE: {
 #ifdef TIME_TESTER
       if (metric_observer_) {
+        if (event.event_data->trace()) {
+          event.event_data->trace()->Mark(
+              protocol_handler::MessageTrace::kTransportSent);
+        }
         metric_observer_->StopRawMsg(event.event_data.get());
       }
 #endif  // TIME_TESTER
@@ -729,7 +733,8 @@ void TransportManagerImpl::SetTimeMetricObserver(TMMetricObserver* observer) {
 }
 #endif  // TIME_TESTER
 
-void TransportManagerImpl::Handle(::protocol_handler::RawMessagePtr msg) {
+void TransportManagerImpl::Handle(
+    ::protocol_handler::PrioritizedRawMessage msg) {
   LOG4CXX_TRACE(logger_, "enter");
   ConnectionInternal* connection = GetConnection(msg->connection_key());
   if (connection == NULL) {
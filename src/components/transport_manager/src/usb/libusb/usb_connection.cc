@@ -151,7 +151,7 @@ void UsbConnection::PopOutMessage() {
     current_out_message_.reset();
   } else {
     current_out_message_ = out_messages_.front();
-    out_messages_.pop_front();
+    out_messages_.pop();
     PostOutTransfer();
   }
   LOG4CXX_TRACE(logger_, "exit");
@@ -217,7 +217,7 @@ TransportAdapter::Error UsbConnection::SendData(::protocol_handler::RawMessagePt
   }
   sync_primitives::AutoLock locker(out_messages_mutex_);
   if (current_out_message_.valid()) {
-    out_messages_.push_back(message);
+    out_messages_.push(message);
   } else {
     current_out_message_ = message;
     if (!PostOutTransfer()) {
@@ -249,9 +249,10 @@ void UsbConnection::Finalise() {
         waiting_in_transfer_cancel_ = false;
       }
     }
-    for (std::list<protocol_handler::RawMessagePtr>::iterator it = out_messages_.begin();
-         it != out_messages_.end(); it = out_messages_.erase(it)) {
-      controller_->DataSendFailed(device_uid_, app_handle_, *it, DataSendError());
+    while (!out_messages_.empty()) {
+      controller_->DataSendFailed(device_uid_, app_handle_,
+                                  out_messages_.front(), DataSendError());
+      out_messages_.pop();
     }
   }
   while (waiting_in_transfer_cancel_ || waiting_out_transfer_cancel_) {
@@ -164,7 +164,7 @@ void UsbConnection::PopOutMessage() {
     current_out_message_.reset();
   } else {
     current_out_message_ = out_messages_.front();
-    out_messages_.pop_front();
+    out_messages_.pop();
   }
 }
 
@@ -243,7 +243,7 @@ TransportAdapter::Error UsbConnection::SendData(::protocol_handler::RawMessagePt
   }
   pthread_mutex_lock(&out_messages_mutex_);
   if (current_out_message_.valid()) {
-    out_messages_.push_back(message);
+    out_messages_.push(message);
   } else {
     current_out_message_ = message;
     if (!PostOutTransfer()) {
@@ -261,9 +261,10 @@ void UsbConnection::Finalise() {
   disconnecting_ = true;
   usbd_abort_pipe(in_pipe_);
   usbd_abort_pipe(out_pipe_);
-  for (std::list<protocol_handler::RawMessagePtr>::iterator it = out_messages_.begin();
-       it != out_messages_.end(); it = out_messages_.erase(it)) {
-    controller_->DataSendFailed(device_uid_, app_handle_, *it, DataSendError());
+  while (!out_messages_.empty()) {
+    controller_->DataSendFailed(device_uid_, app_handle_,
+                                out_messages_.front(), DataSendError());
+    out_messages_.pop();
   }
   pthread_mutex_unlock(&out_messages_mutex_);
   while (pending_in_transfer_ || pending_out_transfer_) sched_yield();
@@ -92,6 +92,12 @@ class BitStream {
   // If there is not enough data in the stream, it is marked bad.
   void ExtractBytes(void* buffer, size_t length);
 
+  // Skip |length| bytes of the stream and return pointer to the first
+  // of them. Stream read position must be byte aligned when it is called.
+  // If there is not enough data in the stream, it is marked bad and NULL
+  // is returned.
+  const uint8_t* SkipBytes(size_t length);
+
  private:
   const uint8_t* bytes_;
   const size_t   bytes_count_;
@@ -105,6 +111,7 @@ class BitStream {
   friend void Extract(BitStream*, uint32_t*, size_t);
   friend void Extract(BitStream*, std::string*, size_t);
   friend void Extract(BitStream*, std::vector<uint8_t>*, size_t);
+  friend void Extract(BitStream*, const uint8_t**, size_t);
 
 };
 
@@ -133,6 +140,11 @@ void Extract(BitStream* bs, std::string* str, size_t length);
 // vector |data|. If stream is too short it is marked bad.
 void Extract(BitStream* bs, std::vector<uint8_t>* data, size_t length);
 
+// Skip |length| bytes of stream and point |data| to the first of them.
+// Bytes are not copied, they are valid as long as buffer of the stream.
+// If stream is too short it is marked bad.
+void Extract(BitStream* bs, const uint8_t** data, size_t length);
+
 
 // Template member definitions
 template<typename T>
@@ -68,6 +68,20 @@ void BitStream::ExtractBytes(void* buffer, size_t length) {
   byte_offset_ += length;
 }
 
+const uint8_t* BitStream::SkipBytes(size_t length) {
+  if (IsGood()) {
+    if (bit_offset_ != 0 ||          // bytes can be skipped only when
+        FullBytesLeft() < length) {  // stream is byte-aligned
+      MarkBad();
+      return NULL;
+    }
+    const uint8_t* bytes = &bytes_[byte_offset_];
+    byte_offset_ += length;
+    return bytes;
+  }
+  return NULL;
+}
+
 void Extract(BitStream* bs, uint8_t* val) {
   DCHECK(bs && val);
   if (*bs) {
@@ -128,5 +142,12 @@ void Extract(BitStream* bs, std::vector<uint8_t>* data, size_t length) {
   }
 }
 
+void Extract(BitStream* bs, const uint8_t** data, size_t length) {
+  DCHECK(bs && data);
+  if (*bs) {
+    *data = bs->SkipBytes(length);
+  }
+}
+
 }  // namespace utils
 
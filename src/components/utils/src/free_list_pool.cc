@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "utils/free_list_pool.h"
+
+#include <new>
+
+namespace utils {
+
+FreeListPool::FreeListPool(size_t max_block_size, size_t max_free_blocks)
+  : max_block_size_(max_block_size),
+    max_free_blocks_(max_free_blocks),
+    classes_count_(max_block_size / kGranularity + 1) {
+  pthread_key_create(&cache_key_, &FreeListPool::ReleaseCache);
+}
+
+FreeListPool::~FreeListPool() {
+  pthread_key_delete(cache_key_);
+  sync_primitives::AutoLock auto_lock(caches_lock_);
+  std::set<ThreadCache*>::iterator it = caches_.begin();
+  for (; caches_.end() != it; ++it) {
+    for (size_t i = 0; i < classes_count_; ++i) {
+      while ((*it)->free_lists[i]) {
+        FreeBlock* block = (*it)->free_lists[i];
+        (*it)->free_lists[i] = block->next;
+        ::operator delete(block);
+      }
+    }
+    delete *it;
+  }
+  caches_.clear();
+}
+
+size_t FreeListPool::SizeClass(size_t size) const {
+  if (size > max_block_size_) {
+    return classes_count_;
+  }
+  // Freed block has to hold free list link
+  if (size < sizeof(FreeBlock)) {
+    size = sizeof(FreeBlock);
+  }
+  return (size + kGranularity - 1) / kGranularity;
+}
+
+FreeListPool::ThreadCache* FreeListPool::cache() {
+  ThreadCache* thread_cache =
+      static_cast<ThreadCache*>(pthread_getspecific(cache_key_));
+  if (!thread_cache) {
+    thread_cache = new ThreadCache(this, classes_count_);
+    pthread_setspecific(cache_key_, thread_cache);
+    sync_primitives::AutoLock auto_lock(caches_lock_);
+    caches_.insert(thread_cache);
+  }
+  return thread_cache;
+}
+
+void* FreeListPool::Allocate(size_t size) {
+  ThreadCache* thread_cache = cache();
+  ++thread_cache->counters.allocations;
+  const size_t size_class = SizeClass(size);
+  if (size_class < classes_count_ && thread_cache->free_lists[size_class]) {
+    FreeBlock* block = thread_cache->free_lists[size_class];
+    thread_cache->free_lists[size_class] = block->next;
+    --thread_cache->free_counts[size_class];
+    ++thread_cache->counters.reused;
+    return block;
+  }
+  ++thread_cache->counters.heap_allocations;
+  // Block gets full size of its class to be reusable by any size of it
+  return ::operator new(size_class < classes_count_ ?
+                        size_class * kGranularity : size);
+}
+
+void FreeListPool::Deallocate(void* memory, size_t size) {
+  if (!memory) {
+    return;
+  }
+  ThreadCache* thread_cache = cache();
+  ++thread_cache->counters.deallocations;
+  const size_t size_class = SizeClass(size);
+  if (size_class < classes_count_ &&
+      thread_cache->free_counts[size_class] < max_free_blocks_) {
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = thread_cache->free_lists[size_class];
+    thread_cache->free_lists[size_class] = block;
+    ++thread_cache->free_counts[size_class];
+    return;
+  }
+  ++thread_cache->counters.heap_releases;
+  ::operator delete(memory);
+}
+
+FreeListPool::Statistics FreeListPool::statistics() const {
+  sync_primitives::AutoLock auto_lock(caches_lock_);
+  Counters total = released_counters_;
+  uint64_t pooled = 0;
+  std::set<ThreadCache*>::const_iterator it = caches_.begin();
+  for (; caches_.end() != it; ++it) {
+    const Counters& counters = (*it)->counters;
+    total.allocations += counters.allocations;
+    total.deallocations += counters.deallocations;
+    total.reused += counters.reused;
+    total.heap_allocations += counters.heap_allocations;
+    total.heap_releases += counters.heap_releases;
+    for (size_t i = 0; i < classes_count_; ++i) {
+      pooled += (*it)->free_counts[i];
+    }
+  }
+
+  Statistics statistics;
+  statistics.allocations = total.allocations;
+  statistics.reused = total.reused;
+  statistics.heap_allocations = total.heap_allocations;
+  statistics.heap_releases = total.heap_releases;
+  statistics.live = total.allocations - total.deallocations;
+  statistics.pooled = pooled;
+  return statistics;
+}
+
+void FreeListPool::ReleaseCache(void* cache) {
+  ThreadCache* thread_cache = static_cast<ThreadCache*>(cache);
+  thread_cache->pool->Release(thread_cache);
+}
+
+void FreeListPool::Release(ThreadCache* thread_cache) {
+  for (size_t i = 0; i < classes_count_; ++i) {
+    while (thread_cache->free_lists[i]) {
+      FreeBlock* block = thread_cache->free_lists[i];
+      thread_cache->free_lists[i] = block->next;
+      ::operator delete(block);
+      ++thread_cache->counters.heap_releases;
+    }
+  }
+  sync_primitives::AutoLock auto_lock(caches_lock_);
+  const Counters& counters = thread_cache->counters;
+  released_counters_.allocations += counters.allocations;
+  released_counters_.deallocations += counters.deallocations;
+  released_counters_.reused += counters.reused;
+  released_counters_.heap_allocations += counters.heap_allocations;
+  released_counters_.heap_releases += counters.heap_releases;
+  caches_.erase(thread_cache);
+  delete thread_cache;
+}
+
+}  // namespace utils
@@ -205,6 +205,24 @@ void Thread::stop() {
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
+void Thread::join() {
+  if (!is_joinable() || 0 == thread_handle_) {
+    return;
+  }
+  if (pthread_self() == thread_handle_) {
+    LOG4CXX_ERROR(logger_, "Couldn't join the same thread (#"
+                  << thread_handle_ << " \"" << name_ << "\")");
+    return;
+  }
+  const int pthread_result = pthread_join(thread_handle_, NULL);
+  if (pthread_result != EOK) {
+    LOG4CXX_WARN(logger_, "Couldn't join thread (#" << thread_handle_ << " \""
+                 << name_ << "\"). Error code = " << pthread_result << " (\""
+                 << strerror(pthread_result) << "\")");
+  }
+  thread_handle_ = 0;
+}
+
 bool Thread::Id::operator==(const Thread::Id& other) const {
   return pthread_equal(id_, other.id_) != 0;
 }
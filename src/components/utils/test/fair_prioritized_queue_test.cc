@@ -0,0 +1,147 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "utils/macro.h"
+#include "utils/fair_prioritized_queue.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+
+namespace {
+struct TestMessage {
+  TestMessage(uint32_t key, size_t cost, size_t priority, int id)
+    : key(key), cost(cost), priority(priority), id(id) {
+  }
+  size_t PriorityOrder() const {
+    return priority;
+  }
+  uint32_t FairQueueKey() const {
+    return key;
+  }
+  size_t FairQueueCost() const {
+    return cost;
+  }
+  uint32_t key;
+  size_t cost;
+  size_t priority;
+  int id;
+};
+
+typedef ::utils::FairPrioritizedQueue<TestMessage> TestQueue;
+
+std::vector<int> PopAll(TestQueue* queue) {
+  std::vector<int> ids;
+  while (!queue->empty()) {
+    ids.push_back(queue->front().id);
+    queue->pop();
+  }
+  return ids;
+}
+}  // namespace
+
+TEST(FairPrioritizedQueueTest, HigherPriorityGoesFirst) {
+  TestQueue queue;
+  queue.push(TestMessage(1, 1, 0, 1));
+  queue.push(TestMessage(1, 1, 5, 2));
+  queue.push(TestMessage(2, 1, 3, 3));
+
+  const int expected[] = {2, 3, 1};
+  EXPECT_EQ(std::vector<int>(expected, expected + ARRAYSIZE(expected)),
+            PopAll(&queue));
+}
+
+TEST(FairPrioritizedQueueTest, FloodingSourceDoesNotDelayOthers) {
+  TestQueue queue(2);
+  for (int i = 0; i < 6; ++i) {
+    queue.push(TestMessage(1, 1, 0, 10 + i));
+  }
+  queue.push(TestMessage(2, 1, 0, 20));
+  queue.push(TestMessage(3, 1, 0, 30));
+  queue.push(TestMessage(3, 1, 0, 31));
+
+  // Each source sends two messages per turn
+  const int expected[] = {10, 11, 20, 30, 31, 12, 13, 14, 15};
+  EXPECT_EQ(std::vector<int>(expected, expected + ARRAYSIZE(expected)),
+            PopAll(&queue));
+}
+
+TEST(FairPrioritizedQueueTest, CostIsChargedFromCredit) {
+  TestQueue queue(4);
+  queue.push(TestMessage(1, 8, 0, 10));
+  queue.push(TestMessage(1, 8, 0, 11));
+  queue.push(TestMessage(2, 1, 0, 20));
+  queue.push(TestMessage(2, 1, 0, 21));
+  queue.push(TestMessage(2, 1, 0, 22));
+  queue.push(TestMessage(2, 1, 0, 23));
+  queue.push(TestMessage(2, 1, 0, 24));
+
+  // Expensive message waits until its source saves enough credit
+  const int expected[] = {20, 21, 22, 23, 10, 24, 11};
+  EXPECT_EQ(std::vector<int>(expected, expected + ARRAYSIZE(expected)),
+            PopAll(&queue));
+}
+
+TEST(FairPrioritizedQueueTest, SizesAreCountedBySource) {
+  TestQueue queue;
+  queue.push(TestMessage(1, 1, 0, 1));
+  queue.push(TestMessage(1, 1, 2, 2));
+  queue.push(TestMessage(2, 1, 0, 3));
+  EXPECT_EQ(3u, queue.size());
+  EXPECT_EQ(2u, queue.size(1));
+  EXPECT_EQ(1u, queue.size(2));
+  EXPECT_EQ(0u, queue.size(3));
+
+  PopAll(&queue);
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_EQ(0u, queue.size(1));
+}
+
+TEST(FairPrioritizedQueueTest, FrontIsMessageToBePopped) {
+  TestQueue queue(1);
+  queue.push(TestMessage(1, 3, 0, 10));
+  queue.push(TestMessage(2, 1, 0, 20));
+  EXPECT_EQ(20, queue.front().id);
+  EXPECT_EQ(20, queue.front().id);
+  queue.pop();
+  EXPECT_EQ(10, queue.front().id);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
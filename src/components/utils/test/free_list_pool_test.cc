@@ -0,0 +1,77 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include "utils/free_list_pool.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+
+using ::utils::FreeListPool;
+
+TEST(FreeListPoolTest, FreedBlockIsReusedBySameSizeClass) {
+  FreeListPool pool(256, 2);
+  void* first = pool.Allocate(100);
+  pool.Deallocate(first, 100);
+  void* second = pool.Allocate(110);
+  EXPECT_EQ(first, second);
+  void* other_class = pool.Allocate(200);
+  EXPECT_NE(first, other_class);
+  pool.Deallocate(second, 110);
+  pool.Deallocate(other_class, 200);
+
+  const FreeListPool::Statistics statistics = pool.statistics();
+  EXPECT_EQ(3u, statistics.allocations);
+  EXPECT_EQ(1u, statistics.reused);
+  EXPECT_EQ(0u, statistics.live);
+  EXPECT_EQ(2u, statistics.pooled);
+}
+
+TEST(FreeListPoolTest, PoolIsBounded) {
+  FreeListPool pool(256, 1);
+  void* big = pool.Allocate(1000);
+  void* first = pool.Allocate(64);
+  void* second = pool.Allocate(64);
+  pool.Deallocate(big, 1000);
+  pool.Deallocate(first, 64);
+  pool.Deallocate(second, 64);
+
+  const FreeListPool::Statistics statistics = pool.statistics();
+  EXPECT_EQ(1u, statistics.pooled);
+  EXPECT_EQ(2u, statistics.heap_releases);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
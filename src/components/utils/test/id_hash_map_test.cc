@@ -0,0 +1,127 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <map>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "utils/id_hash_map.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+
+using ::utils::IdHashMap;
+
+TEST(IdHashMapTest, FindsInsertedValues) {
+  IdHashMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(NULL, map.find(1));
+
+  map[1] = 10;
+  map[65537] = 20;
+  EXPECT_EQ(2u, map.size());
+  ASSERT_TRUE(NULL != map.find(1));
+  EXPECT_EQ(10, *map.find(1));
+  ASSERT_TRUE(NULL != map.find(65537));
+  EXPECT_EQ(20, *map.find(65537));
+  EXPECT_EQ(NULL, map.find(2));
+
+  map[1] = 30;
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(30, *map.find(1));
+}
+
+TEST(IdHashMapTest, DefaultValueIsInserted) {
+  IdHashMap<std::set<int> > map;
+  map[7].insert(1);
+  map[7].insert(2);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(2u, map.find(7)->size());
+}
+
+TEST(IdHashMapTest, EraseKeepsOtherKeysReachable) {
+  IdHashMap<uint32_t> map;
+  // Keys differing only in high bits, as application ids do
+  for (uint32_t i = 0; i < 100; ++i) {
+    map[i << 24] = i;
+  }
+  for (uint32_t i = 0; i < 100; i += 2) {
+    EXPECT_TRUE(map.erase(i << 24));
+  }
+  EXPECT_FALSE(map.erase(0));
+  EXPECT_EQ(50u, map.size());
+  for (uint32_t i = 0; i < 100; ++i) {
+    const uint32_t* value = map.find(i << 24);
+    if (i % 2) {
+      ASSERT_TRUE(NULL != value);
+      EXPECT_EQ(i, *value);
+    } else {
+      EXPECT_EQ(NULL, value);
+    }
+  }
+}
+
+TEST(IdHashMapTest, MatchesStdMap) {
+  IdHashMap<int> map;
+  std::map<uint32_t, int> expected;
+  srand(42);
+  for (int i = 0; i < 20000; ++i) {
+    const uint32_t key = rand() % 512;
+    if (rand() % 3) {
+      map[key] = i;
+      expected[key] = i;
+    } else {
+      EXPECT_EQ(expected.erase(key) != 0, map.erase(key));
+    }
+  }
+  ASSERT_EQ(expected.size(), map.size());
+  for (uint32_t key = 0; key < 512; ++key) {
+    std::map<uint32_t, int>::const_iterator it = expected.find(key);
+    if (expected.end() == it) {
+      EXPECT_EQ(NULL, map.find(key));
+    } else {
+      ASSERT_TRUE(NULL != map.find(key));
+      EXPECT_EQ(it->second, *map.find(key));
+    }
+  }
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(NULL, map.find(0));
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
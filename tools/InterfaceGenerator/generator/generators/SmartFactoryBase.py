@@ -27,6 +27,21 @@ class GenerateError(Exception):
     pass
 
 
+class _ValidatorCall(object):
+
+    """Reference to generated validator function.
+
+    Used as parameter type of PARAMS and MSG_PARAMS parts of the message
+    when function validator is generated.
+
+    """
+
+    def __init__(self, name):
+        """Construct new object."""
+
+        self.name = name
+
+
 class CodeGenerator(object):
 
     """Base SmartFactory generator.
@@ -41,6 +56,8 @@ class CodeGenerator(object):
 
         self._generated_structs = []
         self._structs_add_code = u""
+        self._function_id_enum = None
+        self._message_type_enum = None
 
     def generate(self, interface, filename, namespace, destination_dir):
         """Generate SmartFactory source files.
@@ -68,6 +85,9 @@ class CodeGenerator(object):
             interface.enums["messageType"] = self._preprocess_message_type(
                 interface.enums["messageType"])
 
+        self._function_id_enum = interface.enums.get("FunctionID")
+        self._message_type_enum = interface.enums.get("messageType")
+
         if not os.path.exists(destination_dir):
             os.makedirs(destination_dir)
 
@@ -150,6 +170,12 @@ class CodeGenerator(object):
                 header_file_name=unicode(header_file_name),
                 namespace=namespace,
                 class_name=class_name,
+                compiled_validators=self._gen_compiled_validators(
+                    interface.enums.values(),
+                    interface.structs.values(),
+                    interface.functions.values(),
+                    namespace_open,
+                    namespace_close),
                 function_id_items=self._indent_code(function_id_items, 1),
                 message_type_items=self._indent_code(message_type_items, 1),
                 struct_schema_items=self._structs_add_code,
@@ -227,6 +253,368 @@ class CodeGenerator(object):
         """
         return u",\n".join([namespace + "::" + enum.name + "::" + x.primary_name for x in enum.elements.values()])
 
+    def _gen_compiled_validators(self, enums, structs, functions,
+                                 namespace_open, namespace_close):
+        """Generate compiled validators for source file.
+
+        Generates validation functions that check smart objects against
+        the interface definition directly, without walking schema items.
+        Every validator returns exactly the same result as the schema
+        generated for the same item. Members are checked in the order of
+        their keys so the first reported error is the same as well.
+
+        Keyword arguments:
+        enums -- list of enums to generate allowed value checks for.
+        structs -- list of structs to generate validators for.
+        functions -- list of functions to generate validators for.
+        namespace_open -- code that opens destination namespace.
+        namespace_close -- code that closes destination namespace.
+
+        Returns:
+        String with compiled validators source code.
+
+        """
+
+        if enums is None:
+            raise GenerateError("Enums is None")
+
+        if structs is None:
+            raise GenerateError("Structs is None")
+
+        if functions is None:
+            raise GenerateError("Functions is None")
+
+        struct_decls = u"".join(
+            [self._validator_struct_decl_template.substitute(
+                name=self._gen_validator_struct_name(x.name))
+             for x in structs])
+
+        enum_checks = u"\n".join(
+            [self._validator_enum_template.substitute(
+                name=x.name,
+                cases=self._indent_code(self._gen_validator_enum_cases(
+                    x.name, x.elements.values()), 2)[:-1])
+             for x in enums])
+
+        struct_validators = u"\n".join(
+            [self._gen_validator_map(
+                self._gen_validator_struct_name(x.name),
+                x.members.values())
+             for x in structs])
+
+        message_types = []
+        for function in functions:
+            if function.message_type.primary_name not in message_types:
+                message_types.append(function.message_type.primary_name)
+
+        params_validators = u"\n".join(
+            [self._gen_validator_map(
+                self._gen_validator_params_name(x),
+                self._gen_validator_params(x))
+             for x in message_types])
+
+        function_validators = u"\n".join(
+            [self._gen_validator_function(x) for x in functions])
+
+        return self._validators_template.substitute(
+            namespace_open=namespace_open,
+            struct_decls=struct_decls,
+            enum_checks=enum_checks,
+            struct_validators=struct_validators,
+            params_validators=params_validators,
+            function_validators=function_validators,
+            namespace_close=namespace_close)
+
+    def _gen_validator_params(self, message_type_name):
+        """Generate list of PARAMS members for compiled validator.
+
+        In the base class this method is not implemented (raises exception).
+        This method must be implemented by the subclasses to specify format
+        specific PARAMS in the same way as _gen_schema_params_fill does.
+
+        Keyword arguments:
+        message_type_name -- Name of the messageType enum element.
+
+        Returns:
+        List of parameters.
+
+        """
+
+        raise GenerateError("Unexpected call to the unimplemented function.")
+
+    def _gen_validator_base_params(self):
+        """Generate PARAMS members common for all formats.
+
+        Returns:
+        List of parameters.
+
+        """
+
+        return [Model.Param(name=u"function_id",
+                            param_type=self._function_id_enum),
+                Model.Param(name=u"message_type",
+                            param_type=self._message_type_enum),
+                Model.Param(name=u"protocol_version",
+                            param_type=Model.Integer()),
+                Model.Param(name=u"protocol_type",
+                            param_type=Model.Integer())]
+
+    def _gen_validator_function(self, function):
+        """Generate compiled validator of function.
+
+        Generates root validator for function which checks PARAMS and
+        MSG_PARAMS parts of the message.
+
+        Keyword arguments:
+        function -- function to generate validator for.
+
+        Returns:
+        String with function validator source code.
+
+        """
+
+        name = u"".join([function.function_id.primary_name, u"_",
+                         function.message_type.primary_name])
+        msg_params_name = self._gen_validator_msg_params_name(name)
+        params_name = self._gen_validator_params_name(
+            function.message_type.primary_name)
+        return u"\n".join(
+            [self._gen_validator_map(msg_params_name,
+                                     function.params.values()),
+             self._gen_validator_map(
+                 self._gen_validator_function_name(name),
+                 [Model.Param(name=u"msg_params",
+                              param_type=_ValidatorCall(msg_params_name)),
+                  Model.Param(name=u"params",
+                              param_type=_ValidatorCall(params_name))])])
+
+    def _gen_validator_map(self, validator_name, members):
+        """Generate validator of map object with given members.
+
+        Keyword arguments:
+        validator_name -- name of validator function.
+        members -- list of struct members/function parameters.
+
+        Returns:
+        String with validator source code.
+
+        """
+
+        if not members:
+            return self._validator_empty_map_template.substitute(
+                name=validator_name)
+
+        sorted_members = sorted(members,
+                                key=lambda x: x.name.encode("utf-8"))
+        return self._validator_map_template.substitute(
+            name=validator_name,
+            members=u"".join(
+                [self._indent_code(self._gen_validator_member(x), 1)
+                 for x in sorted_members]))
+
+    def _gen_validator_member(self, member):
+        """Generate validation code for member of map object.
+
+        Keyword arguments:
+        member -- struct member/function parameter.
+
+        Returns:
+        String with member validation source code.
+
+        """
+
+        return self._validator_member_template.substitute(
+            name=member.name,
+            missing_member=self._validator_missing_mandatory_template
+            if member.is_mandatory is True else u"",
+            check=self._indent_code(
+                self._gen_validator_check(member.param_type, u"(*member)", 0),
+                1)[:-1])
+
+    def _gen_validator_check(self, param, var_name, depth):
+        """Generate validation code for value of given type.
+
+        Generated code returns from validator on the first error found.
+
+        Keyword arguments:
+        param -- value of parameter type.
+        var_name -- expression that refers to SmartObject to check.
+        depth -- nesting level of arrays (used to name loop variables).
+
+        Returns:
+        String with validation source code.
+
+        """
+
+        if type(param) is Model.Boolean:
+            return self._validator_type_template.substitute(
+                var=var_name, type=u"SmartType_Boolean")
+        elif type(param) is Model.Integer or type(param) is Model.Double:
+            code = self._validator_number_type_template.substitute(
+                var=var_name)
+            if type(param) is Model.Double:
+                value_type, getter, suffix = u"double", u"asDouble", u""
+            elif param.max_value < 2 ** 31:
+                value_type, getter, suffix = u"int32_t", u"asInt", u""
+            elif param.max_value < 2 ** 63:
+                value_type, getter, suffix = u"int64_t", u"asInt64", u"LL"
+            else:
+                raise GenerateError("Parameter value too large: " +
+                                    str(param.max_value))
+            conditions = self._gen_validator_range_conditions(
+                u"value", param.min_value, param.max_value, suffix)
+            if conditions:
+                code = u"".join([code, self._validator_number_range_template.
+                                 substitute(type=value_type,
+                                            var=var_name,
+                                            getter=getter,
+                                            conditions=conditions)])
+            return code
+        elif type(param) is Model.String:
+            return u"".join([
+                self._validator_type_template.substitute(
+                    var=var_name, type=u"SmartType_String"),
+                self._gen_validator_length_check(
+                    var_name, param.min_length, param.max_length)])
+        elif type(param) is Model.Array:
+            element_var = u"element_{0}".format(depth)
+            return u"".join([
+                self._validator_type_template.substitute(
+                    var=var_name, type=u"SmartType_Array"),
+                self._gen_validator_length_check(
+                    var_name, param.min_size, param.max_size),
+                self._validator_array_template.substitute(
+                    var=var_name,
+                    index=u"i_{0}".format(depth),
+                    element=element_var,
+                    check=self._indent_code(self._gen_validator_check(
+                        param.element_type, element_var, depth + 1),
+                        1)[:-1])])
+        elif type(param) is Model.Struct:
+            return self._validator_call_template.substitute(
+                name=self._gen_validator_struct_name(param.name),
+                var=var_name)
+        elif type(param) is _ValidatorCall:
+            return self._validator_call_template.substitute(
+                name=param.name,
+                var=var_name)
+        elif type(param) is Model.Enum:
+            return u"".join([
+                self._validator_type_template.substitute(
+                    var=var_name, type=u"SmartType_Integer"),
+                self._validator_enum_check_template.substitute(
+                    name=param.name, var=var_name)])
+        elif type(param) is Model.EnumSubset:
+            return u"".join([
+                self._validator_type_template.substitute(
+                    var=var_name, type=u"SmartType_Integer"),
+                self._validator_enum_subset_template.substitute(
+                    var=var_name,
+                    cases=self._indent_code(self._gen_validator_enum_cases(
+                        param.enum.name,
+                        param.allowed_elements.values()), 1)[:-1])])
+        else:
+            raise GenerateError("Unexpected type of parameter: " +
+                                str(type(param)))
+
+    def _gen_validator_length_check(self, var_name, min_length, max_length):
+        """Generate length check of string or array for compiled validator.
+
+        Keyword arguments:
+        var_name -- expression that refers to SmartObject to check.
+        min_length -- minimum allowed length (None if not limited).
+        max_length -- maximum allowed length (None if not limited).
+
+        Returns:
+        String with validation source code or empty string if length is
+        not limited.
+
+        """
+
+        conditions = self._gen_validator_range_conditions(
+            u"".join([var_name, u".length()"]),
+            min_length if min_length else None,
+            max_length, u"u")
+        if not conditions:
+            return u""
+        return self._validator_out_of_range_template.substitute(
+            conditions=conditions)
+
+    @staticmethod
+    def _gen_validator_range_conditions(value, min_value, max_value, suffix):
+        """Generate out of range condition for compiled validator.
+
+        Keyword arguments:
+        value -- expression with value to check.
+        min_value -- minimum allowed value (None if not limited).
+        max_value -- maximum allowed value (None if not limited).
+        suffix -- suffix of numeric literals.
+
+        Returns:
+        String with condition or empty string if value is not limited.
+
+        """
+
+        conditions = []
+        if min_value is not None:
+            conditions.append(u"{0} < {1}{2}".format(value, min_value, suffix))
+        if max_value is not None:
+            conditions.append(u"{0} > {1}{2}".format(value, max_value, suffix))
+        return u" || ".join(conditions)
+
+    @staticmethod
+    def _gen_validator_enum_cases(enum_name, elements):
+        """Generate case labels for allowed enum elements.
+
+        Elements that share the same value are labeled once.
+
+        Keyword arguments:
+        enum_name -- name of the enum.
+        elements -- list of allowed enum elements.
+
+        Returns:
+        String with case labels source code.
+
+        """
+
+        cases = []
+        values = []
+        next_value = 0
+        for element in elements:
+            value = int(element.value) if element.value is not None \
+                else next_value
+            next_value = value + 1
+            if value in values:
+                continue
+            values.append(value)
+            cases.append(u"case {0}::{1}:".format(enum_name,
+                                                  element.primary_name))
+        return u"".join([u"\n".join(cases), u"\n"]) if cases else u""
+
+    @staticmethod
+    def _gen_validator_struct_name(struct_name):
+        """Generate name of compiled validator of struct."""
+
+        return u"".join([u"ValidateStruct_", struct_name])
+
+    @staticmethod
+    def _gen_validator_params_name(message_type_name):
+        """Generate name of compiled validator of PARAMS."""
+
+        return u"".join([u"ValidateParams_", message_type_name])
+
+    @staticmethod
+    def _gen_validator_msg_params_name(function_name):
+        """Generate name of compiled validator of MSG_PARAMS."""
+
+        return u"".join([u"ValidateMsgParams_", function_name])
+
+    @staticmethod
+    def _gen_validator_function_name(function_name):
+        """Generate name of compiled validator of function."""
+
+        return u"".join([u"Validate_", function_name])
+
     def _gen_h_class(self, class_name, params, functions, structs):
         """Generate source code of class for header file.
 
@@ -1367,9 +1755,14 @@ class CodeGenerator(object):
         u'''#include "smart_objects/enum_schema_item.h"\n'''
         u'''#include "smart_objects/number_schema_item.h"\n'''
         u'''#include "smart_objects/schema_item_parameter.h"\n'''
+        u'''#include "smart_objects/compiled_schema_item.h"\n'''
         u'''\n'''
         u'''using namespace NsSmartDeviceLink::NsSmartObjects;\n'''
         u'''\n'''
+        u'''//------------------ Compiled validators ---------------------\n'''
+        u'''\n'''
+        u'''$compiled_validators'''
+        u'''\n'''
         u'''$namespace::$class_name::$class_name()\n'''
         u''' : NsSmartDeviceLink::NsJSONHandler::CSmartFactory<FunctionID::eType, '''
         u'''messageType::eType, StructIdentifiers::eType>() {\n'''
@@ -1474,12 +1867,126 @@ class CodeGenerator(object):
         u'''struct_schema_item_${name})));''')
 
     _function_schema_template = string.Template(
-        u'''functions_schemes_.insert(std::make_pair(NsSmartDeviceLink::'''
-        u'''NsJSONHandler::'''
-        u'''SmartSchemaKey<FunctionID::eType, messageType::eType>'''
-        u'''(FunctionID::$function_id, messageType::$message_type), '''
+        u'''AddCompiledFunctionSchema('''
+        u'''FunctionID::$function_id, messageType::$message_type, '''
         u'''InitFunction_${function_id}_${message_type}('''
-        u'''struct_schema_items, function_id_items, message_type_items)));''')
+        u'''struct_schema_items, function_id_items, message_type_items), '''
+        u'''&compiled_validators::'''
+        u'''Validate_${function_id}_${message_type});''')
+
+    _validators_template = string.Template(
+        u'''${namespace_open}'''
+        u'''namespace compiled_validators {\n'''
+        u'''\n'''
+        u'''${struct_decls}'''
+        u'''\n'''
+        u'''${enum_checks}'''
+        u'''\n'''
+        u'''${struct_validators}'''
+        u'''\n'''
+        u'''${params_validators}'''
+        u'''\n'''
+        u'''${function_validators}'''
+        u'''\n'''
+        u'''} // compiled_validators\n'''
+        u'''${namespace_close}''')
+
+    _validator_struct_decl_template = string.Template(
+        u'''Errors::eType ${name}(const SmartObject& object);\n''')
+
+    _validator_enum_template = string.Template(
+        u'''bool IsAllowed_${name}(int32_t value) {\n'''
+        u'''  switch (value) {\n'''
+        u'''${cases}'''
+        u'''      return true;\n'''
+        u'''    default:\n'''
+        u'''      return false;\n'''
+        u'''  }\n'''
+        u'''}\n''')
+
+    _validator_map_template = string.Template(
+        u'''Errors::eType ${name}(const SmartObject& object) {\n'''
+        u'''  if (SmartType_Map != object.getType()) {\n'''
+        u'''    return Errors::INVALID_VALUE;\n'''
+        u'''  }\n'''
+        u'''  SmartMap::const_iterator it = object.map_begin();\n'''
+        u'''  const SmartMap::const_iterator end = object.map_end();\n'''
+        u'''  const SmartObject* member = NULL;\n'''
+        u'''  Errors::eType result = Errors::OK;\n'''
+        u'''\n'''
+        u'''${members}'''
+        u'''  return result;\n'''
+        u'''}\n''')
+
+    _validator_empty_map_template = string.Template(
+        u'''Errors::eType ${name}(const SmartObject& object) {\n'''
+        u'''  if (SmartType_Map != object.getType()) {\n'''
+        u'''    return Errors::INVALID_VALUE;\n'''
+        u'''  }\n'''
+        u'''  return Errors::OK;\n'''
+        u'''}\n''')
+
+    _validator_member_template = string.Template(
+        u'''member = FindMemberInOrder(&it, end, "${name}");\n'''
+        u'''if (NULL != member) {\n'''
+        u'''${check}'''
+        u'''}${missing_member}\n''')
+
+    _validator_missing_mandatory_template = (
+        u''' else {\n'''
+        u'''  return Errors::MISSING_MANDATORY_PARAMETER;\n'''
+        u'''}''')
+
+    _validator_type_template = string.Template(
+        u'''if (${type} != ${var}.getType()) {\n'''
+        u'''  return Errors::INVALID_VALUE;\n'''
+        u'''}\n''')
+
+    _validator_number_type_template = string.Template(
+        u'''if (SmartType_Integer != ${var}.getType() &&\n'''
+        u'''    SmartType_Double != ${var}.getType()) {\n'''
+        u'''  return Errors::INVALID_VALUE;\n'''
+        u'''}\n''')
+
+    _validator_number_range_template = string.Template(
+        u'''{\n'''
+        u'''  const ${type} value = ${var}.${getter}();\n'''
+        u'''  if (${conditions}) {\n'''
+        u'''    return Errors::OUT_OF_RANGE;\n'''
+        u'''  }\n'''
+        u'''}\n''')
+
+    _validator_out_of_range_template = string.Template(
+        u'''if (${conditions}) {\n'''
+        u'''  return Errors::OUT_OF_RANGE;\n'''
+        u'''}\n''')
+
+    _validator_array_template = string.Template(
+        u'''for (size_t ${index} = 0u; ${index} < ${var}.length(); '''
+        u'''++${index}) {\n'''
+        u'''  const SmartObject& ${element} = '''
+        u'''${var}.getElement(${index});\n'''
+        u'''${check}'''
+        u'''}\n''')
+
+    _validator_call_template = string.Template(
+        u'''result = ${name}(${var});\n'''
+        u'''if (Errors::OK != result) {\n'''
+        u'''  return result;\n'''
+        u'''}\n''')
+
+    _validator_enum_check_template = string.Template(
+        u'''if (!IsAllowed_${name}(${var}.asInt())) {\n'''
+        u'''  return Errors::OUT_OF_RANGE;\n'''
+        u'''}\n''')
+
+    _validator_enum_subset_template = string.Template(
+        u'''switch (${var}.asInt()) {\n'''
+        u'''${cases}'''
+        u'''    break;\n'''
+        u'''  default:\n'''
+        u'''    return Errors::OUT_OF_RANGE;\n'''
+        u'''}\n''')
 
     _struct_impl_template = string.Template(
         u'''utils::SharedPtr<ISchemaItem> $namespace::$class_name::'''
@@ -92,6 +92,29 @@ class CodeGenerator(SmartFactoryBase.CodeGenerator):
              self._additional_response_params
                 if unicode(message_type_name) == u"response" else u""])
 
+    def _gen_validator_params(self, message_type_name):
+        """Generate list of PARAMS members for compiled validator.
+
+        Provides the same set of params as _gen_schema_params_fill does
+        in accordance to the JSONRPC format.
+
+        Keyword arguments:
+        message_type_name -- Name of the messageType enum element.
+
+        Returns:
+        List of parameters.
+
+        """
+
+        params = self._gen_validator_base_params()
+        if unicode(message_type_name) != u"notification":
+            params.append(Model.Param(name=u"correlation_id",
+                                      param_type=Model.Integer()))
+        if unicode(message_type_name) == u"response":
+            params.append(Model.Param(name=u"code",
+                                      param_type=Model.Integer()))
+        return params
+
     _error_response_insert_template = string.Template(
         u'''functions_schemes_.insert(std::make_pair('''
         u'''NsSmartDeviceLink::NsJSONHandler::'''
@@ -4,6 +4,7 @@ Defines SDLRPC format specific code generation rules.
 
 """
 from generator.generators import SmartFactoryBase
+from generator import Model
 
 
 class CodeGenerator(SmartFactoryBase.CodeGenerator):
@@ -90,3 +91,23 @@ class CodeGenerator(SmartFactoryBase.CodeGenerator):
         return u"".join([base_params, correlation_id_param
                         if unicode(message_type_name) !=
                         u"notification" else u""])
+
+    def _gen_validator_params(self, message_type_name):
+        """Generate list of PARAMS members for compiled validator.
+
+        Provides the same set of params as _gen_schema_params_fill does
+        in accordance to the SDLRPC format (both v1 and v2).
+
+        Keyword arguments:
+        message_type_name -- Name of the messageType enum element.
+
+        Returns:
+        List of parameters.
+
+        """
+
+        params = self._gen_validator_base_params()
+        if unicode(message_type_name) != u"notification":
+            params.append(Model.Param(name=u"correlation_id",
+                                      param_type=Model.Integer()))
+        return params
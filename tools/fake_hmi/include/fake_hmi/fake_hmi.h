@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_FAKE_HMI_H_
+#define TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_FAKE_HMI_H_
+
+#include <stdint.h>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread.h"
+#include "fake_hmi/hmi_script.h"
+
+namespace fake_hmi {
+
+class HmiComponent;
+
+/**
+ * \class FakeHmi
+ * \brief Headless HMI which registers standard HMI components in
+ * MessageBroker and answers every request from SDL as script says.
+ * Delayed responses and periodic notifications are sent by scheduler
+ * thread, immediate responses are sent right from receiving thread.
+ */
+class FakeHmi {
+ public:
+  FakeHmi(const std::string& address, uint16_t port,
+          const HmiScript& script);
+  ~FakeHmi();
+
+  /**
+   * \brief Connects components to MessageBroker, notifies SDL that HMI is
+   * ready and starts sending of scripted notifications
+   */
+  bool Start();
+  void Stop();
+
+  void OnRequest(HmiComponent* component, const Json::Value& request);
+  void OnResponse(const std::string& method, const Json::Value& response);
+  void OnNotification(HmiComponent* component,
+                      const Json::Value& notification);
+
+  /**
+   * \brief Prints how many messages of every method were handled
+   */
+  void Report(std::ostream& out) const;
+
+ private:
+  struct ScheduledMessage {
+    HmiComponent* component;
+    Json::Value message;
+    // Zero for messages sent once
+    int64_t period_us;
+  };
+  typedef std::multimap<int64_t, ScheduledMessage> Schedule;
+  typedef std::map<std::string, uint32_t> Counters;
+
+  class SchedulerDelegate;
+
+  void ScheduleMessage(HmiComponent* component, const Json::Value& message,
+                       int64_t send_time_us, int64_t period_us);
+  void RunScheduler();
+  void ExitScheduler();
+
+  /**
+   * \brief Component which sends messages of |method|, BasicCommunication
+   * if interface of method is unknown
+   */
+  HmiComponent* ComponentOf(const std::string& method) const;
+  void Count(const std::string& method, Counters* counters);
+
+  const std::string address_;
+  const uint16_t port_;
+  const HmiScript& script_;
+  std::vector<HmiComponent*> components_;
+
+  threads::Thread* scheduler_thread_;
+  sync_primitives::Lock schedule_lock_;
+  sync_primitives::ConditionalVariable schedule_changed_;
+  Schedule schedule_;
+  bool scheduler_stop_;
+  bool scheduler_running_;
+
+  mutable sync_primitives::Lock counters_lock_;
+  Counters requests_;
+  Counters responses_;
+  Counters notifications_received_;
+  Counters notifications_sent_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeHmi);
+};
+
+}  // namespace fake_hmi
+
+#endif  // TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_FAKE_HMI_H_
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_HMI_COMPONENT_H_
+#define TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_HMI_COMPONENT_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "mb_controller.hpp"
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread.h"
+
+namespace fake_hmi {
+
+class FakeHmi;
+
+/**
+ * \class HmiComponent
+ * \brief One HMI interface (UI, VR, ...) registered in MessageBroker.
+ * Messages received by component are passed to FakeHmi.
+ */
+class HmiComponent : public NsMessageBroker::CMessageBrokerController {
+ public:
+  HmiComponent(const std::string& address, uint16_t port,
+               const std::string& name, FakeHmi* hmi);
+
+  /**
+   * \brief Registers component in MessageBroker and subscribes it to
+   * |notifications| sent by SDL
+   */
+  void Register(const std::vector<std::string>& notifications);
+
+  /**
+   * \brief Starts thread which receives messages until connection is closed
+   * or StopReceiving is called
+   */
+  bool StartReceiving();
+
+  /**
+   * \brief Closes connection and stops receiving thread
+   */
+  void StopReceiving();
+
+  ssize_t Recv(std::string& data);
+  void processRequest(Json::Value& root);
+  void processResponse(std::string method, Json::Value& root);
+  void processNotification(Json::Value& root);
+
+ private:
+  class ReceiverDelegate;
+
+  void ReceiveMessages();
+  /**
+   * \brief Closes connection and waits until ReceiveMessages returns
+   */
+  void ExitReceiving();
+
+  FakeHmi* hmi_;
+  threads::Thread* receiver_thread_;
+  sync_primitives::Lock receiving_lock_;
+  sync_primitives::ConditionalVariable receiving_finished_;
+  bool receiving_;
+
+  DISALLOW_COPY_AND_ASSIGN(HmiComponent);
+};
+
+}  // namespace fake_hmi
+
+#endif  // TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_HMI_COMPONENT_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_HMI_SCRIPT_H_
+#define TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_HMI_SCRIPT_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+namespace fake_hmi {
+
+/**
+ * \struct MethodBehavior
+ * \brief How fake HMI answers requests of one method
+ */
+struct MethodBehavior {
+  MethodBehavior();
+
+  // Negative values mean that default behavior is used
+  int32_t delay_ms;
+  int32_t code;
+  // Parameters added to result of successful response
+  Json::Value result;
+};
+
+/**
+ * \struct NotificationStream
+ * \brief Notification which fake HMI sends periodically
+ */
+struct NotificationStream {
+  NotificationStream();
+
+  std::string method;
+  // Notifications per second
+  double rate;
+  Json::Value params;
+};
+
+/**
+ * \class HmiScript
+ * \brief Behavior of fake HMI loaded from JSON script:
+ * \code
+ * {
+ *   "activateApps": true,
+ *   "default": {"delay": 0, "code": "SUCCESS"},
+ *   "methods": {
+ *     "UI.Show": {"delay": 50},
+ *     "UI.GetLanguage": {"result": {"language": "EN-US"}},
+ *     "TTS.Speak": {"code": "REJECTED"}
+ *   },
+ *   "notifications": [
+ *     {"method": "VehicleInfo.OnVehicleData", "rate": 10,
+ *      "params": {"speed": 60.5}}
+ *   ]
+ * }
+ * \endcode
+ * Delays are in milliseconds, codes are names or values of Common.Result.
+ */
+class HmiScript {
+ public:
+  HmiScript();
+
+  /**
+   * \brief Loads script from file, settings which are absent in script
+   * are left unchanged
+   */
+  bool Load(const std::string& file_name);
+
+  /**
+   * \brief Behavior for |method| with defaults applied. IsReady requests
+   * are answered with available interface unless script says otherwise.
+   */
+  MethodBehavior Behavior(const std::string& method) const;
+
+  void set_default_delay_ms(int32_t delay_ms);
+  void set_default_code(int32_t code);
+  void set_activate_apps(bool activate_apps);
+  void AddNotification(const NotificationStream& notification);
+
+  const std::vector<NotificationStream>& notifications() const;
+  /**
+   * \brief Whether registered applications are activated by HMI, so that
+   * they get FULL level
+   */
+  bool activate_apps() const;
+
+  /**
+   * \brief Converts name or value of Common.Result to value
+   * \return false if |code| is neither
+   */
+  static bool ParseResultCode(const Json::Value& code, int32_t* value);
+
+ private:
+  bool ParseBehavior(const Json::Value& json, MethodBehavior* behavior);
+
+  MethodBehavior default_behavior_;
+  std::map<std::string, MethodBehavior> methods_;
+  std::vector<NotificationStream> notifications_;
+  bool activate_apps_;
+};
+
+}  // namespace fake_hmi
+
+#endif  // TOOLS_FAKE_HMI_INCLUDE_FAKE_HMI_HMI_SCRIPT_H_
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fake_hmi/fake_hmi.h"
+
+#include <unistd.h>
+#include <cstdio>
+#include <algorithm>
+#include <iomanip>
+
+#include "fake_hmi/hmi_component.h"
+#include "utils/date_time.h"
+#include "utils/threads/thread_delegate.h"
+#include "interfaces/HMI_API.h"
+
+namespace fake_hmi {
+
+namespace {
+
+const char* const kComponents[] = {
+  "BasicCommunication",
+  "UI",
+  "VR",
+  "TTS",
+  "VehicleInfo",
+  "Navigation",
+  "Buttons"
+};
+const size_t kComponentsCount = sizeof(kComponents) / sizeof(kComponents[0]);
+
+const char kOnReady[] = "BasicCommunication.OnReady";
+const char kOnAppRegistered[] = "BasicCommunication.OnAppRegistered";
+const char kActivateApp[] = "SDL.ActivateApp";
+
+// MessageBroker handles messages of different components in order they
+// are read from sockets, so SDL gets OnReady only after components had
+// time to register
+const useconds_t kRegistrationTimeUs = 500000;
+// Late periodic notifications are not sent in a burst
+const int64_t kMaxLagUs = 1000000;
+
+int64_t Now() {
+  return date_time::DateTime::getuSecs(date_time::DateTime::getCurrentTime());
+}
+
+Json::Value Notification(const std::string& method,
+                         const Json::Value& params) {
+  Json::Value notification;
+  notification["jsonrpc"] = "2.0";
+  notification["method"] = method;
+  notification["params"] = params;
+  return notification;
+}
+
+}  // namespace
+
+class FakeHmi::SchedulerDelegate : public threads::ThreadDelegate {
+ public:
+  explicit SchedulerDelegate(FakeHmi* hmi)
+    : hmi_(hmi) {
+  }
+
+  void threadMain() {
+    hmi_->RunScheduler();
+  }
+
+  bool exitThreadMain() {
+    hmi_->ExitScheduler();
+    return true;
+  }
+
+ private:
+  FakeHmi* hmi_;
+};
+
+FakeHmi::FakeHmi(const std::string& address, uint16_t port,
+                 const HmiScript& script)
+  : address_(address),
+    port_(port),
+    script_(script),
+    scheduler_thread_(NULL),
+    scheduler_stop_(false),
+    scheduler_running_(false) {
+}
+
+FakeHmi::~FakeHmi() {
+  Stop();
+}
+
+bool FakeHmi::Start() {
+  for (size_t i = 0; i < kComponentsCount; ++i) {
+    HmiComponent* component =
+        new HmiComponent(address_, port_, kComponents[i], this);
+    components_.push_back(component);
+    if (!component->Connect()) {
+      fprintf(stderr, "Failed to connect %s to %s:%u\n", kComponents[i],
+              address_.c_str(), port_);
+      return false;
+    }
+    if (!component->StartReceiving()) {
+      return false;
+    }
+    std::vector<std::string> notifications;
+    if (component == ComponentOf(kOnAppRegistered)) {
+      notifications.push_back(kOnAppRegistered);
+    }
+    component->Register(notifications);
+  }
+
+  scheduler_running_ = true;
+  scheduler_thread_ = threads::CreateThread("FakeHmiScheduler",
+                                            new SchedulerDelegate(this));
+  if (!scheduler_thread_->start()) {
+    scheduler_running_ = false;
+    return false;
+  }
+
+  usleep(kRegistrationTimeUs);
+  Json::Value on_ready = Notification(kOnReady, Json::objectValue);
+  ComponentOf(kOnReady)->sendJsonMessage(on_ready);
+
+  const std::vector<NotificationStream>& streams = script_.notifications();
+  const int64_t now = Now();
+  for (size_t i = 0; i < streams.size(); ++i) {
+    const int64_t period_us =
+        std::max<int64_t>(1, static_cast<int64_t>(1000000 / streams[i].rate));
+    ScheduleMessage(ComponentOf(streams[i].method),
+                    Notification(streams[i].method, streams[i].params),
+                    now + period_us, period_us);
+  }
+  return true;
+}
+
+void FakeHmi::Stop() {
+  if (scheduler_thread_) {
+    scheduler_thread_->stop();
+    threads::DeleteThread(scheduler_thread_);
+    scheduler_thread_ = NULL;
+  }
+  for (size_t i = 0; i < components_.size(); ++i) {
+    components_[i]->StopReceiving();
+    delete components_[i];
+  }
+  components_.clear();
+}
+
+void FakeHmi::OnRequest(HmiComponent* component,
+                        const Json::Value& request) {
+  const std::string method = request["method"].asString();
+  Count(method, &requests_);
+
+  const MethodBehavior behavior = script_.Behavior(method);
+  Json::Value response;
+  response["jsonrpc"] = "2.0";
+  response["id"] = request["id"];
+  if (behavior.code == 0 ||
+      behavior.code == hmi_apis::Common_Result::WARNINGS) {
+    response["result"] = behavior.result;
+    response["result"]["code"] = behavior.code;
+    response["result"]["method"] = method;
+  } else {
+    response["error"]["code"] = behavior.code;
+    response["error"]["message"] = "Scripted error of fake HMI";
+    response["error"]["data"]["method"] = method;
+  }
+
+  if (behavior.delay_ms) {
+    ScheduleMessage(component, response,
+                    Now() + behavior.delay_ms * 1000, 0);
+  } else {
+    component->sendJsonMessage(response);
+  }
+}
+
+void FakeHmi::OnResponse(const std::string& method,
+                         const Json::Value& response) {
+  Count(response.isMember("error") ? method + " error" : method,
+        &responses_);
+}
+
+void FakeHmi::OnNotification(HmiComponent* component,
+                             const Json::Value& notification) {
+  const std::string method = notification["method"].asString();
+  Count(method, &notifications_received_);
+
+  if (method == kOnAppRegistered && script_.activate_apps()) {
+    Json::Value request;
+    component->prepareMessage(request);
+    request["method"] = kActivateApp;
+    request["params"]["appID"] =
+        notification["params"]["application"]["appID"];
+    component->sendJsonMessage(request);
+  }
+}
+
+void FakeHmi::Report(std::ostream& out) const {
+  struct {
+    const char* title;
+    const Counters& counters;
+  } const tables[] = {
+    {"Requests answered", requests_},
+    {"Notifications sent", notifications_sent_},
+    {"Notifications received", notifications_received_},
+    {"Responses from SDL", responses_}
+  };
+
+  sync_primitives::AutoLock auto_lock(counters_lock_);
+  for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); ++i) {
+    out << tables[i].title << ":\n";
+    for (Counters::const_iterator it = tables[i].counters.begin();
+         it != tables[i].counters.end(); ++it) {
+      out << "  " << std::left << std::setw(48) << it->first
+          << it->second << '\n';
+    }
+  }
+}
+
+void FakeHmi::ScheduleMessage(HmiComponent* component,
+                              const Json::Value& message,
+                              int64_t send_time_us, int64_t period_us) {
+  const ScheduledMessage scheduled = {component, message, period_us};
+  sync_primitives::AutoLock auto_lock(schedule_lock_);
+  schedule_.insert(std::make_pair(send_time_us, scheduled));
+  schedule_changed_.NotifyOne();
+}
+
+void FakeHmi::RunScheduler() {
+  sync_primitives::AutoLock auto_lock(schedule_lock_);
+  while (!scheduler_stop_) {
+    if (schedule_.empty()) {
+      schedule_changed_.Wait(auto_lock);
+      continue;
+    }
+    const int64_t now = Now();
+    Schedule::iterator first = schedule_.begin();
+    if (first->first > now) {
+      schedule_changed_.WaitFor(auto_lock, (first->first - now + 999) / 1000);
+      continue;
+    }
+
+    ScheduledMessage scheduled = first->second;
+    if (scheduled.period_us) {
+      int64_t next_time = first->first + scheduled.period_us;
+      if (next_time < now - kMaxLagUs) {
+        next_time = now;
+      }
+      schedule_.insert(std::make_pair(next_time, scheduled));
+    }
+    schedule_.erase(first);
+
+    sync_primitives::AutoUnlock auto_unlock(auto_lock);
+    scheduled.component->sendJsonMessage(scheduled.message);
+    if (scheduled.period_us) {
+      Count(scheduled.message["method"].asString(), &notifications_sent_);
+    }
+  }
+  scheduler_running_ = false;
+  schedule_changed_.Broadcast();
+}
+
+void FakeHmi::ExitScheduler() {
+  sync_primitives::AutoLock auto_lock(schedule_lock_);
+  scheduler_stop_ = true;
+  schedule_changed_.Broadcast();
+  while (scheduler_running_) {
+    schedule_changed_.Wait(auto_lock);
+  }
+}
+
+HmiComponent* FakeHmi::ComponentOf(const std::string& method) const {
+  const std::string interface_name = method.substr(0, method.find('.'));
+  for (size_t i = 0; i < components_.size(); ++i) {
+    if (components_[i]->getControllersName() == interface_name) {
+      return components_[i];
+    }
+  }
+  return components_.front();
+}
+
+void FakeHmi::Count(const std::string& method, Counters* counters) {
+  sync_primitives::AutoLock auto_lock(counters_lock_);
+  ++(*counters)[method];
+}
+
+}  // namespace fake_hmi
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fake_hmi/hmi_component.h"
+
+#include "fake_hmi/fake_hmi.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace fake_hmi {
+
+class HmiComponent::ReceiverDelegate : public threads::ThreadDelegate {
+ public:
+  explicit ReceiverDelegate(HmiComponent* component)
+    : component_(component) {
+  }
+
+  void threadMain() {
+    component_->ReceiveMessages();
+  }
+
+  bool exitThreadMain() {
+    component_->ExitReceiving();
+    return true;
+  }
+
+ private:
+  HmiComponent* component_;
+};
+
+HmiComponent::HmiComponent(const std::string& address, uint16_t port,
+                           const std::string& name, FakeHmi* hmi)
+  : CMessageBrokerController(address, port, name),
+    hmi_(hmi),
+    receiver_thread_(NULL),
+    receiving_(false) {
+}
+
+void HmiComponent::Register(const std::vector<std::string>& notifications) {
+  registerController();
+  for (size_t i = 0; i < notifications.size(); ++i) {
+    subscribeTo(notifications[i]);
+  }
+}
+
+bool HmiComponent::StartReceiving() {
+  DCHECK(!receiver_thread_);
+  {
+    // Set before thread runs so that ExitReceiving waits for it anyway
+    sync_primitives::AutoLock auto_lock(receiving_lock_);
+    receiving_ = true;
+  }
+  receiver_thread_ = threads::CreateThread(getControllersName().c_str(),
+                                           new ReceiverDelegate(this));
+  if (!receiver_thread_->start()) {
+    sync_primitives::AutoLock auto_lock(receiving_lock_);
+    receiving_ = false;
+    return false;
+  }
+  return true;
+}
+
+void HmiComponent::StopReceiving() {
+  if (receiver_thread_) {
+    receiver_thread_->stop();
+    threads::DeleteThread(receiver_thread_);
+    receiver_thread_ = NULL;
+  }
+}
+
+void HmiComponent::ReceiveMessages() {
+  MethodForReceiverThread(NULL);
+  sync_primitives::AutoLock auto_lock(receiving_lock_);
+  receiving_ = false;
+  receiving_finished_.Broadcast();
+}
+
+void HmiComponent::ExitReceiving() {
+  exitReceivingThread();
+  sync_primitives::AutoLock auto_lock(receiving_lock_);
+  while (receiving_) {
+    receiving_finished_.Wait(auto_lock);
+  }
+}
+
+ssize_t HmiComponent::Recv(std::string& data) {
+  const ssize_t received = CMessageBrokerController::Recv(data);
+  if (received <= 0) {
+    // Connection is closed, receiving loop would never end otherwise
+    stop = true;
+  }
+  return received;
+}
+
+void HmiComponent::processRequest(Json::Value& root) {
+  hmi_->OnRequest(this, root);
+}
+
+void HmiComponent::processResponse(std::string method, Json::Value& root) {
+  hmi_->OnResponse(method, root);
+}
+
+void HmiComponent::processNotification(Json::Value& root) {
+  hmi_->OnNotification(this, root);
+}
+
+}  // namespace fake_hmi
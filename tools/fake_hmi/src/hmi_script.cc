@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fake_hmi/hmi_script.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "smart_objects/enum_schema_item.h"
+#include "interfaces/HMI_API.h"
+
+namespace fake_hmi {
+
+namespace {
+
+const char kIsReadySuffix[] = ".IsReady";
+
+bool EndsWith(const std::string& value, const std::string& suffix) {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(),
+                       suffix) == 0;
+}
+
+}  // namespace
+
+MethodBehavior::MethodBehavior()
+  : delay_ms(-1),
+    code(-1),
+    result(Json::objectValue) {
+}
+
+NotificationStream::NotificationStream()
+  : rate(0),
+    params(Json::objectValue) {
+}
+
+HmiScript::HmiScript()
+  : activate_apps_(true) {
+  default_behavior_.delay_ms = 0;
+  default_behavior_.code = hmi_apis::Common_Result::SUCCESS;
+}
+
+bool HmiScript::Load(const std::string& file_name) {
+  std::ifstream file(file_name.c_str());
+  Json::Value script;
+  Json::Reader reader;
+  if (!file || !reader.parse(file, script) || !script.isObject()) {
+    fprintf(stderr, "Failed to parse script %s\n", file_name.c_str());
+    return false;
+  }
+
+  if (script.isMember("activateApps")) {
+    activate_apps_ = script["activateApps"].asBool();
+  }
+  if (script.isMember("default")) {
+    MethodBehavior behavior;
+    if (!ParseBehavior(script["default"], &behavior)) {
+      return false;
+    }
+    if (behavior.delay_ms >= 0) {
+      default_behavior_.delay_ms = behavior.delay_ms;
+    }
+    if (behavior.code >= 0) {
+      default_behavior_.code = behavior.code;
+    }
+  }
+
+  const Json::Value& methods = script["methods"];
+  const Json::Value::Members names = methods.getMemberNames();
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (!ParseBehavior(methods[names[i]], &methods_[names[i]])) {
+      fprintf(stderr, "Wrong behavior of %s\n", names[i].c_str());
+      return false;
+    }
+  }
+
+  const Json::Value& notifications = script["notifications"];
+  for (Json::Value::ArrayIndex i = 0; i < notifications.size(); ++i) {
+    const Json::Value& json = notifications[i];
+    NotificationStream notification;
+    notification.method = json["method"].asString();
+    notification.rate = json["rate"].asDouble();
+    if (json.isMember("params")) {
+      notification.params = json["params"];
+    }
+    if (notification.method.empty() || notification.rate <= 0) {
+      fprintf(stderr, "Notification %u needs method and rate\n", i);
+      return false;
+    }
+    notifications_.push_back(notification);
+  }
+  return true;
+}
+
+MethodBehavior HmiScript::Behavior(const std::string& method) const {
+  MethodBehavior behavior;
+  std::map<std::string, MethodBehavior>::const_iterator it =
+      methods_.find(method);
+  if (it != methods_.end()) {
+    behavior = it->second;
+  }
+  if (behavior.delay_ms < 0) {
+    behavior.delay_ms = default_behavior_.delay_ms;
+  }
+  if (behavior.code < 0) {
+    behavior.code = default_behavior_.code;
+  }
+  if (EndsWith(method, kIsReadySuffix) && !behavior.result.isMember(
+          "available")) {
+    behavior.result["available"] = true;
+  }
+  return behavior;
+}
+
+void HmiScript::set_default_delay_ms(int32_t delay_ms) {
+  default_behavior_.delay_ms = delay_ms;
+}
+
+void HmiScript::set_default_code(int32_t code) {
+  default_behavior_.code = code;
+}
+
+void HmiScript::set_activate_apps(bool activate_apps) {
+  activate_apps_ = activate_apps;
+}
+
+void HmiScript::AddNotification(const NotificationStream& notification) {
+  notifications_.push_back(notification);
+}
+
+const std::vector<NotificationStream>& HmiScript::notifications() const {
+  return notifications_;
+}
+
+bool HmiScript::activate_apps() const {
+  return activate_apps_;
+}
+
+bool HmiScript::ParseResultCode(const Json::Value& code, int32_t* value) {
+  using NsSmartDeviceLink::NsSmartObjects::EnumConversionHelper;
+  if (code.isIntegral()) {
+    *value = code.asInt();
+    return *value >= 0;
+  }
+  hmi_apis::Common_Result::eType result;
+  if (code.isString() &&
+      EnumConversionHelper<hmi_apis::Common_Result::eType>::StringToEnum(
+          code.asString(), &result)) {
+    *value = result;
+    return true;
+  }
+  return false;
+}
+
+bool HmiScript::ParseBehavior(const Json::Value& json,
+                              MethodBehavior* behavior) {
+  if (!json.isObject()) {
+    return false;
+  }
+  if (json.isMember("delay")) {
+    if (!json["delay"].isIntegral() || json["delay"].asInt() < 0) {
+      return false;
+    }
+    behavior->delay_ms = json["delay"].asInt();
+  }
+  if (json.isMember("code") &&
+      !ParseResultCode(json["code"], &behavior->code)) {
+    return false;
+  }
+  if (json.isMember("result")) {
+    behavior->result = json["result"];
+  }
+  return behavior->result.isObject();
+}
+
+}  // namespace fake_hmi
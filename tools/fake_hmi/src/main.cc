@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "utils/logger.h"
+#ifdef ENABLE_LOG
+#include "utils/log_message_loop_thread.h"
+#endif  // ENABLE_LOG
+#include "fake_hmi/fake_hmi.h"
+#include "fake_hmi/hmi_script.h"
+
+namespace {
+
+struct Options {
+  Options()
+    : host("127.0.0.1"),
+      port(8087),
+      duration_s(0),
+      vehicle_data_rate(0),
+      touch_rate(0) {
+  }
+
+  std::string host;
+  uint16_t port;
+  std::string script;
+  uint32_t duration_s;
+  double vehicle_data_rate;
+  double touch_rate;
+};
+
+void PrintUsage(const char* program_name) {
+  printf("Usage: %s [--option=value]...\n"
+         "Headless HMI which answers every request of SDL.\nOptions:\n"
+         "  --host=ADDRESS           MessageBroker address, 127.0.0.1\n"
+         "  --port=PORT              MessageBroker port, 8087\n"
+         "  --script=FILE            JSON script of responses and"
+         " notifications\n"
+         "  --delay=MS               default delay of responses\n"
+         "  --code=RESULT            default result code of responses\n"
+         "  --activate=0|1           activate registered applications\n"
+         "  --vehicle-data-rate=N    OnVehicleData notifications per second\n"
+         "  --touch-rate=N           OnTouchEvent notifications per second\n"
+         "  --duration=S             seconds to run, until signal if 0\n",
+         program_name);
+}
+
+bool ParseCommandLine(int argc, char** argv, Options* options,
+                      fake_hmi::HmiScript* script) {
+  for (int i = 1; i < argc; ++i) {
+    const char* separator = strchr(argv[i], '=');
+    if (strncmp(argv[i], "--", 2) != 0 || !separator) {
+      return false;
+    }
+    const std::string name(argv[i] + 2, separator - argv[i] - 2);
+    const char* value = separator + 1;
+    char* end = NULL;
+    const double number = strtod(value, &end);
+    const bool is_number = *value && !*end && number >= 0;
+
+    if (name == "host") {
+      options->host = value;
+    } else if (name == "port" && is_number && number <= 0xFFFF) {
+      options->port = static_cast<uint16_t>(number);
+    } else if (name == "script") {
+      options->script = value;
+    } else if (name == "delay" && is_number) {
+      script->set_default_delay_ms(static_cast<int32_t>(number));
+    } else if (name == "code") {
+      int32_t code = 0;
+      if (!fake_hmi::HmiScript::ParseResultCode(
+              is_number ? Json::Value(static_cast<int32_t>(number))
+                        : Json::Value(value), &code)) {
+        return false;
+      }
+      script->set_default_code(code);
+    } else if (name == "activate" && is_number) {
+      script->set_activate_apps(number != 0);
+    } else if (name == "vehicle-data-rate" && is_number) {
+      options->vehicle_data_rate = number;
+    } else if (name == "touch-rate" && is_number) {
+      options->touch_rate = number;
+    } else if (name == "duration" && is_number) {
+      options->duration_s = static_cast<uint32_t>(number);
+    } else {
+      fprintf(stderr, "Wrong option %s\n", argv[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+fake_hmi::NotificationStream VehicleDataStream(double rate) {
+  fake_hmi::NotificationStream stream;
+  stream.method = "VehicleInfo.OnVehicleData";
+  stream.rate = rate;
+  stream.params["speed"] = 60.5;
+  stream.params["rpm"] = 2500;
+  stream.params["fuelLevel"] = 50.0;
+  return stream;
+}
+
+fake_hmi::NotificationStream TouchEventStream(double rate) {
+  fake_hmi::NotificationStream stream;
+  stream.method = "UI.OnTouchEvent";
+  stream.rate = rate;
+  stream.params["type"] = "MOVE";
+  Json::Value& event = stream.params["event"][0u];
+  event["id"] = 0;
+  event["ts"][0u] = 1;
+  event["c"][0u]["x"] = 100;
+  event["c"][0u]["y"] = 100;
+  return stream;
+}
+
+}  // namespace
+
+/**
+ * \brief Entry point of fake HMI. Runs until duration expires or SIGINT or
+ * SIGTERM is received and then prints how many messages were handled.
+ */
+int32_t main(int32_t argc, char** argv) {
+  Options options;
+  fake_hmi::HmiScript script;
+  // Script overrides defaults given in command line, so it is loaded after
+  if (!ParseCommandLine(argc, argv, &options, &script) ||
+      (!options.script.empty() && !script.Load(options.script))) {
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (options.vehicle_data_rate > 0) {
+    script.AddNotification(VehicleDataStream(options.vehicle_data_rate));
+  }
+  if (options.touch_rate > 0) {
+    script.AddNotification(TouchEventStream(options.touch_rate));
+  }
+  INIT_LOGGER("log4cxx.properties");
+
+  // Signals are blocked in all threads and are waited for by main thread
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, NULL);
+  // MessageBroker client writes to socket which SDL may close at any time
+  signal(SIGPIPE, SIG_IGN);
+
+  int32_t result = EXIT_SUCCESS;
+  {
+    fake_hmi::FakeHmi hmi(options.host, options.port, script);
+    if (hmi.Start()) {
+      printf("Fake HMI is connected to %s:%u\n", options.host.c_str(),
+             options.port);
+      if (options.duration_s) {
+        const timespec timeout = {static_cast<time_t>(options.duration_s), 0};
+        sigtimedwait(&signals, NULL, &timeout);
+      } else {
+        int signal_number = 0;
+        sigwait(&signals, &signal_number);
+      }
+    } else {
+      result = EXIT_FAILURE;
+    }
+    hmi.Stop();
+    hmi.Report(std::cout);
+  }
+
+#ifdef ENABLE_LOG
+  logger::LogMessageLoopThread::destroy();
+#endif  // ENABLE_LOG
+  DEINIT_LOGGER();
+  return result;
+}
@@ -56,28 +56,60 @@ EnumFromJsonStringFunction::~EnumFromJsonStringFunction() {
 }
 
 void EnumFromJsonStringFunction::DefineBody(std::ostream* os) const {
-  const Enum::ConstantsList& consts = enm_->constants();
-  if (!consts.empty()) {
-    const char* if_statement = "if (\"{0}\" == {1}) {";
-    for (Enum::ConstantsList::const_iterator i = consts.begin();
+  // Literals are emitted sorted by name (constants_by_name is ordered
+  // the same way std::string::compare orders them) and looked up
+  // with binary search instead of comparing with every literal in turn
+  const Enum::ConstantsByName& consts = enm_->constants_by_name();
+  if (consts.empty()) {
+    *os << "return false;" << endl;
+    return;
+  }
+  *os << "static const struct {" << endl;
+  {
+    Indent indent(*os);
+    *os << "const char* literal;" << endl;
+    *os << enm_->name() << " value;" << endl;
+  }
+  *os << "} kLiterals[] = {" << endl;
+  {
+    Indent indent(*os);
+    for (Enum::ConstantsByName::const_iterator i = consts.begin();
         i != consts.end(); ++i) {
-      const Enum::Constant& c = *i;
-      strmfmt(*os, if_statement, c.name(), parameters_[0].name) << endl;
-      {
-        Indent indent(*os);
-        strmfmt(*os, "{0} = {1};", parameters_[1].name,
-                LiteralGenerator(c).result()) << '\n';
-        *os << "return true;" << '\n';
-      }
-      if_statement = "} else if (\"{0}\" == {1}) {";
+      const Enum::Constant& c = *i->second;
+      *os << "{ \"" << c.name() << "\", " << LiteralGenerator(c).result()
+          << " }," << endl;
     }
   }
-  *os << "} else {" << endl;
+  *os << "};" << endl;
+  *os << "size_t first = 0;" << endl;
+  *os << "size_t last = sizeof(kLiterals) / sizeof(kLiterals[0]);" << endl;
+  *os << "while (first < last) {" << endl;
   {
     Indent indent(*os);
-    *os << "return false;" << '\n';
+    *os << "const size_t middle = first + (last - first) / 2;" << endl;
+    strmfmt(*os, "const int order = {0}.compare(kLiterals[middle].literal);",
+            parameters_[0].name) << endl;
+    *os << "if (order == 0) {" << endl;
+    {
+      Indent indent(*os);
+      strmfmt(*os, "{0} = kLiterals[middle].value;", parameters_[1].name)
+          << endl;
+      *os << "return true;" << endl;
+    }
+    *os << "} else if (order < 0) {" << endl;
+    {
+      Indent indent(*os);
+      *os << "last = middle;" << endl;
+    }
+    *os << "} else {" << endl;
+    {
+      Indent indent(*os);
+      *os << "first = middle + 1;" << endl;
+    }
+    *os << "}" << endl;
   }
   *os << "}" << endl;
+  *os << "return false;" << endl;
 }
 
 }  // namespace codegen
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_LOAD_CONFIG_H_
+#define TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_LOAD_CONFIG_H_
+
+#include <stdint.h>
+#include <string>
+
+namespace load_generator {
+
+/**
+ * \struct LoadConfig
+ * \brief Parameters of load run. Rates are given per application, so total
+ * load grows with number of applications.
+ */
+struct LoadConfig {
+  LoadConfig();
+
+  std::string host;
+  uint16_t port;
+  // Number of simultaneous applications, one TCP connection each
+  uint32_t applications;
+  // Load lasts that long after last application is connected
+  uint32_t duration_s;
+  // Delay between connecting of consecutive applications
+  uint32_t ramp_ms;
+  // Time after which request without response is counted as timed out
+  uint32_t response_timeout_ms;
+
+  // Requests per second of every application
+  double show_rate;
+  double subscribe_rate;
+  double put_file_rate;
+  // AddCommand is sent in bursts of add_command_burst requests
+  double add_command_rate;
+  uint32_t add_command_burst;
+
+  uint32_t put_file_size;
+  // Video is streamed only if bitrate is not zero
+  uint32_t video_kbps;
+};
+
+/**
+ * \brief Fills |config| from command line options of form --name=value
+ * \return false if options could not be parsed or help was requested
+ */
+bool ParseCommandLine(int argc, char** argv, LoadConfig* config);
+
+void PrintUsage(const char* program_name);
+
+}  // namespace load_generator
+
+#endif  // TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_LOAD_CONFIG_H_
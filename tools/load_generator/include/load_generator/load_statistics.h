@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_LOAD_STATISTICS_H_
+#define TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_LOAD_STATISTICS_H_
+
+#include <stdint.h>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace load_generator {
+
+/**
+ * \class LoadStatistics
+ * \brief Counts requests, responses and their latencies per RPC.
+ * Every session collects own statistics without locking, they are merged
+ * when load run is finished.
+ */
+class LoadStatistics {
+ public:
+  LoadStatistics();
+
+  void OnRequestSent(const std::string& rpc_name);
+  /**
+   * \param latency_us Time from sending of request to receiving of response
+   * \param result_code resultCode of response
+   */
+  void OnResponseReceived(const std::string& rpc_name, int64_t latency_us,
+                          const std::string& result_code);
+  void OnResponseTimeout(const std::string& rpc_name);
+  void OnNotificationReceived();
+  void OnVideoSent(size_t bytes);
+  /**
+   * \brief Counts session which failed to connect, start RPC service
+   * or register application
+   */
+  void OnSessionFailed(const std::string& reason);
+
+  void Merge(const LoadStatistics& other);
+
+  /**
+   * \brief Prints throughput, latency percentiles and result codes
+   * \param duration_s Length of load phase throughput is calculated for
+   */
+  void Report(double duration_s, std::ostream& out) const;
+
+ private:
+  struct RpcStatistics {
+    RpcStatistics();
+
+    uint32_t sent;
+    uint32_t timed_out;
+    std::vector<int64_t> latencies_us;
+    std::map<std::string, uint32_t> result_codes;
+  };
+  typedef std::map<std::string, RpcStatistics> RpcStatisticsMap;
+
+  RpcStatisticsMap rpcs_;
+  std::map<std::string, uint32_t> failed_sessions_;
+  uint32_t notifications_;
+  uint64_t video_bytes_;
+};
+
+}  // namespace load_generator
+
+#endif  // TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_LOAD_STATISTICS_H_
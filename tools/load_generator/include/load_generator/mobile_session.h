@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_MOBILE_SESSION_H_
+#define TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_MOBILE_SESSION_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/macro.h"
+#include "protocol/service_type.h"
+#include "load_generator/load_config.h"
+#include "load_generator/load_statistics.h"
+#include "load_generator/rpc_builder.h"
+
+namespace protocol_handler {
+class ProtocolPacket;
+}  // namespace protocol_handler
+
+namespace load_generator {
+
+/**
+ * \class MobileSession
+ * \brief Emulates one mobile application connected to SDL over TCP.
+ * Session is driven by single thread: requests are sent when they are due
+ * and responses are read in between, so session needs no locking.
+ */
+class MobileSession {
+ public:
+  /**
+   * \param index Number of application, makes its name and id unique
+   */
+  MobileSession(uint32_t index, const LoadConfig& config);
+  ~MobileSession();
+
+  /**
+   * \brief Connects to SDL, registers application and sends requests at
+   * configured rates until |load_end_us|. Then waits for responses to
+   * requests which are still pending.
+   * \param load_end_us Absolute time in microseconds
+   */
+  void Run(int64_t load_end_us);
+
+  const LoadStatistics& statistics() const;
+
+ private:
+  enum ScheduleType {
+    kShow = 0,
+    kAddCommand,
+    kSubscribeVehicleData,
+    kPutFile,
+    kVideo,
+    kSchedulesCount
+  };
+
+  struct Schedule {
+    // Zero interval means the schedule is off
+    int64_t interval_us;
+    int64_t next_us;
+  };
+
+  struct PendingRequest {
+    std::string rpc_name;
+    int64_t sent_us;
+  };
+  typedef std::map<uint32_t, PendingRequest> PendingRequests;
+
+  bool Connect();
+  /**
+   * \brief Sends StartService and waits for ACK or NACK
+   */
+  bool StartService(protocol_handler::ServiceType service_type);
+  bool RegisterApplication();
+
+  void InitSchedules(int64_t now_us);
+  void SendDueRequests(int64_t now_us);
+  /**
+   * \return Time in microseconds when next request is due
+   */
+  int64_t NextDue() const;
+  bool SendScheduled(ScheduleType type);
+
+  bool SendRequest(const std::string& rpc_name, uint32_t correlation_id,
+                   const RpcPayload& payload);
+  /**
+   * \brief Splits message into frames as protocol handler does and sends them
+   */
+  bool SendMessage(uint8_t service_type, const uint8_t* data, size_t size);
+  bool SendFrame(const protocol_handler::ProtocolPacket& packet);
+
+  /**
+   * \brief Waits up to |timeout_us| for data from SDL and handles all
+   * frames received completely
+   * \return false if connection is closed
+   */
+  bool Receive(int64_t timeout_us);
+  /**
+   * \brief Receives until |*condition| becomes true or timeout expires
+   */
+  bool ReceiveUntil(const bool* condition, int64_t timeout_us);
+  void HandleFrame(const protocol_handler::ProtocolPacket& frame);
+  void HandleRpc(const uint8_t* data, size_t size);
+  /**
+   * \brief Counts requests pending since |deadline_us| as timed out
+   */
+  void ExpirePending(int64_t deadline_us);
+
+  const uint32_t index_;
+  const LoadConfig& config_;
+  RpcBuilder builder_;
+  LoadStatistics statistics_;
+
+  int socket_;
+  uint8_t session_id_;
+  uint32_t message_id_;
+  uint32_t correlation_id_;
+  uint32_t command_id_;
+  uint32_t put_file_count_;
+  bool subscribed_;
+
+  // Results of handshake with SDL
+  bool control_answered_;
+  bool service_started_;
+  uint32_t register_correlation_id_;
+  bool register_answered_;
+  bool registered_;
+
+  Schedule schedules_[kSchedulesCount];
+  PendingRequests pending_;
+  // Received bytes which don't make complete frame yet
+  std::vector<uint8_t> incoming_;
+  // Data of multiframe message being assembled
+  std::vector<uint8_t> multi_frame_;
+  RpcPayload video_frame_;
+
+  DISALLOW_COPY_AND_ASSIGN(MobileSession);
+};
+
+}  // namespace load_generator
+
+#endif  // TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_MOBILE_SESSION_H_
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_RPC_BUILDER_H_
+#define TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_RPC_BUILDER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "utils/macro.h"
+#include "smart_objects/smart_object.h"
+#include "interfaces/MOBILE_API_schema.h"
+
+namespace load_generator {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+typedef std::vector<uint8_t> RpcPayload;
+
+/**
+ * \struct RpcHeader
+ * \brief Binary header which precedes JSON of RPC in protocol version 2
+ */
+struct RpcHeader {
+  enum {
+    kSize = 12
+  };
+  enum RpcType {
+    kRequest = 0,
+    kResponse = 1,
+    kNotification = 2
+  };
+
+  RpcType rpc_type;
+  int32_t function_id;
+  uint32_t correlation_id;
+  uint32_t json_size;
+};
+
+/**
+ * \class RpcBuilder
+ * \brief Encodes mobile requests the same way as mobile library does:
+ * message is validated against generated mobile API schema, formatted
+ * to JSON and prepended with binary RPC header
+ */
+class RpcBuilder {
+ public:
+  RpcBuilder();
+
+  bool RegisterAppInterface(uint32_t correlation_id,
+                            const std::string& app_name,
+                            const std::string& app_id,
+                            bool is_navigation,
+                            RpcPayload* payload);
+  bool Show(uint32_t correlation_id, const std::string& text,
+            RpcPayload* payload);
+  bool AddCommand(uint32_t correlation_id, uint32_t command_id,
+                  RpcPayload* payload);
+  /**
+   * \brief Builds SubscribeVehicleData if |subscribe| is true or
+   * UnsubscribeVehicleData otherwise for the same data
+   */
+  bool SubscribeVehicleData(uint32_t correlation_id, bool subscribe,
+                            RpcPayload* payload);
+  bool PutFile(uint32_t correlation_id, const std::string& file_name,
+               uint32_t file_size, RpcPayload* payload);
+
+  /**
+   * \brief Parses binary header of RPC from mobile payload
+   * \return false if payload is too small to contain header and JSON
+   */
+  static bool ParseHeader(const uint8_t* payload, size_t size,
+                          RpcHeader* header);
+
+  /**
+   * \brief Extracts resultCode from JSON of response
+   * \return Name of result code or empty string if it is absent
+   */
+  static std::string ResultCode(const RpcHeader& header,
+                                const uint8_t* json);
+
+ private:
+  bool Build(mobile_apis::FunctionID::eType function_id,
+             uint32_t correlation_id,
+             const smart_objects::SmartObject& msg_params,
+             const RpcPayload& binary_data,
+             RpcPayload* payload);
+
+  mobile_apis::MOBILE_API factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(RpcBuilder);
+};
+
+}  // namespace load_generator
+
+#endif  // TOOLS_LOAD_GENERATOR_INCLUDE_LOAD_GENERATOR_RPC_BUILDER_H_
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "load_generator/load_config.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <cstdio>
+
+namespace load_generator {
+
+namespace {
+
+struct Option {
+  const char* name;
+  const char* description;
+};
+
+const Option kOptions[] = {
+  {"host", "address of SDL TCP transport adapter"},
+  {"port", "port of SDL TCP transport adapter"},
+  {"apps", "number of applications"},
+  {"duration", "seconds of load after last app is connected"},
+  {"ramp", "milliseconds between connecting of applications"},
+  {"timeout", "milliseconds to wait for response"},
+  {"show", "Show requests per second per app"},
+  {"subscribe",
+   "Subscribe/UnsubscribeVehicleData requests per second per app"},
+  {"put-file", "PutFile requests per second per app"},
+  {"put-file-size", "bytes of file sent by PutFile"},
+  {"add-command", "AddCommand bursts per second per app"},
+  {"add-command-burst", "AddCommand requests in one burst"},
+  {"video-kbps", "video stream bitrate of every app, 0 is off"}
+};
+
+const size_t kOptionsCount = sizeof(kOptions) / sizeof(kOptions[0]);
+
+bool SetOption(const std::string& name, const char* value,
+               LoadConfig* config) {
+  char* end = NULL;
+  const unsigned long number = strtoul(value, &end, 10);
+  const bool is_number = *value && !*end;
+  const double rate = strtod(value, &end);
+  const bool is_rate = *value && !*end && rate >= 0;
+
+  if (name == "host") {
+    config->host = value;
+    return true;
+  }
+  if (name == "port" && is_number && number <= 0xFFFF) {
+    config->port = static_cast<uint16_t>(number);
+    return true;
+  }
+
+  struct {
+    const char* name;
+    uint32_t* field;
+  } const unsigned_fields[] = {
+    {"apps", &config->applications},
+    {"duration", &config->duration_s},
+    {"ramp", &config->ramp_ms},
+    {"timeout", &config->response_timeout_ms},
+    {"put-file-size", &config->put_file_size},
+    {"add-command-burst", &config->add_command_burst},
+    {"video-kbps", &config->video_kbps}
+  };
+  for (size_t i = 0;
+       i < sizeof(unsigned_fields) / sizeof(unsigned_fields[0]); ++i) {
+    if (name == unsigned_fields[i].name && is_number) {
+      *unsigned_fields[i].field = static_cast<uint32_t>(number);
+      return true;
+    }
+  }
+
+  struct {
+    const char* name;
+    double* field;
+  } const rate_fields[] = {
+    {"show", &config->show_rate},
+    {"subscribe", &config->subscribe_rate},
+    {"put-file", &config->put_file_rate},
+    {"add-command", &config->add_command_rate}
+  };
+  for (size_t i = 0; i < sizeof(rate_fields) / sizeof(rate_fields[0]); ++i) {
+    if (name == rate_fields[i].name && is_rate) {
+      *rate_fields[i].field = rate;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+LoadConfig::LoadConfig()
+  : host("127.0.0.1"),
+    port(12345),
+    applications(1),
+    duration_s(60),
+    ramp_ms(100),
+    response_timeout_ms(10000),
+    show_rate(1.0),
+    subscribe_rate(0.0),
+    put_file_rate(0.0),
+    add_command_rate(0.0),
+    add_command_burst(10),
+    put_file_size(64 * 1024),
+    video_kbps(0) {
+}
+
+bool ParseCommandLine(int argc, char** argv, LoadConfig* config) {
+  for (int i = 1; i < argc; ++i) {
+    const char* argument = argv[i];
+    if (strcmp(argument, "--help") == 0) {
+      return false;
+    }
+    const char* separator = strchr(argument, '=');
+    if (strncmp(argument, "--", 2) != 0 || !separator) {
+      fprintf(stderr, "Unknown argument %s\n", argument);
+      return false;
+    }
+    const std::string name(argument + 2, separator);
+    if (!SetOption(name, separator + 1, config)) {
+      fprintf(stderr, "Wrong value of option %s\n", argument);
+      return false;
+    }
+  }
+  if (!config->applications || !config->add_command_burst) {
+    fprintf(stderr, "Number of apps and AddCommand burst can't be zero\n");
+    return false;
+  }
+  return true;
+}
+
+void PrintUsage(const char* program_name) {
+  const LoadConfig defaults;
+  printf("Usage: %s [--option=value]...\n"
+         "Registers applications over TCP and sends requests to SDL at"
+         " given rates.\nOptions:\n", program_name);
+  for (size_t i = 0; i < kOptionsCount; ++i) {
+    printf("  --%-20s %s\n", kOptions[i].name, kOptions[i].description);
+  }
+  printf("Defaults: --host=%s --port=%u --apps=%u --duration=%u --show=%g\n",
+         defaults.host.c_str(), defaults.port, defaults.applications,
+         defaults.duration_s, defaults.show_rate);
+}
+
+}  // namespace load_generator
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "load_generator/load_statistics.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace load_generator {
+
+namespace {
+
+/**
+ * \brief Nearest-rank percentile of sorted |values|
+ */
+int64_t Percentile(const std::vector<int64_t>& values, uint32_t percent) {
+  if (values.empty()) {
+    return 0;
+  }
+  const size_t rank = (values.size() * percent + 99) / 100;
+  return values[rank ? rank - 1 : 0];
+}
+
+double Milliseconds(int64_t microseconds) {
+  return microseconds / 1000.0;
+}
+
+}  // namespace
+
+LoadStatistics::RpcStatistics::RpcStatistics()
+  : sent(0),
+    timed_out(0) {
+}
+
+LoadStatistics::LoadStatistics()
+  : notifications_(0),
+    video_bytes_(0) {
+}
+
+void LoadStatistics::OnRequestSent(const std::string& rpc_name) {
+  ++rpcs_[rpc_name].sent;
+}
+
+void LoadStatistics::OnResponseReceived(const std::string& rpc_name,
+                                        int64_t latency_us,
+                                        const std::string& result_code) {
+  RpcStatistics& rpc = rpcs_[rpc_name];
+  rpc.latencies_us.push_back(latency_us);
+  ++rpc.result_codes[result_code.empty() ? "NO_RESULT_CODE" : result_code];
+}
+
+void LoadStatistics::OnResponseTimeout(const std::string& rpc_name) {
+  ++rpcs_[rpc_name].timed_out;
+}
+
+void LoadStatistics::OnNotificationReceived() {
+  ++notifications_;
+}
+
+void LoadStatistics::OnVideoSent(size_t bytes) {
+  video_bytes_ += bytes;
+}
+
+void LoadStatistics::OnSessionFailed(const std::string& reason) {
+  ++failed_sessions_[reason];
+}
+
+void LoadStatistics::Merge(const LoadStatistics& other) {
+  for (RpcStatisticsMap::const_iterator it = other.rpcs_.begin();
+       it != other.rpcs_.end(); ++it) {
+    RpcStatistics& rpc = rpcs_[it->first];
+    rpc.sent += it->second.sent;
+    rpc.timed_out += it->second.timed_out;
+    rpc.latencies_us.insert(rpc.latencies_us.end(),
+                            it->second.latencies_us.begin(),
+                            it->second.latencies_us.end());
+    for (std::map<std::string, uint32_t>::const_iterator code =
+         it->second.result_codes.begin();
+         code != it->second.result_codes.end(); ++code) {
+      rpc.result_codes[code->first] += code->second;
+    }
+  }
+  for (std::map<std::string, uint32_t>::const_iterator it =
+       other.failed_sessions_.begin();
+       it != other.failed_sessions_.end(); ++it) {
+    failed_sessions_[it->first] += it->second;
+  }
+  notifications_ += other.notifications_;
+  video_bytes_ += other.video_bytes_;
+}
+
+void LoadStatistics::Report(double duration_s, std::ostream& out) const {
+  if (duration_s <= 0) {
+    duration_s = 1;
+  }
+  out << std::fixed << std::setprecision(1);
+  out << std::left << std::setw(24) << "RPC"
+      << std::right << std::setw(8) << "sent"
+      << std::setw(8) << "recv"
+      << std::setw(9) << "timeout"
+      << std::setw(9) << "resp/s"
+      << std::setw(9) << "p50 ms"
+      << std::setw(9) << "p90 ms"
+      << std::setw(9) << "p99 ms"
+      << std::setw(9) << "max ms" << '\n';
+
+  uint32_t total_responses = 0;
+  for (RpcStatisticsMap::const_iterator it = rpcs_.begin();
+       it != rpcs_.end(); ++it) {
+    const RpcStatistics& rpc = it->second;
+    std::vector<int64_t> latencies(rpc.latencies_us);
+    std::sort(latencies.begin(), latencies.end());
+    total_responses += latencies.size();
+    out << std::left << std::setw(24) << it->first
+        << std::right << std::setw(8) << rpc.sent
+        << std::setw(8) << latencies.size()
+        << std::setw(9) << rpc.timed_out
+        << std::setw(9) << latencies.size() / duration_s
+        << std::setw(9) << Milliseconds(Percentile(latencies, 50))
+        << std::setw(9) << Milliseconds(Percentile(latencies, 90))
+        << std::setw(9) << Milliseconds(Percentile(latencies, 99))
+        << std::setw(9)
+        << Milliseconds(latencies.empty() ? 0 : latencies.back()) << '\n';
+  }
+  out << "Total responses/s: " << total_responses / duration_s << '\n';
+  out << "Notifications received: " << notifications_ << '\n';
+  out << "Video Mbps: " << video_bytes_ * 8 / duration_s / 1000000 << '\n';
+
+  out << "Result codes:\n";
+  for (RpcStatisticsMap::const_iterator it = rpcs_.begin();
+       it != rpcs_.end(); ++it) {
+    for (std::map<std::string, uint32_t>::const_iterator code =
+         it->second.result_codes.begin();
+         code != it->second.result_codes.end(); ++code) {
+      out << "  " << it->first << ' ' << code->first << ": "
+          << code->second << '\n';
+    }
+  }
+  for (std::map<std::string, uint32_t>::const_iterator it =
+       failed_sessions_.begin(); it != failed_sessions_.end(); ++it) {
+    out << "Failed sessions (" << it->first << "): " << it->second << '\n';
+  }
+}
+
+}  // namespace load_generator
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/logger.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+#ifdef ENABLE_LOG
+#include "utils/log_message_loop_thread.h"
+#endif  // ENABLE_LOG
+#include "load_generator/load_config.h"
+#include "load_generator/load_statistics.h"
+#include "load_generator/mobile_session.h"
+
+namespace {
+
+/**
+ * \brief Lets main thread wait until all sessions are finished
+ */
+class FinishedSessions {
+ public:
+  FinishedSessions()
+    : count_(0) {
+  }
+
+  void OnFinished() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    ++count_;
+    finished_.NotifyOne();
+  }
+
+  void WaitFor(uint32_t count) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (count_ < count) {
+      finished_.Wait(auto_lock);
+    }
+  }
+
+ private:
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable finished_;
+  uint32_t count_;
+};
+
+class SessionDelegate : public threads::ThreadDelegate {
+ public:
+  SessionDelegate(load_generator::MobileSession* session,
+                  int64_t load_end_us, FinishedSessions* finished)
+    : session_(session),
+      load_end_us_(load_end_us),
+      finished_(finished) {
+  }
+
+  void threadMain() {
+    session_->Run(load_end_us_);
+    finished_->OnFinished();
+  }
+
+  bool exitThreadMain() {
+    // Session stops by itself when load is over
+    return true;
+  }
+
+ private:
+  load_generator::MobileSession* session_;
+  int64_t load_end_us_;
+  FinishedSessions* finished_;
+};
+
+int64_t Now() {
+  return date_time::DateTime::getuSecs(date_time::DateTime::getCurrentTime());
+}
+
+}  // namespace
+
+/**
+ * \brief Entry point of load generator. Emulates |apps| mobile applications
+ * connected to SDL TCP transport adapter and prints statistics of
+ * responses when load is over. Applications need HMI which activates them
+ * for most requests to succeed.
+ */
+int32_t main(int32_t argc, char** argv) {
+  load_generator::LoadConfig config;
+  if (!load_generator::ParseCommandLine(argc, argv, &config)) {
+    load_generator::PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  INIT_LOGGER("log4cxx.properties");
+
+  const int64_t start_us = Now();
+  const int64_t load_end_us = start_us +
+      static_cast<int64_t>(config.applications) * config.ramp_ms * 1000 +
+      static_cast<int64_t>(config.duration_s) * 1000000;
+
+  std::vector<load_generator::MobileSession*> sessions;
+  std::vector<threads::Thread*> session_threads;
+  FinishedSessions finished;
+  for (uint32_t i = 0; i < config.applications; ++i) {
+    load_generator::MobileSession* session =
+        new load_generator::MobileSession(i, config);
+    threads::Thread* thread = threads::CreateThread(
+        "LoadApp", new SessionDelegate(session, load_end_us, &finished));
+    sessions.push_back(session);
+    session_threads.push_back(thread);
+    if (!thread->start()) {
+      fprintf(stderr, "Failed to start thread of application %u\n", i);
+      finished.OnFinished();
+    }
+    usleep(config.ramp_ms * 1000);
+  }
+  printf("%u applications started, load ends in %lld s\n",
+         config.applications,
+         static_cast<long long>((load_end_us - Now()) / 1000000));
+
+  finished.WaitFor(config.applications);
+
+  load_generator::LoadStatistics statistics;
+  for (size_t i = 0; i < sessions.size(); ++i) {
+    session_threads[i]->stop();
+    threads::DeleteThread(session_threads[i]);
+    statistics.Merge(sessions[i]->statistics());
+    delete sessions[i];
+  }
+  statistics.Report((load_end_us - start_us) / 1000000.0, std::cout);
+
+#ifdef ENABLE_LOG
+  logger::LogMessageLoopThread::destroy();
+#endif  // ENABLE_LOG
+  DEINIT_LOGGER();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "load_generator/mobile_session.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sstream>
+
+#include "protocol/common.h"
+#include "protocol_handler/protocol_packet.h"
+#include "utils/date_time.h"
+
+namespace load_generator {
+
+using protocol_handler::ProtocolPacket;
+using protocol_handler::RawMessagePtr;
+
+namespace {
+
+// Pending requests are checked for timeout at least this often
+const int64_t kPollIntervalUs = 100000;
+// Due requests are not sent in a burst if session is late more than that
+const int64_t kMaxLagUs = 1000000;
+const size_t kMaxFrameDataSize =
+    protocol_handler::MAXIMUM_FRAME_DATA_SIZE -
+    protocol_handler::PROTOCOL_HEADER_V2_SIZE;
+const size_t kReceiveBufferSize = 64 * 1024;
+
+int64_t Now() {
+  return date_time::DateTime::getuSecs(date_time::DateTime::getCurrentTime());
+}
+
+void WriteUint32BE(uint32_t value, uint8_t* out) {
+  out[0] = value >> 24;
+  out[1] = value >> 16;
+  out[2] = value >> 8;
+  out[3] = value;
+}
+
+uint32_t ReadUint32BE(const uint8_t* in) {
+  return (static_cast<uint32_t>(in[0]) << 24) |
+         (static_cast<uint32_t>(in[1]) << 16) |
+         (static_cast<uint32_t>(in[2]) << 8) |
+         static_cast<uint32_t>(in[3]);
+}
+
+int64_t IntervalUs(double rate) {
+  return rate > 0 ? static_cast<int64_t>(1000000 / rate) : 0;
+}
+
+}  // namespace
+
+MobileSession::MobileSession(uint32_t index, const LoadConfig& config)
+  : index_(index),
+    config_(config),
+    socket_(-1),
+    session_id_(0),
+    message_id_(0),
+    correlation_id_(0),
+    command_id_(0),
+    put_file_count_(0),
+    subscribed_(false),
+    control_answered_(false),
+    service_started_(false),
+    register_correlation_id_(0),
+    register_answered_(false),
+    registered_(false),
+    video_frame_(kMaxFrameDataSize) {
+  for (size_t i = 0; i < kSchedulesCount; ++i) {
+    schedules_[i].interval_us = 0;
+    schedules_[i].next_us = 0;
+  }
+}
+
+MobileSession::~MobileSession() {
+  if (socket_ >= 0) {
+    close(socket_);
+  }
+}
+
+void MobileSession::Run(int64_t load_end_us) {
+  if (!Connect()) {
+    statistics_.OnSessionFailed("connect");
+    return;
+  }
+  if (!StartService(protocol_handler::kRpc)) {
+    statistics_.OnSessionFailed("start RPC service");
+    return;
+  }
+  if (!RegisterApplication()) {
+    statistics_.OnSessionFailed("register application");
+    return;
+  }
+  const bool video_started =
+      config_.video_kbps && StartService(protocol_handler::kMobileNav);
+  if (config_.video_kbps && !video_started) {
+    statistics_.OnSessionFailed("start video service");
+  }
+
+  InitSchedules(Now());
+  if (!video_started) {
+    schedules_[kVideo].interval_us = 0;
+  }
+
+  for (int64_t now = Now(); now < load_end_us; now = Now()) {
+    SendDueRequests(now);
+    ExpirePending(now - config_.response_timeout_ms * 1000);
+    const int64_t wake_up = std::min(NextDue(), load_end_us);
+    const int64_t wait = std::max<int64_t>(
+        0, std::min(wake_up - now, kPollIntervalUs));
+    if (!Receive(wait)) {
+      statistics_.OnSessionFailed("connection closed");
+      ExpirePending(load_end_us);
+      return;
+    }
+  }
+
+  // Responses to requests sent at the very end of load are still counted
+  const int64_t drain_end = Now() + config_.response_timeout_ms * 1000;
+  for (int64_t now = Now(); !pending_.empty() && now < drain_end;
+       now = Now()) {
+    if (!Receive(std::min(drain_end - now, kPollIntervalUs))) {
+      break;
+    }
+  }
+  ExpirePending(drain_end);
+}
+
+const LoadStatistics& MobileSession::statistics() const {
+  return statistics_;
+}
+
+bool MobileSession::Connect() {
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(config_.port);
+  if (inet_pton(AF_INET, config_.host.c_str(), &address.sin_addr) != 1) {
+    return false;
+  }
+  socket_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (socket_ < 0) {
+    return false;
+  }
+  const int yes = 1;
+  setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+  return 0 == connect(socket_, reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address));
+}
+
+bool MobileSession::StartService(protocol_handler::ServiceType service_type) {
+  const ProtocolPacket packet(
+      0, protocol_handler::PROTOCOL_VERSION_2,
+      protocol_handler::PROTECTION_OFF, protocol_handler::FRAME_TYPE_CONTROL,
+      service_type, protocol_handler::FRAME_DATA_START_SERVICE, session_id_,
+      0, ++message_id_);
+  control_answered_ = false;
+  service_started_ = false;
+  return SendFrame(packet) &&
+         ReceiveUntil(&control_answered_,
+                      config_.response_timeout_ms * 1000) &&
+         service_started_;
+}
+
+bool MobileSession::RegisterApplication() {
+  std::stringstream app_name;
+  app_name << "LoadApp" << index_;
+  std::stringstream app_id;
+  app_id << 100000 + index_;
+
+  register_correlation_id_ = ++correlation_id_;
+  RpcPayload payload;
+  if (!builder_.RegisterAppInterface(register_correlation_id_,
+                                     app_name.str(), app_id.str(),
+                                     config_.video_kbps != 0, &payload)) {
+    return false;
+  }
+  return SendRequest("RegisterAppInterface", register_correlation_id_,
+                     payload) &&
+         ReceiveUntil(&register_answered_,
+                      config_.response_timeout_ms * 1000) &&
+         registered_;
+}
+
+void MobileSession::InitSchedules(int64_t now_us) {
+  schedules_[kShow].interval_us = IntervalUs(config_.show_rate);
+  schedules_[kAddCommand].interval_us = IntervalUs(config_.add_command_rate);
+  schedules_[kSubscribeVehicleData].interval_us =
+      IntervalUs(config_.subscribe_rate);
+  schedules_[kPutFile].interval_us = IntervalUs(config_.put_file_rate);
+  // Bits of one frame divided by bits per microsecond
+  schedules_[kVideo].interval_us = config_.video_kbps
+      ? video_frame_.size() * 8 * 1000 / config_.video_kbps : 0;
+
+  // Applications are spread over the interval so that they don't send
+  // their requests at the same moment
+  for (size_t i = 0; i < kSchedulesCount; ++i) {
+    schedules_[i].next_us =
+        now_us + schedules_[i].interval_us * (index_ % 10) / 10;
+  }
+}
+
+void MobileSession::SendDueRequests(int64_t now_us) {
+  for (size_t i = 0; i < kSchedulesCount; ++i) {
+    Schedule& schedule = schedules_[i];
+    if (!schedule.interval_us) {
+      continue;
+    }
+    if (schedule.next_us < now_us - kMaxLagUs) {
+      schedule.next_us = now_us;
+    }
+    while (schedule.next_us <= now_us) {
+      if (!SendScheduled(static_cast<ScheduleType>(i))) {
+        return;
+      }
+      schedule.next_us += schedule.interval_us;
+    }
+  }
+}
+
+int64_t MobileSession::NextDue() const {
+  int64_t next_due = Now() + kPollIntervalUs;
+  for (size_t i = 0; i < kSchedulesCount; ++i) {
+    if (schedules_[i].interval_us) {
+      next_due = std::min(next_due, schedules_[i].next_us);
+    }
+  }
+  return next_due;
+}
+
+bool MobileSession::SendScheduled(ScheduleType type) {
+  RpcPayload payload;
+  switch (type) {
+    case kShow: {
+      const uint32_t correlation_id = ++correlation_id_;
+      std::stringstream text;
+      text << "Show " << correlation_id;
+      return builder_.Show(correlation_id, text.str(), &payload) &&
+             SendRequest("Show", correlation_id, payload);
+    }
+    case kAddCommand: {
+      for (uint32_t i = 0; i < config_.add_command_burst; ++i) {
+        const uint32_t correlation_id = ++correlation_id_;
+        if (!builder_.AddCommand(correlation_id, ++command_id_, &payload) ||
+            !SendRequest("AddCommand", correlation_id, payload)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case kSubscribeVehicleData: {
+      const uint32_t correlation_id = ++correlation_id_;
+      subscribed_ = !subscribed_;
+      return builder_.SubscribeVehicleData(correlation_id, subscribed_,
+                                           &payload) &&
+             SendRequest(subscribed_ ? "SubscribeVehicleData"
+                                     : "UnsubscribeVehicleData",
+                         correlation_id, payload);
+    }
+    case kPutFile: {
+      const uint32_t correlation_id = ++correlation_id_;
+      std::stringstream file_name;
+      file_name << "load_" << index_ << '_' << put_file_count_++ % 10
+                << ".bin";
+      return builder_.PutFile(correlation_id, file_name.str(),
+                              config_.put_file_size, &payload) &&
+             SendRequest("PutFile", correlation_id, payload);
+    }
+    case kVideo: {
+      if (!SendMessage(protocol_handler::kMobileNav, &video_frame_[0],
+                       video_frame_.size())) {
+        return false;
+      }
+      statistics_.OnVideoSent(video_frame_.size());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool MobileSession::SendRequest(const std::string& rpc_name,
+                                uint32_t correlation_id,
+                                const RpcPayload& payload) {
+  if (!SendMessage(protocol_handler::kRpc, &payload[0], payload.size())) {
+    return false;
+  }
+  const PendingRequest request = {rpc_name, Now()};
+  pending_[correlation_id] = request;
+  statistics_.OnRequestSent(rpc_name);
+  return true;
+}
+
+bool MobileSession::SendMessage(uint8_t service_type, const uint8_t* data,
+                                size_t size) {
+  const uint32_t message_id = ++message_id_;
+  if (size <= kMaxFrameDataSize) {
+    const ProtocolPacket packet(
+        0, protocol_handler::PROTOCOL_VERSION_2,
+        protocol_handler::PROTECTION_OFF, protocol_handler::FRAME_TYPE_SINGLE,
+        service_type, protocol_handler::FRAME_DATA_SINGLE, session_id_, size,
+        message_id, data);
+    return SendFrame(packet);
+  }
+
+  const size_t frames_count = (size + kMaxFrameDataSize - 1) /
+                              kMaxFrameDataSize;
+  uint8_t first_frame_data[protocol_handler::FIRST_FRAME_DATA_SIZE];
+  WriteUint32BE(size, first_frame_data);
+  WriteUint32BE(frames_count, first_frame_data + 4);
+  const ProtocolPacket first_frame(
+      0, protocol_handler::PROTOCOL_VERSION_2,
+      protocol_handler::PROTECTION_OFF, protocol_handler::FRAME_TYPE_FIRST,
+      service_type, protocol_handler::FRAME_DATA_FIRST, session_id_,
+      protocol_handler::FIRST_FRAME_DATA_SIZE, message_id, first_frame_data);
+  if (!SendFrame(first_frame)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < frames_count; ++i) {
+    const bool is_last_frame = (i == frames_count - 1);
+    const size_t frame_size =
+        is_last_frame ? size - kMaxFrameDataSize * i : kMaxFrameDataSize;
+    const uint8_t frame_data = is_last_frame
+        ? protocol_handler::FRAME_DATA_LAST_CONSECUTIVE
+        : i % protocol_handler::FRAME_DATA_MAX_CONSECUTIVE + 1;
+    const ProtocolPacket frame(
+        0, protocol_handler::PROTOCOL_VERSION_2,
+        protocol_handler::PROTECTION_OFF,
+        protocol_handler::FRAME_TYPE_CONSECUTIVE, service_type, frame_data,
+        session_id_, frame_size, message_id, data + kMaxFrameDataSize * i);
+    if (!SendFrame(frame)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MobileSession::SendFrame(const ProtocolPacket& packet) {
+  const RawMessagePtr raw_message = packet.serializePacket();
+  if (!raw_message) {
+    return false;
+  }
+  const uint8_t* data = raw_message->data();
+  size_t left = raw_message->data_size();
+  while (left) {
+    const ssize_t sent = send(socket_, data, left, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += sent;
+    left -= sent;
+  }
+  return true;
+}
+
+bool MobileSession::Receive(int64_t timeout_us) {
+  pollfd descriptor = {socket_, POLLIN, 0};
+  const int ready = poll(&descriptor, 1, (timeout_us + 999) / 1000);
+  if (ready < 0) {
+    return errno == EINTR;
+  }
+  if (!ready) {
+    return true;
+  }
+
+  uint8_t buffer[kReceiveBufferSize];
+  const ssize_t received = recv(socket_, buffer, sizeof(buffer), 0);
+  if (received <= 0) {
+    return received < 0 && errno == EINTR;
+  }
+  incoming_.insert(incoming_.end(), buffer, buffer + received);
+
+  size_t offset = 0;
+  while (incoming_.size() - offset >=
+         protocol_handler::PROTOCOL_HEADER_V1_SIZE) {
+    uint8_t* frame_begin = &incoming_[offset];
+    const size_t header_size =
+        (frame_begin[0] >> 4) == protocol_handler::PROTOCOL_VERSION_1
+        ? protocol_handler::PROTOCOL_HEADER_V1_SIZE
+        : protocol_handler::PROTOCOL_HEADER_V2_SIZE;
+    if (incoming_.size() - offset < header_size) {
+      break;
+    }
+    const size_t frame_size = header_size + ReadUint32BE(frame_begin + 4);
+    if (incoming_.size() - offset < frame_size) {
+      break;
+    }
+    const ProtocolPacket frame(0, frame_begin, frame_size);
+    HandleFrame(frame);
+    offset += frame_size;
+  }
+  incoming_.erase(incoming_.begin(), incoming_.begin() + offset);
+  return true;
+}
+
+bool MobileSession::ReceiveUntil(const bool* condition, int64_t timeout_us) {
+  const int64_t end = Now() + timeout_us;
+  while (!*condition) {
+    const int64_t now = Now();
+    if (now >= end || !Receive(end - now)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MobileSession::HandleFrame(const ProtocolPacket& frame) {
+  switch (frame.frame_type()) {
+    case protocol_handler::FRAME_TYPE_CONTROL:
+      if (frame.frame_data() ==
+          protocol_handler::FRAME_DATA_START_SERVICE_ACK) {
+        session_id_ = frame.session_id();
+        service_started_ = true;
+        control_answered_ = true;
+      } else if (frame.frame_data() ==
+                 protocol_handler::FRAME_DATA_START_SERVICE_NACK) {
+        control_answered_ = true;
+      }
+      break;
+    case protocol_handler::FRAME_TYPE_SINGLE:
+      if (frame.service_type() == protocol_handler::kRpc) {
+        HandleRpc(frame.data(), frame.data_size());
+      }
+      break;
+    case protocol_handler::FRAME_TYPE_FIRST:
+      multi_frame_.clear();
+      break;
+    case protocol_handler::FRAME_TYPE_CONSECUTIVE:
+      multi_frame_.insert(multi_frame_.end(), frame.data(),
+                          frame.data() + frame.data_size());
+      if (frame.frame_data() ==
+          protocol_handler::FRAME_DATA_LAST_CONSECUTIVE) {
+        if (frame.service_type() == protocol_handler::kRpc &&
+            !multi_frame_.empty()) {
+          HandleRpc(&multi_frame_[0], multi_frame_.size());
+        }
+        multi_frame_.clear();
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void MobileSession::HandleRpc(const uint8_t* data, size_t size) {
+  RpcHeader header;
+  if (!RpcBuilder::ParseHeader(data, size, &header)) {
+    return;
+  }
+  if (header.rpc_type == RpcHeader::kNotification) {
+    statistics_.OnNotificationReceived();
+    return;
+  }
+  PendingRequests::iterator it = pending_.find(header.correlation_id);
+  if (header.rpc_type != RpcHeader::kResponse || it == pending_.end()) {
+    return;
+  }
+  const std::string result_code =
+      RpcBuilder::ResultCode(header, data + RpcHeader::kSize);
+  statistics_.OnResponseReceived(it->second.rpc_name,
+                                 Now() - it->second.sent_us, result_code);
+  if (header.correlation_id == register_correlation_id_) {
+    register_answered_ = true;
+    registered_ = result_code == "SUCCESS" || result_code == "WARNINGS";
+  }
+  pending_.erase(it);
+}
+
+void MobileSession::ExpirePending(int64_t deadline_us) {
+  PendingRequests::iterator it = pending_.begin();
+  while (it != pending_.end()) {
+    if (it->second.sent_us <= deadline_us) {
+      statistics_.OnResponseTimeout(it->second.rpc_name);
+      pending_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace load_generator
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "load_generator/rpc_builder.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "formatters/CFormatterJsonSDLRPCv2.hpp"
+#include "formatters/CSmartFactory.hpp"
+
+namespace load_generator {
+
+namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+namespace jhs = NsSmartDeviceLink::NsJSONHandler::strings;
+
+namespace {
+
+const int32_t kProtocolVersion = 2;
+
+void WriteUint32BE(uint32_t value, uint8_t* out) {
+  out[0] = value >> 24;
+  out[1] = value >> 16;
+  out[2] = value >> 8;
+  out[3] = value;
+}
+
+uint32_t ReadUint32BE(const uint8_t* in) {
+  return (static_cast<uint32_t>(in[0]) << 24) |
+         (static_cast<uint32_t>(in[1]) << 16) |
+         (static_cast<uint32_t>(in[2]) << 8) |
+         static_cast<uint32_t>(in[3]);
+}
+
+}  // namespace
+
+RpcBuilder::RpcBuilder() {
+}
+
+bool RpcBuilder::RegisterAppInterface(uint32_t correlation_id,
+                                      const std::string& app_name,
+                                      const std::string& app_id,
+                                      bool is_navigation,
+                                      RpcPayload* payload) {
+  smart_objects::SmartObject msg_params(smart_objects::SmartType_Map);
+  msg_params["syncMsgVersion"]["majorVersion"] = 2;
+  msg_params["syncMsgVersion"]["minorVersion"] = 0;
+  msg_params["appName"] = app_name;
+  msg_params["appID"] = app_id;
+  msg_params["isMediaApplication"] = false;
+  msg_params["languageDesired"] = mobile_apis::Language::EN_US;
+  msg_params["hmiDisplayLanguageDesired"] = mobile_apis::Language::EN_US;
+  if (is_navigation) {
+    msg_params["appHMIType"] =
+        smart_objects::SmartObject(smart_objects::SmartType_Array);
+    msg_params["appHMIType"][0] = mobile_apis::AppHMIType::NAVIGATION;
+  }
+  return Build(mobile_apis::FunctionID::RegisterAppInterfaceID,
+               correlation_id, msg_params, RpcPayload(), payload);
+}
+
+bool RpcBuilder::Show(uint32_t correlation_id, const std::string& text,
+                      RpcPayload* payload) {
+  smart_objects::SmartObject msg_params(smart_objects::SmartType_Map);
+  msg_params["mainField1"] = text;
+  msg_params["mainField2"] = std::string("load generator");
+  return Build(mobile_apis::FunctionID::ShowID, correlation_id, msg_params,
+               RpcPayload(), payload);
+}
+
+bool RpcBuilder::AddCommand(uint32_t correlation_id, uint32_t command_id,
+                            RpcPayload* payload) {
+  smart_objects::SmartObject msg_params(smart_objects::SmartType_Map);
+  msg_params["cmdID"] = command_id;
+  std::stringstream menu_name;
+  menu_name << "Command " << command_id;
+  msg_params["menuParams"]["menuName"] = menu_name.str();
+  return Build(mobile_apis::FunctionID::AddCommandID, correlation_id,
+               msg_params, RpcPayload(), payload);
+}
+
+bool RpcBuilder::SubscribeVehicleData(uint32_t correlation_id,
+                                      bool subscribe,
+                                      RpcPayload* payload) {
+  smart_objects::SmartObject msg_params(smart_objects::SmartType_Map);
+  msg_params["speed"] = true;
+  msg_params["rpm"] = true;
+  msg_params["fuelLevel"] = true;
+  return Build(subscribe ? mobile_apis::FunctionID::SubscribeVehicleDataID
+                         : mobile_apis::FunctionID::UnsubscribeVehicleDataID,
+               correlation_id, msg_params, RpcPayload(), payload);
+}
+
+bool RpcBuilder::PutFile(uint32_t correlation_id,
+                         const std::string& file_name,
+                         uint32_t file_size, RpcPayload* payload) {
+  smart_objects::SmartObject msg_params(smart_objects::SmartType_Map);
+  msg_params["syncFileName"] = file_name;
+  msg_params["fileType"] = mobile_apis::FileType::BINARY;
+  msg_params["persistentFile"] = false;
+  RpcPayload file_data(file_size);
+  for (uint32_t i = 0; i < file_size; ++i) {
+    file_data[i] = static_cast<uint8_t>(i);
+  }
+  return Build(mobile_apis::FunctionID::PutFileID, correlation_id,
+               msg_params, file_data, payload);
+}
+
+bool RpcBuilder::ParseHeader(const uint8_t* payload, size_t size,
+                             RpcHeader* header) {
+  if (size < RpcHeader::kSize) {
+    return false;
+  }
+  header->rpc_type = static_cast<RpcHeader::RpcType>(payload[0] >> 4);
+  header->function_id = ReadUint32BE(payload) & 0x0FFFFFFF;
+  header->correlation_id = ReadUint32BE(payload + 4);
+  header->json_size = ReadUint32BE(payload + 8);
+  return header->json_size <= size - RpcHeader::kSize;
+}
+
+std::string RpcBuilder::ResultCode(const RpcHeader& header,
+                                   const uint8_t* json) {
+  smart_objects::SmartObject message;
+  const char* json_begin = reinterpret_cast<const char*>(json);
+  if (!formatters::CFormatterJsonSDLRPCv2::fromString(
+          json_begin, json_begin + header.json_size, message,
+          static_cast<mobile_apis::FunctionID::eType>(header.function_id),
+          mobile_apis::messageType::response)) {
+    return std::string();
+  }
+  const smart_objects::SmartObject& msg_params = message[jhs::S_MSG_PARAMS];
+  if (!msg_params.keyExists("resultCode")) {
+    return std::string();
+  }
+  return msg_params["resultCode"].asString();
+}
+
+bool RpcBuilder::Build(mobile_apis::FunctionID::eType function_id,
+                       uint32_t correlation_id,
+                       const smart_objects::SmartObject& msg_params,
+                       const RpcPayload& binary_data,
+                       RpcPayload* payload) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  message[jhs::S_PARAMS][jhs::S_FUNCTION_ID] = function_id;
+  message[jhs::S_PARAMS][jhs::S_MESSAGE_TYPE] =
+      mobile_apis::messageType::request;
+  message[jhs::S_PARAMS][jhs::S_CORRELATION_ID] = correlation_id;
+  message[jhs::S_PARAMS][jhs::S_PROTOCOL_TYPE] = 0;
+  message[jhs::S_PARAMS][jhs::S_PROTOCOL_VERSION] = kProtocolVersion;
+  message[jhs::S_MSG_PARAMS] = msg_params;
+
+  if (!factory_.attachSchema(message) ||
+      message.validate() != smart_objects::Errors::OK) {
+    return false;
+  }
+  std::string json;
+  if (!formatters::CFormatterJsonSDLRPCv2::toString(message, json)) {
+    return false;
+  }
+
+  payload->resize(RpcHeader::kSize + json.size() + binary_data.size());
+  uint8_t* header = &(*payload)[0];
+  WriteUint32BE(static_cast<uint32_t>(function_id), header);
+  header[0] |= RpcHeader::kRequest << 4;
+  WriteUint32BE(correlation_id, header + 4);
+  WriteUint32BE(json.size(), header + 8);
+  std::copy(json.begin(), json.end(), payload->begin() + RpcHeader::kSize);
+  std::copy(binary_data.begin(), binary_data.end(),
+            payload->begin() + RpcHeader::kSize + json.size());
+  return true;
+}
+
+}  // namespace load_generator